@@ -160,7 +160,56 @@ static int __async_config(WT_SESSION_IMPL* session, WT_CONNECTION_IMPL* conn, co
 	WT_RET(__wt_config_gets(session, cfg, "async.threads", &cval));
 	conn->async_workers = (uint32_t)cval.val;
 
-	WT_ASSERT(session, conn->async_workers <= WT_ASYNC_MAX_WORKERS);
+	WT_RET(__wt_config_gets(session, cfg, "async.threads_max", &cval));
+	conn->async_workers_max = (uint32_t)cval.val;
+
+	if (conn->async_workers > conn->async_workers_max)
+		WT_RET_MSG(session, EINVAL,
+		    "async.threads (%" PRIu32 ") must not exceed async.threads_max (%" PRIu32 ")",
+		    conn->async_workers, conn->async_workers_max);
+
+	return 0;
+}
+
+/*
+ * 根据排队延迟直方图计算百分位数，直方图按log2(usecs)分桶，返回所在桶的上界(usecs)
+ */
+static uint64_t __async_latency_percentile(WT_ASYNC* async, uint32_t pct)
+{
+	uint64_t hist[WT_ASYNC_LATENCY_BUCKETS], sum, target, total;
+	uint32_t i;
+
+	total = 0;
+	for (i = 0; i < WT_ASYNC_LATENCY_BUCKETS; i++){
+		WT_ORDERED_READ(hist[i], async->latency_hist[i]);
+		total += hist[i];
+	}
+	if (total == 0)
+		return 0;
+
+	target = (total * pct + 99) / 100;
+	for (sum = 0, i = 0; i < WT_ASYNC_LATENCY_BUCKETS - 1; i++){
+		sum += hist[i];
+		if (sum >= target)
+			break;
+	}
+
+	return (uint64_t)1 << i;
+}
+
+/*为async worker分配或者扩大session和线程ID数组*/
+static int __async_worker_alloc(WT_SESSION_IMPL* session, WT_ASYNC* async, uint32_t count)
+{
+	size_t bytes;
+
+	if (count <= async->worker_alloc)
+		return 0;
+
+	bytes = async->worker_alloc * sizeof(WT_SESSION_IMPL *);
+	WT_RET(__wt_realloc(session, &bytes, count * sizeof(WT_SESSION_IMPL *), &async->worker_sessions));
+	bytes = async->worker_alloc * sizeof(wt_thread_t);
+	WT_RET(__wt_realloc(session, &bytes, count * sizeof(wt_thread_t), &async->worker_tids));
+	async->worker_alloc = count;
 
 	return 0;
 }
@@ -180,9 +229,27 @@ void __wt_async_stats_update(WT_SESSION_IMPL* session)
 	stats = &conn->stats;
 	WT_STAT_SET(stats, async_cur_queue, async->cur_queue);
 	WT_STAT_SET(stats, async_max_queue, async->max_queue);
+	WT_STAT_SET(stats, async_queue_latency_p50, __async_latency_percentile(async, 50));
+	WT_STAT_SET(stats, async_queue_latency_p90, __async_latency_percentile(async, 90));
+	WT_STAT_SET(stats, async_queue_latency_p99, __async_latency_percentile(async, 99));
+	WT_STAT_SET(stats, async_queue_latency_max, async->latency_max);
 	F_SET(conn, WT_CONN_SERVER_ASYNC);
 }
 
+/*清除排队延迟的直方图和最大值，在清除connection统计信息时调用。和worker的更新并发时可能丢掉个别样本*/
+void __wt_async_stats_clear(WT_SESSION_IMPL* session)
+{
+	WT_ASYNC *async;
+	uint32_t i;
+
+	if ((async = S2C(session)->async) == NULL)
+		return;
+
+	for (i = 0; i < WT_ASYNC_LATENCY_BUCKETS; i++)
+		async->latency_hist[i] = 0;
+	WT_PUBLISH(async->latency_max, 0);
+}
+
 static int __async_start(WT_SESSION_IMPL* session)
 {
 	WT_ASYNC *async;
@@ -198,7 +265,9 @@ static int __async_start(WT_SESSION_IMPL* session)
 	STAILQ_INIT(&async->formatqh);
 	WT_RET(__wt_spin_init(session, &async->ops_lock, "ops"));
 	WT_RET(__wt_cond_alloc(session, "async flush", 0, &async->flush_cond));
+	WT_RET(__wt_cond_alloc(session, "async work", 0, &async->work_cond));
 	WT_RET(__wt_async_op_init(session));
+	WT_RET(__async_worker_alloc(session, async, conn->async_workers_max));
 
 	/*根据配置信息启动sync threads,先创建各个线程所用的session对象，再启动线程*/
 	F_SET(conn, WT_CONN_SERVER_ASYNC);
@@ -246,6 +315,7 @@ int __wt_async_reconfig(WT_SESSION_IMPL* session, const char* cfg[])
 	memset(&tmp_conn, 0, sizeof(tmp_conn));
 	tmp_conn.async_cfg = conn->async_cfg;
 	tmp_conn.async_workers = conn->async_workers;
+	tmp_conn.async_workers_max = conn->async_workers_max;
 	tmp_conn.async_size = conn->async_size;
 	
 	/* Handle configuration. */
@@ -280,11 +350,19 @@ int __wt_async_reconfig(WT_SESSION_IMPL* session, const char* cfg[])
 		conn->async_cfg = 0;
 		return ret;
 	}
-	else if (conn->async_cfg == 0 && run)
-		__async_start(session);
+	else if (conn->async_cfg == 0 && run){
+		conn->async_workers = tmp_conn.async_workers;
+		conn->async_workers_max = tmp_conn.async_workers_max;
+		WT_RET(__async_start(session));
+		async = conn->async;
+	}
 	else if (conn->async_cfg == 0) /*不是开关控制信号*/
 		return 0;
 
+	/*worker数量的上限可以在运行时调整，只需要扩大worker数组*/
+	WT_RET(__async_worker_alloc(session, async, tmp_conn.async_workers_max));
+	conn->async_workers_max = tmp_conn.async_workers_max;
+
 	/*
 	* Running async worker modification cases:
 	* 4. If number of workers didn't change, we're done.
@@ -317,6 +395,7 @@ int __wt_async_reconfig(WT_SESSION_IMPL* session, const char* cfg[])
 			WT_ASSERT(session, async->worker_tids[i] != 0);
 			WT_ASSERT(session, async->worker_sessions[i] != NULL);
 			F_CLR(async->worker_sessions[i], WT_SESSION_SERVER_ASYNC);
+			WT_TRET(__wt_cond_signal(session, async->work_cond));
 			WT_TRET(__wt_thread_join(session, async->worker_tids[i]));
 			async->worker_tids[i] = 0;
 			wt_session = &async->worker_sessions[i]->iface;
@@ -346,8 +425,9 @@ int __wt_async_destroy(WT_SESSION_IMPL* session)
 	if (!conn->async_cfg)
 		return 0;
 
-	/*停止线程*/
+	/*停止线程，唤醒在work_cond上等待的worker*/
 	F_CLR(conn, WT_CONN_SERVER_ASYNC);
+	WT_TRET(__wt_cond_signal(session, async->work_cond));
 	for (i = 0; i < conn->async_workers; i++){
 		if (async->worker_tids[i] != 0) {
 			WT_TRET(__wt_thread_join(session, async->worker_tids[i]));
@@ -356,6 +436,7 @@ int __wt_async_destroy(WT_SESSION_IMPL* session)
 	}
 	/*销毁flush io信号量*/
 	WT_TRET(__wt_cond_destroy(session, &async->flush_cond));
+	WT_TRET(__wt_cond_destroy(session, &async->work_cond));
 
 	/* Close the server threads' sessions. */
 	for (i = 0; i < conn->async_workers; i++){
@@ -389,6 +470,8 @@ int __wt_async_destroy(WT_SESSION_IMPL* session)
 
 	__wt_free(session, async->async_queue);
 	__wt_free(session, async->async_ops);
+	__wt_free(session, async->worker_sessions);
+	__wt_free(session, async->worker_tids);
 	__wt_spin_destroy(session, &async->ops_lock);
 	__wt_free(session, conn->async);
 
@@ -516,3 +599,59 @@ err:
 	return ret;
 }
 
+
+/*
+ * 提交一批对同一个uri的异步操作。整个batch只占用async_ops池中的一个op，只做一次format
+ * 查找和一次排队，worker用同一个cursor执行，最后调用一次notify_batch
+ */
+int __wt_async_batch(WT_SESSION_IMPL* session, const char* uri, const char* config, const char* cfg[],
+					WT_ASYNC_CALLBACK* cb, WT_ASYNC_BATCH_OP* ops, uint32_t nops)
+{
+	WT_ASYNC_OP_IMPL *op;
+	WT_CONNECTION_IMPL *conn;
+	WT_DECL_RET;
+	uint32_t i;
+
+	conn = S2C(session);
+	if (!conn->async_cfg)
+		return (ENOTSUP);
+
+	if (ops == NULL || nops == 0)
+		WT_RET_MSG(session, EINVAL, "async batch must contain at least one operation");
+
+	for (i = 0; i < nops; i++){
+		switch (ops[i].optype){
+		case WT_AOP_INSERT:
+		case WT_AOP_REMOVE:
+		case WT_AOP_SEARCH:
+		case WT_AOP_UPDATE:
+			break;
+		case WT_AOP_COMPACT:
+		case WT_AOP_NONE:
+		default:
+			WT_RET_MSG(session, EINVAL, "async batch operation %" PRIu32 " has unsupported optype %d", i, ops[i].optype);
+		}
+	}
+
+	op = NULL;
+	WT_ERR(__async_new_op_alloc(session, uri, config, &op));
+	WT_ERR(__async_runtime_config(op, cfg));
+	op->cb = cb;
+	op->batch = ops;
+	op->batch_count = nops;
+
+	WT_STAT_FAST_CONN_INCR(session, async_op_batch);
+	WT_STAT_FAST_CONN_INCRV(session, async_op_batch_ops, nops);
+	WT_ERR(__wt_async_op_enqueue(session, op));
+
+	return 0;
+
+err:
+	if (op != NULL){
+		op->batch = NULL;
+		op->batch_count = 0;
+		op->state = WT_ASYNCOP_FREE;
+	}
+
+	return ret;
+}
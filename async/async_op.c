@@ -213,9 +213,10 @@ static int __async_op_init(WT_CONNECTION_IMPL* conn, WT_ASYNC_OP_IMPL* op, uint3
 int __wt_async_op_enqueue(WT_SESSION_IMPL* session, WT_ASYNC_OP_IMPL* op)
 {
 	WT_ASYNC *async;
+	WT_ASYNC_QSLOT *slot;
 	WT_CONNECTION_IMPL *conn;
 	WT_DECL_RET;
-	uint64_t cur_head, cur_tail, my_alloc, my_slot;
+	uint64_t pos, seq;
 
 	conn = S2C(session);
 	async = conn->async;
@@ -226,30 +227,45 @@ int __wt_async_op_enqueue(WT_SESSION_IMPL* session, WT_ASYNC_OP_IMPL* op)
 	if (op->state != WT_ASYNCOP_READY)
 		WT_RET_MSG(session, EINVAL, "application error: WT_ASYNC_OP already in use");
 
-	/*确定排队操作在队列中的位置，async_queue是一个ring buffer,循环队列无锁？？*/
-	my_alloc = WT_ATOMIC_ADD8(async->alloc_head, 1);
-	my_slot = my_alloc % async->async_qsize;
+	WT_RET(__wt_epoch(session, &op->enqueue_time));
 
-	/*等待自己slot操作时机,相当于spin wait*/
-	WT_ORDERED_READ(cur_tail, async->tail_slot);
-	while (cur_tail == my_slot){
-		__wt_yield();
-		WT_ORDERED_READ(cur_tail, async->tail_slot);
+	/*
+	 * async_queue是一个有界的多生产者多消费者ring buffer，通过slot上的seq判断slot是否可用，
+	 * 入队者之间只竞争enqueue_pos，不需要等待前面的入队者完成
+	 */
+	WT_ORDERED_READ(pos, async->enqueue_pos);
+	for (;;){
+		slot = &async->async_queue[pos & (async->async_qsize - 1)];
+		WT_ORDERED_READ(seq, slot->seq);
+		if (seq == pos){
+			if (WT_ATOMIC_CAS8(async->enqueue_pos, pos, pos + 1))
+				break;
+		}
+		else if ((int64_t)(seq - pos) < 0){
+			/*
+			 * 队列满了，队列的长度大于op的个数，只有worker还没有释放slot的瞬间会发生
+			 */
+			__wt_yield();
+		}
+		WT_ORDERED_READ(pos, async->enqueue_pos);
 	}
 
-	/*将操作插入到队列当中,并修改当前排队的op数量*/
-	WT_PUBLISH(async->async_queue[my_slot], op);
+	/*将操作填入slot,并修改当前排队的op数量*/
 	op->state = WT_ASYNCOP_ENQUEUED;
+	slot->op = op;
+	WT_PUBLISH(slot->seq, pos + 1);
 	if (WT_ATOMIC_ADD4(async->cur_queue, 1) > async->max_queue)
 		WT_PUBLISH(async->max_queue, async->cur_queue);
 
-	/*等待自己的op的排队确认*/
-	WT_ORDERED_READ(cur_head, async->head);
-	while (cur_head != (my_alloc - 1)) {
-		__wt_yield();
-		WT_ORDERED_READ(cur_head, async->head);
+	/*
+	 * 有worker在work_cond上等待则唤醒它们，worker在等待之前会先增加idle_workers再检查
+	 * 队列，这里的full barrier保证两边至少有一方能看到对方的修改
+	 */
+	WT_FULL_BARRIER();
+	if (async->idle_workers > 0){
+		WT_STAT_FAST_CONN_INCR(session, async_worker_wakeup);
+		WT_TRET(__wt_cond_signal(session, async->work_cond));
 	}
-	WT_PUBLISH(async->head, my_alloc);
 
 	return ret;
 }
@@ -271,11 +287,15 @@ int __wt_async_op_init(WT_SESSION_IMPL* session)
 
 	/*
 	* Allocate and initialize the work queue.  This is sized so that
-	* the ring buffer is known to be big enough such that the head
-	* can never overlap the tail.  Include extra for the flush op.
+	* the ring buffer is known to be big enough to hold every op and
+	* the flush op, rounded up to a power of two so that positions
+	* map to slots with a mask.
 	*/
-	async->async_qsize = conn->async_size + 2;
+	async->async_qsize = __wt_nlpo2(conn->async_size + 2);
 	WT_RET(__wt_calloc_def(session, async->async_qsize, &async->async_queue));
+	for (i = 0; i < async->async_qsize; i++)
+		async->async_queue[i].seq = i;
+	async->enqueue_pos = async->dequeue_pos = 0;
 
 	WT_ERR(__wt_calloc_def(session, conn->async_size, &async->async_ops));
 	for (i = 0; i < conn->async_size; i++) {
@@ -1,52 +1,100 @@
 #include "wt_internal.h"
 
-/*等待op 排队队列就绪，可以进行对象消费*/
+/*排队队列是否为空*/
+static inline int __async_queue_empty(WT_ASYNC* async)
+{
+	uint64_t pos, seq;
+
+	WT_ORDERED_READ(pos, async->dequeue_pos);
+	WT_ORDERED_READ(seq, async->async_queue[pos & (async->async_qsize - 1)].seq);
+	return seq != pos + 1;
+}
+
+/*
+ * 没有可执行的op时worker在work_cond上等待。先增加idle_workers再检查队列，入队者在
+ * 填充slot后检查idle_workers，两边都有full barrier，所以不会错过唤醒。cond的等待有超时，
+ * 以便worker能及时发现连接关闭和线程数调整
+ */
+static int __async_worker_park(WT_SESSION_IMPL* session, WT_ASYNC* async)
+{
+	WT_DECL_RET;
+
+	(void)WT_ATOMIC_ADD4(async->idle_workers, 1);
+	if (__async_queue_empty(async) && async->flush_state != WT_ASYNC_FLUSHING){
+		WT_STAT_FAST_CONN_INCR(session, async_worker_park);
+		ret = __wt_cond_wait(session, async->work_cond, MAX_ASYNC_SLEEP_USECS);
+	}
+	(void)WT_ATOMIC_SUB4(async->idle_workers, 1);
+
+	return ret;
+}
+
+/*统计op在排队队列中的等待时间，按log2(usecs)计入直方图，并更新最大等待时间*/
+static void __async_latency_record(WT_SESSION_IMPL* session, WT_ASYNC* async, WT_ASYNC_OP_IMPL* op)
+{
+	struct timespec now;
+	uint64_t max, usecs;
+	uint32_t bucket;
+
+	if (__wt_epoch(session, &now) != 0)
+		return;
+
+	usecs = WT_TIMEDIFF(now, op->enqueue_time) / WT_THOUSAND;
+	bucket = usecs == 0 ? 0 : __wt_log2_int((uint32_t)WT_MIN(usecs, UINT32_MAX)) + 1;
+	(void)WT_ATOMIC_ADD8(async->latency_hist[WT_MIN(bucket, WT_ASYNC_LATENCY_BUCKETS - 1)], 1);
+
+	for (;;){
+		WT_ORDERED_READ(max, async->latency_max);
+		if (usecs <= max || WT_ATOMIC_CAS8(async->latency_max, max, usecs))
+			break;
+	}
+}
+
+/*从排队队列中取出一个op，没有op时先yield，再在work_cond上等待*/
 static int __async_op_dequeue(WT_CONNECTION_IMPL* conn, WT_SESSION_IMPL* session, WT_ASYNC_OP_IMPL** op)
 {
 	WT_ASYNC *async;
-	uint64_t cur_tail, last_consume, my_consume, my_slot, prev_slot;
-	uint64_t sleep_usec;
+	WT_ASYNC_QSLOT *slot;
+	uint64_t pos, seq;
 	uint32_t tries;
 
 	async = conn->async;
 	*op = NULL;
-
-retry:
 	tries = 0;
-	sleep_usec = 100;
-	WT_ORDERED_READ(last_consume, async->alloc_tail);
-
-	/*进行spin wait, 检查async是否可以进入工作状态*/
-	while(last_consume == async->head && async->flush_state != WT_ASYNC_FLUSHING){
-		WT_STAT_FAST_CONN_INCR(session, async_nowork);
-		if(++tries < MAX_ASYNC_YIELD)
-			__wt_yield();
-		else{
-			__wt_sleep(0, sleep_usec);
-			sleep_usec = WT_MIN(sleep_usec * 2, MAX_ASYNC_SLEEP_USECS);
-		}
 
-		if(!F_ISSET(session, WT_SESSION_SERVER_ASYNC))
-			return 0;
-		if(!F_ISSET(conn, WT_CONN_SERVER_ASYNC))
+	WT_ORDERED_READ(pos, async->dequeue_pos);
+	for (;;){
+		/*flush进行中，worker不再从队列中取op*/
+		if (async->flush_state == WT_ASYNC_FLUSHING)
 			return 0;
 
-		WT_RET(WT_SESSION_CHECK_PANIC(session));
-		/*更新last_consume，进行下一个循环判断*/
-		WT_ORDERED_READ(last_consume, async->alloc_tail);
+		slot = &async->async_queue[pos & (async->async_qsize - 1)];
+		WT_ORDERED_READ(seq, slot->seq);
+		if (seq == pos + 1){
+			if (WT_ATOMIC_CAS8(async->dequeue_pos, pos, pos + 1))
+				break;
+		}
+		else if ((int64_t)(seq - (pos + 1)) < 0){
+			/*队列为空*/
+			if (!F_ISSET(session, WT_SESSION_SERVER_ASYNC))
+				return 0;
+			if (!F_ISSET(conn, WT_CONN_SERVER_ASYNC))
+				return 0;
+
+			WT_RET(WT_SESSION_CHECK_PANIC(session));
+			WT_STAT_FAST_CONN_INCR(session, async_nowork);
+			if (++tries < MAX_ASYNC_YIELD)
+				__wt_yield();
+			else
+				WT_RET(__async_worker_park(session, async));
+		}
+		WT_ORDERED_READ(pos, async->dequeue_pos);
 	}
-	/*在进入工作状态前，再次判断,防止错误发生*/
-	if (async->flush_state == WT_ASYNC_FLUSHING)
-		return 0;
-
-	my_consume = last_consume + 1;
-	if (!WT_ATOMIC_CAS8(async->alloc_tail, last_consume, my_consume))
-		goto retry;
 
-	/*确定执行的op slot和对象*/
-	my_slot = my_consume % async->async_qsize;
-	prev_slot = last_consume % async->async_qsize;
-	*op = (WT_ASYNC_OP_IMPL*)WT_ATOMIC_STORE8(async->async_queue[my_slot], NULL);
+	/*取出op后将slot交还给下一轮的入队者*/
+	*op = slot->op;
+	slot->op = NULL;
+	WT_PUBLISH(slot->seq, pos + async->async_qsize);
 
 	WT_ASSERT(session, async->cur_queue > 0);
 	WT_ASSERT(session, *op != NULL);
@@ -54,15 +102,13 @@ retry:
 	(void)WT_ATOMIC_SUB4(async->cur_queue, 1);
 	(*op)->state = WT_ASYNCOP_WORKING;
 
-	if(*op == &async->flush_op)
+	if (*op == &async->flush_op){
+		/*唤醒所有等待的worker，让它们参与flush计数*/
 		WT_PUBLISH(async->flush_state, WT_ASYNC_FLUSHING);
-
-	WT_ORDERED_READ(cur_tail, async->tail_slot);
-	while (cur_tail != prev_slot) {
-		__wt_yield();
-		WT_ORDERED_READ(cur_tail, async->tail_slot);
+		WT_RET(__wt_cond_signal(session, async->work_cond));
 	}
-	WT_PUBLISH(async->tail_slot, my_slot);
+	else
+		__async_latency_record(session, async, *op);
 
 	return 0;
 }
@@ -168,6 +214,121 @@ static int __async_worker_execop(WT_SESSION_IMPL* session, WT_ASYNC_OP_IMPL* op,
 
 	return 0;
 }
+/*
+ * batch操作按key排序的比较函数。qsort不是稳定排序，key相同时按在batch中的位置排序，
+ * 保证对同一个key的多个操作按提交的顺序执行
+ */
+static int __async_batch_cmp(const void* a, const void* b)
+{
+	const WT_ASYNC_BATCH_OP *op1, *op2;
+	int cmp;
+
+	op1 = *(const WT_ASYNC_BATCH_OP **)a;
+	op2 = *(const WT_ASYNC_BATCH_OP **)b;
+	if ((cmp = __wt_lex_compare(&op1->key, &op2->key)) != 0)
+		return cmp;
+	return op1 < op2 ? -1 : (op1 > op2 ? 1 : 0);
+}
+
+/*在cursor上执行batch中的一个操作*/
+static int __async_worker_batch_execop(WT_SESSION_IMPL* session, WT_ASYNC_BATCH_OP* bop, WT_CURSOR* cursor)
+{
+	WT_ITEM val;
+
+	__wt_cursor_set_raw_key(cursor, &bop->key);
+	switch (bop->optype){
+	case WT_AOP_INSERT:
+		__wt_cursor_set_raw_value(cursor, &bop->value);
+		return cursor->insert(cursor);
+	case WT_AOP_UPDATE:
+		__wt_cursor_set_raw_value(cursor, &bop->value);
+		return cursor->update(cursor);
+	case WT_AOP_REMOVE:
+		return cursor->remove(cursor);
+	case WT_AOP_SEARCH:
+		/*value在回调结束后释放*/
+		WT_RET(cursor->search(cursor));
+		WT_RET(__wt_cursor_get_raw_value(cursor, &val));
+		return __wt_buf_set(session, &bop->value, val.data, val.size);
+	case WT_AOP_COMPACT:
+	case WT_AOP_NONE:
+	default:
+		WT_RET_MSG(session, EINVAL, "Unknown async optype %d\n", bop->optype);
+	}
+}
+
+/*
+ * 执行一个batch: 在一个事务中用同一个cursor按key的顺序执行所有操作，遇到WT_NOTFOUND
+ * 以外的错误时停止并回滚整个batch，最后调用一次notify_batch
+ */
+static int __async_worker_batch(WT_SESSION_IMPL* session, WT_ASYNC_OP_IMPL* op, WT_ASYNC_WORKER_STATE* worker)
+{
+	WT_ASYNC_BATCH_OP *bop;
+	WT_CURSOR *cursor;
+	WT_DECL_RET;
+	WT_SESSION *wt_session;
+	uint32_t i;
+	int cb_ret, txn_running;
+
+	cursor = NULL;
+	cb_ret = txn_running = 0;
+	wt_session = &session->iface;
+
+	WT_ASSERT(session, op->state == WT_ASYNCOP_WORKING);
+	/*search的value由worker分配，应用传入的value不使用*/
+	for (i = 0; i < op->batch_count; i++){
+		op->batch[i].ret = 0;
+		if (op->batch[i].optype == WT_AOP_SEARCH)
+			memset(&op->batch[i].value, 0, sizeof(op->batch[i].value));
+	}
+
+	WT_ERR(__wt_realloc_def(session, &worker->batch_order_alloc, op->batch_count, &worker->batch_order));
+	for (i = 0; i < op->batch_count; i++)
+		worker->batch_order[i] = &op->batch[i];
+	/*按key排序后在btree上的访问是顺序的，相邻的key大多落在同一个page上*/
+	qsort(worker->batch_order, op->batch_count, sizeof(WT_ASYNC_BATCH_OP *), __async_batch_cmp);
+
+	WT_ERR(wt_session->begin_transaction(wt_session, NULL));
+	txn_running = 1;
+	WT_ERR(__async_worker_cursor(session, op, worker, &cursor));
+
+	for (i = 0; i < op->batch_count; i++){
+		bop = worker->batch_order[i];
+		bop->ret = __async_worker_batch_execop(session, bop, cursor);
+		if (bop->ret != 0 && bop->ret != WT_NOTFOUND){
+			ret = bop->ret;
+			break;
+		}
+	}
+
+	/*出错时也要通告，应用通过ret知道整个batch被回滚了*/
+err:
+	if (op->cb != NULL && op->cb->notify_batch != NULL)
+		cb_ret = op->cb->notify_batch(op->cb, op->batch, op->batch_count, ret);
+
+	if (cursor != NULL)
+		WT_TRET(cursor->reset(cursor));
+	if (txn_running){
+		if (ret == 0 && cb_ret == 0)
+			WT_TRET(wt_session->commit_transaction(wt_session, NULL));
+		else
+			WT_TRET(wt_session->rollback_transaction(wt_session, NULL));
+	}
+
+	/*释放search分配的value*/
+	for (i = 0; i < op->batch_count; i++){
+		bop = &op->batch[i];
+		if (bop->optype == WT_AOP_SEARCH)
+			__wt_buf_free(session, &bop->value);
+	}
+
+	op->batch = NULL;
+	op->batch_count = 0;
+	WT_PUBLISH(op->state, WT_ASYNCOP_FREE);
+
+	return ret;
+}
+
 /*执行async op操作*/
 static int __async_worker_op(WT_SESSION_IMPL* session, WT_ASYNC_OP_IMPL* op, WT_ASYNC_WORKER_STATE* worker)
 {
@@ -181,6 +342,9 @@ static int __async_worker_op(WT_SESSION_IMPL* session, WT_ASYNC_OP_IMPL* op, WT_
 
 	cb_ret = 0;
 
+	if (op->batch != NULL)
+		return __async_worker_batch(session, op, worker);
+
 	/*如果是增删查改，启动一个事务*/
 	wt_session = &session->iface;
 	if(op->optype != WT_AOP_COMPACT)
@@ -227,6 +391,8 @@ WT_THREAD_RET __wt_async_worker(void* arg)
 	async = conn->async;
 
 	worker.num_cursors = 0;
+	worker.batch_order = NULL;
+	worker.batch_order_alloc = 0;
 	STAILQ_INIT(&worker.cursorqh);
 
 	while(F_ISSET(conn, WT_CONN_SERVER_ASYNC) && F_ISSET(session, WT_SESSION_SERVER_ASYNC)){
@@ -259,6 +425,7 @@ err:
 		__wt_free(session, ac);
 		ac = acnext;
 	}
+	__wt_free(session, worker.batch_order);
 
 	return (WT_THREAD_RET_VALUE);
 }
@@ -0,0 +1,287 @@
+/*************************************************************************
+*block cache: 缓存被evict的干净page的磁盘格式image，作为cache之下的第二级缓存
+*************************************************************************/
+
+#include "wt_internal.h"
+
+/*计算(block, offset)的hash值，高位用来选择分区，低位用来选择hash桶*/
+static inline uint64_t __blkcache_hash(WT_BLOCK* block, wt_off_t offset)
+{
+	uint64_t key[2];
+
+	key[0] = block->name_hash;
+	key[1] = (uint64_t)offset;
+	return __wt_hash_city64(key, sizeof(key));
+}
+
+#define WT_BLKCACHE_PART(blkcache, hash)	(&(blkcache)->parts[((hash) >> 32) % WT_BLKCACHE_PARTS])
+#define WT_BLKCACHE_BUCKET(hash)			((hash) % WT_BLKCACHE_HASH_SIZE)
+#define WT_BLKCACHE_ITEM_BYTES(item)		(sizeof(WT_BLKCACHE_ITEM) + (item)->image_size)
+
+/*在分区中查找(block, offset)对应的item，调用者必须持有分区的锁*/
+static inline WT_BLKCACHE_ITEM* __blkcache_find(WT_BLKCACHE_PART* part, uint64_t bucket, WT_BLOCK* block, wt_off_t offset)
+{
+	WT_BLKCACHE_ITEM* item;
+
+	TAILQ_FOREACH(item, &part->hashqh[bucket], hashq){
+		if (item->block == block && item->offset == offset)
+			return item;
+	}
+
+	return NULL;
+}
+
+/*将item从分区中摘除，调用者必须持有分区的锁*/
+static inline void __blkcache_unlink(WT_BLKCACHE_PART* part, uint64_t bucket, WT_BLKCACHE_ITEM* item)
+{
+	TAILQ_REMOVE(&part->hashqh[bucket], item, hashq);
+	TAILQ_REMOVE(&part->lruqh, item, lruq);
+	part->bytes_inuse -= WT_BLKCACHE_ITEM_BYTES(item);
+}
+
+/*根据block_cache.size配置创建block cache，size = 0时不启用*/
+int __wt_blkcache_create(WT_SESSION_IMPL* session, const char* cfg[])
+{
+	WT_BLKCACHE* blkcache;
+	WT_CONFIG_ITEM cval;
+	WT_CONNECTION_IMPL* conn;
+	WT_DECL_RET;
+	u_int i, j;
+
+	conn = S2C(session);
+
+	WT_RET(__wt_config_gets(session, cfg, "block_cache.size", &cval));
+	if (cval.val == 0)
+		return 0;
+
+	WT_RET(__wt_calloc_one(session, &blkcache));
+	blkcache->bytes_max = (uint64_t)cval.val / WT_BLKCACHE_PARTS;
+	for (i = 0; i < WT_BLKCACHE_PARTS; i++){
+		WT_ERR(__wt_spin_init(session, &blkcache->parts[i].lock, "block cache"));
+		TAILQ_INIT(&blkcache->parts[i].lruqh);
+		for (j = 0; j < WT_BLKCACHE_HASH_SIZE; j++)
+			TAILQ_INIT(&blkcache->parts[i].hashqh[j]);
+	}
+
+	conn->blkcache = blkcache;
+	return 0;
+
+err:
+	while (i > 0)
+		__wt_spin_destroy(session, &blkcache->parts[--i].lock);
+	__wt_free(session, blkcache);
+	return ret;
+}
+
+/*释放block cache中所有的page image，在所有的block都关闭后调用*/
+int __wt_blkcache_destroy(WT_SESSION_IMPL* session)
+{
+	WT_BLKCACHE* blkcache;
+	WT_BLKCACHE_ITEM* item;
+	WT_BLKCACHE_PART* part;
+	WT_CONNECTION_IMPL* conn;
+	u_int i;
+
+	conn = S2C(session);
+	if ((blkcache = conn->blkcache) == NULL)
+		return 0;
+
+	for (i = 0; i < WT_BLKCACHE_PARTS; i++){
+		part = &blkcache->parts[i];
+		while ((item = TAILQ_FIRST(&part->lruqh)) != NULL){
+			TAILQ_REMOVE(&part->lruqh, item, lruq);
+			__wt_free(session, item);
+		}
+		__wt_spin_destroy(session, &part->lock);
+	}
+
+	conn->blkcache = NULL;
+	__wt_free(session, blkcache);
+	return 0;
+}
+
+/*
+ * 在block cache中查找addr对应的page image，找到后拷贝到buf中，buf中的数据和
+ * 从磁盘上读取的格式一样(可能是压缩过的)。没有找到返回WT_NOTFOUND
+ */
+int __wt_blkcache_get(WT_SESSION_IMPL* session, WT_BLOCK* block, const uint8_t* addr, size_t addr_size, WT_ITEM* buf)
+{
+	WT_BLKCACHE* blkcache;
+	WT_BLKCACHE_ITEM* item;
+	WT_BLKCACHE_PART* part;
+	WT_DECL_RET;
+	wt_off_t offset;
+	uint64_t hash;
+	uint32_t cksum, size;
+
+	WT_UNUSED(addr_size);
+
+	if ((blkcache = S2C(session)->blkcache) == NULL)
+		return WT_NOTFOUND;
+
+	WT_RET(__wt_block_buffer_to_addr(block, addr, &offset, &size, &cksum));
+
+	hash = __blkcache_hash(block, offset);
+	part = WT_BLKCACHE_PART(blkcache, hash);
+
+	__wt_spin_lock(session, &part->lock);
+	item = __blkcache_find(part, WT_BLKCACHE_BUCKET(hash), block, offset);
+	if (item != NULL && item->size == size && item->cksum == cksum){
+		/*移到LRU队列的头上*/
+		TAILQ_REMOVE(&part->lruqh, item, lruq);
+		TAILQ_INSERT_HEAD(&part->lruqh, item, lruq);
+		ret = __wt_buf_set(session, buf, WT_BLKCACHE_IMAGE(item), item->image_size);
+	}
+	else
+		ret = WT_NOTFOUND;
+	__wt_spin_unlock(session, &part->lock);
+
+	if (ret == 0)
+		WT_STAT_FAST_CONN_INCR(session, block_cache_hit);
+	else if (ret == WT_NOTFOUND)
+		WT_STAT_FAST_CONN_INCR(session, block_cache_miss);
+
+	return ret;
+}
+
+/*
+ * 将addr对应的page image存入block cache，image由hdr和data两段拼接而成，这样调用者
+ * 修改page header时不需要先拷贝整个image。分区超过大小限制时按LRU淘汰
+ */
+int __wt_blkcache_put(WT_SESSION_IMPL* session, WT_BLOCK* block, const uint8_t* addr, size_t addr_size,
+	const void* hdr, size_t hdr_size, const void* data, size_t data_size)
+{
+	WT_BLKCACHE* blkcache;
+	WT_BLKCACHE_ITEM *item, *old;
+	WT_BLKCACHE_PART* part;
+	struct __wt_blkcache_lru freeqh;
+	wt_off_t offset;
+	uint64_t bucket, evict_bytes, evicted, hash, item_bytes;
+	uint32_t cksum, size;
+
+	WT_UNUSED(addr_size);
+
+	if ((blkcache = S2C(session)->blkcache) == NULL)
+		return 0;
+	item_bytes = sizeof(WT_BLKCACHE_ITEM) + hdr_size + data_size;
+	if (item_bytes > blkcache->bytes_max)
+		return 0;
+
+	WT_RET(__wt_block_buffer_to_addr(block, addr, &offset, &size, &cksum));
+
+	item = NULL;
+	WT_RET(__wt_realloc(session, NULL, (size_t)item_bytes, &item));
+	item->block = block;
+	item->offset = offset;
+	item->size = size;
+	item->cksum = cksum;
+	item->image_size = hdr_size + data_size;
+	memcpy(WT_BLKCACHE_IMAGE(item), hdr, hdr_size);
+	memcpy(WT_BLKCACHE_IMAGE(item) + hdr_size, data, data_size);
+
+	hash = __blkcache_hash(block, offset);
+	part = WT_BLKCACHE_PART(blkcache, hash);
+	bucket = WT_BLKCACHE_BUCKET(hash);
+	TAILQ_INIT(&freeqh);
+	evict_bytes = evicted = 0;
+
+	__wt_spin_lock(session, &part->lock);
+	/*同一个位置上已经有旧的image，用新的替换*/
+	if ((old = __blkcache_find(part, bucket, block, offset)) != NULL){
+		__blkcache_unlink(part, bucket, old);
+		TAILQ_INSERT_TAIL(&freeqh, old, lruq);
+		evict_bytes += WT_BLKCACHE_ITEM_BYTES(old);
+	}
+
+	TAILQ_INSERT_HEAD(&part->hashqh[bucket], item, hashq);
+	TAILQ_INSERT_HEAD(&part->lruqh, item, lruq);
+	part->bytes_inuse += item_bytes;
+
+	/*超过分区的限制，从LRU尾部淘汰，释放内存放到锁外面做。解锁后item可能被其他线程淘汰，不能再访问*/
+	while (part->bytes_inuse > blkcache->bytes_max){
+		old = TAILQ_LAST(&part->lruqh, __wt_blkcache_lru);
+		__blkcache_unlink(part, WT_BLKCACHE_BUCKET(__blkcache_hash(old->block, old->offset)), old);
+		TAILQ_INSERT_TAIL(&freeqh, old, lruq);
+		evict_bytes += WT_BLKCACHE_ITEM_BYTES(old);
+		++evicted;
+	}
+	__wt_spin_unlock(session, &part->lock);
+
+	while ((old = TAILQ_FIRST(&freeqh)) != NULL){
+		TAILQ_REMOVE(&freeqh, old, lruq);
+		__wt_free(session, old);
+	}
+
+	WT_STAT_FAST_CONN_INCR(session, block_cache_insert);
+	WT_STAT_FAST_CONN_INCRV(session, block_cache_evict, evicted);
+	WT_STAT_FAST_CONN_INCRV(session, block_cache_bytes, item_bytes);
+	WT_STAT_FAST_CONN_DECRV(session, block_cache_bytes, evict_bytes);
+
+	return 0;
+}
+
+/*block被释放，它的空间可能被重新分配，删除block cache中缓存的image*/
+void __wt_blkcache_remove(WT_SESSION_IMPL* session, WT_BLOCK* block, wt_off_t offset)
+{
+	WT_BLKCACHE* blkcache;
+	WT_BLKCACHE_ITEM* item;
+	WT_BLKCACHE_PART* part;
+	uint64_t bucket, hash;
+
+	if ((blkcache = S2C(session)->blkcache) == NULL)
+		return;
+
+	hash = __blkcache_hash(block, offset);
+	part = WT_BLKCACHE_PART(blkcache, hash);
+	bucket = WT_BLKCACHE_BUCKET(hash);
+
+	__wt_spin_lock(session, &part->lock);
+	if ((item = __blkcache_find(part, bucket, block, offset)) != NULL)
+		__blkcache_unlink(part, bucket, item);
+	__wt_spin_unlock(session, &part->lock);
+
+	if (item != NULL){
+		WT_STAT_FAST_CONN_INCR(session, block_cache_remove);
+		WT_STAT_FAST_CONN_DECRV(session, block_cache_bytes, WT_BLKCACHE_ITEM_BYTES(item));
+		__wt_free(session, item);
+	}
+}
+
+/*block被销毁，删除block cache中属于这个block的所有image*/
+void __wt_blkcache_discard(WT_SESSION_IMPL* session, WT_BLOCK* block)
+{
+	WT_BLKCACHE* blkcache;
+	WT_BLKCACHE_ITEM *item, *next;
+	WT_BLKCACHE_PART* part;
+	struct __wt_blkcache_lru freeqh;
+	uint64_t bytes;
+	u_int i;
+
+	if ((blkcache = S2C(session)->blkcache) == NULL)
+		return;
+
+	TAILQ_INIT(&freeqh);
+	bytes = 0;
+
+	for (i = 0; i < WT_BLKCACHE_PARTS; i++){
+		part = &blkcache->parts[i];
+		__wt_spin_lock(session, &part->lock);
+		for (item = TAILQ_FIRST(&part->lruqh); item != NULL; item = next){
+			next = TAILQ_NEXT(item, lruq);
+			if (item->block != block)
+				continue;
+
+			__blkcache_unlink(part, WT_BLKCACHE_BUCKET(__blkcache_hash(block, item->offset)), item);
+			TAILQ_INSERT_TAIL(&freeqh, item, lruq);
+			bytes += WT_BLKCACHE_ITEM_BYTES(item);
+		}
+		__wt_spin_unlock(session, &part->lock);
+	}
+
+	while ((item = TAILQ_FIRST(&freeqh)) != NULL){
+		TAILQ_REMOVE(&freeqh, item, lruq);
+		__wt_free(session, item);
+	}
+
+	WT_STAT_FAST_CONN_DECRV(session, block_cache_bytes, bytes);
+}
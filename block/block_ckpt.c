@@ -116,6 +116,7 @@ int __wt_block_checkpoint_unload(WT_SESSION_IMPL *session, WT_BLOCK *block, int
 
 		__wt_spin_lock(session, &block->live_lock);
 		__wt_block_ckpt_destroy(session, &block->live);
+		__wt_block_shards_discard(block);
 		__wt_spin_unlock(session, &block->live_lock);
 	}
 
@@ -293,6 +294,9 @@ static int __ckpt_process(WT_SESSION_IMPL* session, WT_BLOCK* block, WT_CKPT* ck
 	__wt_spin_lock(session, &block->live_lock);
 	locked = 1;
 
+	/*收回所有shard的region并合并批量的分配和释放，保证checkpoint的extent list是精确的*/
+	WT_ERR(__wt_block_shards_flush(session, block, 1));
+
 	ckpt_size = ci->ckpt_size;
 	ckpt_size += ci->alloc.bytes;
 	ckpt_size -= ci->discard.bytes;
@@ -57,6 +57,9 @@ int __wt_block_compact_skip(WT_SESSION_IMPL *session, WT_BLOCK *block, int *skip
 
 	__wt_spin_lock(session, &block->live_lock);
 
+	/*shard中的region和批量释放的空间都要计入avail中*/
+	WT_ERR(__wt_block_shards_flush(session, block, 1));
+
 	if(WT_VERBOSE_ISSET(session, WT_VERB_COMPACT))
 		WT_ERR(__block_dump_avail(session, block));
 
@@ -118,6 +121,9 @@ int __wt_block_compact_page_skip(WT_SESSION_IMPL *session, WT_BLOCK *block, cons
 
 	__wt_spin_lock(session, &block->live_lock);
 
+	/*shard中的region和批量释放的空间都要计入avail中*/
+	WT_ERR(__wt_block_shards_flush(session, block, 1));
+
 	/*计算compact文件的起始位置,从文件后面开始compact*/
 	limit = fh->size - ((fh->size / 10) * block->compact_pct_tenths);
 	/*block处于compact的范围中*/
@@ -134,6 +140,7 @@ int __wt_block_compact_page_skip(WT_SESSION_IMPL *session, WT_BLOCK *block, cons
 		}
 	}
 
+err:
 	__wt_spin_unlock(session, &block->live_lock);
 
 	return ret;
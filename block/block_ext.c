@@ -403,12 +403,23 @@ int __wt_block_free(WT_SESSION_IMPL *session, WT_BLOCK *block, const uint8_t *ad
 
 	WT_RET(__wt_verbose(session, WT_VERB_BLOCK,
 		"free %" PRIdMAX "/%" PRIdMAX, (intmax_t)offset, (intmax_t)size));
-	/*为session预分配5个WT_EXT,用于重复利用WT_EXT对象*/
-	WT_RET(__wt_block_ext_prealloc(session, 5));
+	/*释放的空间可能被重新分配，block cache中的image必须删除*/
+	__wt_blkcache_remove(session, block, offset);
+	/*不需要保持first-fit分配时，释放的空间先记录在shard中，批量归还*/
+	if (!block->allocfirst)
+		return __wt_block_shard_free(session, block, offset, (wt_off_t)size);
 
+	/*为session预分配WT_EXT,用于重复利用WT_EXT对象，shard中可能还有未合并的释放*/
+	WT_RET(__wt_block_ext_prealloc(session, WT_BLOCK_SHARD_FREES));
+
+	/*释放的block可能是从shard中分配的，先把shard中的分配合并到live中*/
 	__wt_spin_lock(session, &block->live_lock);
-	ret = __wt_block_off_free(session, block, offset, (wt_off_t)size);
+	ret = __wt_block_shards_flush(session, block, 0);
+	if (ret == 0)
+		ret = __wt_block_off_free(session, block, offset, (wt_off_t)size);
 	__wt_spin_unlock(session, &block->live_lock);
+
+	return ret;
 }
 
 /*在block对应的文件中释放掉(off, size)位置的数据空间(chunk)*/
@@ -426,6 +437,150 @@ int __wt_block_off_free(WT_SESSION_IMPL *session, WT_BLOCK *block, wt_off_t offs
 	return ret;
 }
 
+/*
+ * 把shard的region中已经分配出去的空间计入live.alloc，retire不为0时把region中
+ * 没有用完的空间还给avail。调用时持有live_lock和shard的锁
+ */
+static int __block_shard_merge(WT_SESSION_IMPL* session, WT_BLOCK* block, WT_BLOCK_SHARD* shard, int retire)
+{
+	if (shard->region_off > shard->alloc_off){
+		WT_RET(__block_merge(session, &block->live.alloc, shard->alloc_off, shard->region_off - shard->alloc_off));
+		shard->alloc_off = shard->region_off;
+	}
+
+	if (retire){
+		if (shard->region_end > shard->region_off)
+			WT_RET(__block_merge(session, &block->live.avail, shard->region_off, shard->region_end - shard->region_off));
+		shard->alloc_off = shard->region_off = shard->region_end = 0;
+	}
+
+	return 0;
+}
+
+/*
+ * 将所有shard中的分配和释放合并到live的extent list中，retire不为0时同时收回所有
+ * shard的region，之后live的extent list和文件空间的实际使用情况完全一致。
+ * 调用时持有live_lock
+ */
+int __wt_block_shards_flush(WT_SESSION_IMPL* session, WT_BLOCK* block, int retire)
+{
+	WT_BLOCK_SHARD *shard;
+	WT_DECL_RET;
+	u_int i, j;
+
+	/*释放的空间可能是其他shard分配的，先合并所有shard的分配，再处理释放*/
+	for (i = 0; i < WT_BLOCK_SHARDS; i++){
+		shard = &block->shards[i];
+		__wt_spin_lock(session, &shard->lock);
+		ret = __block_shard_merge(session, block, shard, retire);
+		__wt_spin_unlock(session, &shard->lock);
+		WT_RET(ret);
+	}
+
+	for (i = 0; i < WT_BLOCK_SHARDS; i++){
+		shard = &block->shards[i];
+		__wt_spin_lock(session, &shard->lock);
+		for (j = 0; j < shard->free_next && ret == 0; j++)
+			ret = __wt_block_off_free(session, block, shard->free_off[j], shard->free_size[j]);
+		shard->free_next = 0;
+		__wt_spin_unlock(session, &shard->lock);
+		WT_RET(ret);
+	}
+
+	return 0;
+}
+
+/*丢弃所有shard的状态，live的extent list被销毁时调用*/
+void __wt_block_shards_discard(WT_BLOCK* block)
+{
+	WT_BLOCK_SHARD *shard;
+	u_int i;
+
+	for (i = 0; i < WT_BLOCK_SHARDS; i++){
+		shard = &block->shards[i];
+		shard->alloc_off = shard->region_off = shard->region_end = 0;
+		shard->free_next = 0;
+	}
+}
+
+/*
+ * 为shard切出一段新的region，旧的region先收回。avail中没有region大小的空间，
+ * 但是有能放下这次写入的空间时返回WT_NOTFOUND，由调用者直接从avail中分配，
+ * 不为了region扩大文件。调用时持有live_lock和shard的锁
+ */
+int __wt_block_shard_refill(WT_SESSION_IMPL* session, WT_BLOCK* block, WT_BLOCK_SHARD* shard, wt_off_t size)
+{
+	WT_EXT *ext;
+	WT_SIZE *szp, **sstack[WT_SKIP_MAXDEPTH];
+	wt_off_t off, region;
+
+	WT_RET(__block_shard_merge(session, block, shard, 1));
+
+	region = (wt_off_t)WT_ALIGN(WT_BLOCK_SHARD_REGION, block->allocsize);
+	if (region < size)
+		region = size;
+
+	__block_size_srch(block->live.avail.sz, region, sstack);
+	if ((szp = *sstack[0]) != NULL){
+		ext = szp->off[0];
+		WT_RET(__block_off_remove(session, &block->live.avail, ext->off, &ext));
+		off = ext->off;
+		if (ext->size > region){
+			ext->off += region;
+			ext->size -= region;
+			WT_RET(__block_ext_insert(session, &block->live.avail, ext));
+		}
+		else
+			__wt_block_ext_free(session, ext);
+	}
+	else{
+		__block_size_srch(block->live.avail.sz, size, sstack);
+		if (*sstack[0] != NULL)
+			return WT_NOTFOUND;
+		WT_RET(__block_extend(session, block, &off, region));
+	}
+
+	WT_STAT_FAST_CONN_INCR(session, block_shard_refill);
+	WT_RET(__wt_verbose(session, WT_VERB_BLOCK, "shard region %" PRIdMAX "-%" PRIdMAX, (intmax_t)off, (intmax_t)(off + region)));
+
+	shard->alloc_off = shard->region_off = off;
+	shard->region_end = off + region;
+
+	return 0;
+}
+
+/*将释放的空间记录到session对应的shard中，shard记录满了之后批量归还到live的extent list中*/
+int __wt_block_shard_free(WT_SESSION_IMPL* session, WT_BLOCK* block, wt_off_t offset, wt_off_t size)
+{
+	WT_BLOCK_SHARD *shard;
+	WT_DECL_RET;
+
+	shard = WT_BLOCK_SHARD_GET(block, session);
+
+	__wt_spin_lock(session, &shard->lock);
+	if (shard->free_next < WT_BLOCK_SHARD_FREES){
+		shard->free_off[shard->free_next] = offset;
+		shard->free_size[shard->free_next] = size;
+		++shard->free_next;
+		__wt_spin_unlock(session, &shard->lock);
+		return 0;
+	}
+	__wt_spin_unlock(session, &shard->lock);
+
+	/*一次归还最多WT_BLOCK_SHARDS * WT_BLOCK_SHARD_FREES个空间*/
+	WT_RET(__wt_block_ext_prealloc(session, WT_BLOCK_SHARD_FREES));
+
+	__wt_spin_lock(session, &block->live_lock);
+	ret = __wt_block_shards_flush(session, block, 0);
+	if (ret == 0)
+		ret = __wt_block_off_free(session, block, offset, size);
+	__wt_spin_unlock(session, &block->live_lock);
+
+	WT_STAT_FAST_CONN_INCR(session, block_shard_free_flush);
+
+	return ret;
+}
+
 /*检查alloc与dicard的重叠部分，将已经使用的部分移到checkpoint的avail跳表中*/
 int __wt_block_extlist_overlap(WT_SESSION_IMPL *session, WT_BLOCK *block, WT_BLOCK_CKPT *ci)
 {
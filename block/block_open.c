@@ -60,11 +60,14 @@ static int __block_destroy(WT_SESSION_IMPL *session, WT_BLOCK *block)
 	WT_CONNECTION_IMPL *conn;
 	WT_DECL_RET;
 	uint64_t bucket;
+	u_int i;
 
 	conn = S2C(session);
 	bucket = block->name_hash % WT_HASH_ARRAY_SIZE;
 	/*将block从connection的queue中删除*/
 	WT_CONN_BLOCK_REMOVE(conn, block, bucket);
+	/*删除block cache中属于这个block的image*/
+	__wt_blkcache_discard(session, block);
 
 	if (block->name != NULL)
 		__wt_free(session, block->name);
@@ -73,6 +76,8 @@ static int __block_destroy(WT_SESSION_IMPL *session, WT_BLOCK *block)
 		WT_TRET(__wt_close(session, &block->fh));
 
 	__wt_spin_destroy(session, &block->live_lock);
+	for (i = 0; i < WT_BLOCK_SHARDS; i++)
+		__wt_spin_destroy(session, &block->shards[i].lock);
 
 	__wt_overwrite_and_free(session, block);
 
@@ -102,6 +107,7 @@ int __wt_block_open(WT_SESSION_IMPL *session, const char *filename, const char *
 	WT_CONNECTION_IMPL *conn;
 	WT_DECL_RET;
 	uint64_t bucket, hash;
+	u_int i;
 
 	WT_TRET(__wt_verbose(session, WT_VERB_BLOCK, "open: %s", filename));
 
@@ -155,6 +161,8 @@ int __wt_block_open(WT_SESSION_IMPL *session, const char *filename, const char *
 
 	/*初始化live_lock*/
 	WT_ERR(__wt_spin_init(session, &block->live_lock, "block manager"));
+	for (i = 0; i < WT_BLOCK_SHARDS; i++)
+		WT_ERR(__wt_spin_init(session, &block->shards[i].lock, "block shard"));
 
 	/*除Salvage操作外，都需要读取文件开始的描述信息到block中,并校验文件描述信息*/
 	if (!forced_salvage)
@@ -107,7 +107,7 @@ int __wt_block_read_off(WT_SESSION_IMPL* session, WT_BLOCK* block, WT_ITEM* buf,
 
 	/*确保buf空闲大小为bufsize*/
 	WT_RET(__wt_buf_init(session, buf, bufsize));
-	/*从文件中读取数据到buf中*/
+	/*从文件中读取数据到buf中，单个block的读提交后马上等待没有重叠，直接做同步读*/
 	WT_RET(__wt_read(session, block->fh, offset, size, buf->mem));
 	buf->size = size;
 
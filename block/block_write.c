@@ -38,6 +38,105 @@ int __wt_block_write(WT_SESSION_IMPL *session, WT_BLOCK *block, WT_ITEM *buf, ui
 	return 0;
 }
 
+/*
+ * 判断文件是否需要进行扩大,如果不扩大就有可能存不下刚分配的(offset, size)空间。
+ * 调用时持有live_lock, *lockedp表示live_lock是否是由调用者在本次写入中获得的，
+ * 扩大文件时可能会释放它
+ */
+static int __block_write_extend(WT_SESSION_IMPL* session, WT_BLOCK* block, wt_off_t offset, wt_off_t size, int caller_locked, int* lockedp)
+{
+	WT_DECL_RET;
+	WT_FH *fh;
+
+	fh = block->fh;
+
+	if(fh->extend_len != 0 && (fh->extend_size <= fh->size ||
+		(offset + fh->extend_len <= fh->extend_size && offset + fh->extend_len + size >= fh->extend_size))){
+			/*调整extend_size为原来的offset + extend_len的两倍*/
+			fh->extend_size = offset + fh->extend_len * 2;
+			if (fh->fallocate_available != WT_FALLOCATE_NOT_AVAILABLE) {
+				/*释放block->live_lock的自旋锁，因为重设文件大小会时间比较长，需要先释放自旋锁，防止CPU空转*/
+				if (!fh->fallocate_requires_locking && *lockedp) {
+					__wt_spin_unlock(session, &block->live_lock);
+					*lockedp = 0;
+				}
+
+				/*扩大文件的占用空间*/
+				if ((ret = __wt_fallocate(session,fh, offset, fh->extend_len * 2)) == ENOTSUP) {
+					ret = 0;
+					goto extend_truncate;
+				}
+			}
+			else{
+extend_truncate:
+				if (!caller_locked && *lockedp == 0) {
+					__wt_spin_lock(session, &block->live_lock);
+					*lockedp = 1;
+				}
+				/*直接调整文件大小,这个比__wt_fallocate更慢*/
+				if ((ret = __wt_ftruncate(session, fh, offset + fh->extend_len * 2)) == EBUSY)
+					ret = 0;
+			}
+	}
+
+	return ret;
+}
+
+/*
+ * 从session对应的shard中分配写入空间，shard的region用完时持有live_lock从avail中
+ * 切出新的region，这样大部分的写入不需要竞争live_lock
+ */
+static int __block_shard_alloc(WT_SESSION_IMPL* session, WT_BLOCK* block, wt_off_t* offp, wt_off_t size)
+{
+	WT_BLOCK_SHARD *shard;
+	WT_DECL_RET;
+	wt_off_t extend_off, extend_size;
+	int locked;
+
+	shard = WT_BLOCK_SHARD_GET(block, session);
+
+	__wt_spin_lock(session, &shard->lock);
+	if (shard->region_end - shard->region_off >= size){
+		*offp = shard->region_off;
+		shard->region_off += size;
+		__wt_spin_unlock(session, &shard->lock);
+
+		WT_STAT_FAST_DATA_INCR(session, block_alloc);
+		WT_STAT_FAST_CONN_INCR(session, block_shard_alloc);
+		return 0;
+	}
+	__wt_spin_unlock(session, &shard->lock);
+
+	/*live_lock必须在shard的锁之前获得*/
+	__wt_spin_lock(session, &block->live_lock);
+	locked = 1;
+
+	__wt_spin_lock(session, &shard->lock);
+	ret = __wt_block_shard_refill(session, block, shard, size);
+	if (ret == 0){
+		*offp = extend_off = shard->region_off;
+		extend_size = shard->region_end - shard->region_off;
+		shard->region_off += size;
+	}
+	__wt_spin_unlock(session, &shard->lock);
+
+	/*avail中只有零散的空间，直接从avail中分配，__wt_block_alloc自己统计block_alloc*/
+	if (ret == 0)
+		WT_STAT_FAST_DATA_INCR(session, block_alloc);
+	else if (ret == WT_NOTFOUND && (ret = __wt_block_alloc(session, block, offp, size)) == 0){
+		extend_off = *offp;
+		extend_size = size;
+	}
+
+	if (ret == 0)
+		ret = __block_write_extend(session, block, extend_off, extend_size, 0, &locked);
+
+	if (locked)
+		__wt_spin_unlock(session, &block->live_lock);
+
+	return ret;
+}
+
 /*将buffer的数据写入到block对应的文件中，并计算checksum和size*/
 int __wt_block_write_off(WT_SESSION_IMPL *session, WT_BLOCK *block, WT_ITEM *buf, wt_off_t *offsetp, 
 						uint32_t *sizep, uint32_t *cksump, int data_cksum, int caller_locked)
@@ -47,7 +146,7 @@ int __wt_block_write_off(WT_SESSION_IMPL *session, WT_BLOCK *block, WT_ITEM *buf
 	WT_FH *fh;
 	size_t align_size;
 	wt_off_t offset;
-	int local_locked;
+	int local_locked, sharded;
 
 	blk = WT_BLOCK_HEADER_REF(buf->mem);
 	fh = block->fh;
@@ -83,58 +182,46 @@ int __wt_block_write_off(WT_SESSION_IMPL *session, WT_BLOCK *block, WT_ITEM *buf
 	/*计算buf的cksum*/
 	blk->cksum = __wt_cksum(buf->mem, data_cksum ? align_size : WT_BLOCK_COMPRESS_SKIP);
 
-	if (!caller_locked) {
+	/*
+	 * 调用者持有live_lock(checkpoint写extent list)或者需要first-fit分配(compact)时
+	 * 直接从avail中分配，其他情况从shard中分配
+	 */
+	sharded = !caller_locked && !block->allocfirst;
+	if (!caller_locked)
 		WT_RET(__wt_block_ext_prealloc(session, 5));
-		__wt_spin_lock(session, &block->live_lock);
-		local_locked = 1;
-	}
 
-	ret = __wt_block_alloc(session, block, &offset, (wt_off_t)align_size);
-	/*判断文件是否需要进行扩大,如果不扩大就有可能存不下写入的block数据*/
-	if(ret == 0 && fh->extend_len != 0 && (fh->extend_size <= fh->size ||
-		(offset + fh->extend_len <= fh->extend_size && offset + fh->extend_len + (wt_off_t)align_size >= fh->extend_size))){
-			/*调整extend_size为原来的offset + extend_len的两倍*/
-			fh->extend_size = offset + fh->extend_len * 2;
-			if (fh->fallocate_available != WT_FALLOCATE_NOT_AVAILABLE) {
-				/*释放block->live_lock的自旋锁，因为重设文件大小会时间比较长，需要先释放自旋锁，防止CPU空转*/
-				if (!fh->fallocate_requires_locking && local_locked) {
-					__wt_spin_unlock(session, &block->live_lock);
-					local_locked = 0;
-				}
+	if (sharded)
+		ret = __block_shard_alloc(session, block, &offset, (wt_off_t)align_size);
+	else{
+		if (!caller_locked) {
+			__wt_spin_lock(session, &block->live_lock);
+			local_locked = 1;
+		}
 
-				/*扩大文件的占用空间*/
-				if ((ret = __wt_fallocate(session,fh, offset, fh->extend_len * 2)) == ENOTSUP) {
-					ret = 0;
-					goto extend_truncate;
-				}
-			}
-			else{
-extend_truncate:
-				if (!caller_locked && local_locked == 0) {
-					__wt_spin_lock(session, &block->live_lock);
-					local_locked = 1;
-				}
-				/*直接调整文件大小,这个比__wt_fallocate更慢*/
-				if ((ret = __wt_ftruncate(session, fh, offset + fh->extend_len * 2)) == EBUSY)
-					ret = 0;
-			}
-	}
+		ret = __wt_block_alloc(session, block, &offset, (wt_off_t)align_size);
+		if (ret == 0)
+			ret = __block_write_extend(session, block, offset, (wt_off_t)align_size, caller_locked, &local_locked);
 
-	if(local_locked){
-		__wt_spin_unlock(session, &block->live_lock);
-		local_locked = 0;
+		if(local_locked){
+			__wt_spin_unlock(session, &block->live_lock);
+			local_locked = 0;
+		}
 	}
 
 	WT_RET(ret);
 	/*进行block的数据写入*/
 	ret =__wt_write(session, fh, offset, align_size, buf->mem);
 	if (ret != 0) {
-		if (!caller_locked)
-			__wt_spin_lock(session, &block->live_lock);
 		/*没写成功，将ext对应的数据返回给avail list*/
-		WT_TRET(__wt_block_off_free(session, block, offset, (wt_off_t)align_size));
-		if (!caller_locked)
-			__wt_spin_unlock(session, &block->live_lock);
+		if (sharded)
+			WT_TRET(__wt_block_shard_free(session, block, offset, (wt_off_t)align_size));
+		else{
+			if (!caller_locked)
+				__wt_spin_lock(session, &block->live_lock);
+			WT_TRET(__wt_block_off_free(session, block, offset, (wt_off_t)align_size));
+			if (!caller_locked)
+				__wt_spin_unlock(session, &block->live_lock);
+		}
 
 		WT_RET(ret);
 	}
@@ -3,8 +3,8 @@
 
 #define	WT_BLOOM_TABLE_CONFIG "key_format=r,value_format=1t,exclusive=true"
 
-/*分配一个bloom对象，并用config对其初始化*/
-static int __bloom_init(WT_SESSION_IMPL* session, const char* uri, const char* config, WT_BLOOM** bloomp)
+/*分配一个bloom对象，并用config对其初始化, blocked表示按照cache line blocked的方式分布bit*/
+static int __bloom_init(WT_SESSION_IMPL* session, const char* uri, const char* config, int blocked, WT_BLOOM** bloomp)
 {
 	WT_BLOOM *bloom;
 	WT_DECL_RET;
@@ -17,13 +17,15 @@ static int __bloom_init(WT_SESSION_IMPL* session, const char* uri, const char* c
 	/*对uri的拷贝*/
 	WT_ERR(__wt_strdup(session, uri, &bloom->uri));
 	/*对config的拷贝*/
-	len = strlen(WT_BLOOM_TABLE_CONFIG) + 2;
+	len = strlen(WT_BLOOM_TABLE_CONFIG) + strlen(",app_metadata=" WT_BLOOM_BLOCKED_META) + 2;
 	if (config != NULL)
 		len += strlen(config);
 	WT_ERR(__wt_calloc_def(session, len, &bloom->config));
-	snprintf(bloom->config, len, "%s,%s", config == NULL ? "" : config, WT_BLOOM_TABLE_CONFIG);
+	snprintf(bloom->config, len, "%s,%s%s", config == NULL ? "" : config, WT_BLOOM_TABLE_CONFIG,
+		blocked ? ",app_metadata=" WT_BLOOM_BLOCKED_META : "");
 
 	bloom->session = session;
+	bloom->blocked = blocked;
 	*bloomp = bloom;
 	
 	return 0;
@@ -34,7 +36,7 @@ err:
 	__wt_free(session, bloom->bitstring);
 	__wt_free(session, bloom);
 
-	return 0;
+	return ret;
 }
 
 /*设置bloom过滤器的参数*/
@@ -48,6 +50,9 @@ static int __bloom_setup(WT_BLOOM* bloom, uint64_t n, uint64_t m, uint32_t facto
 	if(n != 0){
 		bloom->n = n;
 		bloom->m = n * bloom->factor;
+		/*blocked bloom filter的bit数必须是block的整数倍*/
+		if (bloom->blocked)
+			bloom->m = WT_ALIGN(bloom->m, WT_BLOOM_BLOCK_BITS);
 	}
 	else{
 		bloom->m = m;
@@ -64,8 +69,8 @@ int __wt_bloom_create(WT_SESSION_IMPL *session, const char *uri, const char *con
 	WT_BLOOM *bloom;
 	WT_DECL_RET;
 
-	/*创建bloom fliter*/
-	WT_RET(__bloom_init(session, uri, config, &bloom));
+	/*创建bloom fliter, 新建的bloom filter都是blocked的*/
+	WT_RET(__bloom_init(session, uri, config, 1, &bloom));
 	WT_ERR(__bloom_setup(bloom, count, 0, factor, k));
 
 	WT_ERR(__bit_alloc(session, bloom->m, &bloom->bitstring));
@@ -106,11 +111,23 @@ static int __bloom_open_cursor(WT_BLOOM *bloom, WT_CURSOR *owner)
 int __wt_bloom_open(WT_SESSION_IMPL *session, const char *uri, uint32_t factor, uint32_t k, WT_CURSOR *owner, WT_BLOOM **bloomp)
 {
 	WT_BLOOM *bloom;
+	WT_CONFIG_ITEM cval;
 	WT_CURSOR *c;
 	WT_DECL_RET;
 	uint64_t size;
-
-	WT_RET(__bloom_init(session, uri, NULL, &bloom));
+	char *metaconf;
+	int blocked;
+
+	/*从bloom文件的元数据中确定bit的分布方式，老版本创建的bloom filter不是blocked的*/
+	metaconf = NULL;
+	blocked = 0;
+	WT_RET(__wt_metadata_search(session, uri, &metaconf));
+	if ((ret = __wt_config_getones(session, metaconf, "app_metadata", &cval)) == 0)
+		blocked = WT_STRING_MATCH(WT_BLOOM_BLOCKED_META, cval.str, cval.len);
+	__wt_free(session, metaconf);
+	WT_RET_NOTFOUND_OK(ret);
+
+	WT_RET(__bloom_init(session, uri, NULL, blocked, &bloom));
 	WT_ERR(__bloom_open_cursor(bloom, owner));
 	c = bloom->c;
 
@@ -129,6 +146,21 @@ err:
 	return ret;
 }
 
+/*
+ * 计算第i次hash定位的bit位置。普通的bloom filter在整个bit map中做double hash；
+ * blocked bloom filter先用h1选定一个block，再在block内部做double hash
+ */
+static inline uint64_t __bloom_bit(WT_BLOOM *bloom, uint64_t h1, uint64_t h2, uint32_t i)
+{
+	uint64_t block;
+
+	if (!bloom->blocked)
+		return ((h1 + i * h2) % bloom->m);
+
+	block = h1 % (bloom->m / WT_BLOOM_BLOCK_BITS);
+	return (block * WT_BLOOM_BLOCK_BITS + (h2 + i * ((h2 >> 32) | 1)) % WT_BLOOM_BLOCK_BITS);
+}
+
 /*设置一个KEY值的bloom过滤值*/
 int __wt_bloom_insert(WT_BLOOM *bloom, WT_ITEM *key)
 {
@@ -137,8 +169,8 @@ int __wt_bloom_insert(WT_BLOOM *bloom, WT_ITEM *key)
 
 	h1 = __wt_hash_fnv64(key->data, key->size);
 	h2 = __wt_hash_city64(key->data, key->size);
-	for (i = 0; i < bloom->k; i++, h1 += h2) {
-		__bit_set(bloom->bitstring, h1 % bloom->m);
+	for (i = 0; i < bloom->k; i++) {
+		__bit_set(bloom->bitstring, __bloom_bit(bloom, h1, h2, i));
 	}
 	return (0);
 }
@@ -200,48 +232,125 @@ int __wt_bloom_hash(WT_BLOOM *bloom, WT_ITEM *key, WT_BLOOM_HASH *bhash)
 	return 0;
 }
 
-/*判断bhash对应的值是否在bloom过滤器中,如果在其中，返回为0*/
-int __wt_bloom_hash_get(WT_BLOOM *bloom, WT_BLOOM_HASH *bhash)
+/*
+ * 将finalize后的bloom filter从btree中读出来，加载成内存中的bit map。bit map挂在
+ * bloom文件的btree句柄上，所有打开这个bloom filter的cursor共享一份，btree关闭时释放
+ */
+static int __bloom_load(WT_BLOOM *bloom)
 {
+	WT_BLOOM_BITS *bits;
+	WT_BTREE *btree;
 	WT_CURSOR *c;
 	WT_DECL_RET;
-	int result;
-	uint32_t i;
-	uint64_t h1, h2;
+	WT_SESSION_IMPL *session;
+	uint64_t recno;
 	uint8_t bit;
 
-	/* Get operations are only supported by finalized bloom filters. */
-	WT_ASSERT(bloom->session, bloom->bitstring == NULL);
+	session = bloom->session;
+	bits = NULL;
 
 	/* Create a cursor on the first time through. */
-	WT_ERR(__bloom_open_cursor(bloom, NULL));
+	WT_RET(__bloom_open_cursor(bloom, NULL));
 	c = bloom->c;
+	btree = ((WT_CURSOR_BTREE *)c)->btree;
 
-	h1 = bhash->h1;
-	h2 = bhash->h2;
+	/*其他的cursor已经加载过了*/
+	if (btree->bloom_bits != NULL) {
+		bloom->bits = btree->bloom_bits;
+		return 0;
+	}
 
-	result = 0;
-	for (i = 0; i < bloom->k; i++, h1 += h2) {
-		/*
-		 * Add 1 to the hash because WiredTiger tables are 1 based and
-		 * the original bitstring array was 0 based.
-		 */
-		c->set_key(c, (h1 % bloom->m) + 1);
-		WT_ERR(c->search(c));
+	WT_RET(__wt_calloc_one(session, &bits));
+	bits->m = bloom->m;
+	bits->memsize = (size_t)__bitstr_size(bloom->m);
+	WT_ERR(__bit_alloc(session, bloom->m, &bits->bitstring));
+
+	/*WiredTiger的记录号从1开始，bit map从0开始*/
+	while ((ret = c->next(c)) == 0) {
+		WT_ERR(c->get_key(c, &recno));
 		WT_ERR(c->get_value(c, &bit));
+		if (bit != 0 && recno <= bloom->m)
+			__bit_set(bits->bitstring, recno - 1);
+	}
+	WT_ERR_NOTFOUND_OK(ret);
+	WT_ERR(c->reset(c));
+
+	/*多个cursor同时加载时，只保留第一个设置到btree上的bit map*/
+	if (!WT_ATOMIC_CAS8(btree->bloom_bits, NULL, bits)) {
+		__wt_free(session, bits->bitstring);
+		__wt_free(session, bits);
+	} else {
+		WT_STAT_FAST_CONN_INCR(session, lsm_bloom_load);
+		WT_STAT_FAST_CONN_ATOMIC_INCRV(session, lsm_bloom_memory, bits->memsize);
+	}
+
+	bloom->bits = btree->bloom_bits;
+	return 0;
+
+err:
+	if (bits != NULL) {
+		__wt_free(session, bits->bitstring);
+		__wt_free(session, bits);
+	}
+	return ret;
+}
+
+/*释放bloom filter在内存中的bit map*/
+void __wt_bloom_bits_free(WT_SESSION_IMPL *session, WT_BLOOM_BITS **bitsp)
+{
+	WT_BLOOM_BITS *bits;
 
-		if (bit == 0) {
+	if ((bits = *bitsp) == NULL)
+		return;
+
+	*bitsp = NULL;
+	WT_STAT_FAST_CONN_ATOMIC_DECRV(session, lsm_bloom_memory, bits->memsize);
+	__wt_free(session, bits->bitstring);
+	__wt_free(session, bits);
+}
+
+/*判断bhash对应的值是否在bloom过滤器中,如果在其中，返回为0*/
+int __wt_bloom_hash_get(WT_BLOOM *bloom, WT_BLOOM_HASH *bhash)
+{
+	WT_DECL_RET;
+	WT_SESSION_IMPL *session;
+	struct timespec start, stop;
+	int result, timed;
+	uint32_t i;
+
+	session = bloom->session;
+
+	/* Get operations are only supported by finalized bloom filters. */
+	WT_ASSERT(session, bloom->bitstring == NULL);
+
+	/*第一次查找时将bloom filter加载到内存中*/
+	if (bloom->bits == NULL)
+		WT_ERR(__bloom_load(bloom));
+
+	/*对查找的耗时做采样统计*/
+	if ((timed = (++bloom->probes % WT_BLOOM_PROBE_SAMPLE == 0)) != 0)
+		WT_ERR(__wt_epoch(session, &start));
+
+	result = 0;
+	for (i = 0; i < bloom->k; i++) {
+		if (!__bit_test(bloom->bits->bitstring, __bloom_bit(bloom, bhash->h1, bhash->h2, i))) {
 			result = WT_NOTFOUND;
 			break;
 		}
 	}
-	WT_ERR(c->reset(c));
+
+	if (timed) {
+		WT_ERR(__wt_epoch(session, &stop));
+		WT_STAT_FAST_CONN_INCR(session, lsm_bloom_probe_sampled);
+		WT_STAT_FAST_CONN_INCRV(session, lsm_bloom_probe_time, WT_TIMEDIFF(stop, start));
+	}
+
 	return result;
 
 err:	/* Don't return WT_NOTFOUND from a failed search. */
 	if (ret == WT_NOTFOUND)
 		ret = WT_ERROR;
-	__wt_err(bloom->session, ret, "Failed lookup in bloom filter.");
+	__wt_err(session, ret, "Failed lookup in bloom filter.");
 	return ret;
 }
 
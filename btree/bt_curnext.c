@@ -393,7 +393,7 @@ int __wt_btcur_next(WT_CURSOR_BTREE *cbt, int truncating)
 		__wt_btcur_iterate_setup(cbt, 1);
 
 	/*对btree的扫描*/
-	for (;;){
+	for (newpage = 0;; newpage = 1){
 		page = cbt->ref == NULL ? NULL : cbt->ref->page;
 		WT_ASSERT(session, page == NULL || !WT_PAGE_IS_INTERNAL(page));
 
@@ -452,6 +452,9 @@ int __wt_btcur_next(WT_CURSOR_BTREE *cbt, int truncating)
 		/*btree cursor跳转到下一个page上*/
 		WT_ERR(__wt_tree_walk(session, &cbt->ref, NULL, flags));
 		WT_ERR_TEST(cbt->ref == NULL, WT_NOTFOUND);
+
+		/*顺序扫描时对后续的leaf page做异步read-ahead，read-ahead只是提示，失败不影响扫描*/
+		(void)__wt_btcur_readahead(cbt, 0);
 	}
 
 err:
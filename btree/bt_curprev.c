@@ -522,6 +522,9 @@ int __wt_btcur_prev(WT_CURSOR_BTREE *cbt, int truncating)
 
 		WT_ERR(__wt_tree_walk(session, &cbt->ref, NULL, flags));
 		WT_ERR_TEST(cbt->ref == NULL, WT_NOTFOUND);
+
+		/*顺序扫描时对后续的leaf page做异步read-ahead，read-ahead只是提示，失败不影响扫描*/
+		(void)__wt_btcur_readahead(cbt, 1);
 	}
 
 err:
@@ -280,6 +280,137 @@ err:
 	return ret;
 }
 
+/*
+ * search_batch中对row store的定位。key是按升序处理的，所以key一定不小于cursor当前持有的
+ * leaf page的下界，只需要在leaf page的父亲page上做二分定位: 如果key落在父亲page的非最后
+ * 一个孩子上，直接在这个leaf page(或者它的兄弟page)上检索，否则从root开始检索
+ */
+static int __cursor_batch_row_search(WT_SESSION_IMPL* session, WT_CURSOR_BTREE* cbt)
+{
+	WT_BTREE *btree;
+	WT_DECL_RET;
+	WT_ITEM *srch_key, item;
+	WT_PAGE *parent;
+	WT_PAGE_INDEX *pindex;
+	WT_REF *descent, *leaf;
+	uint32_t base, indx, limit;
+	int cmp;
+
+	btree = cbt->btree;
+	srch_key = &cbt->iface.key;
+	leaf = cbt->ref;
+
+	if (leaf != NULL && !__wt_ref_is_root(leaf)){
+		parent = leaf->home;
+		WT_INTL_INDEX_GET(session, parent, pindex);
+
+		base = 1;
+		for (limit = pindex->entries - 1; limit != 0; limit >>= 1){
+			indx = base + (limit >> 1);
+			descent = pindex->index[indx];
+			__wt_ref_key(parent, descent, &item.data, &item.size);
+			WT_RET(__wt_compare(session, btree->collator, srch_key, &item, &cmp));
+			if (cmp == 0){
+				base = indx + 1;
+				break;
+			}
+			if (cmp > 0){
+				base = indx + 1;
+				--limit;
+			}
+		}
+		descent = pindex->index[base - 1];
+
+		/*最后一个孩子的上界是父亲page的上界，无法确定key没有超出父亲page的范围*/
+		if (base < pindex->entries){
+			ret = __wt_page_swap(session, leaf, descent, 0);
+			if (ret == 0){
+				cbt->ref = descent;
+				WT_STAT_FAST_CONN_INCR(session, cursor_search_batch_leaf);
+				if ((ret = __wt_row_search(session, srch_key, descent, cbt, 0)) != 0)
+					cbt->ref = NULL;
+				return ret;
+			}
+
+			/*兄弟page正在split，从root开始检索*/
+			if (ret != WT_RESTART){
+				cbt->ref = NULL;
+				return ret;
+			}
+		}
+	}
+
+	WT_RET(__wt_page_release(session, cbt->ref, 0));
+	cbt->ref = NULL;
+
+	return __wt_row_search(session, srch_key, NULL, cbt, 0);
+}
+
+/*search_batch中查找cursor上设置的key，两次查找之间cursor一直持有上一个key所在的leaf page*/
+static int __cursor_batch_lookup(WT_CURSOR* cursor, WT_ITEM* value)
+{
+	WT_BTREE *btree;
+	WT_CURSOR_BTREE *cbt;
+	WT_DECL_RET;
+	WT_SESSION_IMPL *session;
+	WT_UPDATE *upd;
+
+	cbt = (WT_CURSOR_BTREE *)cursor;
+	btree = cbt->btree;
+	session = (WT_SESSION_IMPL *)cursor->session;
+
+	WT_STAT_FAST_CONN_INCR(session, cursor_search);
+	WT_STAT_FAST_DATA_INCR(session, cursor_search);
+
+	if (btree->type == BTREE_ROW){
+		WT_RET(__cursor_size_chk(session, &cursor->key));
+		WT_WITH_PAGE_INDEX(session, ret = __cursor_batch_row_search(session, cbt));
+	}
+	else{
+		/*column store的检索代价很小，每次都从root开始*/
+		WT_RET(__wt_page_release(session, cbt->ref, 0));
+		cbt->ref = NULL;
+		ret = __cursor_col_search(session, cbt);
+	}
+	WT_RET(ret);
+
+	if (cbt->compare == 0 && __cursor_valid(cbt, &upd))
+		WT_RET(__wt_kv_return(session, cbt, upd));
+	else if (__cursor_fix_implicit(btree, cbt)){
+		cbt->recno = cursor->recno;
+		cbt->v = 0;
+		cursor->value.data = &cbt->v;
+		cursor->value.size = 1;
+	}
+	else
+		return WT_NOTFOUND;
+
+	*value = cursor->value;
+	return 0;
+}
+
+/*批量查找多个key，cursor在整个批量查找过程中只进入一次*/
+int __wt_btcur_search_batch(WT_CURSOR_BTREE* cbt, size_t count, const WT_ITEM* keys, WT_ITEM* values, int* results)
+{
+	WT_CURSOR *cursor;
+	WT_DECL_RET;
+	WT_SESSION_IMPL *session;
+
+	cursor = &cbt->iface;
+	session = (WT_SESSION_IMPL *)cursor->session;
+
+	WT_STAT_FAST_CONN_INCR(session, cursor_search_batch);
+	WT_STAT_FAST_DATA_INCR(session, cursor_search_batch);
+
+	WT_RET(__cursor_func_init(cbt, 1));
+
+	ret = __wt_cursor_batch_search(cursor, cbt->btree->collator, count, keys, values, results, __cursor_batch_lookup);
+
+	WT_TRET(__cursor_reset(cbt));
+
+	return ret;
+}
+
 /*进行key value查找检索，如果定位的记录不在btree上，那么使cursor指向Key位置的前一条或者后一条记录位置*/
 int __wt_btcur_search_near(WT_CURSOR_BTREE* cbt, int* exactp)
 {
@@ -122,6 +122,9 @@ int __wt_btree_close(WT_SESSION_IMPL* session)
 	}
 	btree->collator = NULL;
 
+	/*释放bloom filter在内存中的bit map*/
+	__wt_bloom_bits_free(session, &btree->bloom_bits);
+
 	btree->bulk_load_ok = 0;
 
 	return ret;
@@ -4,6 +4,37 @@
 
 #include "wt_internal.h"
 
+/*
+ * 读取addr对应的block，先在block cache中查找，没有找到才从磁盘上读取。verify和salvage需要检查磁盘上真实的数据，不使用block cache。
+ * 压缩过的block在读取时就把磁盘上的image存入block cache，evict时不用再重新压缩
+ */
+static inline int __bt_read_block(WT_SESSION_IMPL* session, WT_ITEM* buf, const uint8_t* addr, size_t addr_size)
+{
+	WT_BM* bm;
+	WT_BTREE* btree;
+	WT_DECL_RET;
+	int use_cache;
+
+	btree = S2BT(session);
+	bm = btree->bm;
+
+	use_cache = S2C(session)->blkcache != NULL && !F_ISSET(btree, WT_BTREE_VERIFY) && !F_ISSET(session, WT_SESSION_SALVAGE_CORRUPT_OK);
+	if (use_cache){
+		WT_RET_NOTFOUND_OK(ret = __wt_blkcache_get(session, bm->block, addr, addr_size, buf));
+		if (ret == 0)
+			return 0;
+	}
+
+	WT_RET(bm->read(bm, session, buf, addr, addr_size));
+
+	/*存入block cache失败不影响读取*/
+	if (use_cache && buf->size > WT_BLOCK_COMPRESS_SKIP && F_ISSET((const WT_PAGE_HEADER *)buf->data, WT_PAGE_COMPRESSED))
+		(void)__wt_blkcache_put(session, bm->block, addr, addr_size,
+			buf->data, WT_BLOCK_COMPRESS_SKIP, (const uint8_t *)buf->data + WT_BLOCK_COMPRESS_SKIP, buf->size - WT_BLOCK_COMPRESS_SKIP);
+
+	return 0;
+}
+
 /*从block addr对应的文件位置中读取对应page的数据，根据btree的属性来觉得是否需要解压*/
 int __wt_bt_read(WT_SESSION_IMPL* session, WT_ITEM* buf, const uint8_t* addr, size_t addr_size)
 {
@@ -20,12 +51,12 @@ int __wt_bt_read(WT_SESSION_IMPL* session, WT_ITEM* buf, const uint8_t* addr, si
 
 	/*假如btree是一个压缩型的数据存储，必须先解压,那么读取的数据必须先存入一个临时缓冲区中，然后解压到buf中*/
 	if (btree->compressor == NULL){
-		WT_RET(bm->read(bm, session, buf, addr, addr_size));
+		WT_RET(__bt_read_block(session, buf, addr, addr_size));
 		dsk = buf->data;
 	}
 	else{
 		WT_RET(__wt_scr_alloc(session, 0, &tmp));
-		WT_ERR(bm->read(bm, session, tmp, addr, addr_size));
+		WT_ERR(__bt_read_block(session, tmp, addr, addr_size));
 		dsk = tmp->data;
 	}
 
@@ -83,73 +114,95 @@ int __wt_bt_read(WT_SESSION_IMPL* session, WT_ITEM* buf, const uint8_t* addr, si
 
 err:
 	__wt_scr_free(session, &tmp);
+	return ret;
 }
 
-/*将buf中的数据写入到addr对应page中的block中*/
-int __wt_bt_write(WT_SESSION_IMPL* session, WT_ITEM* buf, uint8_t* addr, size_t* addr_sizep, int checkpoint, int compressed)
+/*
+ * evict一个干净的page时，把它的磁盘格式image存入block cache。page->dsk是解压后的数据，
+ * 磁盘上压缩过的page在读取时已经存入了block cache，这里只存入磁盘上没有压缩的page
+ */
+int __wt_bt_blkcache_put(WT_SESSION_IMPL* session, WT_REF* ref)
+{
+	WT_BTREE* btree;
+	WT_PAGE* page;
+	const WT_PAGE_HEADER* dsk;
+	const uint8_t* addr;
+	size_t addr_size;
+
+	btree = S2BT(session);
+	page = ref->page;
+
+	if (S2C(session)->blkcache == NULL || page->modify != NULL || (dsk = page->dsk) == NULL ||
+		F_ISSET(btree, WT_BTREE_VERIFY) || F_ISSET(dsk, WT_PAGE_COMPRESSED) || dsk->mem_size <= WT_BLOCK_COMPRESS_SKIP)
+		return 0;
+
+	WT_RET(__wt_ref_info(session, ref, &addr, &addr_size, NULL));
+	if (addr == NULL)
+		return 0;
+
+	return __wt_blkcache_put(session, btree->bm->block, addr, addr_size,
+		dsk, WT_BLOCK_COMPRESS_SKIP, (const uint8_t *)dsk + WT_BLOCK_COMPRESS_SKIP, dsk->mem_size - WT_BLOCK_COMPRESS_SKIP);
+}
+
+/*为buf中page的压缩分配目标缓冲区dst，返回dst中可以存放压缩数据的长度*/
+static int __bt_compress_alloc(WT_SESSION_IMPL* session, WT_ITEM* buf, WT_ITEM* dst, size_t* dst_lenp)
 {
 	WT_BM *bm;
 	WT_BTREE *btree;
-	WT_ITEM *ip;
-	WT_DECL_ITEM(tmp);
-	WT_DECL_RET;
-	WT_PAGE_HEADER *dsk;
-	size_t len, src_len, dst_len, result_len, size;
-	int data_cksum, compression_failed;
-	uint8_t *src, *dst;
+	size_t len, src_len, size;
 
 	btree = S2BT(session);
 	bm = btree->bm;
 
-	WT_ASSERT(session, (checkpoint == 0 && addr != NULL && addr_sizep != NULL) || (checkpoint == 1 && addr == NULL && addr_sizep == NULL));
-
-	/*对数据压缩的判断，如果要压缩，必须先将buf中的数据通过btree->compressor->compress函数压缩到一个临时缓冲区中*/
-	if (btree->compressor == NULL || btree->compressor->compress == NULL || compressed)
-		ip = buf;
-	else if (buf->size <= btree->allocsize) /*数据太短了，不做压缩*/
-		ip = buf;
-	else{ /*进行数据压缩*/
-		src = (uint8_t *)buf->mem + WT_BLOCK_COMPRESS_SKIP;
-		src_len = buf->size - WT_BLOCK_COMPRESS_SKIP;
+	src_len = buf->size - WT_BLOCK_COMPRESS_SKIP;
 
-		/*预先计算压缩后的数据长度，长度用于分配临时缓冲区和标记page header*/
-		if (btree->compressor->pre_size == NULL)
-			len = src_len;
-		else
-			WT_ERR(btree->compressor->pre_size(btree->compressor, &session->iface, src, src_len, &len));
+	/*预先计算压缩后的数据长度，长度用于分配临时缓冲区和标记page header*/
+	if (btree->compressor->pre_size == NULL)
+		len = src_len;
+	else
+		WT_RET(btree->compressor->pre_size(btree->compressor, &session->iface, (uint8_t *)buf->mem + WT_BLOCK_COMPRESS_SKIP, src_len, &len));
 
-		/*计算block的数据长度size*/
-		size = len + WT_BLOCK_COMPRESS_SKIP;
-		WT_ERR(bm->write_size(bm, session, &size));
-		WT_ERR(__wt_scr_alloc(session, size, &tmp));
+	/*计算block的数据长度size*/
+	size = len + WT_BLOCK_COMPRESS_SKIP;
+	WT_RET(bm->write_size(bm, session, &size));
+	WT_RET(__wt_buf_init(session, dst, size));
 
-		dst = (uint8_t *)tmp->mem + WT_BLOCK_COMPRESS_SKIP;
-		dst_len = len;
+	*dst_lenp = len;
+	return 0;
+}
 
-		/*数据压缩*/
-		compression_failed = 0;
-		WT_ERR(btree->compressor->compress(btree->compressor,
-			&session->iface,
-			src, src_len,
-			dst, dst_len,
-			&result_len, &compression_failed));
-		result_len += WT_BLOCK_COMPRESS_SKIP;
+/*根据压缩的结果决定写入压缩后的数据还是原始数据，返回要写入的数据*/
+static WT_ITEM* __bt_compress_result(WT_SESSION_IMPL* session, WT_ITEM* buf, WT_ITEM* dst, size_t result_len, int compression_failed)
+{
+	WT_BTREE *btree;
 
-		/*假如数据压缩失败，直接写入原始数据*/
-		if (compression_failed || buf->size / btree->allocsize <= result_len / btree->allocsize) {
-			ip = buf;
-			WT_STAT_FAST_DATA_INCR(session, compress_write_fail);
-		}
-		else{
-			compressed = 1;
-			WT_STAT_FAST_DATA_INCR(session, compress_write);
+	btree = S2BT(session);
+	result_len += WT_BLOCK_COMPRESS_SKIP;
 
-			memcpy(tmp->mem, buf->mem, WT_BLOCK_COMPRESS_SKIP);
-			tmp->size = result_len;
-			ip = tmp;
-		}
+	/*假如数据压缩失败或者压缩后没有节省空间，直接写入原始数据*/
+	if (compression_failed || buf->size / btree->allocsize <= result_len / btree->allocsize) {
+		WT_STAT_FAST_DATA_INCR(session, compress_write_fail);
+		return buf;
 	}
 
+	WT_STAT_FAST_DATA_INCR(session, compress_write);
+
+	memcpy(dst->mem, buf->mem, WT_BLOCK_COMPRESS_SKIP);
+	dst->size = result_len;
+	return dst;
+}
+
+/*将已经确定是否压缩过的page数据ip写入block中*/
+static int __bt_write_block(WT_SESSION_IMPL* session, WT_ITEM* ip, uint8_t* addr, size_t* addr_sizep, int checkpoint, int compressed)
+{
+	WT_BM *bm;
+	WT_BTREE *btree;
+	WT_PAGE_HEADER *dsk;
+	int data_cksum;
+
+	btree = S2BT(session);
+	bm = btree->bm;
+
 	/*将ip的mem作为page的空间首地址*/
 	dsk = ip->mem;
 	/*设置page的压缩标志*/
@@ -189,15 +242,282 @@ int __wt_bt_write(WT_SESSION_IMPL* session, WT_ITEM* buf, uint8_t* addr, size_t*
 	}
 
 	/*进行checkpoint数据落盘*/
-	WT_ERR(checkpoint ? bm->checkpoint(bm, session, ip, btree->ckpt, data_cksum) : bm->write(bm, session, ip, addr, addr_sizep, data_cksum));
+	WT_RET(checkpoint ? bm->checkpoint(bm, session, ip, btree->ckpt, data_cksum) : bm->write(bm, session, ip, addr, addr_sizep, data_cksum));
 
 	WT_STAT_FAST_CONN_INCR(session, cache_write);
 	WT_STAT_FAST_DATA_INCR(session, cache_write);
 	WT_STAT_FAST_CONN_INCRV(session, cache_bytes_write, dsk->mem_size);
 	WT_STAT_FAST_DATA_INCRV(session, cache_bytes_write, dsk->mem_size);
 
+	return 0;
+}
+
+/*将buf中的数据写入到addr对应page中的block中*/
+int __wt_bt_write(WT_SESSION_IMPL* session, WT_ITEM* buf, uint8_t* addr, size_t* addr_sizep, int checkpoint, int compressed)
+{
+	WT_BTREE *btree;
+	WT_ITEM *ip;
+	WT_DECL_ITEM(tmp);
+	WT_DECL_RET;
+	size_t dst_len, result_len;
+	int compression_failed;
+
+	btree = S2BT(session);
+
+	WT_ASSERT(session, (checkpoint == 0 && addr != NULL && addr_sizep != NULL) || (checkpoint == 1 && addr == NULL && addr_sizep == NULL));
+
+	/*对数据压缩的判断，如果要压缩，必须先将buf中的数据通过btree->compressor->compress函数压缩到一个临时缓冲区中*/
+	if (btree->compressor == NULL || btree->compressor->compress == NULL || compressed)
+		ip = buf;
+	else if (buf->size <= btree->allocsize) /*数据太短了，不做压缩*/
+		ip = buf;
+	else{ /*进行数据压缩*/
+		WT_ERR(__wt_scr_alloc(session, 0, &tmp));
+		WT_ERR(__bt_compress_alloc(session, buf, tmp, &dst_len));
+
+		compression_failed = 0;
+		WT_ERR(btree->compressor->compress(btree->compressor,
+			&session->iface,
+			(uint8_t *)buf->mem + WT_BLOCK_COMPRESS_SKIP, buf->size - WT_BLOCK_COMPRESS_SKIP,
+			(uint8_t *)tmp->mem + WT_BLOCK_COMPRESS_SKIP, dst_len,
+			&result_len, &compression_failed));
+
+		ip = __bt_compress_result(session, buf, tmp, result_len, compression_failed);
+		compressed = (ip == tmp);
+	}
+
+	ret = __bt_write_block(session, ip, addr, addr_sizep, checkpoint, compressed);
+
 err:
 	__wt_scr_free(session, &tmp);
 	return ret;
 }
 
+/*执行一个压缩任务，可能在压缩线程中执行，也可能在等待任务的session中执行*/
+static void __bt_compress_run(WT_SESSION_IMPL* session, WT_COMPRESS_JOB* job)
+{
+	job->compression_failed = 0;
+	job->ret = job->compressor->compress(job->compressor,
+		&session->iface,
+		(uint8_t *)job->src.mem + WT_BLOCK_COMPRESS_SKIP, job->src.size - WT_BLOCK_COMPRESS_SKIP,
+		(uint8_t *)job->dst.mem + WT_BLOCK_COMPRESS_SKIP, job->dst_len,
+		&job->result_len, &job->compression_failed);
+
+	WT_PUBLISH(job->state, WT_COMPRESS_JOB_DONE);
+}
+
+/*压缩线程主体，从压缩任务队列中取出任务并执行*/
+static WT_THREAD_RET __bt_compress_server(void* arg)
+{
+	WT_COMPRESS_JOB *job;
+	WT_CONNECTION_IMPL *conn;
+	WT_DECL_RET;
+	WT_SESSION_IMPL *session;
+
+	session = arg;
+	conn = S2C(session);
+
+	while (F_ISSET(conn, WT_CONN_SERVER_COMPRESS)){
+		__wt_spin_lock(session, &conn->compress_lock);
+		if ((job = TAILQ_FIRST(&conn->compress_qh)) != NULL){
+			TAILQ_REMOVE(&conn->compress_qh, job, q);
+			job->state = WT_COMPRESS_JOB_RUNNING;
+		}
+		__wt_spin_unlock(session, &conn->compress_lock);
+
+		if (job == NULL){
+			WT_ERR(__wt_cond_wait(session, conn->compress_cond, 10000));
+			continue;
+		}
+
+		__bt_compress_run(session, job);
+		WT_ERR(__wt_cond_signal(session, conn->compress_done_cond));
+	}
+
+	if (0){
+err:
+		__wt_err(session, ret, "block compression server error");
+	}
+
+	return WT_THREAD_RET_VALUE;
+}
+
+/*
+ * 判断buf中的page是否需要压缩，如果需要就拷贝一份page交给压缩线程异步压缩，
+ * 压缩结果由__wt_bt_compress_write写入block
+ */
+int __wt_bt_compress_submit(WT_SESSION_IMPL* session, WT_ITEM* buf, WT_COMPRESS_JOB* job, int* submittedp)
+{
+	WT_BTREE *btree;
+	WT_CONNECTION_IMPL *conn;
+
+	btree = S2BT(session);
+	conn = S2C(session);
+	*submittedp = 0;
+
+	WT_ASSERT(session, job->state == WT_COMPRESS_JOB_IDLE);
+
+	if (conn->compress_workers == 0 || btree->compressor == NULL || btree->compressor->compress == NULL)
+		return 0;
+	if (buf->size <= btree->allocsize)
+		return 0;
+
+	WT_RET(__wt_buf_set(session, &job->src, buf->data, buf->size));
+	WT_RET(__bt_compress_alloc(session, buf, &job->dst, &job->dst_len));
+	job->compressor = btree->compressor;
+	job->result_len = 0;
+	job->ret = 0;
+
+	__wt_spin_lock(session, &conn->compress_lock);
+	job->state = WT_COMPRESS_JOB_QUEUED;
+	TAILQ_INSERT_TAIL(&conn->compress_qh, job, q);
+	__wt_spin_unlock(session, &conn->compress_lock);
+
+	*submittedp = 1;
+	WT_STAT_FAST_CONN_INCR(session, rec_compress_async);
+
+	return __wt_cond_signal(session, conn->compress_cond);
+}
+
+/*等待压缩任务完成，任务还在队列中没有被压缩线程领取时，直接由当前session执行*/
+static int __bt_compress_wait(WT_SESSION_IMPL* session, WT_COMPRESS_JOB* job)
+{
+	WT_CONNECTION_IMPL *conn;
+	int run;
+
+	conn = S2C(session);
+
+	if (job->state == WT_COMPRESS_JOB_DONE)
+		return 0;
+
+	__wt_spin_lock(session, &conn->compress_lock);
+	if ((run = (job->state == WT_COMPRESS_JOB_QUEUED)) != 0){
+		TAILQ_REMOVE(&conn->compress_qh, job, q);
+		job->state = WT_COMPRESS_JOB_RUNNING;
+	}
+	__wt_spin_unlock(session, &conn->compress_lock);
+
+	if (run){
+		__bt_compress_run(session, job);
+		return 0;
+	}
+
+	WT_STAT_FAST_CONN_INCR(session, rec_compress_wait);
+	while (job->state != WT_COMPRESS_JOB_DONE)
+		WT_RET(__wt_cond_wait(session, conn->compress_done_cond, 100));
+
+	return 0;
+}
+
+/*等待压缩任务完成，并将压缩的结果按__wt_bt_write的规则写入block中*/
+int __wt_bt_compress_write(WT_SESSION_IMPL* session, WT_COMPRESS_JOB* job, uint8_t* addr, size_t* addr_sizep)
+{
+	WT_ITEM *ip;
+
+	WT_RET(__bt_compress_wait(session, job));
+	WT_READ_BARRIER();
+	job->state = WT_COMPRESS_JOB_IDLE;
+	WT_RET(job->ret);
+
+	ip = __bt_compress_result(session, &job->src, &job->dst, job->result_len, job->compression_failed);
+	return __bt_write_block(session, ip, addr, addr_sizep, 0, ip == &job->dst);
+}
+
+/*放弃一个压缩任务，如果压缩线程正在执行这个任务，等待它结束*/
+int __wt_bt_compress_discard(WT_SESSION_IMPL* session, WT_COMPRESS_JOB* job)
+{
+	WT_CONNECTION_IMPL *conn;
+
+	conn = S2C(session);
+
+	if (job->state == WT_COMPRESS_JOB_IDLE)
+		return 0;
+
+	__wt_spin_lock(session, &conn->compress_lock);
+	if (job->state == WT_COMPRESS_JOB_QUEUED){
+		TAILQ_REMOVE(&conn->compress_qh, job, q);
+		job->state = WT_COMPRESS_JOB_DONE;
+	}
+	__wt_spin_unlock(session, &conn->compress_lock);
+
+	while (job->state != WT_COMPRESS_JOB_DONE)
+		WT_RET(__wt_cond_wait(session, conn->compress_done_cond, 100));
+
+	job->state = WT_COMPRESS_JOB_IDLE;
+	return 0;
+}
+
+/*根据eviction.compress_threads启动split block的压缩线程*/
+int __wt_bt_compress_create(WT_SESSION_IMPL* session, const char* cfg[])
+{
+	WT_CONFIG_ITEM cval;
+	WT_CONNECTION_IMPL *conn;
+	WT_COMPRESS_WORKER *worker;
+	uint32_t i, nworkers;
+
+	conn = S2C(session);
+
+	WT_RET(__wt_config_gets(session, cfg, "eviction.compress_threads", &cval));
+	if ((nworkers = (uint32_t)cval.val) == 0)
+		return 0;
+
+	TAILQ_INIT(&conn->compress_qh);
+	WT_RET(__wt_spin_init(session, &conn->compress_lock, "block compression"));
+	WT_RET(__wt_cond_alloc(session, "block compression server", 0, &conn->compress_cond));
+	WT_RET(__wt_cond_alloc(session, "block compression done", 0, &conn->compress_done_cond));
+	WT_RET(__wt_calloc_def(session, nworkers, &conn->compress_workctx));
+	conn->compress_workers_alloc = nworkers;
+
+	F_SET(conn, WT_CONN_SERVER_COMPRESS);
+	for (i = 0; i < nworkers; i++){
+		worker = &conn->compress_workctx[i];
+		WT_RET(__wt_open_internal_session(conn, "block-compress", 0, 0, &worker->session));
+		WT_RET(__wt_thread_create(session, &worker->tid, __bt_compress_server, worker->session));
+		worker->tid_set = 1;
+		/*压缩线程启动后才对外可见，队列中的任务总能被执行*/
+		WT_PUBLISH(conn->compress_workers, i + 1);
+	}
+
+	return 0;
+}
+
+/*停止压缩线程，这时已经没有reconcile在使用压缩线程*/
+int __wt_bt_compress_destroy(WT_SESSION_IMPL* session)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_COMPRESS_WORKER *worker;
+	WT_DECL_RET;
+	WT_SESSION *wt_session;
+	uint32_t i;
+
+	conn = S2C(session);
+
+	if (conn->compress_workctx == NULL)
+		return 0;
+
+	F_CLR(conn, WT_CONN_SERVER_COMPRESS);
+	conn->compress_workers = 0;
+
+	for (i = 0; i < conn->compress_workers_alloc; i++){
+		worker = &conn->compress_workctx[i];
+		if (worker->tid_set){
+			WT_TRET(__wt_cond_signal(session, conn->compress_cond));
+			WT_TRET(__wt_thread_join(session, worker->tid));
+			worker->tid_set = 0;
+		}
+		if (worker->session != NULL){
+			wt_session = &worker->session->iface;
+			WT_TRET(wt_session->close(wt_session, NULL));
+			worker->session = NULL;
+		}
+	}
+
+	WT_ASSERT(session, TAILQ_EMPTY(&conn->compress_qh));
+	__wt_free(session, conn->compress_workctx);
+	conn->compress_workers_alloc = 0;
+	WT_TRET(__wt_cond_destroy(session, &conn->compress_cond));
+	WT_TRET(__wt_cond_destroy(session, &conn->compress_done_cond));
+	__wt_spin_destroy(session, &conn->compress_lock);
+
+	return ret;
+}
@@ -0,0 +1,371 @@
+/*******************************************************
+* cursor顺序扫描时的异步read-ahead
+*******************************************************/
+
+#include "wt_internal.h"
+
+/*释放一个read-ahead请求*/
+static void __readahead_req_free(WT_SESSION_IMPL* session, WT_READAHEAD_REQ* req)
+{
+	__wt_free(session, req->name);
+	__wt_free(session, req->checkpoint);
+	__wt_buf_free(session, &req->keys);
+	__wt_free(session, req);
+}
+
+/*在read-ahead线程中通过key重新定位请求中的leaf page，把它们读入cache并实例化*/
+static int __readahead_run(WT_SESSION_IMPL* session, WT_READAHEAD_REQ* req)
+{
+	WT_CURSOR_BTREE cbt;
+	WT_DECL_RET;
+	WT_ITEM key;
+	WT_PAGE *page;
+	u_int i;
+	int full;
+
+	/*cache已经到了evict的触发点，read-ahead只会加剧evict的压力，放弃这个请求*/
+	WT_RET(__wt_eviction_check(session, &full, 0));
+	if (full >= (int)S2C(session)->cache->eviction_trigger){
+		WT_STAT_FAST_CONN_INCR(session, cache_readahead_skip_full);
+		return 0;
+	}
+
+	/*btree可能已经被drop或者正在被独占使用，read-ahead只是一个提示，直接放弃*/
+	if (__wt_session_get_btree(session, req->name, req->checkpoint, NULL, 0) != 0)
+		return 0;
+
+	memset(&cbt, 0, sizeof(cbt));
+	cbt.iface.session = &session->iface;
+	cbt.btree = S2BT(session);
+
+	WT_CLEAR(key);
+	for (i = 0; i < req->count && F_ISSET(S2C(session), WT_CONN_SERVER_READAHEAD); i++){
+		if (req->row){
+			key.data = (uint8_t *)req->keys.mem + req->key_off[i];
+			key.size = req->key_size[i];
+			WT_WITH_PAGE_INDEX(session, ret = __wt_row_search(session, &key, NULL, &cbt, 0));
+		}
+		else
+			WT_WITH_PAGE_INDEX(session, ret = __wt_col_search(session, req->recno[i], NULL, &cbt));
+		WT_ERR(ret);
+
+		if (cbt.ref != NULL){
+			page = cbt.ref->page;
+			if (!page->readahead){
+				page->readahead = 1;
+				WT_STAT_FAST_CONN_INCR(session, cache_readahead_read);
+			}
+			ret = __wt_page_release(session, cbt.ref, 0);
+			cbt.ref = NULL;
+			WT_ERR(ret);
+		}
+	}
+
+err:
+	__wt_buf_free(session, &cbt.search_key);
+	__wt_buf_free(session, &cbt.tmp);
+	WT_TRET(__wt_session_release_btree(session));
+	return ret;
+}
+
+/*read-ahead线程主体，从请求队列中取出请求并执行*/
+static WT_THREAD_RET __readahead_server(void* arg)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_DECL_RET;
+	WT_READAHEAD_REQ *req;
+	WT_SESSION_IMPL *session;
+
+	session = arg;
+	conn = S2C(session);
+
+	while (F_ISSET(conn, WT_CONN_SERVER_READAHEAD)){
+		__wt_spin_lock(session, &conn->readahead_lock);
+		if ((req = TAILQ_FIRST(&conn->readahead_qh)) != NULL){
+			TAILQ_REMOVE(&conn->readahead_qh, req, q);
+			--conn->readahead_queued;
+		}
+		__wt_spin_unlock(session, &conn->readahead_lock);
+
+		if (req == NULL){
+			WT_ERR(__wt_cond_wait(session, conn->readahead_cond, 10000));
+			continue;
+		}
+
+		ret = __readahead_run(session, req);
+		__readahead_req_free(session, req);
+		WT_ERR(ret);
+	}
+
+	if (0){
+err:
+		__wt_err(session, ret, "read-ahead server error");
+	}
+
+	return WT_THREAD_RET_VALUE;
+}
+
+/*把parent page中一个slot对应的leaf page加入read-ahead请求*/
+static int __readahead_req_add(WT_SESSION_IMPL* session, WT_READAHEAD_REQ* req, WT_PAGE* home, WT_REF* ref)
+{
+	void *p;
+	size_t size;
+
+	if (req->row){
+		__wt_ref_key(home, ref, &p, &size);
+		req->key_off[req->count] = req->keys.size;
+		req->key_size[req->count] = size;
+		WT_RET(__wt_buf_grow(session, &req->keys, req->keys.size + size));
+		memcpy((uint8_t *)req->keys.mem + req->keys.size, p, size);
+		req->keys.size += size;
+	}
+	else
+		req->recno[req->count] = ref->key.recno;
+
+	++req->count;
+	return 0;
+}
+
+/*提交[start, end)范围内的read-ahead请求，prev扫描时按从后往前的顺序提交*/
+static int __readahead_submit(WT_SESSION_IMPL* session, WT_CURSOR_BTREE* cbt, WT_PAGE* home, WT_PAGE_INDEX* pindex, uint32_t start, uint32_t end)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_DATA_HANDLE *dhandle;
+	WT_DECL_RET;
+	WT_READAHEAD_REQ *req;
+	WT_REF *ref;
+	uint64_t mask;
+	uint32_t i, slot;
+
+	conn = S2C(session);
+	dhandle = cbt->btree->dhandle;
+
+	if (conn->readahead_queued >= WT_READAHEAD_QUEUE_MAX){
+		WT_STAT_FAST_CONN_INCR(session, cache_readahead_queue_full);
+		return 0;
+	}
+
+	WT_RET(__wt_calloc_one(session, &req));
+	req->row = cbt->btree->type == BTREE_ROW;
+	mask = 0;
+	for (i = start; i < end; i++){
+		/*只有不在内存中的page才需要read-ahead*/
+		slot = cbt->ra_prev ? end - 1 - (i - start) : i;
+		ref = pindex->index[slot];
+		if (ref->state != WT_REF_DISK)
+			continue;
+
+		WT_ERR(__readahead_req_add(session, req, home, ref));
+		mask |= (uint64_t)1 << (slot % WT_READAHEAD_MAX);
+	}
+
+	if (req->count == 0)
+		goto err;
+
+	WT_ERR(__wt_strdup(session, dhandle->name, &req->name));
+	WT_ERR(__wt_strdup(session, dhandle->checkpoint, &req->checkpoint));
+
+	__wt_spin_lock(session, &conn->readahead_lock);
+	if (conn->readahead_queued < WT_READAHEAD_QUEUE_MAX){
+		TAILQ_INSERT_TAIL(&conn->readahead_qh, req, q);
+		++conn->readahead_queued;
+		WT_STAT_FAST_CONN_INCRV(session, cache_readahead_queued, req->count);
+		cbt->ra_mask |= mask;
+		req = NULL;
+	}
+	__wt_spin_unlock(session, &conn->readahead_lock);
+
+	if (req != NULL){
+		WT_STAT_FAST_CONN_INCR(session, cache_readahead_queue_full);
+		goto err;
+	}
+
+	return __wt_cond_signal(session, conn->readahead_cond);
+
+err:
+	__readahead_req_free(session, req);
+	return ret;
+}
+
+/*
+ * 根据cursor所在leaf page在parent page中的位置判断是否是顺序扫描，统计上一次read-ahead
+ * 的命中情况并调整read-ahead深度，然后提交scan方向上后续leaf page的read-ahead请求
+ */
+static int __readahead_check(WT_SESSION_IMPL* session, WT_CURSOR_BTREE* cbt, int prev)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_PAGE *home, *page;
+	WT_PAGE_INDEX *pindex;
+	uint32_t end, queued, slot, start;
+	int sequential;
+
+	conn = S2C(session);
+	page = cbt->ref->page;
+
+	__wt_page_refp(session, cbt->ref, &pindex, &slot);
+	home = cbt->ref->home;
+
+	if (cbt->ra_depth == 0)
+		cbt->ra_depth = WT_MAX(conn->readahead_depth / 4, 1);
+
+	/*在同一个parent page下相邻的slot上移动，或者从上一个parent page的边界进入新parent page的边界*/
+	sequential = 0;
+	if (cbt->ra_home != NULL && cbt->ra_prev == (uint8_t)prev){
+		if (cbt->ra_home == home)
+			sequential = prev ? slot + 1 == cbt->ra_slot : slot == cbt->ra_slot + 1;
+		else
+			sequential = prev ? slot + 1 == pindex->entries : slot == 0;
+	}
+
+	if (!sequential || cbt->ra_home != home){
+		cbt->ra_limit = prev ? slot : slot + 1;
+		cbt->ra_mask = 0;
+		if (!sequential)
+			cbt->ra_seq = 0;
+	}
+	else if (cbt->ra_mask & ((uint64_t)1 << (slot % WT_READAHEAD_MAX))){
+		/*到达的是已经提交过read-ahead的page，检查read-ahead线程是否已经把它读入*/
+		cbt->ra_mask &= ~((uint64_t)1 << (slot % WT_READAHEAD_MAX));
+		if (page->readahead){
+			page->readahead = 0;
+			++cbt->ra_hits;
+			WT_STAT_FAST_CONN_INCR(session, cache_readahead_hit);
+		}
+		else {
+			++cbt->ra_misses;
+			WT_STAT_FAST_CONN_INCR(session, cache_readahead_miss);
+		}
+	}
+
+	cbt->ra_home = home;
+	cbt->ra_slot = slot;
+	cbt->ra_prev = (uint8_t)prev;
+	if (sequential)
+		++cbt->ra_seq;
+
+	/*命中率低说明read-ahead跟不上scan，加大深度；全部命中时逐步减小深度，减少对cache的占用*/
+	if (cbt->ra_hits + cbt->ra_misses >= 8){
+		if (cbt->ra_misses * 4 > cbt->ra_hits + cbt->ra_misses)
+			cbt->ra_depth = WT_MIN(cbt->ra_depth * 2, conn->readahead_depth);
+		else if (cbt->ra_misses == 0 && cbt->ra_depth > 2)
+			--cbt->ra_depth;
+		cbt->ra_hits = cbt->ra_misses = 0;
+	}
+
+	/*连续3个page顺序移动才认为是顺序扫描*/
+	if (cbt->ra_seq < 2)
+		return 0;
+
+	/*还没有被cursor到达的read-ahead page超过深度的一半时不提交，让请求成批提交*/
+	if (prev){
+		queued = slot > cbt->ra_limit ? slot - cbt->ra_limit : 0;
+		start = slot > cbt->ra_depth ? slot - cbt->ra_depth : 0;
+		end = WT_MIN(slot, cbt->ra_limit);
+	}
+	else {
+		queued = cbt->ra_limit > slot + 1 ? cbt->ra_limit - slot - 1 : 0;
+		start = WT_MAX(slot + 1, cbt->ra_limit);
+		end = WT_MIN(slot + 1 + cbt->ra_depth, pindex->entries);
+	}
+	if (queued > cbt->ra_depth / 2 || start >= end)
+		return 0;
+
+	cbt->ra_limit = prev ? start : end;
+	return __readahead_submit(session, cbt, home, pindex, start, end);
+}
+
+/*cursor移动到一个新的leaf page后调用，判断是否需要对后续的leaf page做read-ahead*/
+int __wt_btcur_readahead(WT_CURSOR_BTREE* cbt, int prev)
+{
+	WT_DECL_RET;
+	WT_SESSION_IMPL *session;
+
+	session = (WT_SESSION_IMPL *)cbt->iface.session;
+
+	if (S2C(session)->readahead_workers == 0 || cbt->ref == NULL || __wt_ref_is_root(cbt->ref))
+		return 0;
+
+	WT_WITH_PAGE_INDEX(session, ret = __readahead_check(session, cbt, prev));
+	return ret;
+}
+
+/*根据read_ahead配置启动read-ahead线程*/
+int __wt_readahead_create(WT_SESSION_IMPL* session, const char* cfg[])
+{
+	WT_CONFIG_ITEM cval;
+	WT_CONNECTION_IMPL *conn;
+	WT_READAHEAD_WORKER *worker;
+	uint32_t i, nworkers;
+
+	conn = S2C(session);
+
+	WT_RET(__wt_config_gets(session, cfg, "read_ahead.depth", &cval));
+	conn->readahead_depth = WT_MIN((uint32_t)cval.val, WT_READAHEAD_MAX);
+
+	WT_RET(__wt_config_gets(session, cfg, "read_ahead.threads", &cval));
+	if ((nworkers = (uint32_t)cval.val) == 0)
+		return 0;
+
+	TAILQ_INIT(&conn->readahead_qh);
+	WT_RET(__wt_spin_init(session, &conn->readahead_lock, "read-ahead"));
+	WT_RET(__wt_cond_alloc(session, "read-ahead server", 0, &conn->readahead_cond));
+	WT_RET(__wt_calloc_def(session, nworkers, &conn->readahead_workctx));
+	conn->readahead_workers_alloc = nworkers;
+
+	F_SET(conn, WT_CONN_SERVER_READAHEAD);
+	for (i = 0; i < nworkers; i++){
+		worker = &conn->readahead_workctx[i];
+		WT_RET(__wt_open_internal_session(conn, "read-ahead", 1, 0, &worker->session));
+		WT_RET(__wt_thread_create(session, &worker->tid, __readahead_server, worker->session));
+		worker->tid_set = 1;
+		WT_PUBLISH(conn->readahead_workers, i + 1);
+	}
+
+	return 0;
+}
+
+/*停止read-ahead线程并丢弃还没有执行的请求，必须在关闭btree handle之前调用*/
+int __wt_readahead_destroy(WT_SESSION_IMPL* session)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_DECL_RET;
+	WT_READAHEAD_REQ *req;
+	WT_READAHEAD_WORKER *worker;
+	WT_SESSION *wt_session;
+	uint32_t i;
+
+	conn = S2C(session);
+
+	if (conn->readahead_workctx == NULL)
+		return 0;
+
+	F_CLR(conn, WT_CONN_SERVER_READAHEAD);
+	conn->readahead_workers = 0;
+
+	for (i = 0; i < conn->readahead_workers_alloc; i++){
+		worker = &conn->readahead_workctx[i];
+		if (worker->tid_set){
+			WT_TRET(__wt_cond_signal(session, conn->readahead_cond));
+			WT_TRET(__wt_thread_join(session, worker->tid));
+			worker->tid_set = 0;
+		}
+		if (worker->session != NULL){
+			wt_session = &worker->session->iface;
+			WT_TRET(wt_session->close(wt_session, NULL));
+			worker->session = NULL;
+		}
+	}
+
+	while ((req = TAILQ_FIRST(&conn->readahead_qh)) != NULL){
+		TAILQ_REMOVE(&conn->readahead_qh, req, q);
+		__readahead_req_free(session, req);
+	}
+	conn->readahead_queued = 0;
+
+	__wt_free(session, conn->readahead_workctx);
+	conn->readahead_workers_alloc = 0;
+	WT_TRET(__wt_cond_destroy(session, &conn->readahead_cond));
+	__wt_spin_destroy(session, &conn->readahead_lock);
+
+	return ret;
+}
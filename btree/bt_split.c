@@ -125,6 +125,18 @@ static int __split_safe_free(WT_SESSION_IMPL* session, uint64_t split_gen, int e
 	return __split_stash_add(session, split_gen, p, s);
 }
 
+/*
+ * 释放一个不持有锁就可能被其他线程读取的对象(例如connection的dhandle)，读取的线程通过WT_ENTER_PAGE_INDEX
+ * 发布自己的split_gen，p在这些线程都退出之后才会被真正释放
+ */
+int __wt_split_safe_free_deferred(WT_SESSION_IMPL* session, void* p, size_t s)
+{
+	uint64_t split_gen;
+
+	split_gen = WT_ATOMIC_ADD8(S2C(session)->split_gen, 1);
+	return __split_safe_free(session, split_gen, 0, p, s);
+}
+
 /*检查btree是否可以deepen（加深层次）*/
 static int __split_should_deepen(WT_SESSION_IMPL *session, WT_REF *ref, uint32_t *childrenp)
 {
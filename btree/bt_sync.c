@@ -48,6 +48,7 @@ static int __sync_file(WT_SESSION_IMPL* session, int syncop)
 			if (walk == NULL)
 				break;
 
+			page = walk->page;
 			/* 将无操作的脏写入磁盘，如果有的更新在刷盘事务之后产生，那么这个更新的page不做刷盘操作*/
 			if (__wt_page_is_modified(page) && __wt_txn_visible_all(session, page->modify->update_txn)){
 				if (txn->isolation == TXN_ISO_READ_COMMITTED)
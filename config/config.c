@@ -495,16 +495,33 @@ static int __config_getraw(WT_CONFIG *cparser, WT_CONFIG_ITEM *key, WT_CONFIG_IT
 	return (top ? __config_process_value(cparser, value) : 0);
 }
 
+/*在一个配置字符串中查找key，预编译的配置直接查找预编译的结果，不需要解析字符串*/
+static inline int __config_getone(WT_SESSION_IMPL *session, const char *config, WT_CONFIG_ITEM *key, WT_CONFIG_ITEM *value)
+{
+	WT_CONFIG cparser;
+	WT_CONFIG_COMPILED *compiled;
+	const WT_CONFIG_COMPILED_ITEM *item;
+
+	if ((compiled = __wt_config_compiled_find(session, config)) != NULL &&
+		(item = __wt_config_compiled_get(compiled, key)) != NULL){
+		if (!item->found)
+			return WT_NOTFOUND;
+		*value = item->value;
+		return 0;
+	}
+
+	WT_RET(__wt_config_init(session, &cparser, config));
+	return __config_getraw(&cparser, key, value, 1);
+}
+
 /*通过key获得value*/
 int __wt_config_get(WT_SESSION_IMPL *session, const char **cfg, WT_CONFIG_ITEM *key, WT_CONFIG_ITEM *value)
 {
-	WT_CONFIG cparser;
 	WT_DECL_RET;
 	int found;
 
 	for (found = 0; *cfg != NULL; cfg++) {
-		WT_RET(__wt_config_init(session, &cparser, *cfg));
-		if ((ret = __config_getraw(&cparser, key, value, 1)) == 0)
+		if ((ret = __config_getone(session, *cfg, key, value)) == 0)
 			found = 1;
 		else if(ret != WT_NOTFOUND)
 			return ret;
@@ -533,20 +550,15 @@ int __wt_config_gets_none(WT_SESSION_IMPL *session, const char **cfg, const char
 
 int __wt_config_getone(WT_SESSION_IMPL *session, const char *config, WT_CONFIG_ITEM *key, WT_CONFIG_ITEM *value)
 {
-	WT_CONFIG cparser;
-
-	WT_RET(__wt_config_init(session, &cparser, config));
-	return __config_getraw(&cparser, key, value, 1);
+	return __config_getone(session, config, key, value);
 }
 
 int __wt_config_getones(WT_SESSION_IMPL *session, const char *config, const char *key, WT_CONFIG_ITEM *value)
 {
-	WT_CONFIG cparser;
 	WT_CONFIG_ITEM key_item =
 	{ key, strlen(key), 0, WT_CONFIG_ITEM_STRING };
 
-	WT_RET(__wt_config_init(session, &cparser, config));
-	return __config_getraw(&cparser, &key_item, value, 1);
+	return __config_getone(session, config, &key_item, value);
 }
 
 int __wt_config_getones_none(WT_SESSION_IMPL *session, const char *config, const char *key, WT_CONFIG_ITEM *value)
@@ -567,8 +579,11 @@ int __wt_config_gets_def(WT_SESSION_IMPL *session, const char **cfg, const char
 	if (cfg == NULL || cfg[0] == NULL || cfg[1] == NULL)
 		return 0;
 
-	else if (cfg[2] == NULL)
+	/*只有一个用户配置时，用户配置中没有的key直接使用def*/
+	if (cfg[2] == NULL){
 		WT_RET_NOTFOUND_OK(__wt_config_getones(session, cfg[1], key, value));
+		return 0;
+	}
 
 	return (__wt_config_gets(session, cfg, key, value));
 }
@@ -156,9 +156,17 @@ err:
 	return ret;
 }
 
-/**/
+/*检查配置字符串是否符合entry的定义，预编译的配置在编译时已经检查过，只需要确认是为这个方法编译的*/
 int __wt_config_check(WT_SESSION_IMPL *session, const WT_CONFIG_ENTRY *entry, const char *config, size_t config_len)
 {
+	WT_CONFIG_COMPILED *compiled;
+
+	if ((compiled = __wt_config_compiled_find(session, config)) != NULL){
+		if (F_ISSET(compiled, WT_CONFIG_COMPILED_BASE) || compiled->method == entry->method || strcmp(compiled->method, entry->method) == 0)
+			return 0;
+		WT_RET_MSG(session, EINVAL, "configuration compiled for %s can not be used by %s", compiled->method, entry->method);
+	}
+
 	return (config == NULL || entry->checks == NULL ? 0 : config_check(session, entry->checks, entry->checks_entries, config, config_len));
 }
 
@@ -0,0 +1,252 @@
+/**********************************************************************
+*配置字符串的预编译，预编译后的配置查找key时不需要再解析配置字符串
+**********************************************************************/
+
+#include "wt_internal.h"
+
+/*计算checks展开后的key个数和key名字需要的空间*/
+static void __config_compile_count(const WT_CONFIG_CHECK* checks, size_t prefix_len, u_int* countp, size_t* bytesp)
+{
+	const WT_CONFIG_CHECK* cp;
+	size_t len;
+
+	for (cp = checks; cp->name != NULL; ++cp){
+		len = (prefix_len == 0 ? 0 : prefix_len + 1) + strlen(cp->name);
+		++*countp;
+		*bytesp += len + 1;
+		if (cp->subconfigs != NULL)
+			__config_compile_count(cp->subconfigs, len, countp, bytesp);
+	}
+}
+
+/*展开checks，子配置的key用"parent.child"的形式*/
+static void __config_compile_fill(const WT_CONFIG_CHECK* checks, const char* prefix, size_t prefix_len, WT_CONFIG_COMPILED_ITEM** itemp, char** namep)
+{
+	const WT_CONFIG_CHECK* cp;
+	size_t len;
+	char* name;
+
+	for (cp = checks; cp->name != NULL; ++cp){
+		name = *namep;
+		len = 0;
+		if (prefix_len != 0){
+			memcpy(name, prefix, prefix_len);
+			name[prefix_len] = '.';
+			len = prefix_len + 1;
+		}
+		strcpy(name + len, cp->name);
+		len += strlen(cp->name);
+		*namep += len + 1;
+
+		(*itemp)->name = name;
+		++*itemp;
+		if (cp->subconfigs != NULL)
+			__config_compile_fill(cp->subconfigs, name, len, itemp, namep);
+	}
+}
+
+static int __config_compile_item_cmp(const void* a, const void* b)
+{
+	return strcmp(((const WT_CONFIG_COMPILED_ITEM *)a)->name, ((const WT_CONFIG_COMPILED_ITEM *)b)->name);
+}
+
+/*
+ * 将entry方法的配置字符串config预编译，返回的handle是预编译结果中的配置字符串拷贝。同一个方法的同一个配置字符串
+ * 只编译一次，重复编译返回已有的handle。调用者必须持有api_lock或者在connection打开的过程中调用
+ */
+static int __config_compile(WT_SESSION_IMPL* session, const WT_CONFIG_ENTRY* entry, const char* config, uint32_t flags, const char** handlep)
+{
+	WT_CONFIG_COMPILED* compiled;
+	WT_CONFIG_COMPILED_ITEM *item, *items;
+	WT_CONFIG_ITEM key;
+	WT_CONNECTION_IMPL* conn;
+	WT_DECL_RET;
+	size_t len, name_bytes;
+	uint64_t bucket, hash;
+	u_int i, count;
+	char* names;
+
+	conn = S2C(session);
+	compiled = NULL;
+	items = NULL;
+
+	len = strlen(config);
+	hash = __wt_hash_city64(config, len);
+
+	/*用户的配置才需要去重，默认配置每个方法只编译一次*/
+	if (!LF_ISSET(WT_CONFIG_COMPILED_BASE))
+		SLIST_FOREACH(compiled, &conn->config_compiled_strhash[hash % WT_HASH_ARRAY_SIZE], strhashl)
+			if (compiled->hash == hash && compiled->method == entry->method && strcmp(compiled->config, config) == 0){
+				*handlep = compiled->config;
+				return 0;
+			}
+
+	WT_RET(__wt_calloc(session, 1, sizeof(WT_CONFIG_COMPILED) + len + 1, &compiled));
+	compiled->method = entry->method;
+	compiled->hash = hash;
+	compiled->config = (const char *)(compiled + 1);
+	compiled->flags = flags;
+	memcpy((char *)(compiled + 1), config, len + 1);
+
+	/*展开方法的所有key，key的名字放在items数组的后面*/
+	count = 0;
+	name_bytes = 0;
+	if (entry->checks != NULL)
+		__config_compile_count(entry->checks, 0, &count, &name_bytes);
+	if (count != 0){
+		WT_ERR(__wt_calloc(session, 1, count * sizeof(WT_CONFIG_COMPILED_ITEM) + name_bytes, &items));
+		item = items;
+		names = (char *)(items + count);
+		__config_compile_fill(entry->checks, NULL, 0, &item, &names);
+		qsort(items, count, sizeof(WT_CONFIG_COMPILED_ITEM), __config_compile_item_cmp);
+	}
+
+	/*handle还没有发布，这里的查找会解析字符串，value指向拷贝出来的字符串*/
+	for (i = 0, item = items; i < count; ++i, ++item){
+		key.str = item->name;
+		key.len = strlen(item->name);
+		key.type = WT_CONFIG_ITEM_STRING;
+		if ((ret = __wt_config_getone(session, compiled->config, &key, &item->value)) == 0)
+			item->found = 1;
+		else if (ret == WT_NOTFOUND)
+			ret = 0;
+		else
+			WT_ERR(ret);
+	}
+
+	compiled->items = items;
+	compiled->items_entries = count;
+
+	/*发布handle，之后其他线程就可以通过handle找到预编译的结果*/
+	bucket = WT_CONFIG_COMPILED_BUCKET(compiled->config);
+	SLIST_NEXT(compiled, hashl) = SLIST_FIRST(&conn->config_compiled_hash[bucket]);
+	WT_PUBLISH(SLIST_FIRST(&conn->config_compiled_hash[bucket]), compiled);
+	SLIST_INSERT_HEAD(&conn->config_compiled_strhash[hash % WT_HASH_ARRAY_SIZE], compiled, strhashl);
+
+	*handlep = compiled->config;
+	return 0;
+
+err:
+	__wt_free(session, items);
+	__wt_free(session, compiled);
+	return ret;
+}
+
+/*
+ * 预编译config_def.c中每个方法的默认配置。conn->config_entries指向拷贝出来的entry，
+ * 它们的base是预编译的默认配置
+ */
+int __wt_config_compile_init(WT_SESSION_IMPL* session, const WT_CONFIG_ENTRY* entries, size_t entries_count)
+{
+	WT_CONNECTION_IMPL* conn;
+	size_t i;
+
+	conn = S2C(session);
+
+	WT_RET(__wt_calloc_def(session, entries_count, &conn->config_base_entries));
+
+	for (i = 0; i < entries_count; i++){
+		conn->config_base_entries[i] = entries[i];
+		if (entries[i].method != NULL)
+			WT_RET(__config_compile(session, &entries[i], entries[i].base, WT_CONFIG_COMPILED_BASE, &conn->config_base_entries[i].base));
+		conn->config_entries[i] = &conn->config_base_entries[i];
+	}
+
+	return 0;
+}
+
+/*释放所有预编译的配置，这时已经没有使用handle的线程*/
+void __wt_config_compile_destroy(WT_SESSION_IMPL* session)
+{
+	WT_CONFIG_COMPILED* compiled;
+	WT_CONNECTION_IMPL* conn;
+	uint64_t bucket;
+
+	conn = S2C(session);
+
+	/*每个预编译配置同时在两个hash表中，只按config_compiled_hash释放*/
+	for (bucket = 0; bucket < WT_HASH_ARRAY_SIZE; ++bucket){
+		SLIST_INIT(&conn->config_compiled_strhash[bucket]);
+		while ((compiled = SLIST_FIRST(&conn->config_compiled_hash[bucket])) != NULL){
+			SLIST_REMOVE_HEAD(&conn->config_compiled_hash[bucket], hashl);
+			__wt_free(session, compiled->items);
+			__wt_free(session, compiled);
+		}
+	}
+
+	__wt_free(session, conn->config_base_entries);
+}
+
+/*为方法method预编译用户的配置字符串，WT_CONNECTION::compile_configuration的实现*/
+int __wt_config_compile_method(WT_SESSION_IMPL* session, const char* method, const char* config, const char** handlep)
+{
+	const WT_CONFIG_ENTRY** epp;
+	WT_CONNECTION_IMPL* conn;
+	WT_DECL_RET;
+
+	conn = S2C(session);
+	*handlep = NULL;
+
+	if (config == NULL)
+		WT_RET_MSG(session, EINVAL, "no configuration specified");
+
+	for (epp = conn->config_entries; (*epp)->method != NULL; ++epp)
+		if (strcmp((*epp)->method, method) == 0)
+			break;
+	if ((*epp)->method == NULL)
+		WT_RET_MSG(session, WT_NOTFOUND, "no method matching %s found", method);
+
+	/*预编译的配置在使用时不再检查，这里必须先检查*/
+	WT_RET(__wt_config_check(session, *epp, config, 0));
+
+	__wt_spin_lock(session, &conn->api_lock);
+	ret = __config_compile(session, *epp, config, 0, handlep);
+	__wt_spin_unlock(session, &conn->api_lock);
+
+	return ret;
+}
+
+/*如果config是一个预编译配置的handle，返回对应的预编译结果，否则返回NULL。hash链表只会在头上插入，不需要加锁*/
+WT_CONFIG_COMPILED* __wt_config_compiled_find(WT_SESSION_IMPL* session, const char* config)
+{
+	WT_CONFIG_COMPILED* compiled;
+	WT_CONNECTION_IMPL* conn;
+	uint64_t bucket;
+
+	if (session == NULL || config == NULL)
+		return NULL;
+
+	conn = S2C(session);
+	bucket = WT_CONFIG_COMPILED_BUCKET(config);
+	for (compiled = SLIST_FIRST(&conn->config_compiled_hash[bucket]); compiled != NULL; compiled = SLIST_NEXT(compiled, hashl))
+		if (compiled->config == config)
+			return compiled;
+
+	return NULL;
+}
+
+/*在预编译的配置中二分查找key，返回NULL表示key不在方法的配置定义中，需要解析配置字符串*/
+const WT_CONFIG_COMPILED_ITEM* __wt_config_compiled_get(WT_CONFIG_COMPILED* compiled, const WT_CONFIG_ITEM* key)
+{
+	const WT_CONFIG_COMPILED_ITEM* item;
+	u_int base, indx, limit;
+	int cmp;
+
+	for (base = 0, limit = compiled->items_entries; limit != 0; limit >>= 1){
+		indx = base + (limit >> 1);
+		item = &compiled->items[indx];
+
+		cmp = strncmp(item->name, key->str, key->len);
+		if (cmp == 0 && item->name[key->len] != '\0')
+			cmp = 1;
+
+		if (cmp == 0)
+			return item;
+		if (cmp < 0){
+			base = indx + 1;
+			--limit;
+		}
+	}
+
+	return NULL;
+}
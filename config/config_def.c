@@ -40,18 +40,22 @@ static const WT_CONFIG_CHECK confchk_connection_open_session[] = {
 static const WT_CONFIG_CHECK confchk_async_subconfigs[] = {
 	{ "enabled", "boolean", NULL, NULL, NULL, 0 },
 	{ "ops_max", "int", NULL, "min=1,max=4096", NULL, 0 },
-	{ "threads", "int", NULL, "min=1,max=20", NULL, 0 },
+	{ "threads", "int", NULL, "min=1,max=1024", NULL, 0 },
+	{ "threads_max", "int", NULL, "min=1,max=1024", NULL, 0 },
 	{ NULL, NULL, NULL, NULL, NULL, 0 }
 };
 
 static const WT_CONFIG_CHECK confchk_checkpoint_subconfigs[] = {
 	{ "log_size", "int", NULL, "min=0,max=2GB", NULL, 0 },
 	{ "name", "string", NULL, NULL, NULL, 0 },
+	{ "threads", "int", NULL, "min=1,max=64", NULL, 0 },
 	{ "wait", "int", NULL, "min=0,max=100000", NULL, 0 },
 	{ NULL, NULL, NULL, NULL, NULL, 0 }
 };
 
 static const WT_CONFIG_CHECK confchk_eviction_subconfigs[] = {
+	{ "compress_threads", "int", NULL, "min=0,max=20", NULL, 0 },
+	{ "dirty_aware", "boolean", NULL, NULL, NULL, 0 },
 	{ "threads_max", "int", NULL, "min=1,max=20", NULL, 0 },
 	{ "threads_min", "int", NULL, "min=1,max=20", NULL, 0 },
 	{ NULL, NULL, NULL, NULL, NULL, 0 }
@@ -91,16 +95,16 @@ static const WT_CONFIG_CHECK confchk_statistics_log_subconfigs[] = {
 static const WT_CONFIG_CHECK confchk_connection_reconfigure[] = {
 	{ "async", "category",
 	NULL, NULL,
-	confchk_async_subconfigs, 3 },
+	confchk_async_subconfigs, 4 },
 	{ "cache_overhead", "int", NULL, "min=0,max=30", NULL, 0 },
 	{ "cache_size", "int", NULL, "min=1MB,max=10TB", NULL, 0 },
 	{ "checkpoint", "category",
 	NULL, NULL,
-	confchk_checkpoint_subconfigs, 3 },
+	confchk_checkpoint_subconfigs, 4 },
 	{ "error_prefix", "string", NULL, NULL, NULL, 0 },
 	{ "eviction", "category",
 	NULL, NULL,
-	confchk_eviction_subconfigs, 2 },
+	confchk_eviction_subconfigs, 4 },
 	{ "eviction_dirty_target", "int",
 	NULL, "min=10,max=99",
 	NULL, 0 },
@@ -377,6 +381,12 @@ static const WT_CONFIG_CHECK confchk_table_meta[] = {
 	{ NULL, NULL, NULL, NULL, NULL, 0 }
 };
 
+static const WT_CONFIG_CHECK confchk_io_uring_subconfigs[] = {
+	{ "enabled", "boolean", NULL, NULL, NULL, 0 },
+	{ "queue_depth", "int", NULL, "min=1,max=4096", NULL, 0 },
+	{ NULL, NULL, NULL, NULL, NULL, 0 }
+};
+
 static const WT_CONFIG_CHECK confchk_log_subconfigs[] = {
 	{ "archive", "boolean", NULL, NULL, NULL, 0 },
 	{ "compressor", "string", NULL, NULL, NULL, 0 },
@@ -387,6 +397,18 @@ static const WT_CONFIG_CHECK confchk_log_subconfigs[] = {
 	{ "recover", "string",
 	NULL, "choices=[\"error\",\"on\"]",
 	NULL, 0 },
+	{ "recover_threads", "int", NULL, "min=1,max=64", NULL, 0 },
+	{ NULL, NULL, NULL, NULL, NULL, 0 }
+};
+
+static const WT_CONFIG_CHECK confchk_block_cache_subconfigs[] = {
+	{ "size", "int", NULL, "min=0,max=10TB", NULL, 0 },
+	{ NULL, NULL, NULL, NULL, NULL, 0 }
+};
+
+static const WT_CONFIG_CHECK confchk_read_ahead_subconfigs[] = {
+	{ "depth", "int", NULL, "min=1,max=64", NULL, 0 },
+	{ "threads", "int", NULL, "min=0,max=20", NULL, 0 },
 	{ NULL, NULL, NULL, NULL, NULL, 0 }
 };
 
@@ -401,13 +423,16 @@ static const WT_CONFIG_CHECK confchk_transaction_sync_subconfigs[] = {
 static const WT_CONFIG_CHECK confchk_wiredtiger_open[] = {
 	{ "async", "category",
 	NULL, NULL,
-	confchk_async_subconfigs, 3 },
+	confchk_async_subconfigs, 4 },
+	{ "block_cache", "category",
+	NULL, NULL,
+	confchk_block_cache_subconfigs, 1 },
 	{ "buffer_alignment", "int", NULL, "min=-1,max=1MB", NULL, 0 },
 	{ "cache_overhead", "int", NULL, "min=0,max=30", NULL, 0 },
 	{ "cache_size", "int", NULL, "min=1MB,max=10TB", NULL, 0 },
 	{ "checkpoint", "category",
 	NULL, NULL,
-	confchk_checkpoint_subconfigs, 3 },
+	confchk_checkpoint_subconfigs, 4 },
 	{ "checkpoint_sync", "boolean", NULL, NULL, NULL, 0 },
 	{ "config_base", "boolean", NULL, NULL, NULL, 0 },
 	{ "create", "boolean", NULL, NULL, NULL, 0 },
@@ -417,7 +442,7 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open[] = {
 	{ "error_prefix", "string", NULL, NULL, NULL, 0 },
 	{ "eviction", "category",
 	NULL, NULL,
-	confchk_eviction_subconfigs, 2 },
+	confchk_eviction_subconfigs, 4 },
 	{ "eviction_dirty_target", "int",
 	NULL, "min=10,max=99",
 	NULL, 0 },
@@ -432,13 +457,20 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open[] = {
 	NULL, NULL,
 	confchk_file_manager_subconfigs, 2 },
 	{ "hazard_max", "int", NULL, "min=15", NULL, 0 },
-	{ "log", "category", NULL, NULL, confchk_log_subconfigs, 7 },
+	{ "io_uring", "category",
+	NULL, NULL,
+	confchk_io_uring_subconfigs, 2 },
+	{ "log", "category", NULL, NULL, confchk_log_subconfigs, 8 },
 	{ "lsm_manager", "category",
 	NULL, NULL,
 	confchk_lsm_manager_subconfigs, 2 },
 	{ "lsm_merge", "boolean", NULL, NULL, NULL, 0 },
 	{ "mmap", "boolean", NULL, NULL, NULL, 0 },
 	{ "multiprocess", "boolean", NULL, NULL, NULL, 0 },
+	{ "read_ahead", "category",
+	NULL, NULL,
+	confchk_read_ahead_subconfigs, 2 },
+	{ "session_cursor_cache", "int", NULL, "min=0,max=1024", NULL, 0 },
 	{ "session_max", "int", NULL, "min=1", NULL, 0 },
 	{ "session_scratch_max", "int", NULL, NULL, NULL, 0 },
 	{ "shared_cache", "category",
@@ -467,13 +499,16 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open[] = {
 static const WT_CONFIG_CHECK confchk_wiredtiger_open_all[] = {
 	{ "async", "category",
 	NULL, NULL,
-	confchk_async_subconfigs, 3 },
+	confchk_async_subconfigs, 4 },
+	{ "block_cache", "category",
+	NULL, NULL,
+	confchk_block_cache_subconfigs, 1 },
 	{ "buffer_alignment", "int", NULL, "min=-1,max=1MB", NULL, 0 },
 	{ "cache_overhead", "int", NULL, "min=0,max=30", NULL, 0 },
 	{ "cache_size", "int", NULL, "min=1MB,max=10TB", NULL, 0 },
 	{ "checkpoint", "category",
 	NULL, NULL,
-	confchk_checkpoint_subconfigs, 3 },
+	confchk_checkpoint_subconfigs, 4 },
 	{ "checkpoint_sync", "boolean", NULL, NULL, NULL, 0 },
 	{ "config_base", "boolean", NULL, NULL, NULL, 0 },
 	{ "create", "boolean", NULL, NULL, NULL, 0 },
@@ -483,7 +518,7 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_all[] = {
 	{ "error_prefix", "string", NULL, NULL, NULL, 0 },
 	{ "eviction", "category",
 	NULL, NULL,
-	confchk_eviction_subconfigs, 2 },
+	confchk_eviction_subconfigs, 4 },
 	{ "eviction_dirty_target", "int",
 	NULL, "min=10,max=99",
 	NULL, 0 },
@@ -498,13 +533,20 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_all[] = {
 	NULL, NULL,
 	confchk_file_manager_subconfigs, 2 },
 	{ "hazard_max", "int", NULL, "min=15", NULL, 0 },
-	{ "log", "category", NULL, NULL, confchk_log_subconfigs, 7 },
+	{ "io_uring", "category",
+	NULL, NULL,
+	confchk_io_uring_subconfigs, 2 },
+	{ "log", "category", NULL, NULL, confchk_log_subconfigs, 8 },
 	{ "lsm_manager", "category",
 	NULL, NULL,
 	confchk_lsm_manager_subconfigs, 2 },
 	{ "lsm_merge", "boolean", NULL, NULL, NULL, 0 },
 	{ "mmap", "boolean", NULL, NULL, NULL, 0 },
 	{ "multiprocess", "boolean", NULL, NULL, NULL, 0 },
+	{ "read_ahead", "category",
+	NULL, NULL,
+	confchk_read_ahead_subconfigs, 2 },
+	{ "session_cursor_cache", "int", NULL, "min=0,max=1024", NULL, 0 },
 	{ "session_max", "int", NULL, "min=1", NULL, 0 },
 	{ "session_scratch_max", "int", NULL, NULL, NULL, 0 },
 	{ "shared_cache", "category",
@@ -534,13 +576,16 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_all[] = {
 static const WT_CONFIG_CHECK confchk_wiredtiger_open_basecfg[] = {
 	{ "async", "category",
 	NULL, NULL,
-	confchk_async_subconfigs, 3 },
+	confchk_async_subconfigs, 4 },
+	{ "block_cache", "category",
+	NULL, NULL,
+	confchk_block_cache_subconfigs, 1 },
 	{ "buffer_alignment", "int", NULL, "min=-1,max=1MB", NULL, 0 },
 	{ "cache_overhead", "int", NULL, "min=0,max=30", NULL, 0 },
 	{ "cache_size", "int", NULL, "min=1MB,max=10TB", NULL, 0 },
 	{ "checkpoint", "category",
 	NULL, NULL,
-	confchk_checkpoint_subconfigs, 3 },
+	confchk_checkpoint_subconfigs, 4 },
 	{ "checkpoint_sync", "boolean", NULL, NULL, NULL, 0 },
 	{ "direct_io", "list",
 	NULL, "choices=[\"checkpoint\",\"data\",\"log\"]",
@@ -548,7 +593,7 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_basecfg[] = {
 	{ "error_prefix", "string", NULL, NULL, NULL, 0 },
 	{ "eviction", "category",
 	NULL, NULL,
-	confchk_eviction_subconfigs, 2 },
+	confchk_eviction_subconfigs, 4 },
 	{ "eviction_dirty_target", "int",
 	NULL, "min=10,max=99",
 	NULL, 0 },
@@ -562,13 +607,20 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_basecfg[] = {
 	NULL, NULL,
 	confchk_file_manager_subconfigs, 2 },
 	{ "hazard_max", "int", NULL, "min=15", NULL, 0 },
-	{ "log", "category", NULL, NULL, confchk_log_subconfigs, 7 },
+	{ "io_uring", "category",
+	NULL, NULL,
+	confchk_io_uring_subconfigs, 2 },
+	{ "log", "category", NULL, NULL, confchk_log_subconfigs, 8 },
 	{ "lsm_manager", "category",
 	NULL, NULL,
 	confchk_lsm_manager_subconfigs, 2 },
 	{ "lsm_merge", "boolean", NULL, NULL, NULL, 0 },
 	{ "mmap", "boolean", NULL, NULL, NULL, 0 },
 	{ "multiprocess", "boolean", NULL, NULL, NULL, 0 },
+	{ "read_ahead", "category",
+	NULL, NULL,
+	confchk_read_ahead_subconfigs, 2 },
+	{ "session_cursor_cache", "int", NULL, "min=0,max=1024", NULL, 0 },
 	{ "session_max", "int", NULL, "min=1", NULL, 0 },
 	{ "session_scratch_max", "int", NULL, NULL, NULL, 0 },
 	{ "shared_cache", "category",
@@ -597,13 +649,16 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_basecfg[] = {
 static const WT_CONFIG_CHECK confchk_wiredtiger_open_usercfg[] = {
 	{ "async", "category",
 	NULL, NULL,
-	confchk_async_subconfigs, 3 },
+	confchk_async_subconfigs, 4 },
+	{ "block_cache", "category",
+	NULL, NULL,
+	confchk_block_cache_subconfigs, 1 },
 	{ "buffer_alignment", "int", NULL, "min=-1,max=1MB", NULL, 0 },
 	{ "cache_overhead", "int", NULL, "min=0,max=30", NULL, 0 },
 	{ "cache_size", "int", NULL, "min=1MB,max=10TB", NULL, 0 },
 	{ "checkpoint", "category",
 	NULL, NULL,
-	confchk_checkpoint_subconfigs, 3 },
+	confchk_checkpoint_subconfigs, 4 },
 	{ "checkpoint_sync", "boolean", NULL, NULL, NULL, 0 },
 	{ "direct_io", "list",
 	NULL, "choices=[\"checkpoint\",\"data\",\"log\"]",
@@ -611,7 +666,7 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_usercfg[] = {
 	{ "error_prefix", "string", NULL, NULL, NULL, 0 },
 	{ "eviction", "category",
 	NULL, NULL,
-	confchk_eviction_subconfigs, 2 },
+	confchk_eviction_subconfigs, 4 },
 	{ "eviction_dirty_target", "int",
 	NULL, "min=10,max=99",
 	NULL, 0 },
@@ -625,13 +680,20 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_usercfg[] = {
 	NULL, NULL,
 	confchk_file_manager_subconfigs, 2 },
 	{ "hazard_max", "int", NULL, "min=15", NULL, 0 },
-	{ "log", "category", NULL, NULL, confchk_log_subconfigs, 7 },
+	{ "io_uring", "category",
+	NULL, NULL,
+	confchk_io_uring_subconfigs, 2 },
+	{ "log", "category", NULL, NULL, confchk_log_subconfigs, 8 },
 	{ "lsm_manager", "category",
 	NULL, NULL,
 	confchk_lsm_manager_subconfigs, 2 },
 	{ "lsm_merge", "boolean", NULL, NULL, NULL, 0 },
 	{ "mmap", "boolean", NULL, NULL, NULL, 0 },
 	{ "multiprocess", "boolean", NULL, NULL, NULL, 0 },
+	{ "read_ahead", "category",
+	NULL, NULL,
+	confchk_read_ahead_subconfigs, 2 },
+	{ "session_cursor_cache", "int", NULL, "min=0,max=1024", NULL, 0 },
 	{ "session_max", "int", NULL, "min=1", NULL, 0 },
 	{ "session_scratch_max", "int", NULL, NULL, NULL, 0 },
 	{ "shared_cache", "category",
@@ -663,14 +725,15 @@ static const WT_CONFIG_ENTRY config_entries[] = {
 	{ "connection.add_compressor", "", NULL, 0},
 	{ "connection.add_data_source", "", NULL, 0 },
 	{ "connection.add_extractor", "", NULL, 0 },
+	{ "connection.async_batch", "append=0,overwrite=,raw=0,timeout=1200", confchk_connection_async_new_op, 4},
 	{ "connection.async_new_op", "append=0,overwrite=,raw=0,timeout=1200", confchk_connection_async_new_op, 4},
 	{ "connection.close", "leak_memory=0", confchk_connection_close, 1 },
 	{ "connection.load_extension", "config=,entry=wiredtiger_extension_init,terminate=wiredtiger_extension_terminate", confchk_connection_load_extension, 3 },
 	{ "connection.open_session", "isolation=read-committed", confchk_connection_open_session, 1},
 	
-	{ "connection.reconfigure", "async=(enabled=0,ops_max=1024,threads=2),cache_overhead=8,cache_size=100MB,checkpoint=(log_size=0,"
-	"name=\"WiredTigerCheckpoint\",wait=0),error_prefix=,"
-	"eviction=(threads_max=1,threads_min=1),eviction_dirty_target=80,"
+	{ "connection.reconfigure", "async=(enabled=0,ops_max=1024,threads=2,threads_max=20),cache_overhead=8,cache_size=100MB,checkpoint=(log_size=0,"
+	"name=\"WiredTigerCheckpoint\",threads=1,wait=0),error_prefix=,"
+	"eviction=(compress_threads=0,dirty_aware=0,threads_max=1,threads_min=1),eviction_dirty_target=80,"
 	"eviction_target=80,eviction_trigger=95,"
 	"file_manager=(close_idle_time=30,close_scan_interval=10),"
 	"lsm_manager=(merge=,worker_thread_max=4),lsm_merge=,"
@@ -735,78 +798,82 @@ static const WT_CONFIG_ENTRY config_entries[] = {
 	{ "table.meta","app_metadata=,colgroups=,collator=,columns=,key_format=u,value_format=u",confchk_table_meta, 6},
 	
 	{ "wiredtiger_open",
-	"async=(enabled=0,ops_max=1024,threads=2),buffer_alignment=-1,"
+	"async=(enabled=0,ops_max=1024,threads=2,threads_max=20),block_cache=(size=0),buffer_alignment=-1,"
 	"cache_overhead=8,cache_size=100MB,checkpoint=(log_size=0,"
-	"name=\"WiredTigerCheckpoint\",wait=0),checkpoint_sync=,"
+	"name=\"WiredTigerCheckpoint\",threads=1,wait=0),checkpoint_sync=,"
 	"config_base=,create=0,direct_io=,error_prefix=,"
-	"eviction=(threads_max=1,threads_min=1),eviction_dirty_target=80,"
+	"eviction=(compress_threads=0,dirty_aware=0,threads_max=1,threads_min=1),eviction_dirty_target=80,"
 	"eviction_target=80,eviction_trigger=95,exclusive=0,extensions=,"
 	"file_extend=,file_manager=(close_idle_time=30,"
-	"close_scan_interval=10),hazard_max=1000,log=(archive=,"
-	"compressor=,enabled=0,file_max=100MB,path=,prealloc=,recover=on)"
+	"close_scan_interval=10),hazard_max=1000,io_uring=(enabled=0,queue_depth=64),log=(archive=,"
+	"compressor=,enabled=0,file_max=100MB,path=,prealloc=,recover=on,"
+	"recover_threads=4)"
 	",lsm_manager=(merge=,worker_thread_max=4),lsm_merge=,mmap=,"
-	"multiprocess=0,session_max=100,session_scratch_max=2MB,"
+	"multiprocess=0,read_ahead=(depth=8,threads=0),session_cursor_cache=32,session_max=100,session_scratch_max=2MB,"
 	"shared_cache=(chunk=10MB,name=,reserve=0,size=500MB),"
 	"statistics=none,statistics_log=(on_close=0,"
 	"path=\"WiredTigerStat.%d.%H\",sources=,"
 	"timestamp=\"%b %d %H:%M:%S\",wait=0),transaction_sync=(enabled=0"
 	",method=fsync),use_environment_priv=0,verbose=",
-	confchk_wiredtiger_open, 32},
+	confchk_wiredtiger_open, 36},
 
 	{ "wiredtiger_open_all",
-	"async=(enabled=0,ops_max=1024,threads=2),buffer_alignment=-1,"
+	"async=(enabled=0,ops_max=1024,threads=2,threads_max=20),block_cache=(size=0),buffer_alignment=-1,"
 	"cache_overhead=8,cache_size=100MB,checkpoint=(log_size=0,"
-	"name=\"WiredTigerCheckpoint\",wait=0),checkpoint_sync=,"
+	"name=\"WiredTigerCheckpoint\",threads=1,wait=0),checkpoint_sync=,"
 	"config_base=,create=0,direct_io=,error_prefix=,"
-	"eviction=(threads_max=1,threads_min=1),eviction_dirty_target=80,"
+	"eviction=(compress_threads=0,dirty_aware=0,threads_max=1,threads_min=1),eviction_dirty_target=80,"
 	"eviction_target=80,eviction_trigger=95,exclusive=0,extensions=,"
 	"file_extend=,file_manager=(close_idle_time=30,"
-	"close_scan_interval=10),hazard_max=1000,log=(archive=,"
-	"compressor=,enabled=0,file_max=100MB,path=,prealloc=,recover=on)"
+	"close_scan_interval=10),hazard_max=1000,io_uring=(enabled=0,queue_depth=64),log=(archive=,"
+	"compressor=,enabled=0,file_max=100MB,path=,prealloc=,recover=on,"
+	"recover_threads=4)"
 	",lsm_manager=(merge=,worker_thread_max=4),lsm_merge=,mmap=,"
-	"multiprocess=0,session_max=100,session_scratch_max=2MB,"
+	"multiprocess=0,read_ahead=(depth=8,threads=0),session_cursor_cache=32,session_max=100,session_scratch_max=2MB,"
 	"shared_cache=(chunk=10MB,name=,reserve=0,size=500MB),"
 	"statistics=none,statistics_log=(on_close=0,"
 	"path=\"WiredTigerStat.%d.%H\",sources=,"
 	"timestamp=\"%b %d %H:%M:%S\",wait=0),transaction_sync=(enabled=0"
 	",method=fsync),use_environment_priv=0,verbose=,version=(major=0,"
-	"minor=0)",confchk_wiredtiger_open_all, 33},
+	"minor=0)",confchk_wiredtiger_open_all, 37},
 
 	{ "wiredtiger_open_basecfg",
-	"async=(enabled=0,ops_max=1024,threads=2),buffer_alignment=-1,"
+	"async=(enabled=0,ops_max=1024,threads=2,threads_max=20),block_cache=(size=0),buffer_alignment=-1,"
 	"cache_overhead=8,cache_size=100MB,checkpoint=(log_size=0,"
-	"name=\"WiredTigerCheckpoint\",wait=0),checkpoint_sync=,"
-	"direct_io=,error_prefix=,eviction=(threads_max=1,threads_min=1),"
+	"name=\"WiredTigerCheckpoint\",threads=1,wait=0),checkpoint_sync=,"
+	"direct_io=,error_prefix=,eviction=(compress_threads=0,dirty_aware=0,threads_max=1,threads_min=1),"
 	"eviction_dirty_target=80,eviction_target=80,eviction_trigger=95,"
 	"extensions=,file_extend=,file_manager=(close_idle_time=30,"
-	"close_scan_interval=10),hazard_max=1000,log=(archive=,"
-	"compressor=,enabled=0,file_max=100MB,path=,prealloc=,recover=on)"
+	"close_scan_interval=10),hazard_max=1000,io_uring=(enabled=0,queue_depth=64),log=(archive=,"
+	"compressor=,enabled=0,file_max=100MB,path=,prealloc=,recover=on,"
+	"recover_threads=4)"
 	",lsm_manager=(merge=,worker_thread_max=4),lsm_merge=,mmap=,"
-	"multiprocess=0,session_max=100,session_scratch_max=2MB,"
+	"multiprocess=0,read_ahead=(depth=8,threads=0),session_cursor_cache=32,session_max=100,session_scratch_max=2MB,"
 	"shared_cache=(chunk=10MB,name=,reserve=0,size=500MB),"
 	"statistics=none,statistics_log=(on_close=0,"
 	"path=\"WiredTigerStat.%d.%H\",sources=,"
 	"timestamp=\"%b %d %H:%M:%S\",wait=0),transaction_sync=(enabled=0"
 	",method=fsync),verbose=,version=(major=0,minor=0)",
-	confchk_wiredtiger_open_basecfg, 29},
+	confchk_wiredtiger_open_basecfg, 33},
 
 	{ "wiredtiger_open_usercfg",
-	"async=(enabled=0,ops_max=1024,threads=2),buffer_alignment=-1,"
+	"async=(enabled=0,ops_max=1024,threads=2,threads_max=20),block_cache=(size=0),buffer_alignment=-1,"
 	"cache_overhead=8,cache_size=100MB,checkpoint=(log_size=0,"
-	"name=\"WiredTigerCheckpoint\",wait=0),checkpoint_sync=,"
-	"direct_io=,error_prefix=,eviction=(threads_max=1,threads_min=1),"
+	"name=\"WiredTigerCheckpoint\",threads=1,wait=0),checkpoint_sync=,"
+	"direct_io=,error_prefix=,eviction=(compress_threads=0,dirty_aware=0,threads_max=1,threads_min=1),"
 	"eviction_dirty_target=80,eviction_target=80,eviction_trigger=95,"
 	"extensions=,file_extend=,file_manager=(close_idle_time=30,"
-	"close_scan_interval=10),hazard_max=1000,log=(archive=,"
-	"compressor=,enabled=0,file_max=100MB,path=,prealloc=,recover=on)"
+	"close_scan_interval=10),hazard_max=1000,io_uring=(enabled=0,queue_depth=64),log=(archive=,"
+	"compressor=,enabled=0,file_max=100MB,path=,prealloc=,recover=on,"
+	"recover_threads=4)"
 	",lsm_manager=(merge=,worker_thread_max=4),lsm_merge=,mmap=,"
-	"multiprocess=0,session_max=100,session_scratch_max=2MB,"
+	"multiprocess=0,read_ahead=(depth=8,threads=0),session_cursor_cache=32,session_max=100,session_scratch_max=2MB,"
 	"shared_cache=(chunk=10MB,name=,reserve=0,size=500MB),"
 	"statistics=none,statistics_log=(on_close=0,"
 	"path=\"WiredTigerStat.%d.%H\",sources=,"
 	"timestamp=\"%b %d %H:%M:%S\",wait=0),transaction_sync=(enabled=0"
 	",method=fsync),verbose=",
-	confchk_wiredtiger_open_usercfg, 28},
+	confchk_wiredtiger_open_usercfg, 32},
 
 	{ NULL, NULL, NULL, 0 }
 };
@@ -815,7 +882,7 @@ static const WT_CONFIG_ENTRY config_entries[] = {
 int __wt_conn_config_init(WT_SESSION_IMPL *session)
 {
 	WT_CONNECTION_IMPL *conn;
-	const WT_CONFIG_ENTRY *ep, **epp;
+	const WT_CONFIG_ENTRY **epp;
 
 	conn = S2C(session);
 
@@ -823,14 +890,8 @@ int __wt_conn_config_init(WT_SESSION_IMPL *session)
 	WT_RET(__wt_calloc_def(session, sizeof(config_entries) / sizeof(config_entries[0]), &epp));
 	conn->config_entries = epp;
 
-	/*进行配置项赋值*/
-	for (ep = config_entries;;) {
-		*epp++ = ep++;
-		if (ep->method == NULL)
-			break;
-	}
-
-	return 0;
+	/*预编译每个方法的默认配置，conn->config_entries指向预编译后的entry*/
+	return __wt_config_compile_init(session, config_entries, sizeof(config_entries) / sizeof(config_entries[0]));
 }
 
 /*废弃session对应的配置项*/
@@ -838,5 +899,6 @@ void __wt_conn_config_discard(WT_SESSION_IMPL *session)
 {
 	WT_CONNECTION_IMPL* conn;
 	conn = S2C(session);
+	__wt_config_compile_destroy(session);
 	__wt_free(session, conn->config_entries);
 }
@@ -558,6 +558,22 @@ int __wt_conn_remove_extractor(WT_SESSION_IMPL *session)
 	return (ret);
 }
 
+/*提交一批异步操作*/
+static int __conn_async_batch(WT_CONNECTION* wt_conn, const char* uri, const char* config,
+	WT_ASYNC_CALLBACK* callback, WT_ASYNC_BATCH_OP* ops, uint32_t nops)
+{
+	WT_CONNECTION_IMPL* conn;
+	WT_DECL_RET;
+	WT_SESSION_IMPL* session;
+
+	conn = (WT_CONNECTION_IMPL *)wt_conn;
+	CONNECTION_API_CALL(conn, session, async_batch, config, cfg);
+	WT_ERR(__wt_async_batch(session, uri, config, cfg, callback, ops, nops));
+
+err:
+	API_END_RET_NOTFOUND_MAP(session, ret);
+}
+
 /*发起一个异步flush数据库操作并等待数据库操作完成*/
 static int __conn_async_flush(WT_CONNECTION *wt_conn)
 {
@@ -611,6 +627,24 @@ err:
 	API_END_RET_NOTFOUND_MAP(session, ret);
 }
 
+/*
+ * 预编译method的配置字符串，返回的handle可以代替配置字符串反复传给这个方法，调用时不需要再检查和解析配置。
+ * handle在connection关闭前一直有效
+ */
+static int __conn_compile_configuration(WT_CONNECTION* wt_conn, const char* method, const char* config, const char** compiledp)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_DECL_RET;
+	WT_SESSION_IMPL *session;
+
+	conn = (WT_CONNECTION_IMPL *)wt_conn;
+	CONNECTION_API_CALL_NOCONF(conn, session, compile_configuration);
+
+	ret = __wt_config_compile_method(session, method, config, compiledp);
+err:
+	API_END_RET_NOTFOUND_MAP(session, ret);
+}
+
 static int __conn_is_new(WT_CONNECTION* wt_conn)
 {
 	return (((WT_CONNECTION_IMPL *)wt_conn)->is_new);
@@ -1244,12 +1278,14 @@ err:
 int __wiredtiger_open(const char *home, WT_EVENT_HANDLER *event_handler, const char *config, WT_CONNECTION **wt_connp)
 {
 	static const WT_CONNECTION stdc = {
+		__conn_async_batch,
 		__conn_async_flush,
 		__conn_async_new_op,
 		__conn_close,
 		__conn_reconfigure,
 		__conn_get_home,
 		__conn_configure_method,
+		__conn_compile_configuration,
 		__conn_is_new,
 		__conn_open_session,
 		__conn_load_extension,
@@ -1359,6 +1395,10 @@ int __wiredtiger_open(const char *home, WT_EVENT_HANDLER *event_handler, const c
 	WT_ERR(__wt_config_gets(session, cfg, "session_scratch_max", &cval));
 	conn->session_scratch_max = (size_t)cval.val;
 
+	/*每个session最多缓存多少个close的cursor，0表示不缓存*/
+	WT_ERR(__wt_config_gets(session, cfg, "session_cursor_cache", &cval));
+	conn->session_cursor_cache = (u_int)cval.val;
+
 	WT_ERR(__wt_config_gets(session, cfg, "checkpoint_sync", &cval));
 	if (cval.val)
 		F_SET(conn, WT_CONN_CKPT_SYNC);
@@ -30,6 +30,10 @@ static int __cache_config_local(WT_SESSION_IMPL* session, int shared, const char
 	WT_RET(__wt_config_gets(session, cfg, "eviction_dirty_target", &cval));
 	cache->eviction_dirty_target = (u_int)cval.val;
 
+	/*是否按照page的写入代价调整evict的优先级*/
+	WT_RET(__wt_config_gets(session, cfg, "eviction.dirty_aware", &cval));
+	cache->eviction_dirty_aware = cval.val != 0;
+
 	WT_RET(__wt_config_gets(session, cfg, "eviction.threads_max", &cval));
 	WT_ASSERT(session, cval.val > 0);
 	evict_workers_max = (uint32_t)cval.val - 1;
@@ -92,6 +96,8 @@ int __wt_cache_create(WT_SESSION_IMPL* session, const char* cfg[])
 	WT_CACHE *cache;
 	WT_CONNECTION_IMPL *conn;
 	WT_DECL_RET;
+	WT_EVICT_QUEUE *queue;
+	uint32_t i;
 
 	conn = S2C(session);
 
@@ -107,12 +113,21 @@ int __wt_cache_create(WT_SESSION_IMPL* session, const char* cfg[])
 	/*创建evict cond信号量*/
 	WT_ERR(__wt_cond_alloc(session, "cache eviction server", 0, &cache->evict_cond));
 	WT_ERR(__wt_cond_alloc(session, "eviction waiters", 0, &cache->evict_waiter_cond));
-	WT_ERR(__wt_spin_init(session, &cache->evict_lock, "cache eviction"));
-	WT_ERR(__wt_spin_init(session, &cache->evict_walk_lock, "cache walk"));
 
-	/* Allocate the LRU eviction queue. */
+	/*
+	 * Allocate the LRU eviction queues: one queue per eviction worker
+	 * thread, so workers don't serialize on a single queue lock.
+	 */
+	cache->evict_queue_count = WT_MIN(WT_MAX(conn->evict_workers_max, 1), WT_EVICT_QUEUE_MAX);
 	cache->evict_slots = WT_EVICT_WALK_BASE + WT_EVICT_WALK_INCR;
-	WT_ERR(__wt_calloc_def(session, cache->evict_slots, &cache->evict));
+	WT_ERR(__wt_calloc_def(session, cache->evict_queue_count, &cache->evict_queues));
+	for (i = 0; i < cache->evict_queue_count; i++){
+		queue = &cache->evict_queues[i];
+		WT_ERR(__wt_spin_init(session, &queue->evict_lock, "cache eviction"));
+		WT_ERR(__wt_spin_init(session, &queue->evict_walk_lock, "cache walk"));
+		WT_ERR(__wt_calloc_def(session, cache->evict_slots, &queue->evict_queue));
+		WT_ERR(__wt_calloc_def(session, cache->evict_slots, &queue->evict_sort));
+	}
 
 	/*初始化cache stat统计模块*/
 	__wt_cache_stats_update(session);
@@ -155,6 +170,8 @@ int __wt_cache_destroy(WT_SESSION_IMPL *session)
 	WT_CACHE *cache;
 	WT_CONNECTION_IMPL *conn;
 	WT_DECL_RET;
+	WT_EVICT_QUEUE *queue;
+	uint32_t i;
 
 	conn = S2C(session);
 	cache = conn->cache;
@@ -164,10 +181,17 @@ int __wt_cache_destroy(WT_SESSION_IMPL *session)
 
 	WT_TRET(__wt_cond_destroy(session, &cache->evict_cond));
 	WT_TRET(__wt_cond_destroy(session, &cache->evict_waiter_cond));
-	__wt_spin_destroy(session, &cache->evict_lock);
-	__wt_spin_destroy(session, &cache->evict_walk_lock);
 
-	__wt_free(session, cache->evict);
+	if (cache->evict_queues != NULL){
+		for (i = 0; i < cache->evict_queue_count; i++){
+			queue = &cache->evict_queues[i];
+			__wt_spin_destroy(session, &queue->evict_lock);
+			__wt_spin_destroy(session, &queue->evict_walk_lock);
+			__wt_free(session, queue->evict_queue);
+			__wt_free(session, queue->evict_sort);
+		}
+		__wt_free(session, cache->evict_queues);
+	}
 	__wt_free(session, conn->cache);
 	return ret;
 }
@@ -13,6 +13,10 @@ static int __ckpt_server_config(WT_SESSION_IMPL* session, const char** cfg, int
 
 	conn = S2C(session);
 
+	/*读取并行处理checkpoint文件的线程数, 手动调用的checkpoint也会使用*/
+	WT_RET(__wt_config_gets(session, cfg, "checkpoint.threads", &cval));
+	conn->ckpt_threads = (u_int)cval.val;
+
 	/*读取checkpoint的间隔时间*/
 	WT_RET(__wt_config_gets(session, cfg, "checkpoint.wait", &cval));
 	conn->ckpt_usecs = (uint64_t)cval.val * 1000000;
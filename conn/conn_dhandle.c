@@ -108,6 +108,55 @@ int __wt_conn_dhandle_find(WT_SESSION_IMPL* session, const char* name, const cha
 	return WT_NOTFOUND;
 }
 
+/*
+ * 不持有dhandle_lock查找name和ckpt对应的dhandle，找到后增加它的session_ref并设置到session中。
+ * hash queue的遍历由split generation保护，从hash queue中删除的dhandle在所有遍历它的线程退出之前不会被释放
+ */
+int __wt_conn_dhandle_lookup(WT_SESSION_IMPL* session, const char* name, const char* ckpt)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_DATA_HANDLE *dhandle;
+	WT_DECL_RET;
+	uint64_t bucket, hash;
+
+	conn = S2C(session);
+	ret = WT_NOTFOUND;
+
+	hash = __wt_hash_city64(name, strlen(name));
+	bucket = hash % WT_HASH_ARRAY_SIZE;
+
+	WT_ENTER_PAGE_INDEX(session);
+	/*
+	 * WT_ENTER_PAGE_INDEX发布split_gen只有写屏障，后面对hash queue的读可能被提前到发布之前，
+	 * 这时删除dhandle的线程可能看不到我们的split_gen就释放了dhandle，这里需要一个完整的屏障
+	 */
+	WT_FULL_BARRIER();
+	/*插入时dhandle先初始化再用WT_PUBLISH挂到bucket的头上，读到的dhandle都是完整的*/
+	for (dhandle = SLIST_FIRST(&conn->dhhash[bucket]); dhandle != NULL; dhandle = SLIST_NEXT(dhandle, hashl)){
+		if (dhandle->name_hash != hash || strcmp(name, dhandle->name) != 0)
+			continue;
+		if (!((ckpt == NULL && dhandle->checkpoint == NULL) ||
+			(ckpt != NULL && dhandle->checkpoint != NULL && strcmp(ckpt, dhandle->checkpoint) == 0)))
+			continue;
+
+		/*
+		 * 先增加session_ref再检查removing，__conn_dhandle_remove是先设置removing再检查session_ref，
+		 * 两边至少有一边能看到对方的修改。dhandle正在被删除时由调用者持有dhandle_lock重新查找
+		 */
+		(void)WT_ATOMIC_ADD4(dhandle->session_ref, 1);
+		if (dhandle->removing)
+			(void)WT_ATOMIC_SUB4(dhandle->session_ref, 1);
+		else {
+			session->dhandle = dhandle;
+			ret = 0;
+		}
+		break;
+	}
+	WT_LEAVE_PAGE_INDEX(session);
+
+	return ret;
+}
+
 /*根据name和checkpoint name获得dhandle,并获得对应的lock*/
 static __conn_dhandle_get(WT_SESSION_IMPL *session, const char *name, const char *ckpt, uint32_t flags)
 {
@@ -311,6 +360,7 @@ static int __conn_btree_open(WT_SESSION_IMPL* session, const char* cfg[], uint32
 	do{
 		WT_ERR(__wt_btree_open(session, cfg));
 		F_SET(dhandle, WT_DHANDLE_OPEN);
+		++dhandle->open_gen;
 
 		if (dhandle->checkpoint == NULL)
 			++S2C(session)->open_btree_count;
@@ -401,7 +451,7 @@ int __wt_conn_btree_apply(WT_SESSION_IMPL* session, int apply_checkpoints, const
 				WT_RET(__conn_btree_apply_internal(session, dhandle, func, cfg));
 	}
 	else{ /*没有指定uri,那么将所有的dhandle的btree都执行一次func,meta file btree除外*/
-		SLIST_FOREACH(dhandle, &conn->dhlh, l)
+		TAILQ_FOREACH(dhandle, &conn->dhlh, l)
 			if (F_ISSET(dhandle, WT_DHANDLE_OPEN) &&
 				(apply_checkpoints || dhandle->checkpoint == NULL) &&
 				WT_PREFIX_MATCH(dhandle->name, "file:") && !WT_IS_METADATA(dhandle))
@@ -550,6 +600,16 @@ static int __conn_dhandle_remove(WT_SESSION_IMPL* session, int final)
 	if (!final && (dhandle->session_inuse != 0 || dhandle->session_ref != 0))
 		return (EBUSY);
 
+	/*__wt_conn_dhandle_lookup不持有dhandle_lock，设置removing后再确认一次没有session引用这个dhandle*/
+	if (!final){
+		dhandle->removing = 1;
+		WT_FULL_BARRIER();
+		if (dhandle->session_inuse != 0 || dhandle->session_ref != 0){
+			dhandle->removing = 0;
+			return (EBUSY);
+		}
+	}
+
 	WT_CONN_DHANDLE_REMOVE(conn, dhandle, bucket);
 	return 0;
 }
@@ -588,12 +648,22 @@ int __wt_conn_dhandle_discard_single(WT_SESSION_IMPL *session, int final)
 
 	if (ret == 0 || final) {
 		WT_TRET(__wt_rwlock_destroy(session, &dhandle->rwlock));
-		__wt_free(session, dhandle->name);
-		__wt_free(session, dhandle->checkpoint);
 		__conn_btree_config_clear(session);
 		__wt_free(session, dhandle->handle);
 		__wt_spin_destroy(session, &dhandle->close_lock);
-		__wt_overwrite_and_free(session, dhandle);
+
+		/*name、checkpoint和dhandle本身可能还在被无锁查找的线程读取，等这些线程退出后再释放*/
+		if (final) {
+			__wt_free(session, dhandle->name);
+			__wt_free(session, dhandle->checkpoint);
+			__wt_overwrite_and_free(session, dhandle);
+		}
+		else {
+			if (dhandle->checkpoint != NULL)
+				WT_TRET(__wt_split_safe_free_deferred(session, (void *)dhandle->checkpoint, strlen(dhandle->checkpoint) + 1));
+			WT_TRET(__wt_split_safe_free_deferred(session, (void *)dhandle->name, strlen(dhandle->name) + 1));
+			WT_TRET(__wt_split_safe_free_deferred(session, dhandle, sizeof(WT_DATA_HANDLE)));
+		}
 
 		session->dhandle = NULL;
 	}
@@ -611,7 +681,7 @@ int __wt_conn_dhandle_discard(WT_SESSION_IMPL* session)
 	conn = S2C(session);
 
 restart:
-	SLIST_FOREACH(dhandle, &conn->dhlh, l) {
+	TAILQ_FOREACH(dhandle, &conn->dhlh, l) {
 		if (WT_IS_METADATA(dhandle))
 			continue;
 
@@ -622,7 +692,7 @@ restart:
 	__wt_session_close_cache(session);
 	F_SET(session, WT_SESSION_NO_DATA_HANDLES);
 
-	while (dhandle = SLIST_FIRST(&conn->dhlh) != NULL){
+	while ((dhandle = TAILQ_FIRST(&conn->dhlh)) != NULL){
 		WT_WITH_DHANDLE(session, dhandle, WT_TRET(__wt_conn_dhandle_discard_single(session, 1)));
 	}
 
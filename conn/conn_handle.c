@@ -11,9 +11,11 @@ int __wt_connection_init(WT_CONNECTION_IMPL* conn)
 	for (i = 0; i < WT_HASH_ARRAY_SIZE; i++) {
 		SLIST_INIT(&conn->dhhash[i]);	/* Data handle hash lists */
 		SLIST_INIT(&conn->fhhash[i]);	/* File handle hash lists */
+		SLIST_INIT(&conn->config_compiled_hash[i]);	/* Compiled configuration hash lists */
+		SLIST_INIT(&conn->config_compiled_strhash[i]);
 	}
 
-	SLIST_INIT(&conn->dhlh);		/* Data handle list */
+	TAILQ_INIT(&conn->dhlh);		/* Data handle list */
 	TAILQ_INIT(&conn->dlhqh);		/* Library list */
 	TAILQ_INIT(&conn->dsrcqh);		/* Data source list */
 	SLIST_INIT(&conn->fhlh);		/* File list */
@@ -33,6 +35,8 @@ int __wt_connection_init(WT_CONNECTION_IMPL* conn)
 
 	/* Statistics. */
 	__wt_stat_init_connection_stats(&conn->stats);
+	WT_RET(__wt_calloc(session, WT_STAT_CONN_SLOTS + 1, sizeof(WT_CONNECTION_STATS_SLOT), &conn->stat_slots_mem));
+	conn->stat_slots = (WT_CONNECTION_STATS_SLOT *)WT_ALIGN((uintptr_t)conn->stat_slots_mem, WT_CACHE_LINE_ALIGNMENT);
 
 	/* Locks. */
 	WT_RET(__wt_spin_init(session, &conn->api_lock, "api"));
@@ -125,6 +129,11 @@ int __wt_connection_destroy(WT_CONNECTION_IMPL *conn)
 	__wt_free(session, conn->error_prefix);
 	__wt_free(session, conn->sessions);
 
+	/*统计槽必须最后释放，前面的__wt_free都会通过WT_STAT_FAST_CONN_INCR写统计槽*/
+	conn->stat_flags = 0;
+	conn->stat_slots = NULL;
+	__wt_free(NULL, conn->stat_slots_mem);
+
 	__wt_free(NULL, conn);
 	return ret;
 }
@@ -53,6 +53,10 @@ static int __logmgr_config(WT_SESSION_IMPL* session, const char** cfg, int* runp
 	WT_RET(__wt_config_gets(session, cfg, "log.path", &cval));
 	WT_RET(__wt_strndup(session, cval.str, cval.len, &conn->log_path));
 
+	/*读取日志推演的并行线程数*/
+	WT_RET(__wt_config_gets(session, cfg, "log.recover_threads", &cval));
+	conn->log_recover_threads = (u_int)cval.val;
+
 	if (*runp == 0)
 		return (0);
 
@@ -265,6 +269,9 @@ static WT_THREAD_RET __log_close_server(void* arg)
 				locked = 0;
 
 				__wt_spin_unlock(session, &log->log_sync_lock);
+				/*flush thread可能在等待这个文件的sync完成*/
+				if (conn->log_flush_cond != NULL)
+					WT_ERR(__wt_cond_signal(session, conn->log_flush_cond));
 		}
 		else{
 			/*等待下一次文件的close cond*/
@@ -282,89 +289,26 @@ err:
 	return WT_THREAD_RET_VALUE;
 }
 
-typedef struct {
-	WT_LSN		lsn;
-	uint32_t	slot_index;
-} WT_LOG_WRLSN_ENTRY;
-
-/*WT_LOG_WRLSN_ENTRY的比较器函数,其实他们的lsn的比较，为了保证lsn顺序所写的*/
-static int WT_CDECL __log_wrlsn_cmp(const void *a, const void *b)
-{
-	WT_LOG_WRLSN_ENTRY *ae, *be;
-
-	ae = (WT_LOG_WRLSN_ENTRY *)a;
-	be = (WT_LOG_WRLSN_ENTRY *)b;
-	return LOG_CMP(&ae->lsn, &be->lsn);
-}
-
 /*只是处理SLOT_BUFFERED且不主动的fsync的模式*/
 static WT_THREAD_RET __log_wrlsn_server(void* arg)
 {
 	WT_CONNECTION_IMPL *conn;
 	WT_DECL_RET;
-	WT_LOG*				log;
-	WT_LOG_WRLSN_ENTRY	written[SLOT_POOL];
-	WT_LOGSLOT*			slot;
 	WT_SESSION_IMPL*	session;
-	size_t				written_i;
-	uint32_t			i, save_i;
+	uint32_t			advanced;
 	int					yield;
 
 	session = (WT_SESSION_IMPL*)arg;
 	conn = S2C(session);
-	log = conn->log;
 	yield = 0;
 
 	while(F_ISSET(conn, WT_CONN_LOG_SERVER_RUN)){
+		/*按照LSN的顺序推进write_lsn,并释放已经写入的slot*/
+		WT_ERR(__wt_log_wrlsn(session, &advanced));
 
-		i = 0;
-		written_i = 0;
-
-		/*这里不需要对slot pool进行多线程保护，因为slot pool是个静态的数组*/
-		while(i < SLOT_POOL){
-			save_i = i;
-			slot = &log->slot_pool[i++];
-			if (slot->slot_state != WT_LOG_SLOT_WRITTEN) /*过滤掉非WRITTEN状态*/
-				continue;
-
-			written[written_i].slot_index = save_i;
-			written[written_i++].lsn = slot->slot_release_lsn;
-		}
-
-		if (written_i > 0) {
-			/*触发一次，表示后续可能很多这样的操作，所以讲yield进行操作*/
+		/*触发一次，表示后续可能很多这样的操作，所以讲yield进行操作*/
+		if (advanced > 0)
 			yield = 0;
-			/*按LSN由小到大排序,因为要按slot进行数据刷盘*/
-			qsort(written, written_i, sizeof(WT_LOG_WRLSN_ENTRY), __log_wrlsn_cmp);
-			/*
-			 * We know the written array is sorted by LSN.  Go
-			 * through them either advancing write_lsn or stop
-			 * as soon as one is not in order.
-			 */
-			for (i = 0; i < written_i; i++) {
-				if (LOG_CMP(&log->write_lsn, &written[i].lsn) != 0)
-					break;
-				/*
-				 * If we get here we have a slot to process.
-				 * Advance the LSN and process the slot.
-				 */
-				slot = &log->slot_pool[written[i].slot_index];
-				WT_ASSERT(session, LOG_CMP(&written[i].lsn, &slot->slot_release_lsn) == 0);
-				/*更新WRITE LSN*/
-				log->write_lsn = slot->slot_end_lsn;
-				WT_ERR(__wt_cond_signal(session,log->log_write_cond));
-
-				WT_STAT_FAST_CONN_INCR(session, log_write_lsn);
-
-				/*
-				 * Signal the close thread if needed.尝试把file page cache的数据sync到磁盘上
-				 */
-				if (F_ISSET(slot, SLOT_CLOSEFH))
-					WT_ERR(__wt_cond_signal(session, conn->log_close_cond));
-
-				WT_ERR(__wt_log_slot_free(session, slot));
-			}
-		}
 
 		if (yield++ < 1000)
 			__wt_yield();
@@ -381,6 +325,94 @@ err:
 	return WT_THREAD_RET_VALUE;
 }
 
+/*
+ * 将write_lsn之前所有已经写入OS的日志数据一次fsync到磁盘上。提交线程只提交sync请求，
+ * 由flush thread统一做fsync，同一时间窗口内的N个sync请求只需要一次fsync。
+ * 如果write_lsn对应的文件不是正在写的文件，或者前一个日志文件还没有被close server
+ * sync，不能只fsync当前的文件，等待close server完成后再做。*waitp返回是否需要等待
+ */
+static int __log_flush_once(WT_SESSION_IMPL* session, int* waitp)
+{
+	WT_DECL_RET;
+	WT_LOG *log;
+	WT_LSN dir_req_lsn, req_lsn, sync_lsn;
+
+	log = S2C(session)->log;
+	*waitp = 1;
+
+	__wt_spin_lock(session, &log->log_flush_lock);
+	req_lsn = log->sync_req_lsn;
+	dir_req_lsn = log->sync_dir_req_lsn;
+	__wt_spin_unlock(session, &log->log_flush_lock);
+
+	/*没有需要处理的sync请求*/
+	if (LOG_CMP(&log->sync_lsn, &req_lsn) >= 0 && log->sync_dir_lsn.file >= dir_req_lsn.file)
+		return 0;
+
+	__wt_spin_lock(session, &log->log_sync_lock);
+	sync_lsn = log->write_lsn;
+	if (log->sync_lsn.file < sync_lsn.file || log->fileid != sync_lsn.file)
+		goto done;
+
+	/*先刷新log dir path索引文件*/
+	if (log->sync_dir_lsn.file < dir_req_lsn.file) {
+		WT_ASSERT(session, log->log_dir_fh != NULL);
+		WT_ERR(__wt_verbose(session, WT_VERB_LOG, "log_flush: sync directory %s", log->log_dir_fh->name));
+		WT_ERR(__wt_directory_sync_fh(session, log->log_dir_fh));
+		log->sync_dir_lsn = dir_req_lsn;
+		WT_STAT_FAST_CONN_INCR(session, log_sync_dir);
+	}
+
+	/*在刷新日志文件，一次fsync覆盖write_lsn之前所有的sync请求*/
+	if (LOG_CMP(&log->sync_lsn, &req_lsn) < 0 && LOG_CMP(&log->sync_lsn, &sync_lsn) < 0) {
+		WT_ERR(__wt_verbose(session, WT_VERB_LOG, "log_flush: sync log %s", log->log_fh->name));
+		WT_STAT_FAST_CONN_INCR(session, log_sync);
+		WT_ERR(__wt_fsync(session, log->log_fh));
+		log->sync_lsn = sync_lsn;
+	}
+
+	*waitp = 0;
+	WT_ERR(__wt_cond_signal(session, log->log_sync_cond));
+
+done:
+err:
+	__wt_spin_unlock(session, &log->log_sync_lock);
+	return ret;
+}
+
+/*log flush thread,处理提交线程提交的sync请求，对日志文件做group fsync*/
+static WT_THREAD_RET __log_flush_server(void* arg)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_DECL_RET;
+	WT_SESSION_IMPL *session;
+	int wait;
+
+	session = (WT_SESSION_IMPL*)arg;
+	conn = S2C(session);
+
+	while(F_ISSET(conn, WT_CONN_LOG_SERVER_RUN)){
+		WT_ERR(__log_flush_once(session, &wait));
+
+		/*等待下一个sync请求或者close server完成前一个文件的sync*/
+		if (wait)
+			WT_ERR(__wt_cond_wait(session, conn->log_flush_cond, 10000));
+	}
+
+	return WT_THREAD_RET_VALUE;
+
+err:
+	/*
+	 * 把错误交给正在等待的提交线程并唤醒它们，之后的sync请求不再提交给flush thread，
+	 * 由提交线程自己做fsync
+	 */
+	WT_PUBLISH(conn->log->flush_ret, ret);
+	(void)__wt_cond_signal(session, conn->log->log_sync_cond);
+	__wt_err(session, ret, "log flush server error");
+
+	return WT_THREAD_RET_VALUE;
+}
+
 /*一个专门删除已经建立checkpoint的日志文件，一般1000触发一次*/
 static WT_THREAD_RET __log_server(void* arg)
 {
@@ -449,6 +481,8 @@ int __wt_logmgr_create(WT_SESSION_IMPL *session, const char *cfg[])
 	WT_RET(__wt_spin_init(session, &log->log_lock, "log"));
 	WT_RET(__wt_spin_init(session, &log->log_slot_lock, "log slot"));
 	WT_RET(__wt_spin_init(session, &log->log_sync_lock, "log sync"));
+	WT_RET(__wt_spin_init(session, &log->log_wrlsn_lock, "log write lsn"));
+	WT_RET(__wt_spin_init(session, &log->log_flush_lock, "log flush"));
 	WT_RET(__wt_rwlock_alloc(session, &log->log_archive_lock, "log archive lock"));
 	/*设置日志记录数据的对齐长度*/
 	if (FLD_ISSET(conn->direct_io, WT_FILE_TYPE_LOG))
@@ -463,6 +497,8 @@ int __wt_logmgr_create(WT_SESSION_IMPL *session, const char *cfg[])
 	WT_INIT_LSN(&log->sync_lsn);
 
 	WT_ZERO_LSN(&log->sync_dir_lsn);
+	WT_ZERO_LSN(&log->sync_req_lsn);
+	WT_ZERO_LSN(&log->sync_dir_req_lsn);
 	WT_INIT_LSN(&log->trunc_lsn);
 	WT_INIT_LSN(&log->write_lsn);
 
@@ -497,6 +533,12 @@ int __wt_logmgr_open(WT_SESSION_IMPL *session)
 	WT_RET(__wt_thread_create(conn->log_wrlsn_session, &conn->log_wrlsn_tid, __log_wrlsn_server, conn->log_wrlsn_session));
 	conn->log_wrlsn_tid_set = 1;
 
+	/*创建一个flush的session,并启动一个flush thread做group fsync*/
+	WT_RET(__wt_open_internal_session(conn, "log-flush-server", 0, 0, &conn->log_flush_session));
+	WT_RET(__wt_cond_alloc(conn->log_flush_session, "log flush server", 0, &conn->log_flush_cond));
+	WT_RET(__wt_thread_create(conn->log_flush_session, &conn->log_flush_tid, __log_flush_server, conn->log_flush_session));
+	conn->log_flush_tid_set = 1;
+
 	/*如果日志没有配置归档和预分配，则直接返回*/
 	if(!FLD_ISSET(conn->log_flags, WT_CONN_LOG_ARCHIVE | WT_CONN_LOG_PREALLOC))
 		return 0;
@@ -554,6 +596,19 @@ int __wt_logmgr_destroy(WT_SESSION_IMPL *session)
 		conn->log_close_session = NULL;
 	}
 
+	if (conn->log_flush_tid_set) {
+		WT_TRET(__wt_cond_signal(session, conn->log_flush_cond));
+		WT_TRET(__wt_thread_join(session, conn->log_flush_tid));
+		conn->log_flush_tid_set = 0;
+	}
+	WT_TRET(__wt_cond_destroy(session, &conn->log_flush_cond));
+
+	if (conn->log_flush_session != NULL) {
+		wt_session = &conn->log_flush_session->iface;
+		WT_TRET(wt_session->close(wt_session, NULL));
+		conn->log_flush_session = NULL;
+	}
+
 	if (conn->log_wrlsn_tid_set) {
 		WT_TRET(__wt_cond_signal(session, conn->log_wrlsn_cond));
 		WT_TRET(__wt_thread_join(session, conn->log_wrlsn_tid));
@@ -582,6 +637,8 @@ int __wt_logmgr_destroy(WT_SESSION_IMPL *session)
 	__wt_spin_destroy(session, &conn->log->log_lock);
 	__wt_spin_destroy(session, &conn->log->log_slot_lock);
 	__wt_spin_destroy(session, &conn->log->log_sync_lock);
+	__wt_spin_destroy(session, &conn->log->log_wrlsn_lock);
+	__wt_spin_destroy(session, &conn->log->log_flush_lock);
 	__wt_free(session, conn->log_path);
 	__wt_free(session, conn->log);
 
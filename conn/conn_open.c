@@ -30,6 +30,9 @@ int __wt_connection_open(WT_CONNECTION_IMPL *conn, const char *cfg[])
 	/* Create the cache. */
 	WT_RET(__wt_cache_create(session, cfg));
 
+	/* Create the optional block cache for evicted clean pages. */
+	WT_RET(__wt_blkcache_create(session, cfg));
+
 	/* Initialize transaction support. */
 	WT_RET(__wt_txn_global_init(session, cfg));
 
@@ -79,6 +82,7 @@ int __wt_connection_close(WT_CONNECTION_IMPL *conn)
 	F_CLR(conn, WT_CONN_SERVER_RUN);
 	WT_TRET(__wt_async_destroy(session));
 	WT_TRET(__wt_lsm_manager_destroy(session));
+	WT_TRET(__wt_readahead_destroy(session));
 
 	F_SET(conn, WT_CONN_CLOSING);
 
@@ -114,12 +118,21 @@ int __wt_connection_close(WT_CONNECTION_IMPL *conn)
 	/* Shut down the eviction server thread. */
 	WT_TRET(__wt_evict_destroy(session));
 
+	/*所有的reconcile都已经结束，停止split block的压缩线程*/
+	WT_TRET(__wt_bt_compress_destroy(session));
+
+	/*所有的文件和日志都已经关闭，没有在途的I/O，释放io_uring*/
+	WT_TRET(__wt_aio_destroy(session));
+
 	/* Disconnect from shared cache - must be before cache destroy. */
 	WT_TRET(__wt_conn_cache_pool_destroy(session));
 
 	/* Discard the cache. */
 	WT_TRET(__wt_cache_destroy(session));
 
+	/*所有的block都已经关闭，释放block cache*/
+	WT_TRET(__wt_blkcache_destroy(session));
+
 	/* Discard transaction state. */
 	__wt_txn_global_destroy(session);
 
@@ -176,11 +189,20 @@ int __wt_connection_close(WT_CONNECTION_IMPL *conn)
 /*启动conecton和对应的service thread*/
 int __wt_connection_workers(WT_SESSION_IMPL *session, const char *cfg[])
 {
-/*
+	/* Start the optional io_uring ring before the threads that read and write files. */
+	WT_RET(__wt_aio_create(session, cfg));
+
+	/*
 	 * Start the eviction thread.
 	 */
 	WT_RET(__wt_evict_create(session));
 
+	/* Start the optional block compression threads used by reconciliation. */
+	WT_RET(__wt_bt_compress_create(session, cfg));
+
+	/* Start the optional read-ahead threads used by cursor scans. */
+	WT_RET(__wt_readahead_create(session, cfg));
+
 	/*
 	 * Start the handle sweep thread.
 	 */
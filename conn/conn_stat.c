@@ -27,11 +27,40 @@ static void __stat_sources_free(WT_SESSION_IMPL* session, char*** sources)
 /*初始化session的统计模块，主要是async统计模块、cache统计模块和事务统计模块*/
 void __wt_conn_stat_init(WT_SESSION_IMPL* session)
 {
-	_wt_async_stats_update(session);
+	__wt_async_stats_update(session);
 	__wt_cache_stats_update(session);
 	__wt_txn_stats_update(session);
 }
 
+/*把所有session分片中的统计值累加到stats中*/
+void __wt_conn_stat_slots_sum(WT_SESSION_IMPL* session, WT_CONNECTION_STATS* stats)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_STATS *from, *to;
+	size_t i, max;
+	u_int slot;
+
+	conn = S2C(session);
+	max = sizeof(WT_CONNECTION_STATS) / sizeof(WT_STATS);
+
+	for (slot = 0; slot < WT_STAT_CONN_SLOTS; slot++){
+		from = (WT_STATS *)&conn->stat_slots[slot].stats;
+		for (i = 0, to = (WT_STATS *)stats; i < max; i++)
+			to[i].v += from[i].v;
+	}
+}
+
+/*清除所有session分片中的统计值，和__wt_stat_refresh_connection_stats清除的统计项一致*/
+void __wt_conn_stat_slots_clear(WT_SESSION_IMPL* session)
+{
+	WT_CONNECTION_IMPL *conn;
+	u_int slot;
+
+	conn = S2C(session);
+	for (slot = 0; slot < WT_STAT_CONN_SLOTS; slot++)
+		__wt_stat_refresh_connection_stats(&conn->stat_slots[slot].stats);
+}
+
 static int __statlog_config(WT_SESSION_IMPL* session, const char** cfg, int* runp)
 {
 	WT_CONFIG objectconf;
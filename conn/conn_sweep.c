@@ -1,123 +1,156 @@
 
 #include "wt_internal.h"
 
-/*将connect list中的处于关闭状态的dhandle删除*/
-static int __sweep_remove_handles(WT_SESSION_IMPL* session)
+/*每轮sweep最多检查的dhandle个数，没有检查到的bucket留到下一轮*/
+#define	WT_SWEEP_HANDLES_MAX	1000
+/*一遍还没有扫描完所有的bucket时，下一轮sweep前等待的时间(微秒)*/
+#define	WT_SWEEP_BATCH_WAIT		100000
+
+/*将从start开始的count个hash bucket中处于关闭状态的dhandle删除，调用者持有dhandle_lock*/
+static int __sweep_remove_handles(WT_SESSION_IMPL* session, u_int start, u_int count)
 {
 	WT_CONNECTION_IMPL *conn;
 	WT_DATA_HANDLE *dhandle, *dhandle_next;
 	WT_DECL_RET;
+	u_int i;
 
 	conn = S2C(session);
-	dhandle = SLIST_FIRST(&conn->dhlh);
-
-	for (; dhandle != NULL; dhandle = dhandle_next){
-		dhandle_next = SLIST_NEXT(dhandle, l);
-		/*元数据的dhandle不做删除*/
-		if (WT_IS_METADATA(dhandle))
-			continue;
-		/*打开状态的dhandle不做删除*/
-		if (F_ISSET(dhandle, WT_DHANDLE_OPEN))
-			continue;
-		/* Make sure we get exclusive access. */
-		if ((ret = __wt_try_writelock(session, dhandle->rwlock)) == EBUSY)
-			continue;
-		WT_RET(ret);
 
-		/*正在被引用的dhandle不做删除，有可能其他的地方正在销毁它*/
-		if (F_ISSET(dhandle, WT_DHANDLE_OPEN) || dhandle->session_inuse != 0 || dhandle->session_ref != 0){
-			WT_RET(__wt_writeunlock(session, dhandle->rwlock));
-			continue;
+	for (i = 0; i < count; i++){
+		dhandle = SLIST_FIRST(&conn->dhhash[(start + i) % WT_HASH_ARRAY_SIZE]);
+		for (; dhandle != NULL; dhandle = dhandle_next){
+			dhandle_next = SLIST_NEXT(dhandle, hashl);
+			/*元数据的dhandle不做删除*/
+			if (WT_IS_METADATA(dhandle))
+				continue;
+			/*打开状态的dhandle不做删除*/
+			if (F_ISSET(dhandle, WT_DHANDLE_OPEN))
+				continue;
+			/* Make sure we get exclusive access. */
+			if ((ret = __wt_try_writelock(session, dhandle->rwlock)) == EBUSY)
+				continue;
+			WT_RET(ret);
+
+			/*正在被引用的dhandle不做删除，有可能其他的地方正在销毁它*/
+			if (F_ISSET(dhandle, WT_DHANDLE_OPEN) || dhandle->session_inuse != 0 || dhandle->session_ref != 0){
+				WT_RET(__wt_writeunlock(session, dhandle->rwlock));
+				continue;
+			}
+
+			/*销毁dhandle,并从connection list中删除*/
+			WT_WITH_DHANDLE(session, dhandle, ret = __wt_conn_dhandle_discard_single(session, 0));
+			/* If the handle was not successfully discarded, unlock it. */
+			if (ret != 0)
+				WT_TRET(__wt_writeunlock(session, dhandle->rwlock));
+			WT_RET_BUSY_OK(ret);
+			WT_STAT_FAST_CONN_INCR(session, dh_conn_ref);
 		}
-
-		/*销毁dhandle,并从connection list中删除*/
-		WT_WITH_DHANDLE(session, dhandle, ret = __wt_conn_dhandle_discard_single(session, 0));
-		/* If the handle was not successfully discarded, unlock it. */
-		if (ret != 0)
-			WT_TRET(__wt_writeunlock(session, dhandle->rwlock));
-		WT_RET_BUSY_OK(ret);
-		WT_STAT_FAST_CONN_INCR(session, dh_conn_ref);
 	}
 
 	return (ret == EBUSY ? 0 : ret);
 }
 
-/*从session对应的connection中关闭不在使用的dhandle*/
-static int __sweep(WT_SESSION_IMPL* session)
+/*检查一个dhandle，关闭空闲时间超过sweep_idle_time的btree，closedp累加可以从connection中删除的dhandle个数*/
+static int __sweep_handle(WT_SESSION_IMPL* session, WT_DATA_HANDLE* dhandle, time_t now, u_int* closedp)
 {
 	WT_BTREE *btree;
+	WT_CONNECTION_IMPL *conn;
+	WT_DECL_RET;
+
+	conn = S2C(session);
+
+	/*不关闭元数据的dhandle*/
+	if (WT_IS_METADATA(dhandle))
+		return 0;
+
+	/*dhandle已经关闭了*/
+	if (!F_ISSET(dhandle, WT_DHANDLE_OPEN) && dhandle->session_inuse == 0 && dhandle->session_ref == 0) {
+		++*closedp;
+		return 0;
+	}
+
+	/*延迟关闭的时间还未到，dhandle不做关闭*/
+	if (dhandle->session_inuse != 0 || now <= dhandle->timeofdeath + conn->sweep_idle_time)
+		return 0;
+
+	if (dhandle->timeofdeath == 0) {
+		dhandle->timeofdeath = now;
+		WT_STAT_FAST_CONN_INCR(session, dh_conn_tod);
+		return 0;
+	}
+	/*
+	* We have a candidate for closing; if it's open, acquire an
+	* exclusive lock on the handle and close it.
+	*
+	* The close would require I/O if an update cannot be written
+	* (updates in a no-longer-referenced file might not yet be
+	* globally visible if sessions have disjoint sets of files
+	* open).  In that case, skip it: we'll retry the close the
+	* next time, after the transaction state has progressed.
+	*
+	* We don't set WT_DHANDLE_EXCLUSIVE deliberately, we want
+	* opens to block on us rather than returning an EBUSY error to
+	* the application.
+	*/
+	if ((ret = __wt_try_writelock(session, dhandle->rwlock)) == EBUSY)
+		return 0;
+	WT_RET(ret);
+
+	/* Only sweep clean trees where all updates are visible.*/
+	btree = dhandle->handle;
+	if (btree->modified || !__wt_txn_visible_all(session, btree->rec_max_txn))
+		goto unlock;
+
+	/*尝试关闭dhanle*/
+	if (F_ISSET(dhandle, WT_DHANDLE_OPEN)){
+		WT_WITH_DHANDLE(session, dhandle, ret = __wt_conn_btree_sync_and_close(session, 0, 0));
+		/* We closed the btree handle, bump the statistic. */
+		if (ret == 0)
+			WT_STAT_FAST_CONN_INCR(session, dh_conn_handles);
+	}
+	/*设置关闭计数器*/
+	if (dhandle->session_inuse == 0 && dhandle->session_ref == 0)
+		++*closedp;
+unlock:
+	WT_TRET(__wt_writeunlock(session, dhandle->rwlock));
+	WT_RET_BUSY_OK(ret);
+
+	return 0;
+}
+
+/*
+ * 增量地关闭connection中不在使用的dhandle: 从上一轮停下的hash bucket开始，检查到WT_SWEEP_HANDLES_MAX
+ * 个dhandle为止，只在检查过的bucket中删除关闭的dhandle。donep返回是否扫描完了一遍所有的bucket。
+ * 删除dhandle只由sweep线程完成，所以遍历hash bucket时不需要持有dhandle_lock
+ */
+static int __sweep(WT_SESSION_IMPL* session, int* donep)
+{
 	WT_CONNECTION_IMPL *conn;
 	WT_DATA_HANDLE *dhandle;
 	WT_DECL_RET;
 	time_t now;
-	int closed_handles;
+	u_int closed_handles, count, examined, start;
 
 	conn = S2C(session);
-	closed_handles = 0;
+	closed_handles = examined = 0;
 
 	WT_RET(__wt_seconds(session, &now));
 
 	WT_STAT_FAST_CONN_INCR(session, dh_conn_sweeps);
-	LIST_FOREACH(dhandle, &conn->dhlh, l){
-		/*不关闭元数据的dhandle*/
-		if (WT_IS_METADATA(dhandle))
-			continue;
-		
-		/*dhandle已经关闭了*/
-		if (!F_ISSET(dhandle, WT_DHANDLE_OPEN) && dhandle->session_inuse == 0 && dhandle->session_ref == 0) {
-			++closed_handles;
-			continue;
-		}
-
-		/*延迟关闭的时间还未到，dhandle不做关闭*/
-		if (dhandle->session_inuse != 0 || now <= dhandle->timeofdeath + conn->sweep_idle_time)
-			continue;
 
-		if (dhandle->timeofdeath == 0) {
-			dhandle->timeofdeath = now;
-			WT_STAT_FAST_CONN_INCR(session, dh_conn_tod);
-			continue;
+	start = conn->sweep_bucket;
+	for (count = 0; count < WT_HASH_ARRAY_SIZE && examined < WT_SWEEP_HANDLES_MAX; count++){
+		SLIST_FOREACH(dhandle, &conn->dhhash[(start + count) % WT_HASH_ARRAY_SIZE], hashl){
+			++examined;
+			WT_RET(__sweep_handle(session, dhandle, now, &closed_handles));
 		}
-		/*
-		* We have a candidate for closing; if it's open, acquire an
-		* exclusive lock on the handle and close it.
-		*
-		* The close would require I/O if an update cannot be written
-		* (updates in a no-longer-referenced file might not yet be
-		* globally visible if sessions have disjoint sets of files
-		* open).  In that case, skip it: we'll retry the close the
-		* next time, after the transaction state has progressed.
-		*
-		* We don't set WT_DHANDLE_EXCLUSIVE deliberately, we want
-		* opens to block on us rather than returning an EBUSY error to
-		* the application.
-		*/
-		if ((ret = __wt_try_writelock(session, dhandle->rwlock)) == EBUSY)
-			continue;
-		WT_RET(ret);
-
-		/* Only sweep clean trees where all updates are visible.*/
-		btree = dhandle->handle;
-		if (btree->modified || !__wt_txn_visible_all(session, btree->rec_max_txn))
-			goto unlock;
-
-		/*尝试关闭dhanle*/
-		if (F_ISSET(dhandle, WT_DHANDLE_OPEN)){
-			WT_WITH_DHANDLE(session, dhandle, ret = __wt_conn_btree_sync_and_close(session, 0, 0));
-			/* We closed the btree handle, bump the statistic. */
-			if (ret == 0)
-				WT_STAT_FAST_CONN_INCR(session, dh_conn_handles);
-		}
-		/*设置关闭计数器*/
-		if (dhandle->session_inuse == 0 && dhandle->session_ref == 0)
-			++closed_handles;
-unlock:
-		WT_TRET(__wt_writeunlock(session, dhandle->rwlock));
-		WT_RET_BUSY_OK(ret);
 	}
+	conn->sweep_bucket = (start + count) % WT_HASH_ARRAY_SIZE;
+	*donep = (start + count >= WT_HASH_ARRAY_SIZE) ? 1 : 0;
+
 	/*从connection list当中删除关闭的dhandle*/
 	if (closed_handles > 0) {
-		WT_WITH_DHANDLE_LOCK(session, ret = __sweep_remove_handles(session));
+		WT_WITH_DHANDLE_LOCK(session, ret = __sweep_remove_handles(session, start, count));
 		WT_RET(ret);
 	}
 
@@ -130,14 +163,17 @@ static WT_THREAD_RET __sweep_server(void* arg)
 	WT_CONNECTION_IMPL *conn;
 	WT_DECL_RET;
 	WT_SESSION_IMPL *session;
+	int done;
 
 	session = arg;
 	conn = S2C(session);
+	done = 1;
 
 	while (F_ISSET(conn, WT_CONN_SERVER_RUN) && F_ISSET(conn, WT_CONN_SERVER_SWEEP)){
-		WT_ERR(__wt_cond_wait(session, conn->sweep_cond, (uint64_t)conn->sweep_interval * WT_MILLION));
+		/*上一轮没有扫描完所有的bucket，很快继续下一轮*/
+		WT_ERR(__wt_cond_wait(session, conn->sweep_cond, done ? (uint64_t)conn->sweep_interval * WT_MILLION : WT_SWEEP_BATCH_WAIT));
 
-		WT_ERR(__sweep(session));
+		WT_ERR(__sweep(session, &done));
 	}
 
 	if (0){
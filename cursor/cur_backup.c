@@ -88,6 +88,7 @@ int __wt_curbackup_open(WT_SESSION_IMPL *session, const char *uri, const char *c
 		__curbackup_reset,		/* reset */
 		__wt_cursor_notsup,		/* search */
 		__wt_cursor_notsup,		/* search-near */
+		__wt_cursor_notsup,		/* search-batch */
 		__wt_cursor_notsup,		/* insert */
 		__wt_cursor_notsup,		/* update */
 		__wt_cursor_notsup,		/* remove */
@@ -36,6 +36,7 @@ int __wt_curconfig_open(WT_SESSION_IMPL *session, const char *uri, const char *c
 	    __wt_cursor_noop,		/* reset */
 	    __wt_cursor_notsup,		/* search */
 	    __wt_cursor_notsup,		/* search-near */
+	    __wt_cursor_notsup,		/* search-batch */
 	    __wt_cursor_notsup,		/* insert */
 	    __wt_cursor_notsup,		/* update */
 	    __wt_cursor_notsup,		/* remove */
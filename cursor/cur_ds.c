@@ -381,6 +381,7 @@ int __wt_curds_open(WT_SESSION_IMPL* session, const char* uri, WT_CURSOR* owner,
 		__curds_reset,		/* reset */
 		__curds_search,		/* search */
 		__curds_search_near,	/* search-near */
+		__wt_cursor_search_batch,	/* search-batch */
 		__curds_insert,		/* insert */
 		__curds_update,		/* update */
 		__curds_remove,		/* remove */
@@ -297,6 +297,7 @@ int __wt_curdump_create(WT_CURSOR *child, WT_CURSOR *owner, WT_CURSOR **cursorp)
 		__curdump_reset,		/* reset */
 		__curdump_search,		/* search */
 		__curdump_search_near,	/* search-near */
+		__wt_cursor_notsup,		/* search-batch */
 		__curdump_insert,		/* insert */
 		__curdump_update,		/* update */
 		__curdump_remove,		/* remove */
@@ -152,6 +152,24 @@ err:
 	API_END_RET(session, ret);
 }
 
+/*btree cursor批量查找多个key*/
+static int __curfile_search_batch(WT_CURSOR* cursor, size_t count, const WT_ITEM* keys, WT_ITEM* values, int* results)
+{
+	WT_CURSOR_BTREE *cbt;
+	WT_DECL_RET;
+	WT_SESSION_IMPL *session;
+
+	cbt = (WT_CURSOR_BTREE *)cursor;
+	CURSOR_API_CALL(cursor, session, search_batch, cbt->btree);
+
+	WT_CURSOR_NOVALUE(cursor);
+
+	ret = __wt_btcur_search_batch(cbt, count, keys, values, results);
+
+err:
+	API_END_RET(session, ret);
+}
+
 /*btree cursor定位到key附近的btree上*/
 static int __curfile_search_near(WT_CURSOR *cursor, int *exact)
 {
@@ -277,6 +295,68 @@ err:
 	return ret;
 }
 
+/*释放session cursor cache中的一个cursor，这个cursor已经不再持有btree handle*/
+static void __curfile_cache_free(WT_SESSION_IMPL* session, WT_CURSOR* cursor)
+{
+	WT_CURSOR_BTREE *cbt;
+
+	cbt = (WT_CURSOR_BTREE *)cursor;
+
+	(void)__wt_btcur_close(cbt);
+	__wt_free(session, cbt->cache_cfg);
+	/* The URI is owned by the btree handle. */
+	cursor->internal_uri = NULL;
+	(void)__wt_cursor_close(cursor);
+
+	WT_STAT_FAST_CONN_INCR(session, cursor_cache_discard);
+}
+
+/*
+ * 将close的cursor放入session的cursor cache，只做reset并释放btree handle，key/value的缓冲区
+ * 保留给下次open使用。cache满了淘汰最久没有用的cursor
+ */
+static int __curfile_cache_park(WT_SESSION_IMPL* session, WT_CURSOR_BTREE* cbt)
+{
+	WT_CURSOR *cursor, *old;
+	WT_DECL_RET;
+
+	cursor = &cbt->iface;
+
+	if (session->ncursors_cached >= S2C(session)->session_cursor_cache){
+		old = TAILQ_LAST(&session->cursor_cache, __cursor_cache);
+		TAILQ_REMOVE(&session->cursor_cache, old, q);
+		--session->ncursors_cached;
+		__curfile_cache_free(session, old);
+	}
+
+	WT_TRET(__wt_btcur_reset(cbt));
+	F_CLR(cursor, WT_CURSTD_KEY_SET | WT_CURSTD_VALUE_SET);
+
+	/*read-ahead的状态回到新建cursor时的值*/
+	cbt->ra_home = NULL;
+	cbt->ra_mask = 0;
+	cbt->ra_slot = cbt->ra_limit = 0;
+	cbt->ra_seq = cbt->ra_depth = 0;
+	cbt->ra_hits = cbt->ra_misses = 0;
+	cbt->ra_prev = 0;
+
+	/*不再持有handle的读锁，park期间drop、verify等操作不会被cache中的cursor阻塞*/
+	cbt->cache_gen = cbt->btree->dhandle->open_gen;
+	__wt_cursor_dhandle_decr_use(session);
+	WT_TRET(__wt_session_release_btree(session));
+
+	TAILQ_REMOVE(&session->cursors, cursor, q);
+	F_CLR(cursor, WT_CURSTD_OPEN);
+	WT_STAT_FAST_DATA_DECR(session, session_cursor_open);
+	WT_STAT_FAST_CONN_ATOMIC_DECR(session, session_cursor_open);
+
+	TAILQ_INSERT_HEAD(&session->cursor_cache, cursor, q);
+	++session->ncursors_cached;
+	WT_STAT_FAST_CONN_INCR(session, cursor_cache_insert);
+
+	return ret;
+}
+
 /*关闭btree cursor*/
 static int __curfile_close(WT_CURSOR *cursor)
 {
@@ -286,12 +366,20 @@ static int __curfile_close(WT_CURSOR *cursor)
 
 	cbt = (WT_CURSOR_BTREE *)cursor;
 	CURSOR_API_CALL(cursor, session, close, cbt->btree);
+
+	/*从open_cursor打开的cursor放入session的cursor cache，下次open相同的uri和配置时重用*/
+	if (F_ISSET(cursor, WT_CURSTD_CACHEABLE) && F_ISSET(cbt->btree->dhandle, WT_DHANDLE_OPEN)){
+		ret = __curfile_cache_park(session, cbt);
+		goto err;
+	}
+
 	WT_TRET(__wt_btcur_close(cbt));
 	if (cbt->btree != NULL) {
 		/* Increment the data-source's in-use counter. */
 		__wt_cursor_dhandle_decr_use(session);
 		WT_TRET(__wt_session_release_btree(session));
 	}
+	__wt_free(session, cbt->cache_cfg);
 	/* The URI is owned by the btree handle. */
 	cursor->internal_uri = NULL;
 	WT_TRET(__wt_cursor_close(cursor));
@@ -316,6 +404,7 @@ int __wt_curfile_create(WT_SESSION_IMPL *session,
 	    __curfile_reset,		/* reset */
 	    __curfile_search,		/* search */
 	    __curfile_search_near,	/* search-near */
+	    __curfile_search_batch,	/* search-batch */
 	    __curfile_insert,		/* insert */
 	    __curfile_update,		/* update */
 	    __curfile_remove,		/* remove */
@@ -431,3 +520,98 @@ err:	/* If the cursor could not be opened, release the handle. */
 	return (ret);
 }
 
+/*如果cursor是可以缓存的file cursor，记录open_cursor的配置，close时放入session的cursor cache*/
+int __wt_curfile_cache_prepare(WT_SESSION_IMPL* session, WT_CURSOR* cursor, const char* config)
+{
+	WT_CURSOR_BTREE *cbt;
+
+	if (cursor->close != __curfile_close || S2C(session)->session_cursor_cache == 0)
+		return 0;
+
+	/*bulk和checkpoint cursor的handle是特殊打开的，不缓存*/
+	cbt = (WT_CURSOR_BTREE *)cursor;
+	if (F_ISSET(cursor, WT_CURSTD_BULK) || cbt->btree->dhandle->checkpoint != NULL)
+		return 0;
+
+	if (config != NULL)
+		WT_RET(__wt_strdup(session, config, &cbt->cache_cfg));
+
+	F_SET(cursor, WT_CURSTD_CACHEABLE);
+	cbt->cache_flags = cursor->flags;
+	return 0;
+}
+
+/*
+ * 在session的cursor cache中查找uri和配置都相同的cursor，重新获取btree handle后返回。
+ * btree在cursor park期间被关闭过的话，cursor不能再用，释放掉按没有找到处理。没有找到返回WT_NOTFOUND
+ */
+int __wt_curfile_cache_get(WT_SESSION_IMPL* session, const char* uri, const char* cfg[], WT_CURSOR** cursorp)
+{
+	WT_CURSOR *cursor;
+	WT_CURSOR_BTREE *cbt;
+	WT_DECL_RET;
+	const char *config;
+
+	*cursorp = NULL;
+
+	if (S2C(session)->session_cursor_cache == 0 || (!WT_PREFIX_MATCH(uri, "file:") && !WT_PREFIX_MATCH(uri, "table:")))
+		return WT_NOTFOUND;
+
+	config = cfg[1];
+	TAILQ_FOREACH(cursor, &session->cursor_cache, q){
+		cbt = (WT_CURSOR_BTREE *)cursor;
+		if (strcmp(cursor->uri, uri) != 0)
+			continue;
+		if (config == NULL ? cbt->cache_cfg == NULL : (cbt->cache_cfg != NULL && strcmp(cbt->cache_cfg, config) == 0))
+			break;
+	}
+
+	if (cursor == NULL){
+		WT_STAT_FAST_CONN_INCR(session, cursor_cache_miss);
+		return WT_NOTFOUND;
+	}
+
+	TAILQ_REMOVE(&session->cursor_cache, cursor, q);
+	--session->ncursors_cached;
+
+	/*获取handle失败时由完整的open流程返回错误*/
+	if ((ret = __wt_session_get_btree(session, cursor->internal_uri, NULL, cfg, 0)) != 0)
+		ret = WT_NOTFOUND;
+	else if (S2BT(session) != cbt->btree || cbt->btree->dhandle->open_gen != cbt->cache_gen){
+		ret = __wt_session_release_btree(session);
+		if (ret == 0)
+			ret = WT_NOTFOUND;
+	}
+	if (ret != 0){
+		__curfile_cache_free(session, cursor);
+		WT_STAT_FAST_CONN_INCR(session, cursor_cache_miss);
+		return ret;
+	}
+
+	__wt_cursor_dhandle_incr_use(session);
+
+	cursor->flags = cbt->cache_flags;
+	TAILQ_INSERT_HEAD(&session->cursors, cursor, q);
+	WT_STAT_FAST_DATA_INCR(session, session_cursor_open);
+	WT_STAT_FAST_CONN_ATOMIC_INCR(session, session_cursor_open);
+	WT_STAT_FAST_CONN_INCR(session, cursor_cache_hit);
+
+	*cursorp = cursor;
+	return 0;
+}
+
+/*释放session cursor cache中使用dhandle的cursor，dhandle为NULL时释放所有的cursor*/
+void __wt_curfile_cache_discard(WT_SESSION_IMPL* session, WT_DATA_HANDLE* dhandle)
+{
+	WT_CURSOR *cursor, *next;
+
+	for (cursor = TAILQ_FIRST(&session->cursor_cache); cursor != NULL; cursor = next){
+		next = TAILQ_NEXT(cursor, q);
+		if (dhandle != NULL && ((WT_CURSOR_BTREE *)cursor)->btree->dhandle != dhandle)
+			continue;
+
+		TAILQ_REMOVE(&session->cursor_cache, cursor, q);
+		--session->ncursors_cached;
+		__curfile_cache_free(session, cursor);
+	}
+}
@@ -303,6 +303,7 @@ int __wt_curlog_open(WT_SESSION_IMPL *session, const char *uri, const char *cfg[
 		__curlog_reset,		/* reset */
 		__curlog_search,		/* search */
 		__wt_cursor_notsup,		/* search-near */
+		__wt_cursor_search_batch,	/* search-batch */
 		__wt_cursor_notsup,		/* insert */
 		__wt_cursor_notsup,		/* update */
 		__wt_cursor_notsup,		/* remove */
@@ -328,6 +328,7 @@ int __wt_curmetadata_open(WT_SESSION_IMPL* session, const char* uri, WT_CURSOR*
 		__curmetadata_reset,	/* reset */
 		__curmetadata_search,	/* search */
 		__curmetadata_search_near,	/* search-near */
+		__wt_cursor_search_batch,	/* search-batch */
 		__curmetadata_insert,	/* insert */
 		__curmetadata_update,	/* update */
 		__curmetadata_remove,	/* remove */
@@ -351,8 +351,12 @@ static void __curstat_conn_init(WT_SESSION_IMPL *session, WT_CURSOR_STAT *cst)
 	 */
 	__wt_conn_stat_init(session);
 	cst->u.conn_stats = conn->stats;
-	if (F_ISSET(cst, WT_CONN_STAT_CLEAR))
+	__wt_conn_stat_slots_sum(session, &cst->u.conn_stats);
+	if (F_ISSET(cst, WT_CONN_STAT_CLEAR)){
 		__wt_stat_refresh_connection_stats(&conn->stats);
+		__wt_conn_stat_slots_clear(session);
+		__wt_async_stats_clear(session);
+	}
 
 	cst->stats_first = cst->stats = (WT_STATS *)&cst->u.conn_stats;
 	cst->stats_base = WT_CONNECTION_STATS_BASE;
@@ -453,6 +457,7 @@ int __wt_curstat_open(WT_SESSION_IMPL *session, const char *uri, const char *cfg
 	    __curstat_reset,		/* reset */
 	    __curstat_search,		/* search */
 	    __wt_cursor_notsup,		/* search-near */
+	    __wt_cursor_search_batch,	/* search-batch */
 	    __wt_cursor_notsup,		/* insert */
 	    __wt_cursor_notsup,		/* update */
 	    __wt_cursor_notsup,		/* remove */
@@ -27,6 +27,7 @@ void __wt_cursor_set_notsup(WT_CURSOR* cursor)
 	cursor->reset = __wt_cursor_noop;
 	cursor->search = __wt_cursor_notsup;
 	cursor->search_near = (int (*)(WT_CURSOR *, int *))__wt_cursor_notsup;
+	cursor->search_batch = (int (*)(WT_CURSOR *, size_t, const WT_ITEM *, WT_ITEM *, int *))__wt_cursor_notsup;
 	cursor->insert = __wt_cursor_notsup;
 	cursor->update = __wt_cursor_notsup;
 	cursor->remove = __wt_cursor_notsup;
@@ -112,6 +113,133 @@ int __wt_cursor_get_raw_value(WT_CURSOR *cursor, WT_ITEM *value)
 	return ret;
 }
 
+/*按collator的顺序对keys的下标做归并排序，结果存在order中，tmp是辅助数组*/
+static int __cursor_batch_sort(WT_SESSION_IMPL* session, WT_COLLATOR* collator, const WT_ITEM* keys, size_t count, size_t* order, size_t* tmp)
+{
+	size_t hi, i, j, k, lo, mid, width, *from, *to, *t;
+	int cmp, sorted;
+
+	for (i = 0; i < count; i++)
+		order[i] = i;
+
+	/*大多数调用者传入的keys本来就是有序的*/
+	for (i = 1, sorted = 1; sorted && i < count; i++){
+		WT_RET(__wt_compare(session, collator, &keys[i - 1], &keys[i], &cmp));
+		sorted = cmp <= 0;
+	}
+	if (sorted)
+		return 0;
+
+	from = order;
+	to = tmp;
+	for (width = 1; width < count; width *= 2){
+		for (lo = 0; lo < count; lo += 2 * width){
+			mid = WT_MIN(lo + width, count);
+			hi = WT_MIN(lo + 2 * width, count);
+			for (i = lo, j = mid, k = lo; k < hi; k++){
+				cmp = -1;
+				if (i < mid && j < hi)
+					WT_RET(__wt_compare(session, collator, &keys[from[i]], &keys[from[j]], &cmp));
+				if (i < mid && (j >= hi || cmp <= 0))
+					to[k] = from[i++];
+				else
+					to[k] = from[j++];
+			}
+		}
+		t = from;
+		from = to;
+		to = t;
+	}
+
+	if (from != order)
+		memcpy(order, from, count * sizeof(size_t));
+
+	return 0;
+}
+
+/*
+ * search_batch的公共流程: 按collator的顺序对每个key调用lookup进行查找，找到的value拷贝到
+ * cursor->batch中，因为batch在拷贝过程中可能重新分配内存，最后再设置values的data指针
+ */
+int __wt_cursor_batch_search(WT_CURSOR* cursor, WT_COLLATOR* collator, size_t count, const WT_ITEM* keys, 
+							WT_ITEM* values, int* results, int (*lookup)(WT_CURSOR *, WT_ITEM *))
+{
+	WT_DECL_RET;
+	WT_ITEM value;
+	WT_SESSION_IMPL *session;
+	size_t i, k, *offsets, *order;
+
+	session = (WT_SESSION_IMPL *)cursor->session;
+
+	if (count == 0)
+		return 0;
+
+	WT_RET(__wt_calloc_def(session, 3 * count, &order));
+	offsets = order + count;
+	WT_ERR(__cursor_batch_sort(session, collator, keys, count, order, order + 2 * count));
+
+	cursor->batch.data = cursor->batch.mem;
+	cursor->batch.size = 0;
+	for (i = 0; i < count; i++){
+		k = order[i];
+		values[k].data = NULL;
+		values[k].size = 0;
+
+		__wt_cursor_set_raw_key(cursor, (WT_ITEM *)&keys[k]);
+		if (!F_ISSET(cursor, WT_CURSTD_KEY_SET))
+			WT_ERR(__wt_cursor_kv_not_set(cursor, 1));
+
+		if ((ret = lookup(cursor, &value)) == WT_NOTFOUND){
+			results[k] = WT_NOTFOUND;
+			ret = 0;
+			continue;
+		}
+		WT_ERR(ret);
+
+		WT_ERR(__wt_buf_extend(session, &cursor->batch, cursor->batch.size + value.size));
+		if (value.size > 0)
+			memcpy((uint8_t *)cursor->batch.mem + cursor->batch.size, value.data, value.size);
+		offsets[k] = cursor->batch.size;
+		cursor->batch.size += value.size;
+
+		results[k] = 0;
+		values[k].size = value.size;
+	}
+
+	for (k = 0; k < count; k++)
+		if (results[k] == 0)
+			values[k].data = (uint8_t *)cursor->batch.mem + offsets[k];
+
+err:
+	__wt_free(session, order);
+	F_CLR(cursor, WT_CURSTD_KEY_SET | WT_CURSTD_VALUE_SET);
+
+	return ret;
+}
+
+/*默认的search_batch查找方式，对每个key调用cursor的search*/
+static int __cursor_batch_lookup(WT_CURSOR* cursor, WT_ITEM* value)
+{
+	WT_RET(cursor->search(cursor));
+
+	return __wt_cursor_get_raw_value(cursor, value);
+}
+
+/*默认的search_batch实现，逐个key调用cursor的search*/
+int __wt_cursor_search_batch(WT_CURSOR* cursor, size_t count, const WT_ITEM* keys, WT_ITEM* values, int* results)
+{
+	WT_DECL_RET;
+	WT_SESSION_IMPL *session;
+
+	CURSOR_API_CALL(cursor, session, search_batch, NULL);
+
+	ret = __wt_cursor_batch_search(cursor, NULL, count, keys, values, results, __cursor_batch_lookup);
+	WT_TRET(cursor->reset(cursor));
+
+err:
+	API_END_RET(session, ret);
+}
+
 /*设置cursor的值*/
 void __wt_cursor_set_raw_value(WT_CURSOR *cursor, WT_ITEM *value)
 {
@@ -392,6 +520,7 @@ int __wt_cursor_close(WT_CURSOR *cursor)
 	/*释放存储key/value值的缓冲区*/
 	__wt_buf_free(session, &cursor->key);
 	__wt_buf_free(session, &cursor->value);
+	__wt_buf_free(session, &cursor->batch);
 
 	if (F_ISSET(cursor, WT_CURSTD_OPEN)) {
 		TAILQ_REMOVE(&session->cursors, cursor, q);
@@ -72,6 +72,7 @@ static int __apply_idx(WT_CURSOR_TABLE* ctable, size_t func_off, int skip_immuta
 		__wt_cursor_notsup,		/* reset */
 		__wt_cursor_notsup,		/* search */
 		__wt_cursor_notsup,		/* search-near */
+		__wt_cursor_notsup,		/* search-batch */
 		__curextract_insert,	/* insert */
 		__wt_cursor_notsup,		/* update */
 		__wt_cursor_notsup,		/* reconfigure */
@@ -380,6 +381,26 @@ err:
 	API_END_RET(session, ret);
 }
 
+/*批量查找多个key，只有一个column group并且没有列投影的table直接在primary cursor上批量查找*/
+static int __curtable_search_batch(WT_CURSOR *cursor, size_t count, const WT_ITEM *keys, WT_ITEM *values, int *results)
+{
+	WT_CURSOR *primary;
+	WT_CURSOR_TABLE *ctable;
+	WT_DECL_RET;
+	WT_SESSION_IMPL *session;
+
+	ctable = (WT_CURSOR_TABLE *)cursor;
+	if (!ctable->table->is_simple || ctable->plan != ctable->table->plan)
+		return __wt_cursor_search_batch(cursor, count, keys, values, results);
+
+	CURSOR_API_CALL(cursor, session, search_batch, NULL);
+	primary = *ctable->cg_cursors;
+	ret = primary->search_batch(primary, count, keys, values, results);
+
+err:
+	API_END_RET(session, ret);
+}
+
 static int __curtable_search_near(WT_CURSOR *cursor, int *exact)
 {
 	WT_CURSOR_TABLE *ctable;
@@ -716,6 +737,7 @@ int __wt_curtable_open(WT_SESSION_IMPL *session, const char *uri, const char *cf
 		__curtable_reset,		/* reset */
 		__curtable_search,		/* search */
 		__curtable_search_near,	/* search-near */
+		__curtable_search_batch,	/* search-batch */
 		__curtable_insert,		/* insert */
 		__curtable_update,		/* update */
 		__curtable_remove,		/* remove */
@@ -6,12 +6,12 @@
 
 static int				__evict_clear_walks(WT_SESSION_IMPL *);
 static int				__evict_has_work(WT_SESSION_IMPL *, uint32_t *);
-static int WT_CDECL		__evict_lru_cmp(const void *, const void *);
 static int				__evict_lru_pages(WT_SESSION_IMPL *, int);
 static int				__evict_lru_walk(WT_SESSION_IMPL *, uint32_t);
 static int				__evict_pass(WT_SESSION_IMPL *);
-static int				__evict_walk(WT_SESSION_IMPL *, uint32_t);
-static int				__evict_walk_file(WT_SESSION_IMPL *, u_int *, uint32_t);
+static int				__evict_walk(WT_SESSION_IMPL *, WT_EVICT_QUEUE *, uint32_t);
+static int				__evict_walk_file(WT_SESSION_IMPL *, WT_EVICT_QUEUE *, u_int *, uint32_t);
+static void				__evict_walk_help(WT_SESSION_IMPL *);
 static WT_THREAD_RET	__evict_worker(void *);
 static int				__evict_server_work(WT_SESSION_IMPL *);
 
@@ -39,15 +39,119 @@ static inline uint64_t __evict_read_gen(const WT_EVICT_ENTRY* entry)
 	return read_gen;
 }
 
-/*qsort函数的比较函数参数,实际上是比较两个WT_EVICT_ENTRY对象的read gen大小, 如果a > b返回1， a < b返回-1*/
-static int WT_CDECL __evict_lru_cmp(const void* a, const void* b)
+/*
+ * 确定一个evict entry在dirty aware模式下的evict优先级。dirty page必须先做一次完整的
+ * reconcile才能被evict，代价和page的内存占用(包括insert skiplist和update链)成正比，
+ * 所以在read gen的基础上按照page的写入代价往后调整，让冷的clean page先被evict。
+ * 如果dirty数据已经超过了eviction_dirty_target(dirty_over)，说明必须要回收dirty page，不做调整。
+ * 这里不能依赖WT_EVICT_PASS_DIRTY，cache超过eviction_target时只设置WT_EVICT_PASS_ALL
+ */
+static inline uint64_t __evict_score(WT_CACHE* cache, const WT_EVICT_ENTRY* entry, uint32_t flags, int dirty_over, int* skewedp)
+{
+	WT_PAGE*	page;
+	uint64_t	cost, read_gen;
+
+	*skewedp = 0;
+	read_gen = __evict_read_gen(entry);
+	if (!cache->eviction_dirty_aware || entry->ref == NULL || read_gen == WT_READGEN_OLDEST)
+		return read_gen;
+
+	if (dirty_over || LF_ISSET(WT_EVICT_PASS_AGGRESSIVE | WT_EVICT_PASS_DIRTY | WT_EVICT_PASS_WOULD_BLOCK))
+		return read_gen;
+
+	page = entry->ref->page;
+	if (!__wt_page_is_modified(page))
+		return read_gen;
+
+	/*写入代价的调整不能超过internal page的调整，否则dirty leaf page会排在internal page之后*/
+	cost = WT_EVICT_DIRTY_SKEW + (page->memory_footprint / WT_EVICT_COST_UNIT) * WT_READGEN_STEP;
+	*skewedp = 1;
+
+	return read_gen + WT_MIN(cost, WT_EVICT_INT_SKEW);
+}
+
+/*
+ * 对evict lru list按照entry的read gen做桶排序，代替原来的qsort。根据所有entry
+ * read gen的范围划分WT_EVICT_HIST_BUCKETS个桶，统计每个桶的entry数量后按桶的顺序
+ * 拷贝回evict lru list，整个过程是O(n)的。同一个桶内的entry不排序，所以结果是
+ * 近似的从冷到热的顺序，这对于确定最冷的25%的淘汰候选已经足够了。
+ * 没有ref的entry会被放到队列的末尾，函数返回有效entry的个数
+ */
+static uint32_t __evict_lru_bucket_sort(WT_SESSION_IMPL* session, WT_EVICT_QUEUE* queue, uint32_t entries, uint32_t flags, uint64_t* min_genp, uint64_t* max_genp)
+{
+	WT_CACHE *cache;
+	WT_EVICT_ENTRY *evict, *sorted;
+	uint64_t max_gen, min_gen, width;
+	uint32_t bucket, count, i, pos, skewed, valid;
+	uint32_t hist[WT_EVICT_HIST_BUCKETS + 1];
+	int dirty_over, skew;
+
+	cache = S2C(session)->cache;
+	dirty_over = __wt_cache_dirty_inuse(cache) > (cache->eviction_dirty_target * S2C(session)->cache_size) / 100;
+	min_gen = UINT64_MAX;
+	max_gen = 0;
+	skewed = valid = 0;
+
+	/*计算每个entry的evict优先级，并确定优先级的范围*/
+	for (i = 0, evict = queue->evict_queue; i < entries; i++, evict++){
+		evict->score = __evict_score(cache, evict, flags, dirty_over, &skew);
+		if (evict->ref == NULL)
+			continue;
+
+		skewed += (uint32_t)skew;
+
+		++valid;
+		if (evict->score < min_gen)
+			min_gen = evict->score;
+		if (evict->score > max_gen)
+			max_gen = evict->score;
+	}
+
+	*min_genp = min_gen;
+	*max_genp = max_gen;
+	if (skewed > 0)
+		WT_STAT_FAST_CONN_INCRV(session, cache_eviction_dirty_skew, skewed);
+	if (valid == 0)
+		return 0;
+
+	/*统计每个桶中的entry数量，最后一个桶用于存放没有ref的entry*/
+	width = (max_gen - min_gen) / WT_EVICT_HIST_BUCKETS + 1;
+	memset(hist, 0, sizeof(hist));
+	for (i = 0, evict = queue->evict_queue; i < entries; i++, evict++){
+		bucket = (evict->ref == NULL) ? WT_EVICT_HIST_BUCKETS : (uint32_t)((evict->score - min_gen) / width);
+		++hist[bucket];
+	}
+
+	/*将每个桶的计数转换成桶在排序结果中的起始位置*/
+	for (i = 0, pos = 0; i <= WT_EVICT_HIST_BUCKETS; i++){
+		count = hist[i];
+		hist[i] = pos;
+		pos += count;
+	}
+
+	/*按照桶的顺序拷贝到排序缓冲区中，再拷贝回evict lru list*/
+	sorted = queue->evict_sort;
+	for (i = 0, evict = queue->evict_queue; i < entries; i++, evict++){
+		bucket = (evict->ref == NULL) ? WT_EVICT_HIST_BUCKETS : (uint32_t)((evict->score - min_gen) / width);
+		sorted[hist[bucket]++] = *evict;
+	}
+	memcpy(queue->evict_queue, sorted, entries * sizeof(WT_EVICT_ENTRY));
+
+	return valid;
+}
+
+/*更新evict server挑选淘汰候选page的时间统计*/
+static void __evict_lru_walk_stats(WT_SESSION_IMPL* session, struct timespec* start, struct timespec* stop)
 {
-	uint64_t a_lru, b_lru;
+	uint64_t usec;
 
-	a_lru = __evict_read_gen(a);
-	b_lru = __evict_read_gen(b);
+	usec = WT_TIMEDIFF(*stop, *start) / WT_THOUSAND;
+	if (usec > WT_CONN_STAT(session, cache_eviction_select_time_max))
+		WT_STAT_FAST_CONN_SET(session, cache_eviction_select_time_max, usec);
 
-	return ((a_lru < b_lru) ? -1 : (a_lru == b_lru) ? 0 : 1);
+	WT_STAT_FAST_CONN_SET(session, cache_eviction_select_time_recent, usec);
+	WT_STAT_FAST_CONN_INCRV(session, cache_eviction_select_time_total, usec);
+	WT_STAT_FAST_CONN_INCR(session, cache_eviction_select);
 }
 
 /*从LRU evict list当中清除一个evict entry*/
@@ -73,7 +177,8 @@ void __wt_evict_list_clear_page(WT_SESSION_IMPL *session, WT_REF *ref)
 {
 	WT_CACHE* cache;
 	WT_EVICT_ENTRY* evict;
-	uint32_t i, elem;
+	WT_EVICT_QUEUE* queue;
+	uint32_t i, elem, q;
 
 	/*root page和处于LOCKED状态下的page不能被evict*/
 	WT_ASSERT(session, __wt_ref_is_root(ref) || ref->state == WT_REF_LOCKED);
@@ -82,20 +187,24 @@ void __wt_evict_list_clear_page(WT_SESSION_IMPL *session, WT_REF *ref)
 	if (!F_ISSET_ATOMIC(ref->page, WT_PAGE_EVICT_LRU))
 		return;
 
+	/*page可能在任意一个evict queue当中，逐个queue查找*/
 	cache = S2C(session)->cache;
-	__wt_spin_lock(session, &cache->evict_lock);
-
-	elem = cache->evict_max;
-	for (i = 0, evict = cache->evict; i < elem; i++, evict++){
-		if (evict->ref == ref) {
-			__evict_list_clear(session, evict);
-			break;
+	for (q = 0; q < cache->evict_queue_count && F_ISSET_ATOMIC(ref->page, WT_PAGE_EVICT_LRU); q++){
+		queue = &cache->evict_queues[q];
+		__wt_spin_lock(session, &queue->evict_lock);
+
+		elem = queue->evict_max;
+		for (i = 0, evict = queue->evict_queue; i < elem; i++, evict++){
+			if (evict->ref == ref) {
+				__evict_list_clear(session, evict);
+				break;
+			}
 		}
+
+		__wt_spin_unlock(session, &queue->evict_lock);
 	}
 
 	WT_ASSERT(session, !F_ISSET_ATOMIC(ref->page, WT_PAGE_EVICT_LRU));
-
-	__wt_spin_unlock(session, &cache->evict_lock);
 }
 
 /*唤醒eviction thread*/
@@ -234,8 +343,12 @@ err:
 
 int __wt_evict_create(WT_SESSION_IMPL* session)
 {
+	WT_CACHE *cache;
 	WT_CONNECTION_IMPL *conn;
+	uint32_t i;
+
 	conn = S2C(session);
+	cache = conn->cache;
 
 	/*设置evict server thread处于run状态*/
 	F_SET(conn, WT_CONN_EVICTION_RUN);
@@ -244,6 +357,10 @@ int __wt_evict_create(WT_SESSION_IMPL* session)
 	WT_RET(__wt_open_internal_session(conn, "eviction-server", 0, 0, &conn->evict_session));
 	session = conn->evict_session;
 
+	/*每个evict queue的walk都使用queue自己的session，walk可以由任意一个evict线程执行*/
+	for (i = 0; i < cache->evict_queue_count; i++)
+		WT_RET(__wt_open_internal_session(conn, "eviction-walk", 0, 0, &cache->evict_queues[i].walk_session));
+
 	/*
 	* If eviction workers were configured, allocate sessions for them now.
 	* This is done to reduce the chance that we will open new eviction
@@ -308,6 +425,16 @@ int __wt_evict_destroy(WT_SESSION_IMPL* session)
 		}
 		__wt_free(session, conn->evict_workctx);
 	}
+	/*关闭evict queue walk session*/
+	if (cache->evict_queues != NULL){
+		for (i = 0; i < cache->evict_queue_count; i++){
+			if (cache->evict_queues[i].walk_session == NULL)
+				continue;
+			wt_session = &cache->evict_queues[i].walk_session->iface;
+			WT_TRET(wt_session->close(wt_session, NULL));
+			cache->evict_queues[i].walk_session = NULL;
+		}
+	}
 	/*关闭eviction server session*/
 	if (conn->evict_session != NULL){
 		wt_session = &conn->evict_session->iface;
@@ -334,6 +461,9 @@ static WT_THREAD_RET __evict_worker(void* arg)
 	cache = conn->cache;
 
 	while (F_ISSET(conn, WT_CONN_EVICTION_RUN) && F_ISSET(worker, WT_EVICT_WORKER_RUN)){
+		/*帮助evict server并行walk各个queue*/
+		__evict_walk_help(session);
+
 		/*执行evict page操作*/
 		ret = __evict_lru_pages(session, 0);
 		if (ret == WT_NOTFOUND) /*等待唤醒执行任务*/
@@ -472,8 +602,9 @@ static int __evict_clear_walks(WT_SESSION_IMPL* session)
 	WT_CACHE *cache;
 	WT_CONNECTION_IMPL *conn;
 	WT_DECL_RET;
+	WT_EVICT_QUEUE *queue;
 	WT_REF *ref;
-	WT_SESSION_IMPL *s;
+	WT_SESSION_IMPL *s, *walk_session;
 	u_int i, session_cnt;
 
 	conn = S2C(session);
@@ -484,17 +615,24 @@ static int __evict_clear_walks(WT_SESSION_IMPL* session)
 		if (!s->active || !F_ISSET(s, WT_SESSION_CLEAR_EVICT_WALK))
 			continue;
 
-		if (s->dhandle == cache->evict_file_next)
-			cache->evict_file_next = NULL;
+		/*btree的walk point是btree所属queue的walk_session持有的，需要用这个session释放*/
+		queue = &cache->evict_queues[WT_EVICT_QUEUE_ID(cache, s->dhandle)];
+		walk_session = queue->walk_session;
+		__wt_spin_lock(session, &queue->evict_walk_lock);
 
-		session->dhandle = s->dhandle;
+		if (s->dhandle == queue->evict_file_next)
+			queue->evict_file_next = NULL;
+
+		walk_session->dhandle = s->dhandle;
 		btree = s->dhandle->handle;
 		ref = btree->evict_ref;
-		if (ret != NULL){
+		if (ref != NULL){
 			btree->evict_ref = NULL;
-			WT_TRET(__wt_page_release(session, ref, 0));
+			WT_TRET(__wt_page_release(walk_session, ref, 0));
 		}
-		session->dhandle = NULL;
+		walk_session->dhandle = NULL;
+
+		__wt_spin_unlock(session, &queue->evict_walk_lock);
 	}
 
 	return ret;
@@ -558,7 +696,8 @@ int __wt_evict_file_exclusive_on(WT_SESSION_IMPL* session, int* evict_resetp)
 	WT_BTREE *btree;
 	WT_CACHE *cache;
 	WT_EVICT_ENTRY *evict;
-	u_int i, elem;
+	WT_EVICT_QUEUE *queue;
+	u_int i, elem, q;
 
 	btree = S2BT(session);
 	cache = S2C(session)->cache;
@@ -571,22 +710,28 @@ int __wt_evict_file_exclusive_on(WT_SESSION_IMPL* session, int* evict_resetp)
 
 	*evict_resetp = 1;
 
-	__wt_spin_lock(session, &cache->evict_walk_lock);
+	/*只有btree所属的queue会walk这个btree，所以只需要持有这个queue的walk lock*/
+	queue = &cache->evict_queues[WT_EVICT_QUEUE_ID(cache, session->dhandle)];
+	__wt_spin_lock(session, &queue->evict_walk_lock);
 	F_SET(btree, WT_BTREE_NO_EVICTION); /*设置这个标示是为了独占btree evict的操作权*/
-	__wt_spin_unlock(session, &cache->evict_walk_lock);
+	__wt_spin_unlock(session, &queue->evict_walk_lock);
 
 	/*清除session的btree上的evict ref,这里会阻塞*/
 	WT_RET(__evict_tree_walk_clear(session));
 
-	__wt_spin_lock(session, &cache->evict_lock);
-	/*将btree上所有在evict lru list中的evict entry清除*/
-	elem = cache->evict_max;
-	for (i = 0, evict = cache->evict; i < elem; i++, evict++){
-		if (evict->btree == btree)
-			__evict_list_clear(session, evict);
-	}
+	/*将btree上所有在evict lru queue中的evict entry清除*/
+	for (q = 0; q < cache->evict_queue_count; q++){
+		queue = &cache->evict_queues[q];
+		__wt_spin_lock(session, &queue->evict_lock);
 
-	__wt_spin_unlock(session, &cache->evict_lock);
+		elem = queue->evict_max;
+		for (i = 0, evict = queue->evict_queue; i < elem; i++, evict++){
+			if (evict->btree == btree)
+				__evict_list_clear(session, evict);
+		}
+
+		__wt_spin_unlock(session, &queue->evict_lock);
+	}
 	/*
 	* We have disabled further eviction: wait for concurrent LRU eviction
 	* activity to drain.
@@ -606,7 +751,7 @@ void __wt_evict_file_exclusive_off(WT_SESSION_IMPL *session)
 	btree = S2BT(session);
 
 	WT_ASSERT(session, btree->evict_ref == NULL);
-	/*这个地方为什么不用cache->evict_lock ??*/
+	/*这个地方为什么不用queue->evict_lock ??*/
 	F_CLR(btree, WT_BTREE_NO_EVICTION);
 }
 
@@ -620,79 +765,188 @@ static int __evict_lru_pages(WT_SESSION_IMPL *session, int is_server)
 	return ret;
 }
 
-/* 根据read_gen的版本号确定可以evict的page数量，多余的page移出lru queue*/
-static int __evict_lru_walk(WT_SESSION_IMPL *session, uint32_t flags)
+/* 根据read_gen的版本号确定queue中可以evict的page数量，多余的page移出lru queue*/
+static int __evict_lru_queue(WT_SESSION_IMPL *session, WT_EVICT_QUEUE *queue, uint32_t flags)
 {
 	WT_CACHE *cache;
-	WT_DECL_RET;
 	WT_EVICT_ENTRY *evict;
-	uint64_t cutoff;
+	struct timespec start, stop;
+	uint64_t cutoff, max_gen, min_gen;
 	uint32_t candidates, entries, i;
 
 	cache = S2C(session)->cache;
 
-	/*为evict动作获得更多需要被evict的page*/
-	if ((ret = __evict_walk(session, flags)) != 0)
-		return (ret == EBUSY ? 0 : ret);
-
-	__wt_spin_lock(session, &cache->evict_lock);
-	entries = cache->evict_entries;
-	/*对evict list按照entry->read_gen从大到小排序*/
-	qsort(cache->evict, entries, sizeof(WT_EVICT_ENTRY), __evict_lru_cmp);
-	/*定位到还有没有被evict且read gen最小的evict entry*/
-	while (entries > 0 && cache->evict[entries - 1].ref == NULL)
-		--entries;
-
-	cache->evict_entries = entries;
+	WT_RET(__wt_epoch(session, &start));
+
+	__wt_spin_lock(session, &queue->evict_lock);
+	/*对evict list按照entry的evict优先级从小到大做桶排序，没有被evict的entry都排在有效entry的后面*/
+	entries = __evict_lru_bucket_sort(session, queue, queue->evict_entries, flags, &min_gen, &max_gen);
+
+	queue->evict_entries = entries;
 	/*evict lru list中没有evict entry,直接返回*/
 	if (entries == 0){
-		cache->evict_candidates = 0;
-		cache->evict_current = NULL;
-		__wt_spin_unlock(session, &cache->evict_lock);
+		queue->evict_candidates = 0;
+		queue->evict_current = NULL;
+		__wt_spin_unlock(session, &queue->evict_lock);
 
 		return 0;
 	}
 
 	/*一定有个evict entry是有效的，并且进行evict*/
-	WT_ASSERT(session, cache->evict[0].ref != NULL);
+	WT_ASSERT(session, queue->evict_queue[0].ref != NULL);
 	if (LF_ISSET(WT_EVICT_PASS_AGGRESSIVE | WT_EVICT_PASS_WOULD_BLOCK)){
 		/*
 		* Take all candidates if we only gathered pages with an oldest
 		* read generation set.
 		*/
-		cache->evict_candidates = entries;
+		queue->evict_candidates = entries;
 	}
 	else{
 		/* Find the bottom 25% of read generations. */
-		cutoff = (3 * __evict_read_gen(&cache->evict[0]) + __evict_read_gen(&cache->evict[entries - 1])) / 4;
-		/*确定evict_candidates边界*/
+		cutoff = (3 * min_gen + max_gen) / 4;
+		/*确定evict_candidates边界,队列是按桶有序的，所以这个边界的误差不超过一个桶的宽度*/
 		for (candidates = 1 + entries / 10; candidates < entries / 2; candidates++){
-			if (__evict_read_gen(&cache->evict[candidates]) > cutoff)
+			if (queue->evict_queue[candidates].score > cutoff)
 				break;
 		}
 
-		cache->evict_candidates = candidates;
+		queue->evict_candidates = candidates;
 	}
 
 	/* If we have more than the minimum number of entries, clear them. */
-	if (cache->evict_entries > WT_EVICT_WALK_BASE) {
-		for (i = WT_EVICT_WALK_BASE, evict = cache->evict + i; i < cache->evict_entries; i++, evict++)
+	if (queue->evict_entries > WT_EVICT_WALK_BASE) {
+		for (i = WT_EVICT_WALK_BASE, evict = queue->evict_queue + i; i < queue->evict_entries; i++, evict++)
 			__evict_list_clear(session, evict);
-		cache->evict_entries = WT_EVICT_WALK_BASE;
+		queue->evict_entries = WT_EVICT_WALK_BASE;
 	}
 
-	cache->evict_current = cache->evict;
-	__wt_spin_unlock(session, &cache->evict_lock);
+	queue->evict_current = queue->evict_queue;
+	__wt_spin_unlock(session, &queue->evict_lock);
+
+	WT_RET(__wt_epoch(session, &stop));
+	__evict_lru_walk_stats(session, &start, &stop);
+
 	/*唤醒一个evict worker进行处理*/
 	WT_RET(__wt_cond_signal(session, cache->evict_waiter_cond));
 
 	return 0;
 }
 
+/*
+ * 认领一个evict server发布的queue walk任务并执行：用queue的walk_session walk属于
+ * 这个queue的btree，然后确定queue中可以evict的page。任务已经被其他线程认领时直接返回
+ */
+static void __evict_walk_queue(WT_SESSION_IMPL *session, WT_EVICT_QUEUE *queue, int is_server)
+{
+	WT_DECL_RET;
+	WT_SESSION_IMPL *walk_session;
+
+	if (!WT_ATOMIC_CAS4(queue->walk_state, WT_EVICT_WALK_PENDING, WT_EVICT_WALK_RUNNING))
+		return;
+
+	if (!is_server)
+		WT_STAT_FAST_CONN_INCR(session, cache_eviction_walk_worker);
+
+	/*为evict动作获得更多需要被evict的page*/
+	walk_session = queue->walk_session;
+	if ((ret = __evict_walk(walk_session, queue, queue->walk_flags)) == 0)
+		ret = __evict_lru_queue(walk_session, queue, queue->walk_flags);
+
+	queue->walk_ret = (ret == EBUSY) ? 0 : ret;
+	WT_PUBLISH(queue->walk_state, WT_EVICT_WALK_IDLE);
+}
+
+/*evict worker帮助evict server执行已经发布的queue walk任务*/
+static void __evict_walk_help(WT_SESSION_IMPL *session)
+{
+	WT_CACHE *cache;
+	uint32_t i;
+
+	cache = S2C(session)->cache;
+	for (i = 0; i < cache->evict_queue_count; i++)
+		if (cache->evict_queues[i].walk_state == WT_EVICT_WALK_PENDING)
+			__evict_walk_queue(session, &cache->evict_queues[i], 0);
+}
+
+/*更新evict walk的速度统计*/
+static void __evict_walk_stats(WT_SESSION_IMPL* session, struct timespec* start, struct timespec* stop)
+{
+	WT_CACHE *cache;
+	uint64_t pages, usec;
+	uint32_t i;
+
+	cache = S2C(session)->cache;
+	for (i = 0, pages = 0; i < cache->evict_queue_count; i++)
+		pages += cache->evict_queues[i].walk_pages;
+
+	usec = WT_TIMEDIFF(*stop, *start) / WT_THOUSAND;
+	if (usec > 0)
+		WT_STAT_FAST_CONN_SET(session, cache_eviction_walk_rate, (pages * WT_MILLION) / usec);
+}
+
+/*
+ * 发布每个evict lru queue的walk任务，evict worker和evict server一起并行的填充
+ * 各个queue，并确定每个queue中可以evict的page
+ */
+static int __evict_lru_walk(WT_SESSION_IMPL *session, uint32_t flags)
+{
+	WT_CACHE *cache;
+	WT_DECL_RET;
+	WT_EVICT_QUEUE *queue;
+	struct timespec start, stop;
+	uint32_t i;
+
+	cache = S2C(session)->cache;
+
+	/*对cache->read_gen自加*/
+	__wt_cache_read_gen_incr(session);
+
+	/*
+	* Update the oldest ID: we use it to decide whether pages are
+	* candidates for eviction.  Without this, if all threads are blocked
+	* after a long-running transaction (such as a checkpoint) completes,
+	* we may never start evicting again.
+	*/
+	__wt_txn_update_oldest(session);
+
+	WT_RET(__wt_epoch(session, &start));
+
+	/*发布walk任务，唤醒evict worker来认领*/
+	for (i = 0; i < cache->evict_queue_count; i++){
+		queue = &cache->evict_queues[i];
+		queue->walk_flags = flags;
+		queue->walk_pages = 0;
+		queue->walk_ret = 0;
+		WT_PUBLISH(queue->walk_state, WT_EVICT_WALK_PENDING);
+	}
+	if (S2C(session)->evict_workers > 0)
+		WT_TRET(__wt_cond_signal(session, cache->evict_waiter_cond));
+
+	/*server执行没有被worker认领的walk任务*/
+	for (i = 0; i < cache->evict_queue_count; i++)
+		__evict_walk_queue(session, &cache->evict_queues[i], 1);
+
+	/*等待worker完成它们认领的walk任务*/
+	for (i = 0; i < cache->evict_queue_count; i++){
+		queue = &cache->evict_queues[i];
+		while (queue->walk_state != WT_EVICT_WALK_IDLE)
+			__wt_yield();
+		WT_TRET(queue->walk_ret);
+	}
+	WT_RET(ret);
+
+	WT_RET(__wt_epoch(session, &stop));
+	__evict_walk_stats(session, &start, &stop);
+
+	return 0;
+}
+
 /*检查是否应evict worker在工作，如果有, 从lru queue中evict page*/
 static int __evict_server_work(WT_SESSION_IMPL* session)
 {
 	WT_CACHE *cache;
+	WT_EVICT_QUEUE *queue;
+	uint32_t i;
 
 	cache = S2C(session)->cache;
 
@@ -704,8 +958,13 @@ static int __evict_server_work(WT_SESSION_IMPL* session)
 		* 这里调用sched_yield是为了在CPU密集计算时，evict server 让出CPU资源给
 		* evict work thread执行evict操作，防止evict queue中堆积过多等待evict的实例
 		*/
-		if (cache->evict_candidates > 10 && cache->evict_current != NULL)
-			__wt_yield();
+		for (i = 0; i < cache->evict_queue_count; i++){
+			queue = &cache->evict_queues[i];
+			if (queue->evict_candidates > 10 && queue->evict_current != NULL){
+				__wt_yield();
+				break;
+			}
+		}
 	}
 	else /*没有evict worker线程，直接用server线程进行evict操作*/
 		WT_RET_NOTFOUND_OK(__evict_lru_pages(session, 1));
@@ -713,8 +972,8 @@ static int __evict_server_work(WT_SESSION_IMPL* session)
 	return 0;
 }
 
-/*扫描整个connection中打开的btree索引文件，将能evict的btree page放入evict lru队列当中*/
-static int __evict_walk(WT_SESSION_IMPL *session, uint32_t flags)
+/*扫描整个connection中打开的btree索引文件，将能evict的btree page放入queue当中*/
+static int __evict_walk(WT_SESSION_IMPL *session, WT_EVICT_QUEUE *queue, uint32_t flags)
 {
 	WT_BTREE *btree;
 	WT_CACHE *cache;
@@ -731,18 +990,7 @@ static int __evict_walk(WT_SESSION_IMPL *session, uint32_t flags)
 	incr = dhandle_locked = 0;
 	retries = 0;
 
-	/*对cache->read_gen自加*/
-	__wt_cache_read_gen_incr(session);
-
-	/*
-	* Update the oldest ID: we use it to decide whether pages are
-	* candidates for eviction.  Without this, if all threads are blocked
-	* after a long-running transaction (such as a checkpoint) completes,
-	* we may never start evicting again.
-	*/
-	__wt_txn_update_oldest(session);
-
-	if (cache->evict_current == NULL)
+	if (queue->evict_current == NULL)
 		WT_STAT_FAST_CONN_INCR(session, cache_eviction_queue_empty);
 	else
 		WT_STAT_FAST_CONN_INCR(session, cache_eviction_queue_not_empty);
@@ -751,7 +999,7 @@ static int __evict_walk(WT_SESSION_IMPL *session, uint32_t flags)
 	 * Set the starting slot in the queue and the maximum pages added
 	 * per walk.
 	 */
-	start_slot = slot = cache->evict_entries;
+	start_slot = slot = queue->evict_entries;
 	max_entries = slot + WT_EVICT_WALK_INCR;
 
 retry:
@@ -775,14 +1023,14 @@ retry:
 
 		/*获得一个dhandle*/
 		if (dhandle == NULL)
-			dhandle = SLIST_FIRST(&conn->dhlh);
+			dhandle = TAILQ_FIRST(&conn->dhlh);
 		else{
 			if (incr){
 				WT_ASSERT(session, dhandle->session_inuse > 0);
 				(void)WT_ATOMIC_SUB4(dhandle->session_inuse, 1);
 				incr = 0;
 			}
-			dhandle = SLIST_NEXT(dhandle, l);
+			dhandle = TAILQ_NEXT(dhandle, l);
 		}
 
 		/* If we reach the end of the list, we're done. */
@@ -792,10 +1040,13 @@ retry:
 		/* Ignore non-file handles, or handles that aren't open. */
 		if (!WT_PREFIX_MATCH(dhandle->name, "file:") || !F_ISSET(dhandle, WT_DHANDLE_OPEN))
 			continue;
+		/*只walk属于这个queue的btree*/
+		if (WT_EVICT_QUEUE_ID(cache, dhandle) != (uint32_t)(queue - cache->evict_queues))
+			continue;
 		/*从上次walk的btree对象开始walk evict page*/
-		if (cache->evict_file_next != NULL && cache->evict_file_next != dhandle)
+		if (queue->evict_file_next != NULL && queue->evict_file_next != dhandle)
 			continue;
-		cache->evict_file_next = NULL;
+		queue->evict_file_next = NULL;
 
 		/* Skip files that don't allow eviction. */
 		btree = dhandle->handle;
@@ -816,7 +1067,7 @@ retry:
 		* If we are filling the queue, skip files that haven't been
 		* useful in the past.
 		*/
-		if (btree->evict_walk_period != 0 && cache->evict_entries >= WT_EVICT_WALK_INCR && btree->evict_walk_skips++ < btree->evict_walk_period)
+		if (btree->evict_walk_period != 0 && queue->evict_entries >= WT_EVICT_WALK_INCR && btree->evict_walk_skips++ < btree->evict_walk_period)
 			continue;
 		btree->evict_walk_skips = 0;
 		prev_slot = slot;
@@ -827,13 +1078,13 @@ retry:
 		dhandle_locked = 0;
 
 		/*获得一个dhandle对应的BTREE对象*/
-		__wt_spin_lock(session, &cache->evict_walk_lock);
+		__wt_spin_lock(session, &queue->evict_walk_lock);
 		if (!F_ISSET(btree, WT_BTREE_NO_EVICTION)) {
 			/*根据evict条件，在各个BTREE上检查可以淘汰的page,并将page加入到evict lru queue中*/
-			WT_WITH_DHANDLE(session, dhandle, ret = __evict_walk_file(session, &slot, flags));
+			WT_WITH_DHANDLE(session, dhandle, ret = __evict_walk_file(session, queue, &slot, flags));
 			WT_ASSERT(session, session->split_gen == 0);
 		}
-		__wt_spin_unlock(session, &cache->evict_walk_lock);
+		__wt_spin_unlock(session, &queue->evict_walk_lock);
 
 		/*本次walk并没有设置这个BTREE的页作为驱逐对象，那么下次减少evict walk的概率，因为walk btree是耗费资源的*/
 		if (slot == prev_slot)
@@ -862,30 +1113,27 @@ retry:
 	* 如果是evict old gen,尽量获取多的evict page到lru queue中
 	*/
 	if (!F_ISSET(cache, WT_CACHE_CLEAR_WALKS) && ret == 0 && slot < max_entries 
-		&& (retries < 2  || (!LF_ISSET(WT_EVICT_PASS_WOULD_BLOCK) && retries < 10 && (slot == cache->evict_entries || slot > start_slot)))) {
-		cache->evict_file_next = NULL;
+		&& (retries < 2  || (!LF_ISSET(WT_EVICT_PASS_WOULD_BLOCK) && retries < 10 && (slot == queue->evict_entries || slot > start_slot)))) {
+		queue->evict_file_next = NULL;
 		start_slot = slot;
 		++retries;
 		goto retry;
 	}
 	/*保存本次walk的btree handle位置*/
-	cache->evict_file_next = dhandle;
-	cache->evict_entries = slot;
+	queue->evict_file_next = dhandle;
+	queue->evict_entries = slot;
 
 	return ret;
 }
 
 /*将一个page设置到entry lru list当中*/
-static void __evict_init_candidate(WT_SESSION_IMPL* session, WT_EVICT_ENTRY* evict, WT_REF* ref)
+static void __evict_init_candidate(WT_SESSION_IMPL* session, WT_EVICT_QUEUE* queue, WT_EVICT_ENTRY* evict, WT_REF* ref)
 {
-	WT_CACHE *cache;
 	u_int slot;
 
-	cache = S2C(session)->cache;
-
-	slot = (u_int)(evict - cache->evict);
-	if (slot >= cache->evict_max)
-		cache->evict_max = slot + 1;
+	slot = (u_int)(evict - queue->evict_queue);
+	if (slot >= queue->evict_max)
+		queue->evict_max = slot + 1;
 
 	if (evict->ref != NULL)
 		__evict_list_clear(session, evict);
@@ -897,7 +1145,7 @@ static void __evict_init_candidate(WT_SESSION_IMPL* session, WT_EVICT_ENTRY* evi
 }
 
 /*根据session对应btree的evict_ref进行btree，把符合evict条件的page添加到evict lru list当中*/
-static int __evict_walk_file(WT_SESSION_IMPL* session, u_int* slotp, uint32_t flags)
+static int __evict_walk_file(WT_SESSION_IMPL* session, WT_EVICT_QUEUE* queue, u_int* slotp, uint32_t flags)
 {
 	WT_BTREE *btree;
 	WT_CACHE *cache;
@@ -914,8 +1162,8 @@ static int __evict_walk_file(WT_SESSION_IMPL* session, u_int* slotp, uint32_t fl
 	cache = S2C(session)->cache;
 
 	/*最多evict 10个page*/
-	start = cache->evict + *slotp;
-	end = WT_MIN(start + WT_EVICT_WALK_PER_FILE, cache->evict + cache->evict_slots);
+	start = queue->evict_queue + *slotp;
+	end = WT_MIN(start + WT_EVICT_WALK_PER_FILE, queue->evict_queue + cache->evict_slots);
 
 	enough = internal_pages = restarts = 0;
 
@@ -1011,7 +1259,7 @@ fast:
 
 		/*将evict page加入到evict lru list当中*/
 		WT_ASSERT(session, evict->ref == NULL);
-		__evict_init_candidate(session, evict, ref);
+		__evict_init_candidate(session, queue, evict, ref);
 		++evict;
 
 		WT_RET(__wt_verbose(session, WT_VERB_EVICTSERVER, "select: %p, size %" PRIu64, page, page->memory_footprint));
@@ -1035,42 +1283,74 @@ fast:
 		ret = 0;
 
 	*slotp += (u_int)(evict - start);
+	queue->walk_pages += pages_walked;
 	WT_STAT_FAST_CONN_INCRV(session, cache_eviction_walk, pages_walked);
 
 	return ret;
 }
 
-/*从evict queue获取一个evict page的ref*/
-static int _evict_get_ref(WT_SESSION_IMPL *session, int is_server, WT_BTREE **btreep, WT_REF **refp)
+/*
+ * 获得一个可以从中获取evict page的queue并锁住它。首先尝试session自己的queue，
+ * 自己的queue为空或者锁被其他线程持有时，从其他的queue中获取(work stealing)，
+ * 所有的queue都为空时返回WT_NOTFOUND
+ */
+static int __evict_queue_lock(WT_SESSION_IMPL *session, WT_EVICT_QUEUE **queuep)
 {
 	WT_CACHE *cache;
-	WT_EVICT_ENTRY *evict;
-	uint32_t candidates;
+	WT_EVICT_QUEUE *queue;
+	uint32_t home, i;
+	int empty;
 	WT_DECL_SPINLOCK_ID(id);			/* Must appear last */
 
 	cache = S2C(session)->cache;
-	*btreep = NULL;
-	*refp = NULL;
+	home = session->id % cache->evict_queue_count;
+	*queuep = NULL;
 
-	/*在cache->evict_current有效时，获得evict_lock锁，整个过程是spin wait*/
 	for (;;){
-		if (cache->evict_current == NULL)
+		empty = 1;
+		for (i = 0; i < cache->evict_queue_count; i++){
+			queue = &cache->evict_queues[(home + i) % cache->evict_queue_count];
+			if (queue->evict_current == NULL)
+				continue;
+
+			empty = 0;
+			if (__wt_spin_trylock(session, &queue->evict_lock, &id) == 0){
+				if (i != 0)
+					WT_STAT_FAST_CONN_INCR(session, cache_eviction_queue_steal);
+				*queuep = queue;
+				return 0;
+			}
+		}
+
+		if (empty)
 			return WT_NOTFOUND;
-		if (__wt_spin_trylock(session, &cache->evict_lock, &id) == 0)
-			break;
 
 		__wt_yield();
 	}
+}
+
+/*从evict queue获取一个evict page的ref*/
+static int _evict_get_ref(WT_SESSION_IMPL *session, int is_server, WT_BTREE **btreep, WT_REF **refp)
+{
+	WT_EVICT_ENTRY *evict;
+	WT_EVICT_QUEUE *queue;
+	uint32_t candidates;
+
+	*btreep = NULL;
+	*refp = NULL;
+
+	/*在queue->evict_current有效时，获得queue的evict_lock锁*/
+	WT_RET(__evict_queue_lock(session, &queue));
 
 	/*如果是evict server thread的话，先evict out 一半数量的page*/
-	candidates = cache->evict_candidates;
+	candidates = queue->evict_candidates;
 	if (is_server && candidates > 1)
 		candidates /= 2;
 
 	/*从evict queue中获取page*/
-	while ((evict = cache->evict_current) != NULL && evict < cache->evict + candidates && evict->ref != NULL){
+	while ((evict = queue->evict_current) != NULL && evict < queue->evict_queue + candidates && evict->ref != NULL){
 		WT_ASSERT(session, evict->btree != NULL);
-		++cache->evict_current;
+		++queue->evict_current;
 
 		/*
 		* Lock the page while holding the eviction mutex to prevent
@@ -1085,20 +1365,20 @@ static int _evict_get_ref(WT_SESSION_IMPL *session, int is_server, WT_BTREE **bt
 		}
 
 		/*增加evict busy计数器，防止btree handle被关闭*/
-		(void*)WT_ATOMIC_ADD4(evict->btree->evict_busy, 1);
+		(void)WT_ATOMIC_ADD4(evict->btree->evict_busy, 1);
 
 		/*已经获得一个evict page*/
 		*btreep = evict->btree;
-		refp = evict->ref;
+		*refp = evict->ref;
 		__evict_list_clear(session, evict);
 
 		break;
 	}
 	/*evict queue没有evict page,直接将evict_current设成NULL*/
-	if (evict >= cache->evict + cache->evict_candidates)
-		cache->evict_current = NULL;
+	if (evict >= queue->evict_queue + queue->evict_candidates)
+		queue->evict_current = NULL;
 
-	__wt_spin_unlock(session, &cache->evict_lock);
+	__wt_spin_unlock(session, &queue->evict_lock);
 
 	return ((*refp == NULL) ? WT_NOTFOUND : 0);
 }
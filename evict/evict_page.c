@@ -79,8 +79,12 @@ int __wt_evict(WT_SESSION_IMPL* session, WT_REF* ref, int exclusive)
 	if (mod == NULL || !F_ISSET(mod, WT_PM_REC_MASK)){ /*脏数据已经reconcile到磁盘上，直接将page驱逐出内存*/
 		if (__wt_ref_is_root(ref))/*直接废弃内存中的page结构对象即可*/
 			__wt_ref_out(session, ref);
-		else
+		else{
+			/*从没修改过的page，磁盘上的image还有效，存入block cache，失败了不影响evict*/
+			if (!exclusive && mod == NULL)
+				(void)__wt_bt_blkcache_put(session, ref);
 			__wt_evict_page_clean_update(session, ref);
+		}
 
 		WT_STAT_FAST_CONN_INCR(session, cache_eviction_clean);
 		WT_STAT_FAST_DATA_INCR(session, cache_eviction_clean);
@@ -19,6 +19,8 @@ typedef enum{
 #define	MAX_ASYNC_SLEEP_USECS	100000	/* Maximum sleep waiting for work */
 #define	MAX_ASYNC_YIELD			200		/* Maximum number of yields for work */
 
+#define	WT_ASYNC_LATENCY_BUCKETS	32	/* Queue latency histogram, log2(usecs) */
+
 /*快速得到conn和session的宏*/
 #define	O2C(op)	((WT_CONNECTION_IMPL *)(op)->iface.connection)
 #define	O2S(op)	(((WT_CONNECTION_IMPL *)(op)->iface.connection)->default_session)
@@ -45,10 +47,23 @@ struct __wt_async_op_impl {
 	WT_ASYNC_FORMAT *format;	/* Format structure */
 	WT_ASYNC_STATE	state;		/* Op state */
 	WT_ASYNC_OPTYPE	optype;		/* Operation type */
+
+	struct timespec	enqueue_time;	/* 进入排队队列的时刻，用于统计排队延迟 */
+
+	WT_ASYNC_BATCH_OP*	batch;		/* 批量操作，不为NULL时op代表整个batch */
+	uint32_t	batch_count;	/* 批量操作的个数 */
+};
+
+/*
+ * 排队队列的slot, seq是slot的序号: seq == pos表示slot空闲，可以被第pos个入队者使用;
+ * seq == pos + 1表示slot已经填充了op，可以被第pos个出队者消费
+ */
+struct __wt_async_qslot {
+	volatile uint64_t	seq;
+	WT_ASYNC_OP_IMPL*	op;
 };
 
 #define	OPS_INVALID_INDEX		0xffffffff
-#define	WT_ASYNC_MAX_WORKERS	20
 
 /*定义async子模块*/
 struct __wt_async
@@ -57,13 +72,17 @@ struct __wt_async
 	WT_ASYNC_OP_IMPL*	async_ops;
 	uint32_t			ops_index;
 	uint64_t			op_id;
-	WT_ASYNC_OP_IMPL**	async_queue;
-	uint32_t			async_qsize;
+	WT_ASYNC_QSLOT*		async_queue;
+	uint32_t			async_qsize;	/* Queue size, power of two */
+
+	uint64_t			enqueue_pos;	/* Next position to enqueue */
+	uint64_t			dequeue_pos;	/* Next position to dequeue */
 
-	uint64_t			alloc_head;	/* Next slot to enqueue */
-	uint64_t			head;		/* Head visible to worker */
-	uint64_t			alloc_tail;	/* Next slot to dequeue */
-	uint64_t			tail_slot;	/* Worker slot consumed */
+	WT_CONDVAR*			work_cond;		/* Idle workers wait here */
+	uint32_t			idle_workers;	/* Workers waiting on work_cond */
+
+	uint64_t			latency_hist[WT_ASYNC_LATENCY_BUCKETS];
+	uint64_t			latency_max;	/* Max queue latency (usecs) */
 
 	STAILQ_HEAD(__wt_async_format_qh, __wt_async_format) formatqh;
 
@@ -76,8 +95,9 @@ struct __wt_async
 	uint32_t			flush_count;
 	uint64_t			flush_gen;
 
-	WT_SESSION_IMPL*	worker_sessions[WT_ASYNC_MAX_WORKERS];
-	wt_thread_t			worker_tids[WT_ASYNC_MAX_WORKERS];
+	WT_SESSION_IMPL**	worker_sessions;
+	wt_thread_t*		worker_tids;
+	uint32_t			worker_alloc;	/* Worker array slots */
 
 	uint32_t			flags;
 };
@@ -96,5 +116,8 @@ struct __wt_async_worker_state
 	uint32_t			id;
 	STAILQ_HEAD(__wt_cursor_qh, __wt_async_cursor)	cursorqh;
 	uint32_t			num_cursors;
+
+	WT_ASYNC_BATCH_OP**	batch_order;	/* 按key排序后的batch操作 */
+	size_t				batch_order_alloc;
 };
 
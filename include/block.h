@@ -111,6 +111,32 @@ struct __wt_bm {
 	int			is_live;				/* The live system */
 };
 
+#define WT_BLOCK_SHARDS				8				/*写入空间分配的shard个数*/
+#define WT_BLOCK_SHARD_REGION		WT_MEGABYTE		/*每次从avail中切给shard的region大小*/
+#define WT_BLOCK_SHARD_FREES		64				/*shard中累积多少个空间释放后批量归还*/
+
+/*session写入时使用的shard*/
+#define WT_BLOCK_SHARD_GET(block, session)			\
+	(&(block)->shards[(session)->id % WT_BLOCK_SHARDS])
+
+/*
+ * 写入空间分配的shard。每个shard在live_lock的保护下从avail中批量切出一段连续的
+ * region，之后的分配只需要持有shard自己的锁。region中已经分配出去的空间
+ * [alloc_off, region_off)还没有计入live.alloc，释放的空间也先记录在shard中，
+ * 两者都在持有live_lock时批量合并到live的extent list中
+ */
+struct __wt_block_shard
+{
+	WT_SPINLOCK				lock;
+	wt_off_t				alloc_off;			/*还没有计入live.alloc的分配起始位置*/
+	wt_off_t				region_off;			/*region中还没有分配的起始位置*/
+	wt_off_t				region_end;			/*region的结束位置*/
+
+	wt_off_t				free_off[WT_BLOCK_SHARD_FREES];
+	wt_off_t				free_size[WT_BLOCK_SHARD_FREES];
+	u_int					free_next;
+};
+
 /*__wt_block块定义*/
 struct __wt_block
 {
@@ -133,6 +159,8 @@ struct __wt_block
 	WT_SPINLOCK				live_lock;			/*对live的保护锁*/
 	WT_BLOCK_CKPT			live;				/*checkpoint的详细信息*/
 
+	WT_BLOCK_SHARD			shards[WT_BLOCK_SHARDS];	/*写入空间分配的shard*/
+
 	int						ckpt_inprogress;	/*是否正在进行checkpoint*/
 	int						compact_pct_tenths;
 
@@ -179,3 +207,39 @@ struct __wt_block_header
 
 #define	WT_BLOCK_COMPRESS_SKIP	64
 
+/*
+ * block cache: 缓存被evict出内存的干净page的磁盘格式image(压缩过的或者原始的)，
+ * 以(block, offset)为key，size和cksum用于确认缓存的image和addr对应的是同一个block
+ */
+#define WT_BLKCACHE_PARTS		16
+#define WT_BLKCACHE_HASH_SIZE	1024
+
+struct __wt_blkcache_item
+{
+	WT_BLOCK*				block;
+	wt_off_t				offset;
+	uint32_t				size;
+	uint32_t				cksum;
+	size_t					image_size;			/*缓存的page image长度，数据紧跟在结构后面*/
+
+	TAILQ_ENTRY(__wt_blkcache_item) hashq;
+	TAILQ_ENTRY(__wt_blkcache_item) lruq;
+};
+
+#define WT_BLKCACHE_IMAGE(item)	((uint8_t *)(item) + sizeof(WT_BLKCACHE_ITEM))
+
+/*block cache的分区，每个分区有独立的锁、hash表和LRU队列*/
+struct __wt_blkcache_part
+{
+	WT_SPINLOCK				lock;
+	uint64_t				bytes_inuse;
+	TAILQ_HEAD(__wt_blkcache_lru, __wt_blkcache_item) lruqh;
+	TAILQ_HEAD(__wt_blkcache_hash, __wt_blkcache_item) hashqh[WT_BLKCACHE_HASH_SIZE];
+};
+
+struct __wt_blkcache
+{
+	uint64_t				bytes_max;			/*每个分区允许缓存的最大字节数*/
+	WT_BLKCACHE_PART		parts[WT_BLKCACHE_PARTS];
+};
+
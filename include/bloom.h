@@ -3,11 +3,29 @@
 ************************************************************************/
 #include <stdint.h>
 
+/*
+ * blocked bloom filter: 第一个hash值选定一个cache line大小的block，k个bit都落在这个
+ * block中，一次查找只会访问一个cache line
+ */
+#define	WT_BLOOM_BLOCK_BITS		(WT_CACHE_LINE_ALIGNMENT * 8)
+#define	WT_BLOOM_BLOCKED_META	"bloom_blocked"		/*blocked bloom filter在app_metadata中的标示*/
+
+#define	WT_BLOOM_PROBE_SAMPLE	64					/*每多少次查找统计一次查找的耗时*/
+
+/*finalize后的bloom filter在内存中的bitset，通过bloom文件的btree句柄共享*/
+struct __wt_bloom_bits
+{
+	uint8_t*			bitstring;		/*bloom bit map*/
+	uint64_t			m;				/*bit map总的bit数*/
+	size_t				memsize;		/*bit map占用的内存*/
+};
+
 struct __wt_bloom
 {
 	const char*			uri;
 	char*				config;			/*bloom配置项字符串*/
 	uint8_t*			bitstring;		/*bloom bit map*/
+	WT_BLOOM_BITS*		bits;			/*finalize后加载到内存中的bit map*/
 	WT_SESSION_IMPL*	session;
 	WT_CURSOR*			c;				/**/
 	
@@ -15,6 +33,9 @@ struct __wt_bloom
 	uint32_t			factor;			/*每个item(可以认为字节)占用的bit数*/
 	uint64_t			m;				/*bloom slots总的bit数*/
 	uint64_t			n;				/*bloom slots总的item数*/
+
+	int					blocked;		/*是否是cache line blocked的bit分布*/
+	uint64_t			probes;			/*查找次数，用于采样查找耗时*/
 };
 
 struct __wt_bloom_hash
@@ -543,6 +543,8 @@ struct __wt_page {
 #define	WT_PAGE_SPLITTING	0x80	/* An internal page is growing */
 	uint8_t flags_atomic;		/* Atomic flags, use F_*_ATOMIC */
 
+	uint8_t readahead;		/* Page was read by a read-ahead thread */
+
 	/*
 	 * The page's read generation acts as an LRU value for each page in the
 	 * tree; it is used by the eviction server thread to select pages to be
@@ -110,6 +110,8 @@ struct __wt_btree
 
 	WT_SPINLOCK				flush_lock;
 
+	WT_BLOOM_BITS*			bloom_bits;			/*bloom filter文件加载到内存中的bit map*/
+
 	uint32_t				flags;
 };
 
@@ -122,5 +124,69 @@ struct __wt_salvage_cookie
 	int						done;
 };
 
+/*split block并行压缩任务的状态*/
+#define WT_COMPRESS_JOB_IDLE		0
+#define WT_COMPRESS_JOB_QUEUED		1
+#define WT_COMPRESS_JOB_RUNNING		2
+#define WT_COMPRESS_JOB_DONE		3
+
+/*
+ * 一个page的压缩任务，src是提交任务时page数据的拷贝，压缩线程将src压缩到dst中，
+ * 提交任务的session负责按照提交的顺序把结果写入block
+ */
+struct __wt_compress_job
+{
+	WT_COMPRESSOR*			compressor;
+	WT_ITEM					src;				/*未压缩的page数据*/
+	WT_ITEM					dst;				/*压缩后的page数据*/
+	size_t					dst_len;			/*dst中可以存放压缩数据的长度*/
+	size_t					result_len;
+	int						compression_failed;
+	int						ret;
+
+	volatile uint32_t		state;				/*WT_COMPRESS_JOB_xxx*/
+	TAILQ_ENTRY(__wt_compress_job) q;
+};
+
+/*压缩线程*/
+struct __wt_compress_worker
+{
+	WT_SESSION_IMPL*		session;
+	wt_thread_t				tid;
+	int						tid_set;
+};
+
+/*一次read-ahead请求最多包含的leaf page数，也是read_ahead.depth的上限*/
+#define WT_READAHEAD_MAX		64
+/*read-ahead队列中最多等待的请求数，超过后新的请求直接丢弃*/
+#define WT_READAHEAD_QUEUE_MAX	256
+
+/*
+ * cursor顺序扫描时提交的read-ahead请求，记录的是同一个parent page下后续leaf page的
+ * 起始key(row store)或者起始recno(column store)。ref指针在提交之后可能因为split
+ * 或者evict失效，所以read-ahead线程通过key重新从root定位这些leaf page
+ */
+struct __wt_readahead_req
+{
+	char*					name;				/*btree的dhandle name*/
+	char*					checkpoint;			/*btree的checkpoint name*/
+	int						row;				/*是否是row store*/
+	u_int					count;
+	uint64_t				recno[WT_READAHEAD_MAX];
+	size_t					key_off[WT_READAHEAD_MAX];
+	size_t					key_size[WT_READAHEAD_MAX];
+	WT_ITEM					keys;				/*所有key连续存放在这里*/
+
+	TAILQ_ENTRY(__wt_readahead_req) q;
+};
+
+/*read-ahead线程*/
+struct __wt_readahead_worker
+{
+	WT_SESSION_IMPL*		session;
+	wt_thread_t				tid;
+	int						tid_set;
+};
+
 /**********************************************************************/
 
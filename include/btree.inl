@@ -703,23 +703,40 @@ static inline int __wt_page_swap_func(WT_SESSION_IMPL* session, WT_REF* held, WT
 	return ret;
 }
 
-/*检查page是否是一个hazard pointer,如果是返回其对应hazard对象,这里涉及到了无锁操作，用了内存屏障来保证并发*/
+/*
+ * 检查page是否是一个hazard pointer,如果是返回其对应hazard对象,这里涉及到了无锁操作，用了内存屏障来保证并发。
+ * 调用者已经将ref设置成WT_REF_LOCKED, 设置hazard pointer的线程是先在自己的位图中置位、增加connection
+ * 上的计数再检查ref状态，所以connection上这一位的计数为0时没有session持有这个page，不需要扫描session。
+ * 计数不为0时只扫描位图中对应的位被设置了的session
+ */
 static inline WT_HAZARD* __wt_page_hazard_check(WT_SESSION_IMPL *session, WT_PAGE *page)
 {
 	WT_CONNECTION_IMPL *conn;
 	WT_HAZARD *hp;
 	WT_SESSION_IMPL *s;
-	uint32_t i, hazard_size, session_cnt;
+	uint64_t mask, word;
+	uint32_t bit, i, hazard_size, session_cnt;
 
 	conn = S2C(session);
+	bit = WT_HAZARD_FILTER_BIT(page);
+	mask = WT_HAZARD_FILTER_MASK(bit);
+
+	WT_FULL_BARRIER();
+	if (conn->hazard_filter_cnt[bit] == 0)
+		return NULL;
 
 	WT_ORDERED_READ(session_cnt, conn->session_cnt);
-	for(s == conn->sessions, i = 0; i < session_cnt; ++s, ++i){
-		if(!s->active)
+	for (s = conn->sessions, i = 0; i < session_cnt; ++s, ++i){
+		if (!s->active)
 			continue;
 
-		WT_ORDERED_READ(hazard_size, s->hazard_size);
+		WT_ORDERED_READ(word, s->hazard_filter[bit >> 6]);
+		if ((word & mask) == 0)
+			continue;
 
+		/*可能是hash冲突，需要扫描这个session的hazard array确认*/
+		WT_STAT_FAST_CONN_INCR(session, cache_eviction_hazard_scan);
+		WT_ORDERED_READ(hazard_size, s->hazard_size);
 		for (hp = s->hazard; hp < s->hazard + hazard_size; ++hp){
 			if (hp->page == page)
 				return hp;
@@ -2,10 +2,79 @@
 *btree的比较函数
 *******************************************************************/
 
+/*
+ * 默认比较器的实现方式，在__wt_lex_compare_init中根据CPU的指令集选定，
+ * 保存在__wt_process.lex_compare_method中
+ */
+#define	WT_LEX_COMPARE_BYTE		0		/* Compare keys one byte at a time */
+#define	WT_LEX_COMPARE_WORD		1		/* Compare keys 8 bytes at a time */
+#define	WT_LEX_COMPARE_SSE2		2		/* Compare keys 16 bytes at a time */
+
+/*逐字节确定userp和treep前len个字节中相同前缀的长度*/
+static inline size_t __wt_lex_prefix_byte(const uint8_t* userp, const uint8_t* treep, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; ++i)
+		if (userp[i] != treep[i])
+			break;
+
+	return i;
+}
+
+/*按8字节的word确定相同前缀的长度，出现不同的word后在word内部逐字节定位*/
+static inline size_t __wt_lex_prefix_word(const uint8_t* userp, const uint8_t* treep, size_t len)
+{
+	uint64_t uw, tw;
+	size_t i;
+
+	for (i = 0; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+		memcpy(&uw, userp + i, sizeof(uint64_t));
+		memcpy(&tw, treep + i, sizeof(uint64_t));
+		if (uw != tw)
+			break;
+	}
+
+	return i + __wt_lex_prefix_byte(userp + i, treep + i, len - i);
+}
+
+#if defined(__amd64) || defined(__x86_64) || defined(_M_AMD64)
+/*用SSE2按16字节确定相同前缀的长度，剩余不足16字节的部分按word比较*/
+static inline size_t __wt_lex_prefix_sse2(const uint8_t* userp, const uint8_t* treep, size_t len)
+{
+	__m128i u, t;
+	size_t i;
+
+	for (i = 0; i + sizeof(__m128i) <= len; i += sizeof(__m128i)) {
+		u = _mm_loadu_si128((const __m128i *)(userp + i));
+		t = _mm_loadu_si128((const __m128i *)(treep + i));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(u, t)) != 0xffff)
+			break;
+	}
+
+	return i + __wt_lex_prefix_word(userp + i, treep + i, len - i);
+}
+#endif
+
+/*按照选定的比较方式确定相同前缀的长度*/
+static inline size_t __wt_lex_prefix(const uint8_t* userp, const uint8_t* treep, size_t len)
+{
+	switch (__wt_process.lex_compare_method) {
+#if defined(__amd64) || defined(__x86_64) || defined(_M_AMD64)
+	case WT_LEX_COMPARE_SSE2:
+		return __wt_lex_prefix_sse2(userp, treep, len);
+#endif
+	case WT_LEX_COMPARE_WORD:
+		return __wt_lex_prefix_word(userp, treep, len);
+	default:
+		return __wt_lex_prefix_byte(userp, treep, len);
+	}
+}
+
 /*比较user与item的内存内容的大小*/
 static inline int __wt_lex_compare(const WT_ITEM* user_item, const WT_ITEM* tree_item)
 {
-	size_t len, usz, tsz;
+	size_t len, match, usz, tsz;
 	const uint8_t* userp, *treep;
 
 	usz = user_item->size;
@@ -15,10 +84,9 @@ static inline int __wt_lex_compare(const WT_ITEM* user_item, const WT_ITEM* tree
 	userp = user_item->data;
 	treep = tree_item->data;
 
-	for(; len > 0; --len, ++userp, ++treep){
-		if(*userp != *treep)
-			return (*userp < *treep ? -1 : 1);
-	}
+	match = __wt_lex_prefix(userp, treep, len);
+	if (match < len)
+		return (userp[match] < treep[match] ? -1 : 1);
 
 	return ((usz == tsz) ? 0 : ((usz < tsz) ? -1 : 1));
 }
@@ -37,7 +105,7 @@ static inline int __wt_compare(WT_SESSION_IMPL* session, WT_COLLATOR* collator,
 /*跳过开始到matchp之间的数据比较，只比较后面的数据内容大小,比较过的内容长度会增加到matchp中*/
 static inline int __wt_lex_compare_skip(const WT_ITEM *user_item, const WT_ITEM *tree_item, size_t *matchp)
 {
-	size_t len, usz, tsz;
+	size_t len, match, usz, tsz;
 	const uint8_t *userp, *treep;
 
 	usz = user_item->size;
@@ -47,9 +115,11 @@ static inline int __wt_lex_compare_skip(const WT_ITEM *user_item, const WT_ITEM
 	userp = (uint8_t *)user_item->data + *matchp;
 	treep = (uint8_t *)tree_item->data + *matchp;
 
-	for (; len > 0; --len, ++userp, ++treep, ++*matchp)
-		if (*userp != *treep)
-			return (*userp < *treep ? -1 : 1);
+	/*相同前缀的长度累加到matchp中，matchp最后指向第一个不同的字节*/
+	match = __wt_lex_prefix(userp, treep, len);
+	*matchp += match;
+	if (match < len)
+		return (userp[match] < treep[match] ? -1 : 1);
 
 	return ((usz == tsz) ? 0 : (usz < tsz) ? -1 : 1);
 }
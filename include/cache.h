@@ -8,12 +8,26 @@
  */
 
 #define WT_EVICT_INT_SKEW		(1 << 20)	/*1M, Prefer leaf pages over internal pages by this many increments of the read generation.*/
+#define WT_EVICT_DIRTY_SKEW		WT_READGEN_STEP		/*dirty page需要reconcile才能evict，比clean page多出的read gen*/
+#define WT_EVICT_COST_UNIT		WT_MEGABYTE			/*每WT_EVICT_COST_UNIT字节的page内存占用增加WT_READGEN_STEP的read gen*/
 
 #define WT_EVICT_WALK_PER_FILE	10			/* Pages to queue per file */
 #define WT_EVICT_MAX_PER_FILE	100			/* Max pages to visit per file */
 #define WT_EVICT_WALK_BASE		300			/* Pages tracked across file visits */
 #define WT_EVICT_WALK_INCR		100			/* Pages added each walk */
 
+#define WT_EVICT_HIST_BUCKETS	64			/* Read generation buckets used to order the LRU queue */
+#define WT_EVICT_QUEUE_MAX		8			/* Maximum number of LRU eviction queues */
+
+/*btree只会被它所属的queue walk，不同的queue walk的btree集合是不相交的*/
+#define	WT_EVICT_QUEUE_ID(cache, dhandle)						\
+	((uint32_t)((dhandle)->name_hash % (cache)->evict_queue_count))
+
+/*queue walk任务的状态*/
+#define	WT_EVICT_WALK_IDLE		0		/* No walk requested */
+#define	WT_EVICT_WALK_PENDING	1		/* Walk requested by the server */
+#define	WT_EVICT_WALK_RUNNING	2		/* Walk claimed by a thread */
+
 #define	WT_EVICT_PASS_AGGRESSIVE	0x01
 #define	WT_EVICT_PASS_ALL			0x02	/*清除所有的evict entry*/
 #define	WT_EVICT_PASS_DIRTY			0x04	/*清除所有有脏数据的page的evict entry*/
@@ -24,6 +38,33 @@ struct __wt_evict_entry
 {
 	WT_BTREE* btree;
 	WT_REF*	ref;
+	uint64_t score;							/* Eviction priority, lower is evicted first */
+};
+
+/*
+ * 一个evict lru queue，每个queue有独立的锁。evict server轮流向各个queue中填充
+ * 淘汰候选page，evict worker优先从自己的queue中获取page，自己的queue空了之后
+ * 再从其他的queue中获取(work stealing)。
+ * 每个queue只walk属于自己的btree，walk任务由evict server发布，可以被任意一个
+ * evict worker认领，walk过程中的hazard pointer都属于queue的walk_session
+ */
+struct __wt_evict_queue
+{
+	WT_SPINLOCK evict_lock;					/* Eviction LRU queue */
+	WT_EVICT_ENTRY *evict_queue;			/* LRU pages being tracked */
+	WT_EVICT_ENTRY *evict_sort;				/* LRU queue bucket sort buffer */
+	WT_EVICT_ENTRY *evict_current;			/* LRU current page to be evicted */
+	uint32_t evict_candidates;				/* LRU list pages to evict */
+	uint32_t evict_entries;					/* LRU entries in the queue */
+	volatile uint32_t evict_max;			/* LRU maximum eviction slot used */
+
+	WT_SPINLOCK evict_walk_lock;			/* Eviction walk location */
+	WT_SESSION_IMPL *walk_session;			/* Session holding the walk hazard pointers */
+	WT_DATA_HANDLE *evict_file_next;		/* LRU next file to search */
+	volatile uint32_t walk_state;			/* Walk state: idle, pending or running */
+	uint32_t walk_flags;					/* Eviction pass flags for the walk */
+	uint64_t walk_pages;					/* Pages visited by the last walk */
+	int walk_ret;							/* Return value of the last walk */
 };
 
 #define	WT_EVICT_WORKER_RUN	0x01
@@ -54,27 +95,22 @@ struct __wt_cache
 
 	uint64_t   read_gen;					/* Page read generation (LRU) */
 	WT_CONDVAR *evict_cond;					/* Eviction server condition */
-	WT_SPINLOCK evict_lock;					/* Eviction LRU queue */
-	WT_SPINLOCK evict_walk_lock;			/* Eviction walk location */
 
 	WT_CONDVAR *evict_waiter_cond;			/* Condition signalled when the eviction server populates the queue */
 
 	u_int eviction_trigger;					/* Percent to trigger eviction */
 	u_int eviction_target;					/* Percent to end eviction */
 	u_int eviction_dirty_target;			/* Percent to allow dirty */
+	int eviction_dirty_aware;				/* Rank candidates by write cost */
 
 	u_int overhead_pct;						/* Cache percent adjustment */
 
 	/*
 	* LRU eviction list information.
 	*/
-	WT_EVICT_ENTRY *evict;					/* LRU pages being tracked */
-	WT_EVICT_ENTRY *evict_current;			/* LRU current page to be evicted */
-	uint32_t evict_candidates;				/* LRU list pages to evict */
-	uint32_t evict_entries;					/* LRU entries in the queue */
-	volatile uint32_t evict_max;			/* LRU maximum eviction slot used */
-	uint32_t evict_slots;					/* LRU list eviction slots */
-	WT_DATA_HANDLE *evict_file_next;		/* LRU next file to search */
+	WT_EVICT_QUEUE *evict_queues;			/* LRU eviction queues */
+	uint32_t evict_queue_count;				/* LRU eviction queues in use */
+	uint32_t evict_slots;					/* LRU list eviction slots per queue */
 
 	volatile uint64_t sync_request;			/* File sync requests */
 	volatile uint64_t sync_complete;		/* File sync requests completed */
@@ -38,6 +38,37 @@ struct __wt_config_entry
 	u_int						checks_entries;
 };
 
+/*
+ * 预编译的配置: 每个预编译配置单独分配，配置字符串拷贝紧跟在WT_CONFIG_COMPILED的后面，
+ * 配置字符串的指针就是预编译配置的handle。handle仍然是一个合法的配置字符串，可以在任何需要配置字符串
+ * 的地方使用，而__wt_config_get等函数会直接从items中二分查找key，不需要再解析配置字符串。
+ * handle按指针hash到connection的config_compiled_hash中，同时按配置字符串的hash值放到config_compiled_strhash中
+ * 用来去重，在connection关闭时释放
+ */
+#define WT_CONFIG_COMPILED_BUCKET(config)	(((uintptr_t)(config) >> 4) % WT_HASH_ARRAY_SIZE)
+
+struct __wt_config_compiled_item
+{
+	const char*					name;				/*完整的key，子配置用'.'连接，例如"read_ahead.depth"*/
+	int							found;				/*配置字符串中是否有这个key*/
+	WT_CONFIG_ITEM				value;
+};
+
+struct __wt_config_compiled
+{
+	const char*					method;				/*对应的API方法*/
+	const char*					config;				/*配置字符串的拷贝，紧跟在结构后面*/
+	SLIST_ENTRY(__wt_config_compiled) hashl;		/*config_compiled_hash的链表，有不加锁的读者*/
+	uint64_t					hash;				/*配置字符串的hash值*/
+	SLIST_ENTRY(__wt_config_compiled) strhashl;		/*config_compiled_strhash的链表，只在api_lock下访问*/
+
+	WT_CONFIG_COMPILED_ITEM*	items;				/*按name排序*/
+	u_int						items_entries;
+
+#define WT_CONFIG_COMPILED_BASE		0x01			/*config_def.c中的默认配置*/
+	uint32_t					flags;
+};
+
 struct __wt_config_parser_impl 
 {
 	WT_CONFIG_PARSER			iface;
@@ -56,37 +87,38 @@ struct __wt_config_parser_impl
 #define	WT_CONFIG_ENTRY_connection_add_compressor		2
 #define	WT_CONFIG_ENTRY_connection_add_data_source		3
 #define	WT_CONFIG_ENTRY_connection_add_extractor		4
-#define	WT_CONFIG_ENTRY_connection_async_new_op			5
-#define	WT_CONFIG_ENTRY_connection_close				6
-#define	WT_CONFIG_ENTRY_connection_load_extension		7
-#define	WT_CONFIG_ENTRY_connection_open_session			8
-#define	WT_CONFIG_ENTRY_connection_reconfigure			9
-#define	WT_CONFIG_ENTRY_cursor_close					10
-#define	WT_CONFIG_ENTRY_cursor_reconfigure				11
-#define	WT_CONFIG_ENTRY_file_meta						12
-#define	WT_CONFIG_ENTRY_index_meta						13
-#define	WT_CONFIG_ENTRY_session_begin_transaction		14
-#define	WT_CONFIG_ENTRY_session_checkpoint				15
-#define	WT_CONFIG_ENTRY_session_close					16
-#define	WT_CONFIG_ENTRY_session_commit_transaction		17
-#define	WT_CONFIG_ENTRY_session_compact					18
-#define	WT_CONFIG_ENTRY_session_create					19
-#define	WT_CONFIG_ENTRY_session_drop					20
-#define	WT_CONFIG_ENTRY_session_log_printf				21
-#define	WT_CONFIG_ENTRY_session_open_cursor				22
-#define	WT_CONFIG_ENTRY_session_reconfigure				23
-#define	WT_CONFIG_ENTRY_session_rename					24
-#define	WT_CONFIG_ENTRY_session_rollback_transaction	25
-#define	WT_CONFIG_ENTRY_session_salvage					26
-#define	WT_CONFIG_ENTRY_session_strerror				27
-#define	WT_CONFIG_ENTRY_session_truncate				28
-#define	WT_CONFIG_ENTRY_session_upgrade					29
-#define	WT_CONFIG_ENTRY_session_verify					30
-#define	WT_CONFIG_ENTRY_table_meta						31
-#define	WT_CONFIG_ENTRY_wiredtiger_open					32
-#define	WT_CONFIG_ENTRY_wiredtiger_open_all				33
-#define	WT_CONFIG_ENTRY_wiredtiger_open_basecfg			34
-#define	WT_CONFIG_ENTRY_wiredtiger_open_usercfg			35
+#define	WT_CONFIG_ENTRY_connection_async_batch			5
+#define	WT_CONFIG_ENTRY_connection_async_new_op			6
+#define	WT_CONFIG_ENTRY_connection_close				7
+#define	WT_CONFIG_ENTRY_connection_load_extension		8
+#define	WT_CONFIG_ENTRY_connection_open_session			9
+#define	WT_CONFIG_ENTRY_connection_reconfigure			10
+#define	WT_CONFIG_ENTRY_cursor_close					11
+#define	WT_CONFIG_ENTRY_cursor_reconfigure				12
+#define	WT_CONFIG_ENTRY_file_meta						13
+#define	WT_CONFIG_ENTRY_index_meta						14
+#define	WT_CONFIG_ENTRY_session_begin_transaction		15
+#define	WT_CONFIG_ENTRY_session_checkpoint				16
+#define	WT_CONFIG_ENTRY_session_close					17
+#define	WT_CONFIG_ENTRY_session_commit_transaction		18
+#define	WT_CONFIG_ENTRY_session_compact					19
+#define	WT_CONFIG_ENTRY_session_create					20
+#define	WT_CONFIG_ENTRY_session_drop					21
+#define	WT_CONFIG_ENTRY_session_log_printf				22
+#define	WT_CONFIG_ENTRY_session_open_cursor				23
+#define	WT_CONFIG_ENTRY_session_reconfigure				24
+#define	WT_CONFIG_ENTRY_session_rename					25
+#define	WT_CONFIG_ENTRY_session_rollback_transaction	26
+#define	WT_CONFIG_ENTRY_session_salvage					27
+#define	WT_CONFIG_ENTRY_session_strerror				28
+#define	WT_CONFIG_ENTRY_session_truncate				29
+#define	WT_CONFIG_ENTRY_session_upgrade					30
+#define	WT_CONFIG_ENTRY_session_verify					31
+#define	WT_CONFIG_ENTRY_table_meta						32
+#define	WT_CONFIG_ENTRY_wiredtiger_open					33
+#define	WT_CONFIG_ENTRY_wiredtiger_open_all				34
+#define	WT_CONFIG_ENTRY_wiredtiger_open_basecfg			35
+#define	WT_CONFIG_ENTRY_wiredtiger_open_usercfg			36
 /*
  * configuration section: END
  * DO NOT EDIT: automatically built by dist/flags.py.
@@ -38,15 +38,19 @@
 #define	WT_SESSION_CHECK_PANIC(session)			WT_CONN_CHECK_PANIC(S2C(session))
 
 
-/*将dhandle插入到connection的main queue和hash queue*/
+/*
+ * 将dhandle插入到connection的main queue和hash queue，hash queue有不持有dhandle_lock的读者，
+ * dhandle必须在初始化完成后才能发布到hash queue的头上
+ */
 #define	WT_CONN_DHANDLE_INSERT(conn, dhandle, bucket) do {				\
-	SLIST_INSERT_HEAD(&(conn)->dhlh, dhandle, l);						\
-	SLIST_INSERT_HEAD(&(conn)->dhhash[bucket], dhandle, hashl);			\
+	TAILQ_INSERT_HEAD(&(conn)->dhlh, dhandle, l);						\
+	SLIST_NEXT(dhandle, hashl) = SLIST_FIRST(&(conn)->dhhash[bucket]);	\
+	WT_PUBLISH(SLIST_FIRST(&(conn)->dhhash[bucket]), dhandle);			\
 } while (0)
 
-/*将dhandle从connection的main queue和hash queue中删除*/
+/*将dhandle从connection的main queue和hash queue中删除，dhandle的hashl保持不变，正在读它的线程可以继续向后遍历*/
 #define	WT_CONN_DHANDLE_REMOVE(conn, dhandle, bucket) do {				\
-	SLIST_REMOVE(&(conn)->dhlh, dhandle, __wt_data_handle, l);			\
+	TAILQ_REMOVE(&(conn)->dhlh, dhandle, l);							\
 	SLIST_REMOVE(&(conn)->dhhash[bucket],								\
 	dhandle, __wt_data_handle, hashl);									\
 } while (0)
@@ -80,6 +84,7 @@ struct __wt_process
 	WT_SPINLOCK			spinlock;
 	TAILQ_HEAD(__wt_connection_impl_qh, __wt_connection_impl) connqh;
 	WT_CACHE_POOL*		cache_pool;
+	int					lex_compare_method;	/* Default collator implementation */
 };
 
 extern WT_PROCESS __wt_process;
@@ -144,6 +149,11 @@ struct __wt_connection_impl
 	WT_EXTENSION_API			extension_api;		/* Extension API */
 
 	const WT_CONFIG_ENTRY**		config_entries;
+	WT_CONFIG_ENTRY*			config_base_entries;/* Entries with compiled base configurations */
+	/* Compiled configurations, hashed by handle */
+	SLIST_HEAD(__wt_config_compiled_hash, __wt_config_compiled) config_compiled_hash[WT_HASH_ARRAY_SIZE];
+	/* Compiled configurations, hashed by configuration string */
+	SLIST_HEAD(__wt_config_compiled_strhash, __wt_config_compiled) config_compiled_strhash[WT_HASH_ARRAY_SIZE];
 
 	void**						foc;
 	size_t						foc_size;
@@ -155,7 +165,7 @@ struct __wt_connection_impl
 
 	SLIST_HEAD(__wt_dhhash, __wt_data_handle) dhhash[WT_HASH_ARRAY_SIZE];
 	/* Locked: data handle list */
-	SLIST_HEAD(__wt_dhandle_lh, __wt_data_handle) dhlh;
+	TAILQ_HEAD(__wt_dhandle_lh, __wt_data_handle) dhlh;
 
 	/* Locked: LSM handle list. */
 	TAILQ_HEAD(__wt_lsm_qh, __wt_lsm_tree) lsmqh;
@@ -179,8 +189,10 @@ struct __wt_connection_impl
 	uint32_t						session_cnt;	/* Session count */
 
 	size_t							session_scratch_max;	/* Max scratch memory per session */
+	u_int							session_cursor_cache;	/* Max cached cursors per session */
 
 	uint32_t						hazard_max;		/* Hazard array size */
+	volatile uint32_t				hazard_filter_cnt[WT_HAZARD_FILTER_BITS];	/* 每一位被置位的session个数 */
 	
 	WT_CACHE*						cache;
 	uint64_t						cache_size;
@@ -199,16 +211,20 @@ struct __wt_connection_impl
 	wt_off_t						ckpt_logsize;	/**/
 	uint32_t						ckpt_signalled;
 	uint64_t						ckpt_usecs;
+	u_int							ckpt_threads;	/* Checkpoint file worker threads */
 
 	int								compact_in_memory_pass;	/* Compaction serialization */
 
 	uint32_t						stat_flags;
 	WT_CONNECTION_STATS				stats;
+	WT_CONNECTION_STATS_SLOT*		stat_slots;		/* Per-session stat slots, cache-line aligned */
+	void*							stat_slots_mem;	/* Unaligned allocation of stat_slots */
 
 	WT_ASYNC*						async;		/* Async structure */
 	int								async_cfg;	/* Global async configuration */
 	uint32_t						async_size;	/* Async op array size */
 	uint32_t						async_workers;	/* Number of async workers */
+	uint32_t						async_workers_max;	/* Async worker limit */
 
 	WT_LSM_MANAGER					lsm_manager;	/* LSM worker thread information */
 
@@ -222,6 +238,26 @@ struct __wt_connection_impl
 	uint32_t						evict_workers;	/* Number of eviction workers */
 	WT_EVICT_WORKER*				evict_workctx;	/* Eviction worker context */
 
+	WT_SPINLOCK						compress_lock;	/* Block compression queue lock */
+	WT_CONDVAR*						compress_cond;	/* Block compression server wait mutex */
+	WT_CONDVAR*						compress_done_cond;/* Block compression job done mutex */
+	TAILQ_HEAD(__wt_compress_qh, __wt_compress_job) compress_qh;/* Block compression job queue */
+	uint32_t						compress_workers_alloc;/* Allocated block compression workers */
+	uint32_t						compress_workers;/* Number of block compression workers */
+	WT_COMPRESS_WORKER*				compress_workctx;/* Block compression worker context */
+
+	WT_SPINLOCK						readahead_lock;	/* Read-ahead queue lock */
+	WT_CONDVAR*						readahead_cond;	/* Read-ahead server wait mutex */
+	TAILQ_HEAD(__wt_readahead_qh, __wt_readahead_req) readahead_qh;/* Read-ahead request queue */
+	uint32_t						readahead_queued;/* Read-ahead requests in the queue */
+	uint32_t						readahead_depth;/* Maximum read-ahead depth */
+	uint32_t						readahead_workers_alloc;/* Allocated read-ahead workers */
+	uint32_t						readahead_workers;/* Number of read-ahead workers */
+	WT_READAHEAD_WORKER*			readahead_workctx;/* Read-ahead worker context */
+
+	WT_AIO*							aio;			/* io_uring asynchronous I/O */
+	WT_BLKCACHE*					blkcache;		/* Evicted page image cache */
+
 	WT_SESSION_IMPL*				stat_session;	/* Statistics log session */
 	wt_thread_t						stat_tid;	/* Statistics log thread */
 	int								stat_tid_set;	/* Statistics log thread set */
@@ -246,11 +282,16 @@ struct __wt_connection_impl
 	WT_SESSION_IMPL *				log_wrlsn_session;/* Log write lsn thread session */
 	wt_thread_t						log_wrlsn_tid;	/* Log write lsn thread thread */
 	int								log_wrlsn_tid_set;/* Log write lsn thread set */
+	WT_CONDVAR	*					log_flush_cond;/* Log flush thread wait mutex */
+	WT_SESSION_IMPL *				log_flush_session;/* Log flush thread session */
+	wt_thread_t						log_flush_tid;	/* Log flush thread thread */
+	int								log_flush_tid_set;/* Log flush thread set */
 	WT_LOG*							log;		/* Logging structure */
 	WT_COMPRESSOR*					log_compressor;/* Logging compressor */
 	wt_off_t						log_file_max;	/* Log file max size */
 	const char	*					log_path;	/* Logging path format */
 	uint32_t						log_prealloc;	/* Log file pre-allocation */
+	u_int							log_recover_threads;/* Log recovery worker threads */
 	uint32_t						txn_logsync;	/* Log sync configuration */
 
 	WT_SESSION_IMPL *				sweep_session;	/* Handle sweep session */
@@ -259,6 +300,7 @@ struct __wt_connection_impl
 	WT_CONDVAR	*					sweep_cond;	/* Handle sweep wait mutex */
 	time_t							sweep_idle_time;/* Handle sweep idle time */
 	time_t							sweep_interval;/* Handle sweep interval */
+	u_int							sweep_bucket;	/* Next dhhash bucket to sweep */
 
 	/* Locked: collator list */
 	TAILQ_HEAD(__wt_coll_qh, __wt_named_collator) collqh;
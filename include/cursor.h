@@ -15,6 +15,7 @@
 	reset,								\
 	search,								\
 	search_near,							\
+	search_batch,							\
 	insert,								\
 	update,								\
 	remove,								\
@@ -36,6 +37,7 @@
 	reset,								\
 	search,								\
 	(int (*)(WT_CURSOR *, int *))(search_near),			\
+	(int (*)(WT_CURSOR *, size_t, const WT_ITEM *, WT_ITEM *, int *))(search_batch),\
 	insert,								\
 	update,								\
 	remove,								\
@@ -48,6 +50,7 @@
 	NULL,				/* lang_private */		\
 		{ NULL, 0, 0, NULL, 0 },	/* WT_ITEM key */		\
 		{ NULL, 0, 0, NULL, 0 },	/* WT_ITEM value */		\
+		{ NULL, 0, 0, NULL, 0 },	/* WT_ITEM batch */		\
 	0,				/* int saved_err */		\
 	NULL,				/* internal_uri */		\
 	0				/* uint32_t flags */		\
@@ -120,6 +123,26 @@ struct __wt_cursor_btree
 
 	WT_UPDATE*		modify_update;
 
+	/*
+	 * 顺序扫描的read-ahead状态，ra_home只用来判断是否还在同一个parent page下，
+	 * 不会被访问。ra_limit是scan方向上已经提交过read-ahead的边界slot，ra_mask按
+	 * slot % WT_READAHEAD_MAX记录还没有被cursor到达的read-ahead page
+	 */
+	WT_PAGE*		ra_home;
+	uint64_t		ra_mask;
+	uint32_t		ra_slot;
+	uint32_t		ra_limit;
+	uint32_t		ra_seq;							/*连续顺序移动的page数*/
+	uint32_t		ra_depth;						/*当前的read-ahead深度*/
+	uint32_t		ra_hits;
+	uint32_t		ra_misses;
+	uint8_t			ra_prev;						/*扫描方向*/
+
+	/*session cursor cache的key和重用时恢复的状态*/
+	char*			cache_cfg;						/*open_cursor的配置字符串*/
+	uint32_t		cache_flags;					/*open时的cursor flags*/
+	uint32_t		cache_gen;						/*park时btree的open_gen*/
+
 	uint8_t			v;
 	uint8_t			append_tree;
 
@@ -26,13 +26,15 @@
 struct __wt_data_handle
 {
 	WT_RWLOCK*					rwlock;	
-	SLIST_ENTRY(__wt_data_handle) l;
+	TAILQ_ENTRY(__wt_data_handle) l;
 	SLIST_ENTRY(__wt_data_handle) hashl;
 
 
 	uint32_t					session_ref;		/* Sessions referencing this handle */
+	volatile uint32_t			removing;			/* Being removed from the connection lists */
 	int32_t						session_inuse;		/* Sessions using this handle */
 	time_t						timeofdeath;		/* Use count went to 0 */
+	uint32_t					open_gen;			/* Incremented each time the btree is opened */
 
 	uint64_t					name_hash;			/* Hash of name */
 	const char*					name;				/* Object name as a URI */
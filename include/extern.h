@@ -1,11 +1,13 @@
 /* DO NOT EDIT: automatically built by dist/s_prototypes. */
 
 extern void __wt_async_stats_update(WT_SESSION_IMPL *session);
+extern void __wt_async_stats_clear(WT_SESSION_IMPL *session);
 extern int __wt_async_create(WT_SESSION_IMPL *session, const char *cfg[]);
 extern int __wt_async_reconfig(WT_SESSION_IMPL *session, const char *cfg[]);
 extern int __wt_async_destroy(WT_SESSION_IMPL *session);
 extern int __wt_async_flush(WT_SESSION_IMPL *session);
 extern int __wt_async_new_op(WT_SESSION_IMPL *session, const char *uri, const char *config, const char *cfg[], WT_ASYNC_CALLBACK *cb, WT_ASYNC_OP_IMPL **opp);
+extern int __wt_async_batch(WT_SESSION_IMPL *session, const char *uri, const char *config, const char *cfg[], WT_ASYNC_CALLBACK *cb, WT_ASYNC_BATCH_OP *ops, uint32_t nops);
 extern int __wt_async_op_enqueue(WT_SESSION_IMPL *session, WT_ASYNC_OP_IMPL *op);
 extern int __wt_async_op_init(WT_SESSION_IMPL *session);
 extern WT_THREAD_RET __wt_async_worker(void *arg);
@@ -13,6 +15,12 @@ extern int __wt_block_addr_to_buffer(WT_BLOCK *block, uint8_t **pp, wt_off_t off
 extern int __wt_block_buffer_to_addr(WT_BLOCK *block, const uint8_t *p, wt_off_t *offsetp, uint32_t *sizep, uint32_t *cksump);
 extern int __wt_block_addr_valid(WT_SESSION_IMPL *session, WT_BLOCK *block, const uint8_t *addr, size_t addr_size, int live);
 extern int __wt_block_addr_string(WT_SESSION_IMPL *session, WT_BLOCK *block, WT_ITEM *buf, const uint8_t *addr, size_t addr_size);
+extern int __wt_blkcache_create(WT_SESSION_IMPL *session, const char *cfg[]);
+extern int __wt_blkcache_destroy(WT_SESSION_IMPL *session);
+extern int __wt_blkcache_get(WT_SESSION_IMPL *session, WT_BLOCK *block, const uint8_t *addr, size_t addr_size, WT_ITEM *buf);
+extern int __wt_blkcache_put(WT_SESSION_IMPL *session, WT_BLOCK *block, const uint8_t *addr, size_t addr_size, const void *hdr, size_t hdr_size, const void *data, size_t data_size);
+extern void __wt_blkcache_remove(WT_SESSION_IMPL *session, WT_BLOCK *block, wt_off_t offset);
+extern void __wt_blkcache_discard(WT_SESSION_IMPL *session, WT_BLOCK *block);
 extern int __wt_block_buffer_to_ckpt(WT_SESSION_IMPL *session, WT_BLOCK *block, const uint8_t *p, WT_BLOCK_CKPT *ci);
 extern int __wt_block_ckpt_to_buffer(WT_SESSION_IMPL *session, WT_BLOCK *block, uint8_t **pp, WT_BLOCK_CKPT *ci);
 extern int __wt_block_ckpt_init( WT_SESSION_IMPL *session, WT_BLOCK_CKPT *ci, const char *name);
@@ -29,6 +37,10 @@ extern int __wt_block_misplaced(WT_SESSION_IMPL *session, WT_BLOCK *block, const
 extern int __wt_block_off_remove_overlap( WT_SESSION_IMPL *session, WT_EXTLIST *el, wt_off_t off, wt_off_t size);
 extern int __wt_block_alloc( WT_SESSION_IMPL *session, WT_BLOCK *block, wt_off_t *offp, wt_off_t size);
 extern int __wt_block_free(WT_SESSION_IMPL *session, WT_BLOCK *block, const uint8_t *addr, size_t addr_size);
+extern int __wt_block_shards_flush(WT_SESSION_IMPL *session, WT_BLOCK *block, int retire);
+extern void __wt_block_shards_discard(WT_BLOCK *block);
+extern int __wt_block_shard_refill(WT_SESSION_IMPL *session, WT_BLOCK *block, WT_BLOCK_SHARD *shard, wt_off_t size);
+extern int __wt_block_shard_free(WT_SESSION_IMPL *session, WT_BLOCK *block, wt_off_t offset, wt_off_t size);
 extern int __wt_block_off_free( WT_SESSION_IMPL *session, WT_BLOCK *block, wt_off_t offset, wt_off_t size);
 extern int __wt_block_extlist_check( WT_SESSION_IMPL *session, WT_EXTLIST *al, WT_EXTLIST *bl);
 extern int __wt_block_extlist_overlap( WT_SESSION_IMPL *session, WT_BLOCK *block, WT_BLOCK_CKPT *ci);
@@ -83,6 +95,7 @@ extern int __wt_bloom_hash_get(WT_BLOOM *bloom, WT_BLOOM_HASH *bhash);
 extern int __wt_bloom_get(WT_BLOOM *bloom, WT_ITEM *key);
 extern int __wt_bloom_close(WT_BLOOM *bloom);
 extern int __wt_bloom_drop(WT_BLOOM *bloom, const char *config);
+extern void __wt_bloom_bits_free(WT_SESSION_IMPL *session, WT_BLOOM_BITS **bitsp);
 extern int __wt_compact(WT_SESSION_IMPL *session, const char *cfg[]);
 extern int __wt_compact_page_skip(WT_SESSION_IMPL *session, WT_REF *ref, int *skipp);
 extern void __wt_btcur_iterate_setup(WT_CURSOR_BTREE *cbt, int next);
@@ -90,6 +103,7 @@ extern int __wt_btcur_next(WT_CURSOR_BTREE *cbt, int truncating);
 extern int __wt_btcur_prev(WT_CURSOR_BTREE *cbt, int truncating);
 extern int __wt_btcur_reset(WT_CURSOR_BTREE *cbt);
 extern int __wt_btcur_search(WT_CURSOR_BTREE *cbt);
+extern int __wt_btcur_search_batch(WT_CURSOR_BTREE *cbt, size_t count, const WT_ITEM *keys, WT_ITEM *values, int *results);
 extern int __wt_btcur_search_near(WT_CURSOR_BTREE *cbt, int *exactp);
 extern int __wt_btcur_insert(WT_CURSOR_BTREE *cbt);
 extern int __wt_btcur_update_check(WT_CURSOR_BTREE *cbt);
@@ -128,7 +142,13 @@ extern int __wt_huffman_confchk(WT_SESSION_IMPL *session, WT_CONFIG_ITEM *v);
 extern int __wt_btree_huffman_open(WT_SESSION_IMPL *session);
 extern void __wt_btree_huffman_close(WT_SESSION_IMPL *session);
 extern int __wt_bt_read(WT_SESSION_IMPL *session, WT_ITEM *buf, const uint8_t *addr, size_t addr_size);
+extern int __wt_bt_blkcache_put(WT_SESSION_IMPL *session, WT_REF *ref);
 extern int __wt_bt_write(WT_SESSION_IMPL *session, WT_ITEM *buf, uint8_t *addr, size_t *addr_sizep, int checkpoint, int compressed);
+extern int __wt_bt_compress_submit(WT_SESSION_IMPL *session, WT_ITEM *buf, WT_COMPRESS_JOB *job, int *submittedp);
+extern int __wt_bt_compress_write(WT_SESSION_IMPL *session, WT_COMPRESS_JOB *job, uint8_t *addr, size_t *addr_sizep);
+extern int __wt_bt_compress_discard(WT_SESSION_IMPL *session, WT_COMPRESS_JOB *job);
+extern int __wt_bt_compress_create(WT_SESSION_IMPL *session, const char *cfg[]);
+extern int __wt_bt_compress_destroy(WT_SESSION_IMPL *session);
 extern const char *__wt_page_type_string(u_int type);
 extern const char *__wt_cell_type_string(uint8_t type);
 extern const char *__wt_page_addr_string(WT_SESSION_IMPL *session, WT_REF *ref, WT_ITEM *buf);
@@ -140,10 +160,14 @@ extern int __wt_page_in_func(WT_SESSION_IMPL *session, WT_REF *ref, uint32_t fla
 extern int __wt_page_alloc(WT_SESSION_IMPL *session, uint8_t type, uint64_t recno, uint32_t alloc_entries, int alloc_refs, WT_PAGE **pagep);
 extern int __wt_page_inmem(WT_SESSION_IMPL *session, WT_REF *ref, const void *image, size_t memsize, uint32_t flags, WT_PAGE **pagep);
 extern int __wt_cache_read(WT_SESSION_IMPL *session, WT_REF *ref);
+extern int __wt_btcur_readahead(WT_CURSOR_BTREE *cbt, int prev);
+extern int __wt_readahead_create(WT_SESSION_IMPL *session, const char *cfg[]);
+extern int __wt_readahead_destroy(WT_SESSION_IMPL *session);
 extern int __wt_kv_return(WT_SESSION_IMPL *session, WT_CURSOR_BTREE *cbt, WT_UPDATE *upd);
 extern int __wt_bt_salvage(WT_SESSION_IMPL *session, WT_CKPT *ckptbase, const char *cfg[]);
 extern void __wt_split_stash_discard(WT_SESSION_IMPL *session);
 extern void __wt_split_stash_discard_all( WT_SESSION_IMPL *session_safe, WT_SESSION_IMPL *session);
+extern int __wt_split_safe_free_deferred(WT_SESSION_IMPL *session, void *p, size_t s);
 extern int __wt_multi_to_ref(WT_SESSION_IMPL *session, WT_PAGE *page, WT_MULTI *multi, WT_REF **refp, size_t *incrp);
 extern int __wt_split_insert(WT_SESSION_IMPL *session, WT_REF *ref, int *splitp);
 extern int __wt_split_rewrite(WT_SESSION_IMPL *session, WT_REF *ref);
@@ -187,6 +211,11 @@ extern int __wt_config_subgetraw(WT_SESSION_IMPL *session, WT_CONFIG_ITEM *cfg,
 extern int __wt_config_subgets(WT_SESSION_IMPL *session, WT_CONFIG_ITEM *cfg, const char *key, WT_CONFIG_ITEM *value);
 extern void __wt_conn_foc_discard(WT_SESSION_IMPL *session);
 extern int __wt_configure_method(WT_SESSION_IMPL *session, const char *method, const char *uri, const char *config, const char *type, const char *check);
+extern int __wt_config_compile_init(WT_SESSION_IMPL *session, const WT_CONFIG_ENTRY *entries, size_t entries_count);
+extern void __wt_config_compile_destroy(WT_SESSION_IMPL *session);
+extern int __wt_config_compile_method(WT_SESSION_IMPL *session, const char *method, const char *config, const char **handlep);
+extern WT_CONFIG_COMPILED *__wt_config_compiled_find(WT_SESSION_IMPL *session, const char *config);
+extern const WT_CONFIG_COMPILED_ITEM *__wt_config_compiled_get(WT_CONFIG_COMPILED *compiled, const WT_CONFIG_ITEM *key);
 extern int __wt_config_check(WT_SESSION_IMPL *session, const WT_CONFIG_ENTRY *entry, const char *config, size_t config_len);
 extern int __wt_config_collapse( WT_SESSION_IMPL *session, const char **cfg, char **config_ret);
 extern int __wt_config_merge( WT_SESSION_IMPL *session, const char **cfg, const char **config_ret);
@@ -220,6 +249,7 @@ extern int __wt_checkpoint_server_create(WT_SESSION_IMPL *session, const char *c
 extern int __wt_checkpoint_server_destroy(WT_SESSION_IMPL *session);
 extern int __wt_checkpoint_signal(WT_SESSION_IMPL *session, wt_off_t logsize);
 extern int __wt_conn_dhandle_find(WT_SESSION_IMPL *session, const char *name, const char *ckpt, uint32_t flags);
+extern int __wt_conn_dhandle_lookup(WT_SESSION_IMPL *session, const char *name, const char *ckpt);
 extern int __wt_conn_btree_sync_and_close(WT_SESSION_IMPL *session, int final, int force);
 extern int __wt_conn_btree_get(WT_SESSION_IMPL *session, const char *name, const char *ckpt, const char *cfg[], uint32_t flags);
 extern int __wt_conn_btree_apply(WT_SESSION_IMPL *session, int apply_checkpoints, const char *uri, int (*func)(WT_SESSION_IMPL *, const char *[]), const char *cfg[]);
@@ -238,6 +268,8 @@ extern int __wt_connection_open(WT_CONNECTION_IMPL *conn, const char *cfg[]);
 extern int __wt_connection_close(WT_CONNECTION_IMPL *conn);
 extern int __wt_connection_workers(WT_SESSION_IMPL *session, const char *cfg[]);
 extern void __wt_conn_stat_init(WT_SESSION_IMPL *session);
+extern void __wt_conn_stat_slots_sum(WT_SESSION_IMPL *session, WT_CONNECTION_STATS *stats);
+extern void __wt_conn_stat_slots_clear(WT_SESSION_IMPL *session);
 extern int __wt_statlog_log_one(WT_SESSION_IMPL *session);
 extern int __wt_statlog_create(WT_SESSION_IMPL *session, const char *cfg[]);
 extern int __wt_statlog_destroy(WT_SESSION_IMPL *session, int is_close);
@@ -254,6 +286,9 @@ extern int __wt_curdump_create(WT_CURSOR *child, WT_CURSOR *owner, WT_CURSOR **c
 extern int __wt_curfile_update_check(WT_CURSOR *cursor);
 extern int __wt_curfile_create(WT_SESSION_IMPL *session, WT_CURSOR *owner, const char *cfg[], int bulk, int bitmap, WT_CURSOR **cursorp);
 extern int __wt_curfile_open(WT_SESSION_IMPL *session, const char *uri, WT_CURSOR *owner, const char *cfg[], WT_CURSOR **cursorp);
+extern int __wt_curfile_cache_prepare(WT_SESSION_IMPL *session, WT_CURSOR *cursor, const char *config);
+extern int __wt_curfile_cache_get(WT_SESSION_IMPL *session, const char *uri, const char *cfg[], WT_CURSOR **cursorp);
+extern void __wt_curfile_cache_discard(WT_SESSION_IMPL *session, WT_DATA_HANDLE *dhandle);
 extern int __wt_curindex_open(WT_SESSION_IMPL *session, const char *uri, WT_CURSOR *owner, const char *cfg[], WT_CURSOR **cursorp);
 extern int __wt_json_alloc_unpack(WT_SESSION_IMPL *session, const void *buffer, size_t size, const char *fmt, WT_CURSOR_JSON *json, int iskey, va_list ap);
 extern void __wt_json_close(WT_SESSION_IMPL *session, WT_CURSOR *cursor);
@@ -277,6 +312,8 @@ extern int __wt_cursor_get_key(WT_CURSOR *cursor, ...);
 extern void __wt_cursor_set_key(WT_CURSOR *cursor, ...);
 extern int __wt_cursor_get_raw_key(WT_CURSOR *cursor, WT_ITEM *key);
 extern void __wt_cursor_set_raw_key(WT_CURSOR *cursor, WT_ITEM *key);
+extern int __wt_cursor_batch_search(WT_CURSOR *cursor, WT_COLLATOR *collator, size_t count, const WT_ITEM *keys, WT_ITEM *values, int *results, int (*lookup)(WT_CURSOR *, WT_ITEM *));
+extern int __wt_cursor_search_batch(WT_CURSOR *cursor, size_t count, const WT_ITEM *keys, WT_ITEM *values, int *results);
 extern int __wt_cursor_get_raw_value(WT_CURSOR *cursor, WT_ITEM *value);
 extern void __wt_cursor_set_raw_value(WT_CURSOR *cursor, WT_ITEM *value);
 extern int __wt_cursor_get_keyv(WT_CURSOR *cursor, uint32_t flags, va_list ap);
@@ -319,6 +356,7 @@ extern int __wt_log_allocfile( WT_SESSION_IMPL *session, uint32_t lognum, const
 extern int __wt_log_remove(WT_SESSION_IMPL *session, const char *file_prefix, uint32_t lognum);
 extern int __wt_log_open(WT_SESSION_IMPL *session);
 extern int __wt_log_close(WT_SESSION_IMPL *session);
+extern int __wt_log_wrlsn(WT_SESSION_IMPL *session, uint32_t *advancedp);
 extern int __wt_log_newfile(WT_SESSION_IMPL *session, int conn_create, int *created);
 extern int __wt_log_read(WT_SESSION_IMPL *session, WT_ITEM *record, WT_LSN *lsnp, uint32_t flags);
 extern int __wt_log_scan(WT_SESSION_IMPL *session, WT_LSN *lsnp, uint32_t flags, int (*func)(WT_SESSION_IMPL *session, WT_ITEM *record, WT_LSN *lsnp, WT_LSN *next_lsnp, void *cookie, int firstrecord), void *cookie);
@@ -484,6 +522,10 @@ extern int __wt_remove(WT_SESSION_IMPL *session, const char *name);
 extern int __wt_rename(WT_SESSION_IMPL *session, const char *from, const char *to);
 extern int __wt_read( WT_SESSION_IMPL *session, WT_FH *fh, wt_off_t offset, size_t len, void *buf);
 extern int __wt_write(WT_SESSION_IMPL *session, WT_FH *fh, wt_off_t offset, size_t len, const void *buf);
+extern int __wt_aio_create(WT_SESSION_IMPL *session, const char *cfg[]);
+extern int __wt_aio_destroy(WT_SESSION_IMPL *session);
+extern int __wt_aio_submit(WT_SESSION_IMPL *session, WT_AIO_REQ *req, WT_FH *fh, int write, wt_off_t offset, size_t len, void *buf);
+extern int __wt_aio_wait(WT_SESSION_IMPL *session, WT_AIO_REQ *req);
 extern void __wt_sleep(uint64_t seconds, uint64_t micro_seconds);
 
 extern int __wt_fopen(WT_SESSION_IMPL *session, const char *name, WT_FHANDLE_MODE mode_flag, u_int flags, FILE **fpp);
@@ -599,6 +641,7 @@ extern int __wt_nfilename( WT_SESSION_IMPL *session, const char *name, size_t na
 extern int __wt_remove_if_exists(WT_SESSION_IMPL *session, const char *name);
 extern int __wt_sync_and_rename_fh( WT_SESSION_IMPL *session, WT_FH **fhp, const char *from, const char *to);
 extern int __wt_sync_and_rename_fp( WT_SESSION_IMPL *session, FILE **fpp, const char *from, const char *to);
+extern void __wt_lex_compare_init(void);
 extern int __wt_library_init(void);
 extern int __wt_breakpoint(void);
 extern void __wt_attach(WT_SESSION_IMPL *session);
@@ -12,11 +12,13 @@
 #define	WT_CONN_PANIC					0x00000080
 #define	WT_CONN_SERVER_ASYNC				0x00000100
 #define	WT_CONN_SERVER_CHECKPOINT			0x00000200
-#define	WT_CONN_SERVER_LSM				0x00000400
-#define	WT_CONN_SERVER_RUN				0x00000800
-#define	WT_CONN_SERVER_STATISTICS			0x00001000
-#define	WT_CONN_SERVER_SWEEP				0x00002000
-#define	WT_CONN_WAS_BACKUP				0x00004000
+#define	WT_CONN_SERVER_COMPRESS			0x00000400
+#define	WT_CONN_SERVER_LSM				0x00000800
+#define	WT_CONN_SERVER_READAHEAD			0x00001000
+#define	WT_CONN_SERVER_RUN				0x00002000
+#define	WT_CONN_SERVER_STATISTICS			0x00004000
+#define	WT_CONN_SERVER_SWEEP				0x00008000
+#define	WT_CONN_WAS_BACKUP				0x00010000
 #define	WT_EVICTING					0x00000001
 #define	WT_FILE_TYPE_CHECKPOINT				0x00000001
 #define	WT_FILE_TYPE_DATA				0x00000002
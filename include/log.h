@@ -84,7 +84,7 @@
 
 #define LOG_FIRST_RECORD	log->allocsize
 
-#define	SLOT_ACTIVE			1
+#define	SLOT_ACTIVE			4		/* Slots threads can join concurrently */
 #define	SLOT_POOL			16
 
 #define	WT_LOG_FORCE_CONSOLIDATE	0x01	/* Disable direct writes */
@@ -110,6 +110,13 @@ typedef /*WT_COMPILER_TYPE_ALIGN(WT_CACHE_LINE_ALIGNMENT)*/ struct
 	uint32_t			flags;						/* slot flags,主要是对slot的一些调整操作标识*/	
 } WT_LOGSLOT;
 
+/*written slot按照release lsn排序用的结构*/
+typedef struct
+{
+	WT_LSN				lsn;
+	uint32_t			slot_index;
+} WT_LOG_WRLSN_ENTRY;
+
 /*WT_MYSLOT结构*/
 typedef struct 
 {
@@ -140,11 +147,16 @@ typedef struct
 	WT_LSN				sync_lsn;					/* 日志文件最后一次sync LSN位置*/
 	WT_LSN				trunc_lsn;					/* 在恢复过程中，如果有日志数据损坏，那么需要截掉这个位置后的所有日志文件，表示开始截掉数据的LSN*/
 	WT_LSN				write_lsn;					/* 最后一次写日志的LSN位置 */
+	WT_LSN				sync_req_lsn;				/* 等待flush thread fsync的最大LSN */
+	WT_LSN				sync_dir_req_lsn;			/* 等待flush thread sync dir的最大LSN */
+	volatile int		flush_ret;					/* flush thread退出时的错误，非0时不再向它提交请求 */
 
 	/*log对象的线程同步latch*/
 	WT_SPINLOCK			log_lock;					/* Locked: Logging fields */
 	WT_SPINLOCK			log_slot_lock;				/* Locked: Consolidation array */
 	WT_SPINLOCK			log_sync_lock;				/* Locked: Single-thread fsync */
+	WT_SPINLOCK			log_wrlsn_lock;				/* Locked: Advance write_lsn */
+	WT_SPINLOCK			log_flush_lock;				/* Locked: Flush requests */
 
 	WT_RWLOCK*			log_archive_lock;			/* Archive and log cursors */
 
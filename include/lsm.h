@@ -28,7 +28,6 @@ struct __wt_lsm_worker_args
 #define	WT_CLSM_ITERATE_PREV    0x04    /* Backward iteration */
 #define	WT_CLSM_MERGE           0x08    /* Merge cursor, don't update */
 #define	WT_CLSM_MINOR_MERGE		0x10    /* Minor merge, include tombstones */
-#define	WT_CLSM_MULTIPLE        0x20    /* Multiple cursors have values for the current key */
 #define	WT_CLSM_OPEN_READ		0x40    /* Open for reads */
 #define	WT_CLSM_OPEN_SNAPSHOT	0x80    /* Open for snapshot isolation */
 
@@ -49,6 +48,9 @@ struct __wt_cursor_lsm
 	size_t			cursor_alloc;
 
 	WT_CURSOR*		current;     				/* The current cursor for iteration */
+	u_int*			heap;						/* 迭代时按照key排序的chunk cursor下标(二叉堆) */
+	size_t			heap_alloc;
+	u_int			heap_entries;				/* 堆中有效的cursor个数 */
 	WT_LSM_CHUNK*	primary_chunk;				/* The current primary chunk */
 
 	uint64_t*		switch_txn;					/* Switch txn for each chunk */
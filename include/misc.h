@@ -6,6 +6,7 @@
 #define WT_UNUSED(var)		(void)(var)
 
 /*一些基本的数量级常量*/
+#define	WT_THOUSAND	(1000)
 #define	WT_MILLION	(1000000)
 #define	WT_BILLION	(1000000000)
 
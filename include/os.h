@@ -90,3 +90,59 @@ struct __wt_fh
 	int				fallocate_requires_locking;
 };
 
+/*
+ * 一个异步I/O请求，由__wt_aio_submit提交，__wt_aio_wait等待完成。没有配置io_uring
+ * 或者队列已满时，__wt_aio_submit直接做同步的__wt_read/__wt_write
+ */
+struct __wt_aio_req
+{
+	WT_FH*			fh;
+	wt_off_t		offset;
+	size_t			len;
+	void*			buf;
+	int				write;
+
+	struct iovec	iov;							/*提交给io_uring的readv/writev参数*/
+	int64_t			res;							/*完成队列返回的结果，<0是-errno*/
+	volatile int	done;
+};
+
+/*
+ * connection共享的io_uring实例，多个线程在lock保护下向提交队列提交请求，
+ * 完成队列在cq_lock保护下由完成线程消费，完成线程设置请求的done并唤醒等待者。
+ * io_uring出错以后等待者自己消费完成队列。
+ * sqes和cqes的类型定义在<linux/io_uring.h>中，这里不直接引用
+ */
+struct __wt_aio
+{
+	int				ring_fd;
+	uint32_t		entries;						/*提交队列的长度*/
+	volatile uint32_t inflight;						/*已经提交但是还没有完成的请求数*/
+	int				broken;							/*io_uring_enter失败后不再使用，全部走同步I/O*/
+
+	WT_SPINLOCK		lock;							/*提交队列的锁*/
+	WT_SPINLOCK		cq_lock;						/*完成队列的锁*/
+	WT_CONDVAR*		cond;							/*请求完成的通知*/
+
+	void*			sq_ring;
+	size_t			sq_ring_size;
+	uint32_t*		sq_head;
+	uint32_t*		sq_tail;
+	uint32_t*		sq_array;
+	uint32_t		sq_mask;
+	void*			sqes;
+	size_t			sqes_size;
+
+	void*			cq_ring;
+	size_t			cq_ring_size;
+	uint32_t*		cq_head;
+	uint32_t*		cq_tail;
+	uint32_t		cq_mask;
+	void*			cqes;
+
+	WT_SESSION_IMPL* session;						/*完成线程的session*/
+	wt_thread_t		tid;
+	int				tid_set;
+	volatile int	running;
+};
+
@@ -25,6 +25,16 @@ struct __wt_hazard
 #define	S2BT(session)	   ((WT_BTREE *)(session)->dhandle->handle)
 #define	S2BT_SAFE(session) ((session)->dhandle == NULL ? NULL : S2BT(session))
 
+/*
+ * 每个session按照page地址把自己持有的hazard pointer发布到一个位图中，位图只由session
+ * 自己用普通的store修改。session的某一位从0变成1(或者从1变成0)时同时增减connection上
+ * 这一位的计数，eviction检查page时先读这一个计数，为0就不需要扫描任何session
+ */
+#define	WT_HAZARD_FILTER_BITS	256
+#define	WT_HAZARD_FILTER_BIT(page)										\
+	((uint32_t)((((uintptr_t)(page) >> 6) ^ ((uintptr_t)(page) >> 14)) & (WT_HAZARD_FILTER_BITS - 1)))
+#define	WT_HAZARD_FILTER_MASK(bit)	((uint64_t)1 << ((bit) & 63))
+
 /*定义session结构, WT_COMPILER_TYPE_ALIGN(WT_CACHE_LINE_ALIGNMENT)*/
 struct __wt_session_impl
 {
@@ -47,6 +57,10 @@ struct __wt_session_impl
 	WT_CURSOR*				cursor;
 	TAILQ_HEAD(__cursors, __wt_cursor) cursors;
 
+	/*close后等待重用的file cursor，按最近close的顺序排列*/
+	TAILQ_HEAD(__cursor_cache, __wt_cursor) cursor_cache;
+	u_int					ncursors_cached;
+
 	WT_CURSOR_BACKUP*		bkp_cursor;
 	WT_COMPACT*				compact;
 
@@ -114,5 +128,8 @@ struct __wt_session_impl
 	uint32_t				hazard_size;
 	uint32_t				nhazard;
 	WT_HAZARD*				hazard;
+
+	uint64_t				hazard_filter[WT_HAZARD_FILTER_BITS / 64];	/* 已发布hazard pointer的page位图 */
+	uint16_t				hazard_filter_cnt[WT_HAZARD_FILTER_BITS];	/* 位图中每一位的hazard pointer个数 */
 };
 /**************************************************************/
@@ -70,22 +70,32 @@ struct __wt_stats
 } while (0)
 
 
+/*
+ * connection的统计值按session分片累加，每个分片按cache line对齐，避免所有线程写同一组
+ * cache line。读取统计值时(stat cursor和statistics_log)再把conn->stats和所有分片累加起来。
+ * SET类型的统计值(最大值、当前值等)只写在conn->stats中，不会累加到分片中
+ */
+#define	WT_STAT_CONN_SLOTS		23
+
+#define	WT_STAT_CONN_SLOT(session)					\
+	(&S2C(session)->stat_slots[(session)->id % WT_STAT_CONN_SLOTS].stats)
+
 #define	WT_STAT_FAST_CONN_ATOMIC_DECRV(session, fld, value)		\
-	WT_STAT_FAST_ATOMIC_DECRV(session, &S2C(session)->stats, fld, value)
+	WT_STAT_FAST_ATOMIC_DECRV(session, WT_STAT_CONN_SLOT(session), fld, value)
 #define	WT_STAT_FAST_CONN_ATOMIC_DECR(session, fld)			\
-	WT_STAT_FAST_ATOMIC_DECR(session, &S2C(session)->stats, fld)
+	WT_STAT_FAST_ATOMIC_DECR(session, WT_STAT_CONN_SLOT(session), fld)
 #define	WT_STAT_FAST_CONN_ATOMIC_INCRV(session, fld, value)		\
-	WT_STAT_FAST_ATOMIC_INCRV(session, &S2C(session)->stats, fld, value)
+	WT_STAT_FAST_ATOMIC_INCRV(session, WT_STAT_CONN_SLOT(session), fld, value)
 #define	WT_STAT_FAST_CONN_ATOMIC_INCR(session, fld)			\
-	WT_STAT_FAST_ATOMIC_INCR(session, &S2C(session)->stats, fld)
+	WT_STAT_FAST_ATOMIC_INCR(session, WT_STAT_CONN_SLOT(session), fld)
 #define	WT_STAT_FAST_CONN_DECR(session, fld)				\
-	WT_STAT_FAST_DECR(session, &S2C(session)->stats, fld)
+	WT_STAT_FAST_DECR(session, WT_STAT_CONN_SLOT(session), fld)
 #define	WT_STAT_FAST_CONN_DECRV(session, fld, value)			\
-	WT_STAT_FAST_DECRV(session, &S2C(session)->stats, fld, value)
+	WT_STAT_FAST_DECRV(session, WT_STAT_CONN_SLOT(session), fld, value)
 #define	WT_STAT_FAST_CONN_INCR(session, fld)				\
-	WT_STAT_FAST_INCR(session, &S2C(session)->stats, fld)
+	WT_STAT_FAST_INCR(session, WT_STAT_CONN_SLOT(session), fld)
 #define	WT_STAT_FAST_CONN_INCRV(session, fld, value)			\
-	WT_STAT_FAST_INCRV(session, &S2C(session)->stats, fld, value)
+	WT_STAT_FAST_INCRV(session, WT_STAT_CONN_SLOT(session), fld, value)
 #define	WT_STAT_FAST_CONN_SET(session, fld, value)			\
 	WT_STAT_FAST_SET(session, &S2C(session)->stats, fld, value)
 
@@ -110,6 +120,7 @@ struct __wt_stats
 	session, &(session)->dhandle->stats, fld, value);	\
 } while (0)
 
+/*只用于读取SET类型的统计值*/
 #define	WT_CONN_STAT(session, fld)	WT_STAT(&S2C(session)->stats, fld)
 
 #define WT_CONNECTION_STATS_BASE 1000
@@ -117,6 +128,9 @@ struct __wt_stats
 /*connection stat*/
 struct __wt_connection_stats 
 {
+	WT_STATS aio_reap_wait;
+	WT_STATS aio_submit;
+	WT_STATS aio_sync;
 	WT_STATS async_alloc_race;
 	WT_STATS async_alloc_view;
 	WT_STATS async_cur_queue;
@@ -125,17 +139,34 @@ struct __wt_connection_stats
 	WT_STATS async_max_queue;
 	WT_STATS async_nowork;
 	WT_STATS async_op_alloc;
+	WT_STATS async_op_batch;
+	WT_STATS async_op_batch_ops;
 	WT_STATS async_op_compact;
 	WT_STATS async_op_insert;
 	WT_STATS async_op_remove;
 	WT_STATS async_op_search;
 	WT_STATS async_op_update;
+	WT_STATS async_queue_latency_max;
+	WT_STATS async_queue_latency_p50;
+	WT_STATS async_queue_latency_p90;
+	WT_STATS async_queue_latency_p99;
+	WT_STATS async_worker_park;
+	WT_STATS async_worker_wakeup;
 	WT_STATS block_byte_map_read;
 	WT_STATS block_byte_read;
 	WT_STATS block_byte_write;
+	WT_STATS block_cache_bytes;
+	WT_STATS block_cache_evict;
+	WT_STATS block_cache_hit;
+	WT_STATS block_cache_insert;
+	WT_STATS block_cache_miss;
+	WT_STATS block_cache_remove;
 	WT_STATS block_map_read;
 	WT_STATS block_preload;
 	WT_STATS block_read;
+	WT_STATS block_shard_alloc;
+	WT_STATS block_shard_free_flush;
+	WT_STATS block_shard_refill;
 	WT_STATS block_write;
 	WT_STATS cache_bytes_dirty;
 	WT_STATS cache_bytes_internal;
@@ -150,28 +181,47 @@ struct __wt_connection_stats
 	WT_STATS cache_eviction_clean;
 	WT_STATS cache_eviction_deepen;
 	WT_STATS cache_eviction_dirty;
+	WT_STATS cache_eviction_dirty_skew;
 	WT_STATS cache_eviction_fail;
 	WT_STATS cache_eviction_force;
 	WT_STATS cache_eviction_force_delete;
 	WT_STATS cache_eviction_force_fail;
 	WT_STATS cache_eviction_hazard;
+	WT_STATS cache_eviction_hazard_scan;
 	WT_STATS cache_eviction_internal;
 	WT_STATS cache_eviction_maximum_page_size;
 	WT_STATS cache_eviction_queue_empty;
 	WT_STATS cache_eviction_queue_not_empty;
+	WT_STATS cache_eviction_queue_steal;
+	WT_STATS cache_eviction_select;
+	WT_STATS cache_eviction_select_time_max;
+	WT_STATS cache_eviction_select_time_recent;
+	WT_STATS cache_eviction_select_time_total;
 	WT_STATS cache_eviction_server_evicting;
 	WT_STATS cache_eviction_server_not_evicting;
 	WT_STATS cache_eviction_slow;
 	WT_STATS cache_eviction_split;
 	WT_STATS cache_eviction_walk;
+	WT_STATS cache_eviction_walk_rate;
+	WT_STATS cache_eviction_walk_worker;
 	WT_STATS cache_eviction_worker_evicting;
 	WT_STATS cache_inmem_split;
 	WT_STATS cache_overhead;
 	WT_STATS cache_pages_dirty;
 	WT_STATS cache_pages_inuse;
 	WT_STATS cache_read;
+	WT_STATS cache_readahead_hit;
+	WT_STATS cache_readahead_miss;
+	WT_STATS cache_readahead_queue_full;
+	WT_STATS cache_readahead_queued;
+	WT_STATS cache_readahead_read;
+	WT_STATS cache_readahead_skip_full;
 	WT_STATS cache_write;
 	WT_STATS cond_wait;
+	WT_STATS cursor_cache_discard;
+	WT_STATS cursor_cache_hit;
+	WT_STATS cursor_cache_insert;
+	WT_STATS cursor_cache_miss;
 	WT_STATS cursor_create;
 	WT_STATS cursor_insert;
 	WT_STATS cursor_next;
@@ -179,6 +229,8 @@ struct __wt_connection_stats
 	WT_STATS cursor_remove;
 	WT_STATS cursor_reset;
 	WT_STATS cursor_search;
+	WT_STATS cursor_search_batch;
+	WT_STATS cursor_search_batch_leaf;
 	WT_STATS cursor_search_near;
 	WT_STATS cursor_update;
 	WT_STATS dh_conn_handles;
@@ -203,6 +255,8 @@ struct __wt_connection_stats
 	WT_STATS log_prealloc_max;
 	WT_STATS log_prealloc_used;
 	WT_STATS log_reads;
+	WT_STATS log_recovery_ops;
+	WT_STATS log_recovery_time;
 	WT_STATS log_release_write_lsn;
 	WT_STATS log_scan_records;
 	WT_STATS log_scan_rereads;
@@ -217,8 +271,13 @@ struct __wt_connection_stats
 	WT_STATS log_slot_transitions;
 	WT_STATS log_sync;
 	WT_STATS log_sync_dir;
+	WT_STATS log_sync_requests;
 	WT_STATS log_write_lsn;
 	WT_STATS log_writes;
+	WT_STATS lsm_bloom_load;
+	WT_STATS lsm_bloom_memory;
+	WT_STATS lsm_bloom_probe_sampled;
+	WT_STATS lsm_bloom_probe_time;
 	WT_STATS lsm_checkpoint_throttle;
 	WT_STATS lsm_merge_throttle;
 	WT_STATS lsm_rows_merged;
@@ -238,6 +297,8 @@ struct __wt_connection_stats
 	WT_STATS page_read_blocked;
 	WT_STATS page_sleep;
 	WT_STATS read_io;
+	WT_STATS rec_compress_async;
+	WT_STATS rec_compress_wait;
 	WT_STATS rec_pages;
 	WT_STATS rec_pages_eviction;
 	WT_STATS rec_split_stashed_bytes;
@@ -248,6 +309,7 @@ struct __wt_connection_stats
 	WT_STATS session_open;
 	WT_STATS txn_begin;
 	WT_STATS txn_checkpoint;
+	WT_STATS txn_checkpoint_file_time_max;
 	WT_STATS txn_checkpoint_generation;
 	WT_STATS txn_checkpoint_running;
 	WT_STATS txn_checkpoint_time_max;
@@ -259,9 +321,18 @@ struct __wt_connection_stats
 	WT_STATS txn_pinned_checkpoint_range;
 	WT_STATS txn_pinned_range;
 	WT_STATS txn_rollback;
+	WT_STATS txn_snapshot_cache_hit;
+	WT_STATS txn_snapshot_cache_miss;
 	WT_STATS write_io;
 };
 
+/*connection统计值的一个分片，按cache line补齐*/
+struct __wt_connection_stats_slot
+{
+	WT_CONNECTION_STATS stats;
+	uint8_t pad[WT_CACHE_LINE_ALIGNMENT - sizeof(WT_CONNECTION_STATS) % WT_CACHE_LINE_ALIGNMENT];
+};
+
 /*数据组织的状态统计*/
 #define	WT_DSRC_STATS_BASE	2000
 struct __wt_dsrc_stats 
@@ -284,6 +355,7 @@ struct __wt_dsrc_stats
 	WT_STATS bloom_page_read;
 	WT_STATS bloom_size;
 	WT_STATS btree_checkpoint_generation;
+	WT_STATS btree_checkpoint_time;
 	WT_STATS btree_column_deleted;
 	WT_STATS btree_column_fix;
 	WT_STATS btree_column_internal;
@@ -332,6 +404,7 @@ struct __wt_dsrc_stats
 	WT_STATS cursor_remove_bytes;
 	WT_STATS cursor_reset;
 	WT_STATS cursor_search;
+	WT_STATS cursor_search_batch;
 	WT_STATS cursor_search_near;
 	WT_STATS cursor_update;
 	WT_STATS cursor_update_bytes;
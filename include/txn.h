@@ -51,6 +51,21 @@ struct __wt_txn_global
 	volatile uint64_t	checkpoint_snap_min;
 
 	WT_TXN_STATE*		states;		/* Per-session transaction states */
+
+	/*
+	* Cached snapshot of the running transaction IDs. It is reused by
+	* snapshot refreshes as long as no transaction ID has been allocated
+	* or released since it was built, so beginning a transaction doesn't
+	* have to scan the states of every (mostly idle) session.
+	*/
+	volatile uint64_t	snapshot_gen;		/* Bumped on transaction ID release */
+	WT_SPINLOCK			snapshot_lock;		/* Locked: cached snapshot */
+	uint64_t			snapshot_cache_gen;	/* Generation the cache was built at */
+	uint64_t			snapshot_cache_current;/* Current ID the cache was built at */
+	uint64_t			snapshot_cache_ckpt_id;/* Checkpoint ID the cache was built at */
+	uint64_t*			snapshot_cache;		/* Sorted running transaction IDs */
+	uint32_t			snapshot_cache_count;
+	int					snapshot_cache_valid;
 };
 
 /* wiredtiger 事务隔离类型 */
@@ -41,6 +41,7 @@ typedef off_t	wt_off_t;
 *******************************/
 struct __wt_async_callback;
 typedef struct __wt_async_callback WT_ASYNC_CALLBACK;
+struct __wt_async_batch_op; typedef struct __wt_async_batch_op WT_ASYNC_BATCH_OP;
 struct __wt_async_op;	    typedef struct __wt_async_op WT_ASYNC_OP;
 struct __wt_collator;	    typedef struct __wt_collator WT_COLLATOR;
 struct __wt_compressor;	    typedef struct __wt_compressor WT_COMPRESSOR;
@@ -120,6 +121,12 @@ struct __wt_cursor
 	int						__F(search)(WT_CURSOR *cursor);
 
 	int						__F(search_near)(WT_CURSOR *cursor, int *exactp);
+	/*
+	 * 批量查找count个key，keys和values都是raw格式，keys不需要有序。results[i]为0表示
+	 * keys[i]找到了，values[i]是对应的value; 为WT_NOTFOUND表示没有找到。values指向的
+	 * 内存在cursor的下一次search_batch、reset或者close之前有效，调用结束后cursor被重置
+	 */
+	int						__F(search_batch)(WT_CURSOR *cursor, size_t count, const WT_ITEM *keys, WT_ITEM *values, int *results);
 
 	int						__F(insert)(WT_CURSOR *cursor);
 
@@ -145,6 +152,7 @@ struct __wt_cursor
 
 	WT_ITEM					key;
 	WT_ITEM					value;
+	WT_ITEM					batch;			/* search_batch value storage */
 
 	int						saved_err;
 	const char*				internal_uri;
@@ -167,6 +175,7 @@ struct __wt_cursor
 #define	WT_CURSTD_VALUE_EXT		0x0400	/* Value points out of the tree. */
 #define	WT_CURSTD_VALUE_INT		0x0800	/* Value points into the tree. */
 #define	WT_CURSTD_VALUE_SET		(WT_CURSTD_VALUE_EXT | WT_CURSTD_VALUE_INT)
+#define	WT_CURSTD_CACHEABLE		0x1000	/* Close parks it in the session cache. */
 
 /*异步操作类型定义*/
 typedef enum{
@@ -204,6 +213,18 @@ struct __wt_async_op{
 
 };
 
+/*
+ * 批量异步操作中的一个操作，key和value都是raw格式。optype只能是WT_AOP_INSERT、
+ * WT_AOP_UPDATE、WT_AOP_REMOVE或者WT_AOP_SEARCH。search的value由worker分配，
+ * 只在notify_batch回调中有效
+ */
+struct __wt_async_batch_op{
+	WT_ASYNC_OPTYPE				optype;
+	WT_ITEM						key;
+	WT_ITEM						value;
+	int							ret;		/* 操作的返回值 */
+};
+
 /*定义wt session*/
 struct __wt_session
 {
@@ -236,6 +257,12 @@ struct __wt_session
 /*定义wt connection,connection是对应一个database实例*/
 struct __wt_connection
 {
+	/*
+	 * 提交一批对同一个uri的异步操作，worker在一个事务中用同一个cursor按key的顺序执行，
+	 * 完成后调用一次callback->notify_batch。ops在回调之前必须保持有效
+	 */
+	int							__F(async_batch)(WT_CONNECTION *connection, const char *uri, const char *config,
+											WT_ASYNC_CALLBACK *callback, WT_ASYNC_BATCH_OP *ops, uint32_t nops);
 	int							__F(async_flush)(WT_CONNECTION* connection);
 	int							__F(async_new_op)(WT_CONNECTION *connection, const char *uri, const char *config, WT_ASYNC_CALLBACK *callback, WT_ASYNC_OP **asyncopp);
 	int							__F(close)(WT_HANDLE_CLOSED(WT_CONNECTION) *connection, const char *config);
@@ -243,6 +270,8 @@ struct __wt_connection
 	const char*					__F(get_home)(WT_CONNECTION *connection);						
 	int							__F(configure_method)(WT_CONNECTION *connection, const char *method, const char *uri,
 											const char *config, const char *type, const char *check);
+	/*预编译method的配置，返回的handle在connection关闭之前一直有效，同一个配置重复编译返回同一个handle*/
+	int							__F(compile_configuration)(WT_CONNECTION *connection, const char *method, const char *config, const char **compiledp);
 	int							__F(is_new)(WT_CONNECTION *connection);
 	int							__F(open_session)(WT_CONNECTION *connection, WT_EVENT_HANDLER *errhandler, const char *config, WT_SESSION **sessionp);
 	int							__F(load_extension)(WT_CONNECTION *connection, const char *path, const char *config);
@@ -262,6 +291,11 @@ const char*						wiredtiger_strerror(int error);
 struct __wt_async_callback
 {
 	int							(*notify)(WT_ASYNC_CALLBACK *cb, WT_ASYNC_OP *op, int op_ret, uint32_t flags);
+	/*
+	 * 批量操作完成的通告，ret不为0时整个batch被回滚，ops[i].ret是每个操作的执行结果，
+	 * 返回非0也会回滚整个batch
+	 */
+	int							(*notify_batch)(WT_ASYNC_CALLBACK *cb, WT_ASYNC_BATCH_OP *ops, uint32_t nops, int ret);
 };
 
 /*wiredtiger的事件处理对象*/
@@ -400,292 +434,398 @@ extern int wiredtiger_extension_init(WT_CONNECTION *connection, WT_CONFIG_ARG *c
 extern int wiredtiger_extension_terminate(WT_CONNECTION *connection);
 
 /*wt connection的统计项*/
+/*! io_uring: waits that reaped the completion queue after io_uring failed */
+#define	WT_STAT_CONN_AIO_REAP_WAIT			1000
+/*! io_uring: I/O requests submitted */
+#define	WT_STAT_CONN_AIO_SUBMIT				1001
+/*! io_uring: I/O requests done synchronously because the queue was full */
+#define	WT_STAT_CONN_AIO_SYNC				1002
 /*! async: number of allocation state races */
-#define	WT_STAT_CONN_ASYNC_ALLOC_RACE			1000
+#define	WT_STAT_CONN_ASYNC_ALLOC_RACE			1003
 /*! async: number of operation slots viewed for allocation */
-#define	WT_STAT_CONN_ASYNC_ALLOC_VIEW			1001
+#define	WT_STAT_CONN_ASYNC_ALLOC_VIEW			1004
 /*! async: current work queue length */
-#define	WT_STAT_CONN_ASYNC_CUR_QUEUE			1002
+#define	WT_STAT_CONN_ASYNC_CUR_QUEUE			1005
 /*! async: number of flush calls */
-#define	WT_STAT_CONN_ASYNC_FLUSH			1003
+#define	WT_STAT_CONN_ASYNC_FLUSH			1006
 /*! async: number of times operation allocation failed */
-#define	WT_STAT_CONN_ASYNC_FULL				1004
+#define	WT_STAT_CONN_ASYNC_FULL				1007
 /*! async: maximum work queue length */
-#define	WT_STAT_CONN_ASYNC_MAX_QUEUE			1005
+#define	WT_STAT_CONN_ASYNC_MAX_QUEUE			1008
 /*! async: number of times worker found no work */
-#define	WT_STAT_CONN_ASYNC_NOWORK			1006
+#define	WT_STAT_CONN_ASYNC_NOWORK			1009
 /*! async: total allocations */
-#define	WT_STAT_CONN_ASYNC_OP_ALLOC			1007
+#define	WT_STAT_CONN_ASYNC_OP_ALLOC			1010
+/*! async: total batch calls */
+#define	WT_STAT_CONN_ASYNC_OP_BATCH			1011
+/*! async: total operations in batch calls */
+#define	WT_STAT_CONN_ASYNC_OP_BATCH_OPS			1012
 /*! async: total compact calls */
-#define	WT_STAT_CONN_ASYNC_OP_COMPACT			1008
+#define	WT_STAT_CONN_ASYNC_OP_COMPACT			1013
 /*! async: total insert calls */
-#define	WT_STAT_CONN_ASYNC_OP_INSERT			1009
+#define	WT_STAT_CONN_ASYNC_OP_INSERT			1014
 /*! async: total remove calls */
-#define	WT_STAT_CONN_ASYNC_OP_REMOVE			1010
+#define	WT_STAT_CONN_ASYNC_OP_REMOVE			1015
 /*! async: total search calls */
-#define	WT_STAT_CONN_ASYNC_OP_SEARCH			1011
+#define	WT_STAT_CONN_ASYNC_OP_SEARCH			1016
 /*! async: total update calls */
-#define	WT_STAT_CONN_ASYNC_OP_UPDATE			1012
+#define	WT_STAT_CONN_ASYNC_OP_UPDATE			1017
+/*! async: work queue latency maximum (usecs) */
+#define	WT_STAT_CONN_ASYNC_QUEUE_LATENCY_MAX		1018
+/*! async: work queue latency 50th percentile (usecs) */
+#define	WT_STAT_CONN_ASYNC_QUEUE_LATENCY_P50		1019
+/*! async: work queue latency 90th percentile (usecs) */
+#define	WT_STAT_CONN_ASYNC_QUEUE_LATENCY_P90		1020
+/*! async: work queue latency 99th percentile (usecs) */
+#define	WT_STAT_CONN_ASYNC_QUEUE_LATENCY_P99		1021
+/*! async: number of times worker waited for work */
+#define	WT_STAT_CONN_ASYNC_WORKER_PARK			1022
+/*! async: number of worker wakeups */
+#define	WT_STAT_CONN_ASYNC_WORKER_WAKEUP		1023
 /*! block-manager: mapped bytes read */
-#define	WT_STAT_CONN_BLOCK_BYTE_MAP_READ		1013
+#define	WT_STAT_CONN_BLOCK_BYTE_MAP_READ		1024
 /*! block-manager: bytes read */
-#define	WT_STAT_CONN_BLOCK_BYTE_READ			1014
+#define	WT_STAT_CONN_BLOCK_BYTE_READ			1025
 /*! block-manager: bytes written */
-#define	WT_STAT_CONN_BLOCK_BYTE_WRITE			1015
+#define	WT_STAT_CONN_BLOCK_BYTE_WRITE			1026
+/*! block-cache: bytes currently in the block cache */
+#define	WT_STAT_CONN_BLOCK_CACHE_BYTES			1027
+/*! block-cache: page images evicted from the block cache */
+#define	WT_STAT_CONN_BLOCK_CACHE_EVICT			1028
+/*! block-cache: page images found in the block cache */
+#define	WT_STAT_CONN_BLOCK_CACHE_HIT			1029
+/*! block-cache: page images inserted into the block cache */
+#define	WT_STAT_CONN_BLOCK_CACHE_INSERT			1030
+/*! block-cache: page images not found in the block cache */
+#define	WT_STAT_CONN_BLOCK_CACHE_MISS			1031
+/*! block-cache: page images removed from the block cache when blocks are freed */
+#define	WT_STAT_CONN_BLOCK_CACHE_REMOVE			1032
 /*! block-manager: mapped blocks read */
-#define	WT_STAT_CONN_BLOCK_MAP_READ			1016
+#define	WT_STAT_CONN_BLOCK_MAP_READ			1033
 /*! block-manager: blocks pre-loaded */
-#define	WT_STAT_CONN_BLOCK_PRELOAD			1017
+#define	WT_STAT_CONN_BLOCK_PRELOAD			1034
 /*! block-manager: blocks read */
-#define	WT_STAT_CONN_BLOCK_READ				1018
+#define	WT_STAT_CONN_BLOCK_READ				1035
+/*! block-manager: blocks allocated from a write shard region */
+#define	WT_STAT_CONN_BLOCK_SHARD_ALLOC			1036
+/*! block-manager: batched frees returned to the free list */
+#define	WT_STAT_CONN_BLOCK_SHARD_FREE_FLUSH		1037
+/*! block-manager: write shard regions carved from the free list */
+#define	WT_STAT_CONN_BLOCK_SHARD_REFILL			1038
 /*! block-manager: blocks written */
-#define	WT_STAT_CONN_BLOCK_WRITE			1019
+#define	WT_STAT_CONN_BLOCK_WRITE			1039
 /*! cache: tracked dirty bytes in the cache */
-#define	WT_STAT_CONN_CACHE_BYTES_DIRTY			1020
+#define	WT_STAT_CONN_CACHE_BYTES_DIRTY			1040
 /*! cache: tracked bytes belonging to internal pages in the cache */
-#define	WT_STAT_CONN_CACHE_BYTES_INTERNAL		1021
+#define	WT_STAT_CONN_CACHE_BYTES_INTERNAL		1041
 /*! cache: bytes currently in the cache */
-#define	WT_STAT_CONN_CACHE_BYTES_INUSE			1022
+#define	WT_STAT_CONN_CACHE_BYTES_INUSE			1042
 /*! cache: tracked bytes belonging to leaf pages in the cache */
-#define	WT_STAT_CONN_CACHE_BYTES_LEAF			1023
+#define	WT_STAT_CONN_CACHE_BYTES_LEAF			1043
 /*! cache: maximum bytes configured */
-#define	WT_STAT_CONN_CACHE_BYTES_MAX			1024
+#define	WT_STAT_CONN_CACHE_BYTES_MAX			1044
 /*! cache: tracked bytes belonging to overflow pages in the cache */
-#define	WT_STAT_CONN_CACHE_BYTES_OVERFLOW		1025
+#define	WT_STAT_CONN_CACHE_BYTES_OVERFLOW		1045
 /*! cache: bytes read into cache */
-#define	WT_STAT_CONN_CACHE_BYTES_READ			1026
+#define	WT_STAT_CONN_CACHE_BYTES_READ			1046
 /*! cache: bytes written from cache */
-#define	WT_STAT_CONN_CACHE_BYTES_WRITE			1027
+#define	WT_STAT_CONN_CACHE_BYTES_WRITE			1047
 /*! cache: pages evicted by application threads */
-#define	WT_STAT_CONN_CACHE_EVICTION_APP			1028
+#define	WT_STAT_CONN_CACHE_EVICTION_APP			1048
 /*! cache: checkpoint blocked page eviction */
-#define	WT_STAT_CONN_CACHE_EVICTION_CHECKPOINT		1029
+#define	WT_STAT_CONN_CACHE_EVICTION_CHECKPOINT		1049
 /*! cache: unmodified pages evicted */
-#define	WT_STAT_CONN_CACHE_EVICTION_CLEAN		1030
+#define	WT_STAT_CONN_CACHE_EVICTION_CLEAN		1050
 /*! cache: page split during eviction deepened the tree */
-#define	WT_STAT_CONN_CACHE_EVICTION_DEEPEN		1031
+#define	WT_STAT_CONN_CACHE_EVICTION_DEEPEN		1051
 /*! cache: modified pages evicted */
-#define	WT_STAT_CONN_CACHE_EVICTION_DIRTY		1032
+#define	WT_STAT_CONN_CACHE_EVICTION_DIRTY		1052
+/*! cache: eviction candidates deprioritized by write cost */
+#define	WT_STAT_CONN_CACHE_EVICTION_DIRTY_SKEW		1053
 /*! cache: pages selected for eviction unable to be evicted */
-#define	WT_STAT_CONN_CACHE_EVICTION_FAIL		1033
+#define	WT_STAT_CONN_CACHE_EVICTION_FAIL		1054
 /*! cache: pages evicted because they exceeded the in-memory maximum */
-#define	WT_STAT_CONN_CACHE_EVICTION_FORCE		1034
+#define	WT_STAT_CONN_CACHE_EVICTION_FORCE		1055
 /*! cache: pages evicted because they had chains of deleted items */
-#define	WT_STAT_CONN_CACHE_EVICTION_FORCE_DELETE	1035
+#define	WT_STAT_CONN_CACHE_EVICTION_FORCE_DELETE	1056
 /*! cache: failed eviction of pages that exceeded the in-memory maximum */
-#define	WT_STAT_CONN_CACHE_EVICTION_FORCE_FAIL		1036
+#define	WT_STAT_CONN_CACHE_EVICTION_FORCE_FAIL		1057
 /*! cache: hazard pointer blocked page eviction */
-#define	WT_STAT_CONN_CACHE_EVICTION_HAZARD		1037
+#define	WT_STAT_CONN_CACHE_EVICTION_HAZARD		1058
+/*! cache: hazard pointer scans after a hazard index hit */
+#define	WT_STAT_CONN_CACHE_EVICTION_HAZARD_SCAN		1059
 /*! cache: internal pages evicted */
-#define	WT_STAT_CONN_CACHE_EVICTION_INTERNAL		1038
+#define	WT_STAT_CONN_CACHE_EVICTION_INTERNAL		1060
 /*! cache: maximum page size at eviction */
-#define	WT_STAT_CONN_CACHE_EVICTION_MAXIMUM_PAGE_SIZE	1039
+#define	WT_STAT_CONN_CACHE_EVICTION_MAXIMUM_PAGE_SIZE	1061
 /*! cache: eviction server candidate queue empty when topping up */
-#define	WT_STAT_CONN_CACHE_EVICTION_QUEUE_EMPTY		1040
+#define	WT_STAT_CONN_CACHE_EVICTION_QUEUE_EMPTY		1062
 /*! cache: eviction server candidate queue not empty when topping up */
-#define	WT_STAT_CONN_CACHE_EVICTION_QUEUE_NOT_EMPTY	1041
+#define	WT_STAT_CONN_CACHE_EVICTION_QUEUE_NOT_EMPTY	1063
+/*! cache: eviction pages taken from another thread's queue */
+#define	WT_STAT_CONN_CACHE_EVICTION_QUEUE_STEAL		1064
+/*! cache: eviction server candidate queue selection passes */
+#define	WT_STAT_CONN_CACHE_EVICTION_SELECT		1065
+/*! cache: eviction server candidate queue selection max time (usecs) */
+#define	WT_STAT_CONN_CACHE_EVICTION_SELECT_TIME_MAX	1066
+/*! cache: eviction server candidate queue selection most recent time (usecs) */
+#define	WT_STAT_CONN_CACHE_EVICTION_SELECT_TIME_RECENT	1067
+/*! cache: eviction server candidate queue selection total time (usecs) */
+#define	WT_STAT_CONN_CACHE_EVICTION_SELECT_TIME_TOTAL	1068
 /*! cache: eviction server evicting pages */
-#define	WT_STAT_CONN_CACHE_EVICTION_SERVER_EVICTING	1042
+#define	WT_STAT_CONN_CACHE_EVICTION_SERVER_EVICTING	1069
 /*! cache: eviction server populating queue, but not evicting pages */
-#define	WT_STAT_CONN_CACHE_EVICTION_SERVER_NOT_EVICTING	1043
+#define	WT_STAT_CONN_CACHE_EVICTION_SERVER_NOT_EVICTING	1070
 /*! cache: eviction server unable to reach eviction goal */
-#define	WT_STAT_CONN_CACHE_EVICTION_SLOW		1044
+#define	WT_STAT_CONN_CACHE_EVICTION_SLOW		1071
 /*! cache: pages split during eviction */
-#define	WT_STAT_CONN_CACHE_EVICTION_SPLIT		1045
+#define	WT_STAT_CONN_CACHE_EVICTION_SPLIT		1072
 /*! cache: pages walked for eviction */
-#define	WT_STAT_CONN_CACHE_EVICTION_WALK		1046
+#define	WT_STAT_CONN_CACHE_EVICTION_WALK		1073
+/*! cache: pages walked for eviction per second */
+#define	WT_STAT_CONN_CACHE_EVICTION_WALK_RATE		1074
+/*! cache: eviction walks performed by worker threads */
+#define	WT_STAT_CONN_CACHE_EVICTION_WALK_WORKER		1075
 /*! cache: eviction worker thread evicting pages */
-#define	WT_STAT_CONN_CACHE_EVICTION_WORKER_EVICTING	1047
+#define	WT_STAT_CONN_CACHE_EVICTION_WORKER_EVICTING	1076
 /*! cache: in-memory page splits */
-#define	WT_STAT_CONN_CACHE_INMEM_SPLIT			1048
+#define	WT_STAT_CONN_CACHE_INMEM_SPLIT			1077
 /*! cache: percentage overhead */
-#define	WT_STAT_CONN_CACHE_OVERHEAD			1049
+#define	WT_STAT_CONN_CACHE_OVERHEAD			1078
 /*! cache: tracked dirty pages in the cache */
-#define	WT_STAT_CONN_CACHE_PAGES_DIRTY			1050
+#define	WT_STAT_CONN_CACHE_PAGES_DIRTY			1079
 /*! cache: pages currently held in the cache */
-#define	WT_STAT_CONN_CACHE_PAGES_INUSE			1051
+#define	WT_STAT_CONN_CACHE_PAGES_INUSE			1080
 /*! cache: pages read into cache */
-#define	WT_STAT_CONN_CACHE_READ				1052
+#define	WT_STAT_CONN_CACHE_READ				1081
+/*! cache: read-ahead pages used by cursor scans */
+#define	WT_STAT_CONN_CACHE_READAHEAD_HIT		1082
+/*! cache: read-ahead pages not in cache when reached by cursor scans */
+#define	WT_STAT_CONN_CACHE_READAHEAD_MISS		1083
+/*! cache: read-ahead requests dropped because the queue is full */
+#define	WT_STAT_CONN_CACHE_READAHEAD_QUEUE_FULL		1084
+/*! cache: pages queued for read-ahead */
+#define	WT_STAT_CONN_CACHE_READAHEAD_QUEUED		1085
+/*! cache: pages read into cache by read-ahead threads */
+#define	WT_STAT_CONN_CACHE_READAHEAD_READ		1086
+/*! cache: read-ahead requests skipped because the cache is full */
+#define	WT_STAT_CONN_CACHE_READAHEAD_SKIP_FULL		1087
 /*! cache: pages written from cache */
-#define	WT_STAT_CONN_CACHE_WRITE			1053
+#define	WT_STAT_CONN_CACHE_WRITE			1088
 /*! connection: pthread mutex condition wait calls */
-#define	WT_STAT_CONN_COND_WAIT				1054
+#define	WT_STAT_CONN_COND_WAIT				1089
+/*! cursor: cursor cache entries discarded */
+#define	WT_STAT_CONN_CURSOR_CACHE_DISCARD		1090
+/*! cursor: cursor cache hits */
+#define	WT_STAT_CONN_CURSOR_CACHE_HIT			1091
+/*! cursor: cursor cache inserts */
+#define	WT_STAT_CONN_CURSOR_CACHE_INSERT		1092
+/*! cursor: cursor cache misses */
+#define	WT_STAT_CONN_CURSOR_CACHE_MISS			1093
 /*! cursor: cursor create calls */
-#define	WT_STAT_CONN_CURSOR_CREATE			1055
+#define	WT_STAT_CONN_CURSOR_CREATE			1094
 /*! cursor: cursor insert calls */
-#define	WT_STAT_CONN_CURSOR_INSERT			1056
+#define	WT_STAT_CONN_CURSOR_INSERT			1095
 /*! cursor: cursor next calls */
-#define	WT_STAT_CONN_CURSOR_NEXT			1057
+#define	WT_STAT_CONN_CURSOR_NEXT			1096
 /*! cursor: cursor prev calls */
-#define	WT_STAT_CONN_CURSOR_PREV			1058
+#define	WT_STAT_CONN_CURSOR_PREV			1097
 /*! cursor: cursor remove calls */
-#define	WT_STAT_CONN_CURSOR_REMOVE			1059
+#define	WT_STAT_CONN_CURSOR_REMOVE			1098
 /*! cursor: cursor reset calls */
-#define	WT_STAT_CONN_CURSOR_RESET			1060
+#define	WT_STAT_CONN_CURSOR_RESET			1099
 /*! cursor: cursor search calls */
-#define	WT_STAT_CONN_CURSOR_SEARCH			1061
+#define	WT_STAT_CONN_CURSOR_SEARCH			1100
+/*! cursor: cursor search batch calls */
+#define	WT_STAT_CONN_CURSOR_SEARCH_BATCH		1101
+/*! cursor: search batch keys found without a root descent */
+#define	WT_STAT_CONN_CURSOR_SEARCH_BATCH_LEAF		1102
 /*! cursor: cursor search near calls */
-#define	WT_STAT_CONN_CURSOR_SEARCH_NEAR			1062
+#define	WT_STAT_CONN_CURSOR_SEARCH_NEAR			1103
 /*! cursor: cursor update calls */
-#define	WT_STAT_CONN_CURSOR_UPDATE			1063
+#define	WT_STAT_CONN_CURSOR_UPDATE			1104
 /*! data-handle: connection dhandles swept */
-#define	WT_STAT_CONN_DH_CONN_HANDLES			1064
+#define	WT_STAT_CONN_DH_CONN_HANDLES			1105
 /*! data-handle: connection candidate referenced */
-#define	WT_STAT_CONN_DH_CONN_REF			1065
+#define	WT_STAT_CONN_DH_CONN_REF			1106
 /*! data-handle: connection sweeps */
-#define	WT_STAT_CONN_DH_CONN_SWEEPS			1066
+#define	WT_STAT_CONN_DH_CONN_SWEEPS			1107
 /*! data-handle: connection time-of-death sets */
-#define	WT_STAT_CONN_DH_CONN_TOD			1067
+#define	WT_STAT_CONN_DH_CONN_TOD			1108
 /*! data-handle: session dhandles swept */
-#define	WT_STAT_CONN_DH_SESSION_HANDLES			1068
+#define	WT_STAT_CONN_DH_SESSION_HANDLES			1109
 /*! data-handle: session sweep attempts */
-#define	WT_STAT_CONN_DH_SESSION_SWEEPS			1069
+#define	WT_STAT_CONN_DH_SESSION_SWEEPS			1110
 /*! connection: files currently open */
-#define	WT_STAT_CONN_FILE_OPEN				1070
+#define	WT_STAT_CONN_FILE_OPEN				1111
 /*! log: log buffer size increases */
-#define	WT_STAT_CONN_LOG_BUFFER_GROW			1071
+#define	WT_STAT_CONN_LOG_BUFFER_GROW			1112
 /*! log: total log buffer size */
-#define	WT_STAT_CONN_LOG_BUFFER_SIZE			1072
+#define	WT_STAT_CONN_LOG_BUFFER_SIZE			1113
 /*! log: log bytes of payload data */
-#define	WT_STAT_CONN_LOG_BYTES_PAYLOAD			1073
+#define	WT_STAT_CONN_LOG_BYTES_PAYLOAD			1114
 /*! log: log bytes written */
-#define	WT_STAT_CONN_LOG_BYTES_WRITTEN			1074
+#define	WT_STAT_CONN_LOG_BYTES_WRITTEN			1115
 /*! log: yields waiting for previous log file close */
-#define	WT_STAT_CONN_LOG_CLOSE_YIELDS			1075
+#define	WT_STAT_CONN_LOG_CLOSE_YIELDS			1116
 /*! log: total size of compressed records */
-#define	WT_STAT_CONN_LOG_COMPRESS_LEN			1076
+#define	WT_STAT_CONN_LOG_COMPRESS_LEN			1117
 /*! log: total in-memory size of compressed records */
-#define	WT_STAT_CONN_LOG_COMPRESS_MEM			1077
+#define	WT_STAT_CONN_LOG_COMPRESS_MEM			1118
 /*! log: log records too small to compress */
-#define	WT_STAT_CONN_LOG_COMPRESS_SMALL			1078
+#define	WT_STAT_CONN_LOG_COMPRESS_SMALL			1119
 /*! log: log records not compressed */
-#define	WT_STAT_CONN_LOG_COMPRESS_WRITE_FAILS		1079
+#define	WT_STAT_CONN_LOG_COMPRESS_WRITE_FAILS		1120
 /*! log: log records compressed */
-#define	WT_STAT_CONN_LOG_COMPRESS_WRITES		1080
+#define	WT_STAT_CONN_LOG_COMPRESS_WRITES		1121
 /*! log: maximum log file size */
-#define	WT_STAT_CONN_LOG_MAX_FILESIZE			1081
+#define	WT_STAT_CONN_LOG_MAX_FILESIZE			1122
 /*! log: pre-allocated log files prepared */
-#define	WT_STAT_CONN_LOG_PREALLOC_FILES			1082
+#define	WT_STAT_CONN_LOG_PREALLOC_FILES			1123
 /*! log: number of pre-allocated log files to create */
-#define	WT_STAT_CONN_LOG_PREALLOC_MAX			1083
+#define	WT_STAT_CONN_LOG_PREALLOC_MAX			1124
 /*! log: pre-allocated log files used */
-#define	WT_STAT_CONN_LOG_PREALLOC_USED			1084
+#define	WT_STAT_CONN_LOG_PREALLOC_USED			1125
 /*! log: log read operations */
-#define	WT_STAT_CONN_LOG_READS				1085
+#define	WT_STAT_CONN_LOG_READS				1126
+/*! log: operations applied by recovery */
+#define	WT_STAT_CONN_LOG_RECOVERY_OPS			1127
+/*! log: recovery time (usecs) */
+#define	WT_STAT_CONN_LOG_RECOVERY_TIME			1128
 /*! log: log release advances write LSN */
-#define	WT_STAT_CONN_LOG_RELEASE_WRITE_LSN		1086
+#define	WT_STAT_CONN_LOG_RELEASE_WRITE_LSN		1129
 /*! log: records processed by log scan */
-#define	WT_STAT_CONN_LOG_SCAN_RECORDS			1087
+#define	WT_STAT_CONN_LOG_SCAN_RECORDS			1130
 /*! log: log scan records requiring two reads */
-#define	WT_STAT_CONN_LOG_SCAN_REREADS			1088
+#define	WT_STAT_CONN_LOG_SCAN_REREADS			1131
 /*! log: log scan operations */
-#define	WT_STAT_CONN_LOG_SCANS				1089
+#define	WT_STAT_CONN_LOG_SCANS				1132
 /*! log: consolidated slot closures */
-#define	WT_STAT_CONN_LOG_SLOT_CLOSES			1090
+#define	WT_STAT_CONN_LOG_SLOT_CLOSES			1133
 /*! log: logging bytes consolidated */
-#define	WT_STAT_CONN_LOG_SLOT_CONSOLIDATED		1091
+#define	WT_STAT_CONN_LOG_SLOT_CONSOLIDATED		1134
 /*! log: consolidated slot joins */
-#define	WT_STAT_CONN_LOG_SLOT_JOINS			1092
+#define	WT_STAT_CONN_LOG_SLOT_JOINS			1135
 /*! log: consolidated slot join races */
-#define	WT_STAT_CONN_LOG_SLOT_RACES			1093
+#define	WT_STAT_CONN_LOG_SLOT_RACES			1136
 /*! log: slots selected for switching that were unavailable */
-#define	WT_STAT_CONN_LOG_SLOT_SWITCH_FAILS		1094
+#define	WT_STAT_CONN_LOG_SLOT_SWITCH_FAILS		1137
 /*! log: record size exceeded maximum */
-#define	WT_STAT_CONN_LOG_SLOT_TOOBIG			1095
+#define	WT_STAT_CONN_LOG_SLOT_TOOBIG			1138
 /*! log: failed to find a slot large enough for record */
-#define	WT_STAT_CONN_LOG_SLOT_TOOSMALL			1096
+#define	WT_STAT_CONN_LOG_SLOT_TOOSMALL			1139
 /*! log: consolidated slot join transitions */
-#define	WT_STAT_CONN_LOG_SLOT_TRANSITIONS		1097
+#define	WT_STAT_CONN_LOG_SLOT_TRANSITIONS		1140
 /*! log: log sync operations */
-#define	WT_STAT_CONN_LOG_SYNC				1098
+#define	WT_STAT_CONN_LOG_SYNC				1141
 /*! log: log sync_dir operations */
-#define	WT_STAT_CONN_LOG_SYNC_DIR			1099
+#define	WT_STAT_CONN_LOG_SYNC_DIR			1142
+/*! log: log sync requests handed to the flush thread */
+#define	WT_STAT_CONN_LOG_SYNC_REQUESTS			1143
 /*! log: log server thread advances write LSN */
-#define	WT_STAT_CONN_LOG_WRITE_LSN			1100
+#define	WT_STAT_CONN_LOG_WRITE_LSN			1144
 /*! log: log write operations */
-#define	WT_STAT_CONN_LOG_WRITES				1101
+#define	WT_STAT_CONN_LOG_WRITES				1145
+/*! LSM: bloom filters loaded into memory */
+#define	WT_STAT_CONN_LSM_BLOOM_LOAD			1146
+/*! LSM: bloom filter bytes in memory */
+#define	WT_STAT_CONN_LSM_BLOOM_MEMORY			1147
+/*! LSM: bloom filter probes sampled for latency */
+#define	WT_STAT_CONN_LSM_BLOOM_PROBE_SAMPLED		1148
+/*! LSM: bloom filter sampled probe time (nsecs) */
+#define	WT_STAT_CONN_LSM_BLOOM_PROBE_TIME		1149
 /*! LSM: sleep for LSM checkpoint throttle */
-#define	WT_STAT_CONN_LSM_CHECKPOINT_THROTTLE		1102
+#define	WT_STAT_CONN_LSM_CHECKPOINT_THROTTLE		1150
 /*! LSM: sleep for LSM merge throttle */
-#define	WT_STAT_CONN_LSM_MERGE_THROTTLE			1103
+#define	WT_STAT_CONN_LSM_MERGE_THROTTLE			1151
 /*! LSM: rows merged in an LSM tree */
-#define	WT_STAT_CONN_LSM_ROWS_MERGED			1104
+#define	WT_STAT_CONN_LSM_ROWS_MERGED			1152
 /*! LSM: application work units currently queued */
-#define	WT_STAT_CONN_LSM_WORK_QUEUE_APP			1105
+#define	WT_STAT_CONN_LSM_WORK_QUEUE_APP			1153
 /*! LSM: merge work units currently queued */
-#define	WT_STAT_CONN_LSM_WORK_QUEUE_MANAGER		1106
+#define	WT_STAT_CONN_LSM_WORK_QUEUE_MANAGER		1154
 /*! LSM: tree queue hit maximum */
-#define	WT_STAT_CONN_LSM_WORK_QUEUE_MAX			1107
+#define	WT_STAT_CONN_LSM_WORK_QUEUE_MAX			1155
 /*! LSM: switch work units currently queued */
-#define	WT_STAT_CONN_LSM_WORK_QUEUE_SWITCH		1108
+#define	WT_STAT_CONN_LSM_WORK_QUEUE_SWITCH		1156
 /*! LSM: tree maintenance operations scheduled */
-#define	WT_STAT_CONN_LSM_WORK_UNITS_CREATED		1109
+#define	WT_STAT_CONN_LSM_WORK_UNITS_CREATED		1157
 /*! LSM: tree maintenance operations discarded */
-#define	WT_STAT_CONN_LSM_WORK_UNITS_DISCARDED		1110
+#define	WT_STAT_CONN_LSM_WORK_UNITS_DISCARDED		1158
 /*! LSM: tree maintenance operations executed */
-#define	WT_STAT_CONN_LSM_WORK_UNITS_DONE		1111
+#define	WT_STAT_CONN_LSM_WORK_UNITS_DONE		1159
 /*! connection: memory allocations */
-#define	WT_STAT_CONN_MEMORY_ALLOCATION			1112
+#define	WT_STAT_CONN_MEMORY_ALLOCATION			1160
 /*! connection: memory frees */
-#define	WT_STAT_CONN_MEMORY_FREE			1113
+#define	WT_STAT_CONN_MEMORY_FREE			1161
 /*! connection: memory re-allocations */
-#define	WT_STAT_CONN_MEMORY_GROW			1114
+#define	WT_STAT_CONN_MEMORY_GROW			1162
 /*! thread-yield: page acquire busy blocked */
-#define	WT_STAT_CONN_PAGE_BUSY_BLOCKED			1115
+#define	WT_STAT_CONN_PAGE_BUSY_BLOCKED			1163
 /*! thread-yield: page acquire eviction blocked */
-#define	WT_STAT_CONN_PAGE_FORCIBLE_EVICT_BLOCKED	1116
+#define	WT_STAT_CONN_PAGE_FORCIBLE_EVICT_BLOCKED	1164
 /*! thread-yield: page acquire locked blocked */
-#define	WT_STAT_CONN_PAGE_LOCKED_BLOCKED		1117
+#define	WT_STAT_CONN_PAGE_LOCKED_BLOCKED		1165
 /*! thread-yield: page acquire read blocked */
-#define	WT_STAT_CONN_PAGE_READ_BLOCKED			1118
+#define	WT_STAT_CONN_PAGE_READ_BLOCKED			1166
 /*! thread-yield: page acquire time sleeping (usecs) */
-#define	WT_STAT_CONN_PAGE_SLEEP				1119
+#define	WT_STAT_CONN_PAGE_SLEEP				1167
 /*! connection: total read I/Os */
-#define	WT_STAT_CONN_READ_IO				1120
+#define	WT_STAT_CONN_READ_IO				1168
+/*! reconciliation: split pages compressed by block compression threads */
+#define	WT_STAT_CONN_REC_COMPRESS_ASYNC			1169
+/*! reconciliation: split page writes that waited for a block compression thread */
+#define	WT_STAT_CONN_REC_COMPRESS_WAIT			1170
 /*! reconciliation: page reconciliation calls */
-#define	WT_STAT_CONN_REC_PAGES				1121
+#define	WT_STAT_CONN_REC_PAGES				1171
 /*! reconciliation: page reconciliation calls for eviction */
-#define	WT_STAT_CONN_REC_PAGES_EVICTION			1122
+#define	WT_STAT_CONN_REC_PAGES_EVICTION			1172
 /*! reconciliation: split bytes currently awaiting free */
-#define	WT_STAT_CONN_REC_SPLIT_STASHED_BYTES		1123
+#define	WT_STAT_CONN_REC_SPLIT_STASHED_BYTES		1173
 /*! reconciliation: split objects currently awaiting free */
-#define	WT_STAT_CONN_REC_SPLIT_STASHED_OBJECTS		1124
+#define	WT_STAT_CONN_REC_SPLIT_STASHED_OBJECTS		1174
 /*! connection: pthread mutex shared lock read-lock calls */
-#define	WT_STAT_CONN_RWLOCK_READ			1125
+#define	WT_STAT_CONN_RWLOCK_READ			1175
 /*! connection: pthread mutex shared lock write-lock calls */
-#define	WT_STAT_CONN_RWLOCK_WRITE			1126
+#define	WT_STAT_CONN_RWLOCK_WRITE			1176
 /*! session: open cursor count */
-#define	WT_STAT_CONN_SESSION_CURSOR_OPEN		1127
+#define	WT_STAT_CONN_SESSION_CURSOR_OPEN		1177
 /*! session: open session count */
-#define	WT_STAT_CONN_SESSION_OPEN			1128
+#define	WT_STAT_CONN_SESSION_OPEN			1178
 /*! transaction: transaction begins */
-#define	WT_STAT_CONN_TXN_BEGIN				1129
+#define	WT_STAT_CONN_TXN_BEGIN				1179
 /*! transaction: transaction checkpoints */
-#define	WT_STAT_CONN_TXN_CHECKPOINT			1130
+#define	WT_STAT_CONN_TXN_CHECKPOINT			1180
+/*! transaction: maximum per-file checkpoint operation time (usecs) */
+#define	WT_STAT_CONN_TXN_CHECKPOINT_FILE_TIME_MAX	1181
 /*! transaction: transaction checkpoint generation */
-#define	WT_STAT_CONN_TXN_CHECKPOINT_GENERATION		1131
+#define	WT_STAT_CONN_TXN_CHECKPOINT_GENERATION		1182
 /*! transaction: transaction checkpoint currently running */
-#define	WT_STAT_CONN_TXN_CHECKPOINT_RUNNING		1132
+#define	WT_STAT_CONN_TXN_CHECKPOINT_RUNNING		1183
 /*! transaction: transaction checkpoint max time (msecs) */
-#define	WT_STAT_CONN_TXN_CHECKPOINT_TIME_MAX		1133
+#define	WT_STAT_CONN_TXN_CHECKPOINT_TIME_MAX		1184
 /*! transaction: transaction checkpoint min time (msecs) */
-#define	WT_STAT_CONN_TXN_CHECKPOINT_TIME_MIN		1134
+#define	WT_STAT_CONN_TXN_CHECKPOINT_TIME_MIN		1185
 /*! transaction: transaction checkpoint most recent time (msecs) */
-#define	WT_STAT_CONN_TXN_CHECKPOINT_TIME_RECENT		1135
+#define	WT_STAT_CONN_TXN_CHECKPOINT_TIME_RECENT		1186
 /*! transaction: transaction checkpoint total time (msecs) */
-#define	WT_STAT_CONN_TXN_CHECKPOINT_TIME_TOTAL		1136
+#define	WT_STAT_CONN_TXN_CHECKPOINT_TIME_TOTAL		1187
 /*! transaction: transactions committed */
-#define	WT_STAT_CONN_TXN_COMMIT				1137
+#define	WT_STAT_CONN_TXN_COMMIT				1188
 /*! transaction: transaction failures due to cache overflow */
-#define	WT_STAT_CONN_TXN_FAIL_CACHE			1138
+#define	WT_STAT_CONN_TXN_FAIL_CACHE			1189
 /*! transaction: transaction range of IDs currently pinned by a checkpoint */
-#define	WT_STAT_CONN_TXN_PINNED_CHECKPOINT_RANGE	1139
+#define	WT_STAT_CONN_TXN_PINNED_CHECKPOINT_RANGE	1190
 /*! transaction: transaction range of IDs currently pinned */
-#define	WT_STAT_CONN_TXN_PINNED_RANGE			1140
+#define	WT_STAT_CONN_TXN_PINNED_RANGE			1191
 /*! transaction: transactions rolled back */
-#define	WT_STAT_CONN_TXN_ROLLBACK			1141
+#define	WT_STAT_CONN_TXN_ROLLBACK			1192
+/*! transaction: transaction snapshots taken from the snapshot cache */
+#define	WT_STAT_CONN_TXN_SNAPSHOT_CACHE_HIT		1193
+/*! transaction: transaction snapshot cache misses */
+#define	WT_STAT_CONN_TXN_SNAPSHOT_CACHE_MISS		1194
 /*! connection: total write I/Os */
-#define	WT_STAT_CONN_WRITE_IO				1142
+#define	WT_STAT_CONN_WRITE_IO				1195
 
 /*data sources的统计项*/
 /*! block-manager: file allocation unit size */
@@ -724,152 +864,154 @@ extern int wiredtiger_extension_terminate(WT_CONNECTION *connection);
 #define	WT_STAT_DSRC_BLOOM_SIZE				2016
 /*! btree: btree checkpoint generation */
 #define	WT_STAT_DSRC_BTREE_CHECKPOINT_GENERATION	2017
+/*! btree: time spent on checkpoint work for this file (usecs) */
+#define	WT_STAT_DSRC_BTREE_CHECKPOINT_TIME		2018
 /*! btree: column-store variable-size deleted values */
-#define	WT_STAT_DSRC_BTREE_COLUMN_DELETED		2018
+#define	WT_STAT_DSRC_BTREE_COLUMN_DELETED		2019
 /*! btree: column-store fixed-size leaf pages */
-#define	WT_STAT_DSRC_BTREE_COLUMN_FIX			2019
+#define	WT_STAT_DSRC_BTREE_COLUMN_FIX			2020
 /*! btree: column-store internal pages */
-#define	WT_STAT_DSRC_BTREE_COLUMN_INTERNAL		2020
+#define	WT_STAT_DSRC_BTREE_COLUMN_INTERNAL		2021
 /*! btree: column-store variable-size leaf pages */
-#define	WT_STAT_DSRC_BTREE_COLUMN_VARIABLE		2021
+#define	WT_STAT_DSRC_BTREE_COLUMN_VARIABLE		2022
 /*! btree: pages rewritten by compaction */
-#define	WT_STAT_DSRC_BTREE_COMPACT_REWRITE		2022
+#define	WT_STAT_DSRC_BTREE_COMPACT_REWRITE		2023
 /*! btree: number of key/value pairs */
-#define	WT_STAT_DSRC_BTREE_ENTRIES			2023
+#define	WT_STAT_DSRC_BTREE_ENTRIES			2024
 /*! btree: fixed-record size */
-#define	WT_STAT_DSRC_BTREE_FIXED_LEN			2024
+#define	WT_STAT_DSRC_BTREE_FIXED_LEN			2025
 /*! btree: maximum tree depth */
-#define	WT_STAT_DSRC_BTREE_MAXIMUM_DEPTH		2025
+#define	WT_STAT_DSRC_BTREE_MAXIMUM_DEPTH		2026
 /*! btree: maximum internal page key size */
-#define	WT_STAT_DSRC_BTREE_MAXINTLKEY			2026
+#define	WT_STAT_DSRC_BTREE_MAXINTLKEY			2027
 /*! btree: maximum internal page size */
-#define	WT_STAT_DSRC_BTREE_MAXINTLPAGE			2027
+#define	WT_STAT_DSRC_BTREE_MAXINTLPAGE			2028
 /*! btree: maximum leaf page key size */
-#define	WT_STAT_DSRC_BTREE_MAXLEAFKEY			2028
+#define	WT_STAT_DSRC_BTREE_MAXLEAFKEY			2029
 /*! btree: maximum leaf page size */
-#define	WT_STAT_DSRC_BTREE_MAXLEAFPAGE			2029
+#define	WT_STAT_DSRC_BTREE_MAXLEAFPAGE			2030
 /*! btree: maximum leaf page value size */
-#define	WT_STAT_DSRC_BTREE_MAXLEAFVALUE			2030
+#define	WT_STAT_DSRC_BTREE_MAXLEAFVALUE			2031
 /*! btree: overflow pages */
-#define	WT_STAT_DSRC_BTREE_OVERFLOW			2031
+#define	WT_STAT_DSRC_BTREE_OVERFLOW			2032
 /*! btree: row-store internal pages */
-#define	WT_STAT_DSRC_BTREE_ROW_INTERNAL			2032
+#define	WT_STAT_DSRC_BTREE_ROW_INTERNAL			2033
 /*! btree: row-store leaf pages */
-#define	WT_STAT_DSRC_BTREE_ROW_LEAF			2033
+#define	WT_STAT_DSRC_BTREE_ROW_LEAF			2034
 /*! cache: bytes read into cache */
-#define	WT_STAT_DSRC_CACHE_BYTES_READ			2034
+#define	WT_STAT_DSRC_CACHE_BYTES_READ			2035
 /*! cache: bytes written from cache */
-#define	WT_STAT_DSRC_CACHE_BYTES_WRITE			2035
+#define	WT_STAT_DSRC_CACHE_BYTES_WRITE			2036
 /*! cache: checkpoint blocked page eviction */
-#define	WT_STAT_DSRC_CACHE_EVICTION_CHECKPOINT		2036
+#define	WT_STAT_DSRC_CACHE_EVICTION_CHECKPOINT		2037
 /*! cache: unmodified pages evicted */
-#define	WT_STAT_DSRC_CACHE_EVICTION_CLEAN		2037
+#define	WT_STAT_DSRC_CACHE_EVICTION_CLEAN		2038
 /*! cache: page split during eviction deepened the tree */
-#define	WT_STAT_DSRC_CACHE_EVICTION_DEEPEN		2038
+#define	WT_STAT_DSRC_CACHE_EVICTION_DEEPEN		2039
 /*! cache: modified pages evicted */
-#define	WT_STAT_DSRC_CACHE_EVICTION_DIRTY		2039
+#define	WT_STAT_DSRC_CACHE_EVICTION_DIRTY		2040
 /*! cache: data source pages selected for eviction unable to be evicted */
-#define	WT_STAT_DSRC_CACHE_EVICTION_FAIL		2040
+#define	WT_STAT_DSRC_CACHE_EVICTION_FAIL		2041
 /*! cache: hazard pointer blocked page eviction */
-#define	WT_STAT_DSRC_CACHE_EVICTION_HAZARD		2041
+#define	WT_STAT_DSRC_CACHE_EVICTION_HAZARD		2042
 /*! cache: internal pages evicted */
-#define	WT_STAT_DSRC_CACHE_EVICTION_INTERNAL		2042
+#define	WT_STAT_DSRC_CACHE_EVICTION_INTERNAL		2043
 /*! cache: pages split during eviction */
-#define	WT_STAT_DSRC_CACHE_EVICTION_SPLIT		2043
+#define	WT_STAT_DSRC_CACHE_EVICTION_SPLIT		2044
 /*! cache: in-memory page splits */
-#define	WT_STAT_DSRC_CACHE_INMEM_SPLIT			2044
+#define	WT_STAT_DSRC_CACHE_INMEM_SPLIT			2045
 /*! cache: overflow values cached in memory */
-#define	WT_STAT_DSRC_CACHE_OVERFLOW_VALUE		2045
+#define	WT_STAT_DSRC_CACHE_OVERFLOW_VALUE		2046
 /*! cache: pages read into cache */
-#define	WT_STAT_DSRC_CACHE_READ				2046
+#define	WT_STAT_DSRC_CACHE_READ				2047
 /*! cache: overflow pages read into cache */
-#define	WT_STAT_DSRC_CACHE_READ_OVERFLOW		2047
+#define	WT_STAT_DSRC_CACHE_READ_OVERFLOW		2048
 /*! cache: pages written from cache */
-#define	WT_STAT_DSRC_CACHE_WRITE			2048
+#define	WT_STAT_DSRC_CACHE_WRITE			2049
 /*! compression: raw compression call failed, no additional data available */
-#define	WT_STAT_DSRC_COMPRESS_RAW_FAIL			2049
+#define	WT_STAT_DSRC_COMPRESS_RAW_FAIL			2050
 /*! compression: raw compression call failed, additional data available */
-#define	WT_STAT_DSRC_COMPRESS_RAW_FAIL_TEMPORARY	2050
+#define	WT_STAT_DSRC_COMPRESS_RAW_FAIL_TEMPORARY	2051
 /*! compression: raw compression call succeeded */
-#define	WT_STAT_DSRC_COMPRESS_RAW_OK			2051
+#define	WT_STAT_DSRC_COMPRESS_RAW_OK			2052
 /*! compression: compressed pages read */
-#define	WT_STAT_DSRC_COMPRESS_READ			2052
+#define	WT_STAT_DSRC_COMPRESS_READ			2053
 /*! compression: compressed pages written */
-#define	WT_STAT_DSRC_COMPRESS_WRITE			2053
+#define	WT_STAT_DSRC_COMPRESS_WRITE			2054
 /*! compression: page written failed to compress */
-#define	WT_STAT_DSRC_COMPRESS_WRITE_FAIL		2054
+#define	WT_STAT_DSRC_COMPRESS_WRITE_FAIL		2055
 /*! compression: page written was too small to compress */
-#define	WT_STAT_DSRC_COMPRESS_WRITE_TOO_SMALL		2055
+#define	WT_STAT_DSRC_COMPRESS_WRITE_TOO_SMALL		2056
 /*! cursor: create calls */
-#define	WT_STAT_DSRC_CURSOR_CREATE			2056
+#define	WT_STAT_DSRC_CURSOR_CREATE			2057
 /*! cursor: insert calls */
-#define	WT_STAT_DSRC_CURSOR_INSERT			2057
+#define	WT_STAT_DSRC_CURSOR_INSERT			2058
 /*! cursor: bulk-loaded cursor-insert calls */
-#define	WT_STAT_DSRC_CURSOR_INSERT_BULK			2058
+#define	WT_STAT_DSRC_CURSOR_INSERT_BULK			2059
 /*! cursor: cursor-insert key and value bytes inserted */
-#define	WT_STAT_DSRC_CURSOR_INSERT_BYTES		2059
+#define	WT_STAT_DSRC_CURSOR_INSERT_BYTES		2060
 /*! cursor: next calls */
-#define	WT_STAT_DSRC_CURSOR_NEXT			2060
+#define	WT_STAT_DSRC_CURSOR_NEXT			2061
 /*! cursor: prev calls */
-#define	WT_STAT_DSRC_CURSOR_PREV			2061
+#define	WT_STAT_DSRC_CURSOR_PREV			2062
 /*! cursor: remove calls */
-#define	WT_STAT_DSRC_CURSOR_REMOVE			2062
+#define	WT_STAT_DSRC_CURSOR_REMOVE			2063
 /*! cursor: cursor-remove key bytes removed */
-#define	WT_STAT_DSRC_CURSOR_REMOVE_BYTES		2063
+#define	WT_STAT_DSRC_CURSOR_REMOVE_BYTES		2064
 /*! cursor: reset calls */
-#define	WT_STAT_DSRC_CURSOR_RESET			2064
+#define	WT_STAT_DSRC_CURSOR_RESET			2065
 /*! cursor: search calls */
-#define	WT_STAT_DSRC_CURSOR_SEARCH			2065
+#define	WT_STAT_DSRC_CURSOR_SEARCH			2066
+/*! cursor: search batch calls */
+#define	WT_STAT_DSRC_CURSOR_SEARCH_BATCH		2067
 /*! cursor: search near calls */
-#define	WT_STAT_DSRC_CURSOR_SEARCH_NEAR			2066
+#define	WT_STAT_DSRC_CURSOR_SEARCH_NEAR			2068
 /*! cursor: update calls */
-#define	WT_STAT_DSRC_CURSOR_UPDATE			2067
+#define	WT_STAT_DSRC_CURSOR_UPDATE			2069
 /*! cursor: cursor-update value bytes updated */
-#define	WT_STAT_DSRC_CURSOR_UPDATE_BYTES		2068
+#define	WT_STAT_DSRC_CURSOR_UPDATE_BYTES		2070
 /*! LSM: sleep for LSM checkpoint throttle */
-#define	WT_STAT_DSRC_LSM_CHECKPOINT_THROTTLE		2069
+#define	WT_STAT_DSRC_LSM_CHECKPOINT_THROTTLE		2071
 /*! LSM: chunks in the LSM tree */
-#define	WT_STAT_DSRC_LSM_CHUNK_COUNT			2070
+#define	WT_STAT_DSRC_LSM_CHUNK_COUNT			2072
 /*! LSM: highest merge generation in the LSM tree */
-#define	WT_STAT_DSRC_LSM_GENERATION_MAX			2071
-/*! LSM: queries that could have benefited from a Bloom filter that did
- * not exist */
-#define	WT_STAT_DSRC_LSM_LOOKUP_NO_BLOOM		2072
+#define	WT_STAT_DSRC_LSM_GENERATION_MAX			2073
+/*! LSM: queries that could have benefited from a Bloom filter that did not exist */
+#define	WT_STAT_DSRC_LSM_LOOKUP_NO_BLOOM		2074
 /*! LSM: sleep for LSM merge throttle */
-#define	WT_STAT_DSRC_LSM_MERGE_THROTTLE			2073
+#define	WT_STAT_DSRC_LSM_MERGE_THROTTLE			2075
 /*! reconciliation: dictionary matches */
-#define	WT_STAT_DSRC_REC_DICTIONARY			2074
+#define	WT_STAT_DSRC_REC_DICTIONARY			2076
 /*! reconciliation: internal page multi-block writes */
-#define	WT_STAT_DSRC_REC_MULTIBLOCK_INTERNAL		2075
+#define	WT_STAT_DSRC_REC_MULTIBLOCK_INTERNAL		2077
 /*! reconciliation: leaf page multi-block writes */
-#define	WT_STAT_DSRC_REC_MULTIBLOCK_LEAF		2076
+#define	WT_STAT_DSRC_REC_MULTIBLOCK_LEAF		2078
 /*! reconciliation: maximum blocks required for a page */
-#define	WT_STAT_DSRC_REC_MULTIBLOCK_MAX			2077
+#define	WT_STAT_DSRC_REC_MULTIBLOCK_MAX			2079
 /*! reconciliation: internal-page overflow keys */
-#define	WT_STAT_DSRC_REC_OVERFLOW_KEY_INTERNAL		2078
+#define	WT_STAT_DSRC_REC_OVERFLOW_KEY_INTERNAL		2080
 /*! reconciliation: leaf-page overflow keys */
-#define	WT_STAT_DSRC_REC_OVERFLOW_KEY_LEAF		2079
+#define	WT_STAT_DSRC_REC_OVERFLOW_KEY_LEAF		2081
 /*! reconciliation: overflow values written */
-#define	WT_STAT_DSRC_REC_OVERFLOW_VALUE			2080
+#define	WT_STAT_DSRC_REC_OVERFLOW_VALUE			2082
 /*! reconciliation: pages deleted */
-#define	WT_STAT_DSRC_REC_PAGE_DELETE			2081
+#define	WT_STAT_DSRC_REC_PAGE_DELETE			2083
 /*! reconciliation: page checksum matches */
-#define	WT_STAT_DSRC_REC_PAGE_MATCH			2082
+#define	WT_STAT_DSRC_REC_PAGE_MATCH			2084
 /*! reconciliation: page reconciliation calls */
-#define	WT_STAT_DSRC_REC_PAGES				2083
+#define	WT_STAT_DSRC_REC_PAGES				2085
 /*! reconciliation: page reconciliation calls for eviction */
-#define	WT_STAT_DSRC_REC_PAGES_EVICTION			2084
+#define	WT_STAT_DSRC_REC_PAGES_EVICTION			2086
 /*! reconciliation: leaf page key bytes discarded using prefix compression */
-#define	WT_STAT_DSRC_REC_PREFIX_COMPRESSION		2085
-/*! reconciliation: internal page key bytes discarded using suffix
- * compression */
-#define	WT_STAT_DSRC_REC_SUFFIX_COMPRESSION		2086
+#define	WT_STAT_DSRC_REC_PREFIX_COMPRESSION		2087
+/*! reconciliation: internal page key bytes discarded using suffix compression */
+#define	WT_STAT_DSRC_REC_SUFFIX_COMPRESSION		2088
 /*! session: object compaction */
-#define	WT_STAT_DSRC_SESSION_COMPACT			2087
+#define	WT_STAT_DSRC_SESSION_COMPACT			2089
 /*! session: open cursor count */
-#define	WT_STAT_DSRC_SESSION_CURSOR_OPEN		2088
+#define	WT_STAT_DSRC_SESSION_CURSOR_OPEN		2090
 /*! transaction: update conflicts */
-#define	WT_STAT_DSRC_TXN_UPDATE_CONFLICT		2089
+#define	WT_STAT_DSRC_TXN_UPDATE_CONFLICT		2091
 
 /*section 统计项*/
 /*! invalid operation */
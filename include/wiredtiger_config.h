@@ -73,6 +73,9 @@
 /* Define to 1 if you have the `z' library (-lz). */
 /* #undef HAVE_LIBZ */
 
+/* Define to 1 if you have the <linux/io_uring.h> header file. */
+/* #undef HAVE_LINUX_IO_URING_H */
+
 /* Define to 1 if you have the <memory.h> header file. */
 #define HAVE_MEMORY_H 1
 
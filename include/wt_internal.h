@@ -24,11 +24,18 @@ extern "C" {
 #include <string.h>
 #include <time.h>
 #include <unistd.h>
+#if defined(__amd64) || defined(__x86_64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#endif
 
 #include "queue.h"
 
 struct __wt_addr;
 typedef struct __wt_addr WT_ADDR;
+struct __wt_aio;
+typedef struct __wt_aio WT_AIO;
+struct __wt_aio_req;
+typedef struct __wt_aio_req WT_AIO_REQ;
 struct __wt_async;
 typedef struct __wt_async WT_ASYNC;
 struct __wt_async_cursor;
@@ -37,8 +44,16 @@ struct __wt_async_format;
 typedef struct __wt_async_format WT_ASYNC_FORMAT;
 struct __wt_async_op_impl;
 typedef struct __wt_async_op_impl WT_ASYNC_OP_IMPL;
+struct __wt_async_qslot;
+typedef struct __wt_async_qslot WT_ASYNC_QSLOT;
 struct __wt_async_worker_state;
 typedef struct __wt_async_worker_state WT_ASYNC_WORKER_STATE;
+struct __wt_blkcache;
+typedef struct __wt_blkcache WT_BLKCACHE;
+struct __wt_blkcache_item;
+typedef struct __wt_blkcache_item WT_BLKCACHE_ITEM;
+struct __wt_blkcache_part;
+typedef struct __wt_blkcache_part WT_BLKCACHE_PART;
 struct __wt_block;
 typedef struct __wt_block WT_BLOCK;
 struct __wt_block_ckpt;
@@ -47,8 +62,12 @@ struct __wt_block_desc;
 typedef struct __wt_block_desc WT_BLOCK_DESC;
 struct __wt_block_header;
 typedef struct __wt_block_header WT_BLOCK_HEADER;
+struct __wt_block_shard;
+typedef struct __wt_block_shard WT_BLOCK_SHARD;
 struct __wt_bloom;
 typedef struct __wt_bloom WT_BLOOM;
+struct __wt_bloom_bits;
+typedef struct __wt_bloom_bits WT_BLOOM_BITS;
 struct __wt_bloom_hash;
 typedef struct __wt_bloom_hash WT_BLOOM_HASH;
 struct __wt_bm;
@@ -73,12 +92,20 @@ struct __wt_colgroup;
 typedef struct __wt_colgroup WT_COLGROUP;
 struct __wt_compact;
 typedef struct __wt_compact WT_COMPACT;
+struct __wt_compress_job;
+typedef struct __wt_compress_job WT_COMPRESS_JOB;
+struct __wt_compress_worker;
+typedef struct __wt_compress_worker WT_COMPRESS_WORKER;
 struct __wt_condvar;
 typedef struct __wt_condvar WT_CONDVAR;
 struct __wt_config;
 typedef struct __wt_config WT_CONFIG;
 struct __wt_config_check;
 typedef struct __wt_config_check WT_CONFIG_CHECK;
+struct __wt_config_compiled;
+typedef struct __wt_config_compiled WT_CONFIG_COMPILED;
+struct __wt_config_compiled_item;
+typedef struct __wt_config_compiled_item WT_CONFIG_COMPILED_ITEM;
 struct __wt_config_entry;
 typedef struct __wt_config_entry WT_CONFIG_ENTRY;
 struct __wt_config_parser_impl;
@@ -87,6 +114,8 @@ struct __wt_connection_impl;
 typedef struct __wt_connection_impl WT_CONNECTION_IMPL;
 struct __wt_connection_stats;
 typedef struct __wt_connection_stats WT_CONNECTION_STATS;
+struct __wt_connection_stats_slot;
+typedef struct __wt_connection_stats_slot WT_CONNECTION_STATS_SLOT;
 struct __wt_connection_stats_spinlock;
 typedef struct __wt_connection_stats_spinlock WT_CONNECTION_STATS_SPINLOCK;
 struct __wt_cursor_backup;
@@ -127,6 +156,8 @@ struct __wt_dsrc_stats;
 typedef struct __wt_dsrc_stats WT_DSRC_STATS;
 struct __wt_evict_entry;
 typedef struct __wt_evict_entry WT_EVICT_ENTRY;
+struct __wt_evict_queue;
+typedef struct __wt_evict_queue WT_EVICT_QUEUE;
 struct __wt_evict_worker;
 typedef struct __wt_evict_worker WT_EVICT_WORKER;
 struct __wt_ext;
@@ -193,6 +224,10 @@ struct __wt_page_modify;
 typedef struct __wt_page_modify WT_PAGE_MODIFY;
 struct __wt_process;
 typedef struct __wt_process WT_PROCESS;
+struct __wt_readahead_req;
+typedef struct __wt_readahead_req WT_READAHEAD_REQ;
+struct __wt_readahead_worker;
+typedef struct __wt_readahead_worker WT_READAHEAD_WORKER;
 struct __wt_ref;
 typedef struct __wt_ref WT_REF;
 struct __wt_row;
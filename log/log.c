@@ -736,6 +736,164 @@ err:
 	return ret;
 }
 
+/*WT_LOG_WRLSN_ENTRY的比较器函数,其实他们的lsn的比较，为了保证lsn顺序所写的*/
+static int WT_CDECL __log_wrlsn_cmp(const void *a, const void *b)
+{
+	WT_LOG_WRLSN_ENTRY *ae, *be;
+
+	ae = (WT_LOG_WRLSN_ENTRY *)a;
+	be = (WT_LOG_WRLSN_ENTRY *)b;
+	return LOG_CMP(&ae->lsn, &be->lsn);
+}
+
+/*
+ * 按照LSN的顺序推进log->write_lsn。有多个active slot时slot的完成顺序和LSN的顺序不一致，
+ * 已经写入OS但是前面还有slot没写完的slot处于WT_LOG_SLOT_WRITTEN状态，等到write_lsn
+ * 推进到它的release lsn时才能处理并释放。wrlsn server和等待write_lsn的__log_release
+ * 都会调用这个函数，advancedp返回本次推进write_lsn处理掉的slot数量
+ */
+int __wt_log_wrlsn(WT_SESSION_IMPL* session, uint32_t* advancedp)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_DECL_RET;
+	WT_LOG *log;
+	WT_LOG_WRLSN_ENTRY written[SLOT_POOL];
+	WT_LOGSLOT *slot;
+	size_t written_i;
+	uint32_t advanced, i, save_i;
+
+	conn = S2C(session);
+	log = conn->log;
+	advanced = 0;
+	written_i = 0;
+
+	__wt_spin_lock(session, &log->log_wrlsn_lock);
+
+	/*这里不需要对slot pool进行多线程保护，因为slot pool是个静态的数组*/
+	for (i = 0; i < SLOT_POOL;) {
+		save_i = i;
+		slot = &log->slot_pool[i++];
+		if (slot->slot_state != WT_LOG_SLOT_WRITTEN) /*过滤掉非WRITTEN状态*/
+			continue;
+
+		written[written_i].slot_index = save_i;
+		written[written_i++].lsn = slot->slot_release_lsn;
+	}
+
+	if (written_i > 0) {
+		/*按LSN由小到大排序,因为要按slot进行数据刷盘*/
+		qsort(written, written_i, sizeof(WT_LOG_WRLSN_ENTRY), __log_wrlsn_cmp);
+		/*
+		 * We know the written array is sorted by LSN.  Go
+		 * through them either advancing write_lsn or stop
+		 * as soon as one is not in order.
+		 */
+		for (i = 0; i < written_i; i++) {
+			if (LOG_CMP(&log->write_lsn, &written[i].lsn) != 0)
+				break;
+			/*
+			 * If we get here we have a slot to process.
+			 * Advance the LSN and process the slot.
+			 */
+			slot = &log->slot_pool[written[i].slot_index];
+			WT_ASSERT(session, LOG_CMP(&written[i].lsn, &slot->slot_release_lsn) == 0);
+			/*更新WRITE LSN*/
+			log->write_lsn = slot->slot_end_lsn;
+			WT_ERR(__wt_cond_signal(session, log->log_write_cond));
+
+			WT_STAT_FAST_CONN_INCR(session, log_write_lsn);
+
+			/*
+			 * Signal the close thread if needed.尝试把file page cache的数据sync到磁盘上
+			 */
+			if (F_ISSET(slot, SLOT_CLOSEFH))
+				WT_ERR(__wt_cond_signal(session, conn->log_close_cond));
+
+			WT_ERR(__wt_log_slot_free(session, slot));
+			++advanced;
+		}
+	}
+
+err:
+	__wt_spin_unlock(session, &log->log_wrlsn_lock);
+	if (advancedp != NULL)
+		*advancedp = advanced;
+
+	return ret;
+}
+
+/*
+ * 向flush thread提交一个slot的sync请求，并等待slot的数据被fsync到磁盘上。
+ * slot的数据在这之前已经写入OS并推进了write_lsn
+ */
+static int __log_flush_wait(WT_SESSION_IMPL* session, WT_LOGSLOT* slot)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_LOG *log;
+	WT_LSN end_lsn;
+
+	conn = S2C(session);
+	log = conn->log;
+	end_lsn = slot->slot_end_lsn;
+
+	__wt_spin_lock(session, &log->log_flush_lock);
+	if (F_ISSET(slot, SLOT_SYNC) && LOG_CMP(&log->sync_req_lsn, &end_lsn) < 0)
+		log->sync_req_lsn = end_lsn;
+	if (F_ISSET(slot, SLOT_SYNC_DIR) && LOG_CMP(&log->sync_dir_req_lsn, &end_lsn) < 0)
+		log->sync_dir_req_lsn = end_lsn;
+	__wt_spin_unlock(session, &log->log_flush_lock);
+
+	WT_STAT_FAST_CONN_INCR(session, log_sync_requests);
+	WT_RET(__wt_cond_signal(session, conn->log_flush_cond));
+
+	while ((F_ISSET(slot, SLOT_SYNC) && LOG_CMP(&log->sync_lsn, &end_lsn) < 0) ||
+		(F_ISSET(slot, SLOT_SYNC_DIR) && log->sync_dir_lsn.file < end_lsn.file)) {
+		/*flush thread出错退出了，请求不会再被处理*/
+		if (log->flush_ret != 0)
+			return log->flush_ret;
+		WT_RET(__wt_cond_wait(session, log->log_sync_cond, 10000));
+	}
+
+	return 0;
+}
+
+#define WT_LOG_AIO_CHUNK	(64 * 1024)
+#define WT_LOG_AIO_CHUNKS	8
+
+/*
+ * 将slot buffer中的数据写入日志文件。配置了io_uring时把大的写入按allocsize对齐切分成多个块，
+ * 同时提交多个写请求，direct I/O的日志文件可以得到真正的队列深度
+ */
+static int __log_write_slot(WT_SESSION_IMPL* session, WT_LOGSLOT* slot, size_t write_size)
+{
+	WT_AIO_REQ reqs[WT_LOG_AIO_CHUNKS];
+	WT_DECL_RET;
+	WT_LOG *log;
+	size_t chunk, len, off;
+	u_int i, n;
+
+	log = S2C(session)->log;
+	chunk = (size_t)WT_ALIGN(WT_LOG_AIO_CHUNK, log->allocsize);
+
+	if (S2C(session)->aio == NULL || write_size <= chunk)
+		return __wt_write(session, slot->slot_fh, slot->slot_start_offset, write_size, slot->slot_buf.mem);
+
+	for (off = 0; off < write_size && ret == 0;){
+		for (n = 0; n < WT_LOG_AIO_CHUNKS && off < write_size; ++n, off += len){
+			len = WT_MIN(chunk, write_size - off);
+			if ((ret = __wt_aio_submit(session, &reqs[n], slot->slot_fh, 1,
+				slot->slot_start_offset + (wt_off_t)off, len, (uint8_t *)slot->slot_buf.mem + off)) != 0)
+				break;
+		}
+
+		/*已经提交的写请求必须全部完成，slot buffer才能被重用*/
+		for (i = 0; i < n; ++i)
+			WT_TRET(__wt_aio_wait(session, &reqs[i]));
+	}
+
+	return ret;
+}
+
 /*release一个log对应的slot， 在这个过程先会将slot buffer中的数据写入到对应文件的page cache中
  *然后对文件进行sync操作，进行日志落盘*/
 static int __log_release(WT_SESSION_IMPL* session, WT_LOGSLOT* slot, int* freep)
@@ -745,6 +903,7 @@ static int __log_release(WT_SESSION_IMPL* session, WT_LOGSLOT* slot, int* freep)
 	WT_LOG *log;
 	WT_LSN sync_lsn;
 	size_t write_size;
+	uint32_t advanced;
 	int locked, yield_count;
 	WT_DECL_SPINLOCK_ID(id);	
 
@@ -757,7 +916,7 @@ static int __log_release(WT_SESSION_IMPL* session, WT_LOGSLOT* slot, int* freep)
 	/*将slot的缓冲区中的log record数据写入到对应文件中*/
 	if(F_ISSET(slot, SLOT_BUFFERED)){
 		write_size = (size_t)(slot->slot_end_lsn.offset - slot->slot_start_offset);
-		WT_ERR(__wt_write(session, slot->slot_fh, slot->slot_start_offset, write_size, slot->slot_buf.mem));
+		WT_ERR(__log_write_slot(session, slot, write_size));
 	}
 
 	/*log 数据只是存储在log file buffer中，但不会做数据的sync，这个时候需要统一有wrlsn thread去更新log->write_lsn*/
@@ -772,8 +931,20 @@ static int __log_release(WT_SESSION_IMPL* session, WT_LOGSLOT* slot, int* freep)
 
 	/*修改统计信息*/
 	WT_STAT_FAST_CONN_INCR(session, log_release_write_lsn);
-	/*判断write lsn是否达到release lsn的位置，如果达到，进行write_lsn的更新,有可能前面的slot数据还没有写入，必须等待前面slot写入OS层*/
-	while (LOG_CMP(&log->write_lsn, &slot->slot_release_lsn) != 0) {
+	/*
+	 * 判断write lsn是否达到release lsn的位置，如果达到，进行write_lsn的更新,有可能前面的slot数据还没有写入，必须等待前面slot写入OS层。
+	 * 有多个active slot时前面的slot可能已经写完处于WRITTEN状态，在这里直接帮wrlsn server推进write_lsn，不用等server线程被唤醒
+	 */
+	for (;;) {
+		__wt_spin_lock(session, &log->log_wrlsn_lock);
+		if (LOG_CMP(&log->write_lsn, &slot->slot_release_lsn) == 0)
+			break;
+		__wt_spin_unlock(session, &log->log_wrlsn_lock);
+
+		WT_ERR(__wt_log_wrlsn(session, &advanced));
+		if (advanced > 0)
+			continue;
+
 		if (++yield_count < 1000)
 			__wt_yield();
 		else
@@ -781,13 +952,26 @@ static int __log_release(WT_SESSION_IMPL* session, WT_LOGSLOT* slot, int* freep)
 	}
 
 	log->write_lsn = slot->slot_end_lsn;
+	__wt_spin_unlock(session, &log->log_wrlsn_lock);
 	/*log write lsn做了更新，让等log_write_cond的线程重新进行write lsn判断*/
 	WT_ERR(__wt_cond_signal(session, log->log_write_cond));
+	/*后面的slot可能已经处于WRITTEN状态在等待这个slot，唤醒wrlsn server处理它们*/
+	if (conn->log_wrlsn_cond != NULL)
+		WT_ERR(__wt_cond_signal(session, conn->log_wrlsn_cond));
 
 	/*如果slot处于关闭文件的表示，通知对应等待线程进行文件关闭*/
 	if (F_ISSET(slot, SLOT_CLOSEFH))
 		WT_ERR(__wt_cond_signal(session, conn->log_close_cond));
 
+	/*
+	 * flush thread已经启动，sync交给flush thread统一做group fsync，本线程只需要等待sync_lsn推进。
+	 * flush thread出错退出后由本线程自己做fsync
+	 */
+	if (F_ISSET(slot, SLOT_SYNC | SLOT_SYNC_DIR) && conn->log_flush_tid_set && log->flush_ret == 0) {
+		WT_ERR(__log_flush_wait(session, slot));
+		F_CLR(slot, SLOT_SYNC | SLOT_SYNC_DIR);
+	}
+
 	while (F_ISSET(slot, SLOT_SYNC | SLOT_SYNC_DIR)){
 		/*如果正在sync的file小于slot->slot_end_lsn.file，表示slot对应的日志文件还没有完成sync操作(不能刷end_lsn对应的文件)，必须进行等待*/
 		if (log->sync_lsn.file < slot->slot_end_lsn.file || __wt_spin_trylock(session, &log->log_sync_lock, &id) != 0) {
@@ -74,16 +74,19 @@ int __wt_log_slot_join(WT_SESSION_IMPL* session, uint64_t mysize, uint32_t flags
 	WT_LOG*				log;
 	WT_LOGSLOT*			slot;
 	int64_t				cur_state, new_state, old_state;
-	uint32_t			allocated_slot, slot_grow_attempts;
+	uint32_t			allocated_slot, slot_attempts, slot_grow_attempts;
 
 	conn = S2C(session);
 	log = conn->log;
 
-	slot_grow_attempts = 0;
+	slot_attempts = slot_grow_attempts = 0;
 
 find_slot:
-	/*随机在active slots中获取一个已经处于准备状态的slot*/
-	allocated_slot = __wt_random(session->rnd) % SLOT_ACTIVE;
+	/*
+	 * 按照session id把线程分散到不同的active slot上，每个session固定先尝试自己的slot，
+	 * 这样并发提交的线程不会都挤在同一个slot上。自己的slot不可用时依次尝试后面的slot
+	 */
+	allocated_slot = (session->id + slot_attempts++) % SLOT_ACTIVE;
 	slot = log->slot_array[allocated_slot];
 	old_state = slot->slot_state;
 
@@ -290,7 +293,7 @@ int __wt_log_slot_grow_buffers(WT_SESSION_IMPL *session, size_t newsize)
 
 	/*这个spin lock是防止其他线程同时grow buffer*/
 	__wt_spin_lock(session, &log->log_slot_lock);
-	for(i < 0; i < SLOT_POOL; i++){
+	for(i = 0; i < SLOT_POOL; i++){
 		slot = &log->slot_pool[i];
 
 		/*正在使用的slot不在grow buffer之列,也避开对应的slot原子操作spin*/
@@ -476,7 +476,7 @@ retry:
 			(*cp)->insert = __wt_curfile_update_check;
 
 		if (!F_ISSET(clsm, WT_CLSM_MERGE) && F_ISSET(chunk, WT_LSM_CHUNK_BLOOM))
-			WT_ERR(__wt_bloom_open(session, chunk->bloom_uri, lsm_tree->bloom_bit_count, c, &clsm->blooms[i]));
+			WT_ERR(__wt_bloom_open(session, chunk->bloom_uri, lsm_tree->bloom_bit_count, lsm_tree->bloom_hash_count, c, &clsm->blooms[i]));
 
 		/* Child cursors always use overwrite and raw mode. */
 		F_SET(*cp, WT_CURSTD_OVERWRITE | WT_CURSTD_RAW);
@@ -526,48 +526,159 @@ int __wt_clsm_init_merge(WT_CURSOR *cursor, u_int start_chunk, uint32_t start_id
 	return ret;
 }
 
-/*获得lsm tree中所有打开的cursor对最小或者最大的cursor，
- *并将lsm tree中当前的cursor中的值拷贝到定位到的cursor中
+/*
+ * 迭代时，chunk cursor按照当前的key组织成一个二叉堆，堆顶就是下一个要返回的cursor，
+ * 每次next/prev只需要调整移动过的cursor在堆中的位置，比较次数是O(log chunks)。
+ * key相同时，新的chunk(下标大)排在前面，这样堆顶就是最新的版本
  */
-static int __clsm_get_current(WT_SESSION_IMPL *session, WT_CURSOR_LSM *clsm, int smallest, int *deletedp)
+static inline int __clsm_heap_before(WT_SESSION_IMPL *session, WT_CURSOR_LSM *clsm, u_int a, u_int b, int smallest, int *beforep)
 {
-	WT_CURSOR *c, *current;
-	int cmp, multiple;
-	u_int i;
+	int cmp;
 
-	current = NULL;
-	multiple = 0;
+	WT_RET(WT_LSM_CURCMP(session, clsm->lsm_tree, clsm->cursors[a], clsm->cursors[b], cmp));
+	if (cmp == 0)
+		*beforep = a > b;
+	else
+		*beforep = smallest ? cmp < 0 : cmp > 0;
 
-	WT_FORALL_CURSORS(clsm, c, i){
-		if (!F_ISSET(c, WT_CURSTD_KEY_INT))
-			continue;
-		/*保存最新的cursor句柄*/
-		if (current == NULL) {
-			current = c;
-			continue;
+	return 0;
+}
+
+/*将堆中pos位置的cursor向下调整*/
+static int __clsm_heap_sift_down(WT_SESSION_IMPL *session, WT_CURSOR_LSM *clsm, u_int pos, int smallest)
+{
+	u_int child, tmp;
+	int before;
+
+	while ((child = 2 * pos + 1) < clsm->heap_entries) {
+		if (child + 1 < clsm->heap_entries) {
+			WT_RET(__clsm_heap_before(session, clsm, clsm->heap[child + 1], clsm->heap[child], smallest, &before));
+			if (before)
+				++child;
 		}
 
-		/*获得最小或者最大的cursor对象*/
+		WT_RET(__clsm_heap_before(session, clsm, clsm->heap[child], clsm->heap[pos], smallest, &before));
+		if (!before)
+			break;
+
+		tmp = clsm->heap[pos];
+		clsm->heap[pos] = clsm->heap[child];
+		clsm->heap[child] = tmp;
+		pos = child;
+	}
+
+	return 0;
+}
+
+/*将第i个chunk cursor加入到堆中*/
+static int __clsm_heap_push(WT_SESSION_IMPL *session, WT_CURSOR_LSM *clsm, u_int i, int smallest)
+{
+	u_int parent, pos;
+	int before;
+
+	pos = clsm->heap_entries++;
+	clsm->heap[pos] = i;
+
+	while (pos > 0) {
+		parent = (pos - 1) / 2;
+		WT_RET(__clsm_heap_before(session, clsm, clsm->heap[pos], clsm->heap[parent], smallest, &before));
+		if (!before)
+			break;
+
+		clsm->heap[pos] = clsm->heap[parent];
+		clsm->heap[parent] = i;
+		pos = parent;
+	}
+
+	return 0;
+}
+
+/*移除堆顶的cursor*/
+static int __clsm_heap_pop(WT_SESSION_IMPL *session, WT_CURSOR_LSM *clsm, int smallest)
+{
+	WT_ASSERT(session, clsm->heap_entries > 0);
+
+	clsm->heap[0] = clsm->heap[--clsm->heap_entries];
+	return (__clsm_heap_sift_down(session, clsm, 0, smallest));
+}
+
+/*用所有已经定位的chunk cursor构建迭代堆, smallest = 1表示next方向*/
+static int __clsm_heap_build(WT_SESSION_IMPL *session, WT_CURSOR_LSM *clsm, int smallest)
+{
+	WT_CURSOR *c;
+	u_int i;
+
+	WT_RET(__wt_realloc_def(session, &clsm->heap_alloc, clsm->nchunks, &clsm->heap));
+
+	clsm->heap_entries = 0;
+	WT_FORALL_CURSORS(clsm, c, i) {
+		if (F_ISSET(c, WT_CURSTD_KEY_INT))
+			clsm->heap[clsm->heap_entries++] = i;
+	}
+
+	for (i = clsm->heap_entries / 2; i > 0; i--)
+		WT_RET(__clsm_heap_sift_down(session, clsm, i - 1, smallest));
+
+	return 0;
+}
+
+/*
+ * 将堆顶的cursor以及和它key相同的cursor都向前(next)或者向后(prev)移动一个位置，
+ * 相同key的cursor要在堆顶cursor之前移动，因为比较时需要用到堆顶cursor的key
+ */
+static int __clsm_heap_advance(WT_SESSION_IMPL *session, WT_CURSOR_LSM *clsm, int smallest)
+{
+	WT_CURSOR *c, *current;
+	WT_DECL_RET;
+	u_int i, top;
+	int cmp;
+
+	if (clsm->heap_entries == 0)
+		return 0;
+
+	top = clsm->heap[0];
+	current = clsm->cursors[top];
+	WT_RET(__clsm_heap_pop(session, clsm, smallest));
+
+	while (clsm->heap_entries > 0) {
+		i = clsm->heap[0];
+		c = clsm->cursors[i];
 		WT_RET(WT_LSM_CURCMP(session, clsm->lsm_tree, c, current, cmp));
-		if (smallest ? cmp < 0 : cmp > 0) {
-			current = c;
-			multiple = 0;
-		} 
-		else if (cmp == 0)
-			multiple = 1;
+		if (cmp != 0)
+			break;
+
+		WT_RET(__clsm_heap_pop(session, clsm, smallest));
+		if ((ret = (smallest ? c->next(c) : c->prev(c))) == 0)
+			WT_RET(__clsm_heap_push(session, clsm, i, smallest));
+		WT_RET_NOTFOUND_OK(ret);
 	}
 
+	if ((ret = (smallest ? current->next(current) : current->prev(current))) == 0)
+		WT_RET(__clsm_heap_push(session, clsm, top, smallest));
+	WT_RET_NOTFOUND_OK(ret);
+
+	return 0;
+}
+
+/*
+ * 以迭代堆的堆顶作为lsm tree cursor当前的cursor,
+ * 并将lsm tree中当前的cursor中的值拷贝到定位到的cursor中
+ */
+static int __clsm_get_current(WT_SESSION_IMPL *session, WT_CURSOR_LSM *clsm, int smallest, int *deletedp)
+{
+	WT_CURSOR *c, *current;
+
+	WT_UNUSED(session);
+	WT_UNUSED(smallest);
+
+	current = clsm->heap_entries == 0 ? NULL : clsm->cursors[clsm->heap[0]];
+
 	c = &clsm->iface;
 	if ((clsm->current = current) == NULL) {
 		F_CLR(c, WT_CURSTD_KEY_SET | WT_CURSTD_VALUE_SET);
 		return (WT_NOTFOUND);
 	}
 
-	if (multiple)
-		F_SET(clsm, WT_CLSM_MULTIPLE);
-	else
-		F_CLR(clsm, WT_CLSM_MULTIPLE);
-
 	WT_RET(current->get_key(current, &c->key));
 	WT_RET(current->get_value(current, &c->value));
 
@@ -608,7 +719,7 @@ static int __clsm_next(WT_CURSOR* cursor)
 	WT_DECL_RET;
 	WT_SESSION_IMPL *session;
 	u_int i;
-	int check, cmp, deleted;
+	int cmp, deleted;
 
 	clsm = (WT_CURSOR_LSM *)cursor;
 
@@ -617,8 +728,6 @@ static int __clsm_next(WT_CURSOR* cursor)
 	WT_ERR(__clsm_enter(clsm, 0, 0));
 
 	if(clsm->current == NULL || !F_ISSET(clsm, WT_CLSM_ITERATE_NEXT)){
-		F_CLR(clsm, WT_CLSM_MULTIPLE);
-
 		WT_FORALL_CURSORS(clsm, c, i) {
 			if (!F_ISSET(cursor, WT_CURSTD_KEY_SET)) {
 				WT_ERR(c->reset(c));
@@ -629,12 +738,8 @@ static int __clsm_next(WT_CURSOR* cursor)
 				if ((ret = c->search_near(c, &cmp)) == 0) {
 					if (cmp < 0)
 						ret = c->next(c);
-					else if (cmp == 0) {
-						if (clsm->current == NULL)
-							clsm->current = c;
-						else
-							F_SET(clsm, WT_CLSM_MULTIPLE);
-					}
+					else if (cmp == 0 && clsm->current == NULL)
+						clsm->current = c;
 				} 
 				else
 					F_CLR(c, WT_CURSTD_KEY_SET);
@@ -643,34 +748,17 @@ static int __clsm_next(WT_CURSOR* cursor)
 		}
 		F_SET(clsm, WT_CLSM_ITERATE_NEXT);
 		F_CLR(clsm, WT_CLSM_ITERATE_PREV);
+		WT_ERR(__clsm_heap_build(session, clsm, 1));
 		if(clsm->current != NULL)
 			goto retry;
 	}
 	else{
 retry:
 		/*
-		 * If there are multiple cursors on that key, move them
-		 * forward.
+		 * Move the smallest cursor forward, along with any other
+		 * cursors on the same key.
 		 */
-		if (F_ISSET(clsm, WT_CLSM_MULTIPLE)) {
-			check = 0;
-			WT_FORALL_CURSORS(clsm, c, i) {
-				if (!F_ISSET(c, WT_CURSTD_KEY_INT))
-					continue;
-
-				if (check) {
-					WT_ERR(WT_LSM_CURCMP(session, clsm->lsm_tree, c, clsm->current, cmp));
-					if (cmp == 0)
-						WT_ERR_NOTFOUND_OK(c->next(c));
-				}
-				if (c == clsm->current)
-					check = 1;
-			}
-		}
-
-		/* Move the smallest cursor forward. */
-		c = clsm->current;
-		WT_ERR_NOTFOUND_OK(c->next(c));
+		WT_ERR(__clsm_heap_advance(session, clsm, 1));
 	}
 
 	/* Find the cursor(s) with the smallest key. 如果KV对被标记为删除，那么要继续向下找*/
@@ -694,7 +782,7 @@ static int __clsm_prev(WT_CURSOR *cursor)
 	WT_DECL_RET;
 	WT_SESSION_IMPL *session;
 	u_int i;
-	int check, cmp, deleted;
+	int cmp, deleted;
 
 	clsm = (WT_CURSOR_LSM *)cursor;
 
@@ -704,7 +792,6 @@ static int __clsm_prev(WT_CURSOR *cursor)
 
 	/* If we aren't positioned for a reverse scan, get started. */
 	if (clsm->current == NULL || !F_ISSET(clsm, WT_CLSM_ITERATE_PREV)) {
-		F_CLR(clsm, WT_CLSM_MULTIPLE);
 		WT_FORALL_CURSORS(clsm, c, i) {
 			if (!F_ISSET(cursor, WT_CURSTD_KEY_SET)) {
 				WT_ERR(c->reset(c));
@@ -715,18 +802,15 @@ static int __clsm_prev(WT_CURSOR *cursor)
 				if ((ret = c->search_near(c, &cmp)) == 0) {
 					if (cmp > 0)
 						ret = c->prev(c);
-					else if (cmp == 0) {
-						if (clsm->current == NULL)
-							clsm->current = c;
-						else
-							F_SET(clsm, WT_CLSM_MULTIPLE);
-					}
+					else if (cmp == 0 && clsm->current == NULL)
+						clsm->current = c;
 				}
 			}
 			WT_ERR_NOTFOUND_OK(ret);
 		}
 		F_SET(clsm, WT_CLSM_ITERATE_PREV);
 		F_CLR(clsm, WT_CLSM_ITERATE_NEXT);
+		WT_ERR(__clsm_heap_build(session, clsm, 0));
 
 		/* We just positioned *at* the key, now move. */
 		if (clsm->current != NULL)
@@ -734,27 +818,10 @@ static int __clsm_prev(WT_CURSOR *cursor)
 	} 
 	else {
 retry:	/*
-		 * If there are multiple cursors on that key, move them
-		 * backwards.
+		 * Move the largest cursor backwards, along with any other
+		 * cursors on the same key.
 		 */
-		if (F_ISSET(clsm, WT_CLSM_MULTIPLE)) {
-			check = 0;
-			WT_FORALL_CURSORS(clsm, c, i) {
-				if (!F_ISSET(c, WT_CURSTD_KEY_INT))
-					continue;
-				if (check) {
-					WT_ERR(WT_LSM_CURCMP(session, clsm->lsm_tree, c, clsm->current, cmp));
-					if (cmp == 0)
-						WT_ERR_NOTFOUND_OK(c->prev(c));
-				}
-				if (c == clsm->current)
-					check = 1;
-			}
-		}
-
-		/* Move the smallest cursor backwards. */
-		c = clsm->current;
-		WT_ERR_NOTFOUND_OK(c->prev(c));
+		WT_ERR(__clsm_heap_advance(session, clsm, 0));
 	}
 
 	/* Find the cursor(s) with the largest key. */
@@ -833,6 +900,9 @@ static int __clsm_lookup(WT_CURSOR_LSM *clsm, WT_ITEM *value)
 	have_hash = 0;
 	session = (WT_SESSION_IMPL *)cursor->session;
 
+	/*查找会移动chunk cursor的位置，迭代堆失效*/
+	F_CLR(clsm, WT_CLSM_ITERATE_NEXT | WT_CLSM_ITERATE_PREV);
+
 	WT_FORALL_CURSORS(clsm, c, i){
 		/*先对bloom filter做存在性检查*/
 		bloom = NULL;
@@ -909,6 +979,43 @@ err:
 	return ret;
 }
 
+/*search_batch中对一个key的查找*/
+static int __clsm_batch_lookup(WT_CURSOR* cursor, WT_ITEM* value)
+{
+	WT_CURSOR_LSM *clsm;
+
+	clsm = (WT_CURSOR_LSM *)cursor;
+
+	WT_RET(__clsm_lookup(clsm, &cursor->value));
+	__clsm_deleted_decode(clsm, &cursor->value);
+
+	*value = cursor->value;
+	return 0;
+}
+
+/*
+ * 批量查找多个key，所有key共用一次__clsm_enter打开的chunk cursor，key按lsm tree的collator
+ * 排序后查找，相邻的key在每个chunk上访问的page也是相邻的
+ */
+static int __clsm_search_batch(WT_CURSOR* cursor, size_t count, const WT_ITEM* keys, WT_ITEM* values, int* results)
+{
+	WT_CURSOR_LSM *clsm;
+	WT_DECL_RET;
+	WT_SESSION_IMPL *session;
+
+	clsm = (WT_CURSOR_LSM *)cursor;
+
+	CURSOR_API_CALL(cursor, session, search_batch, NULL);
+	WT_CURSOR_NOVALUE(cursor);
+	WT_ERR(__clsm_enter(clsm, 1, 0));
+
+	ret = __wt_cursor_batch_search(cursor, clsm->lsm_tree->collator, count, keys, values, results, __clsm_batch_lookup);
+	WT_TRET(cursor->reset(cursor));
+
+err:
+	API_END_RET(session, ret);
+}
+
 /*lsm tree cursor的search near定位，根据key定位到它所在的位置*/
 static int __clsm_search_near(WT_CURSOR* cursor, int *exactp)
 {
@@ -1161,6 +1268,7 @@ static int __clsm_close(WT_CURSOR* cursor)
 	WT_TRET(__clsm_close_cursors(clsm, 0, clsm->nchunks));
 	__wt_free(session, clsm->blooms);
 	__wt_free(session, clsm->cursors);
+	__wt_free(session, clsm->heap);
 	__wt_free(session, clsm->switch_txn);
 
 	/*结束cursor操作*/
@@ -1197,6 +1305,7 @@ int __wt_clsm_open(WT_SESSION_IMPL *session,
 	    __clsm_reset,		/* reset */
 	    __clsm_search,		/* search */
 	    __clsm_search_near,		/* search-near */
+	    __clsm_search_batch,	/* search-batch */
 	    __clsm_insert,		/* insert */
 	    __clsm_update,		/* update */
 	    __clsm_remove,		/* remove */
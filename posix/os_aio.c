@@ -0,0 +1,434 @@
+/***************************************************************************
+ * 基于Linux io_uring的异步I/O, 没有io_uring时退化成同步的pread/pwrite
+ ***************************************************************************/
+
+#include "wt_internal.h"
+
+#ifdef HAVE_LINUX_IO_URING_H
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup		425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter		426
+#endif
+
+static inline int __aio_setup(uint32_t entries, struct io_uring_params* p)
+{
+	return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static inline int __aio_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags)
+{
+	return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+/*完成线程等待完成事件的超时时间，超时后检查running，保证关闭时不依赖提交NOP来唤醒*/
+#define WT_AIO_WAIT_USECS		100000
+
+/*等待至少一个完成事件，最多等待usecs微秒，超时返回-1并设置errno为ETIME*/
+static inline int __aio_enter_wait(int fd, uint64_t usecs)
+{
+	struct __kernel_timespec ts;
+	struct io_uring_getevents_arg arg;
+
+	ts.tv_sec = (int64_t)(usecs / WT_MILLION);
+	ts.tv_nsec = (long long)(usecs % WT_MILLION) * 1000;
+	memset(&arg, 0, sizeof(arg));
+	arg.ts = (uint64_t)(uintptr_t)&ts;
+
+	return (int)syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+}
+
+/*在提交队列中放入一个sqe并提交给内核，调用者必须持有aio->lock*/
+static int __aio_sqe_push(WT_AIO* aio, uint8_t opcode, WT_AIO_REQ* req)
+{
+	struct io_uring_sqe *sqe;
+	WT_DECL_RET;
+	uint32_t idx, tail;
+
+	tail = *aio->sq_tail;
+	idx = tail & aio->sq_mask;
+	sqe = (struct io_uring_sqe *)aio->sqes + idx;
+
+	memset(sqe, 0, sizeof(*sqe));
+	sqe->opcode = opcode;
+	if (req != NULL){
+		sqe->fd = req->fh->fd;
+		sqe->off = (uint64_t)req->offset;
+		sqe->addr = (uint64_t)(uintptr_t)&req->iov;
+		sqe->len = 1;
+	}
+	else
+		sqe->fd = -1;
+	sqe->user_data = (uint64_t)(uintptr_t)req;
+
+	aio->sq_array[idx] = idx;
+	WT_WRITE_BARRIER();
+	*aio->sq_tail = tail + 1;
+	WT_WRITE_BARRIER();
+
+	while (__aio_enter(aio->ring_fd, 1, 0, 0) < 0){
+		if (errno == EINTR)
+			continue;
+		ret = __wt_errno();
+
+		/*内核已经取走了sqe时请求归io_uring所有，完成队列会返回结果；否则撤回sqe，由调用者改做同步I/O*/
+		WT_READ_BARRIER();
+		if (*aio->sq_head != tail)
+			return 0;
+		*aio->sq_tail = tail;
+		WT_WRITE_BARRIER();
+		return ret;
+	}
+
+	return 0;
+}
+
+/*消费完成队列，返回消费的cqe个数。调用者必须持有aio->cq_lock*/
+static uint32_t __aio_reap(WT_AIO* aio)
+{
+	struct io_uring_cqe *cqe;
+	WT_AIO_REQ *req;
+	uint32_t head, n, tail;
+
+	head = *aio->cq_head;
+	tail = *aio->cq_tail;
+	WT_READ_BARRIER();
+
+	for (n = 0; head != tail; ++head, ++n){
+		cqe = (struct io_uring_cqe *)aio->cqes + (head & aio->cq_mask);
+		if ((req = (WT_AIO_REQ *)(uintptr_t)cqe->user_data) == NULL)
+			continue;
+
+		req->res = cqe->res;
+		(void)WT_ATOMIC_SUB4(aio->inflight, 1);
+		/*done设置以后请求可能被等待者立即释放，之后不能再访问req*/
+		WT_PUBLISH(req->done, 1);
+	}
+
+	WT_FULL_BARRIER();
+	*aio->cq_head = head;
+	return n;
+}
+
+/*完成线程，阻塞在io_uring_enter上等待I/O完成并唤醒等待者*/
+static WT_THREAD_RET __aio_server(void* arg)
+{
+	WT_AIO *aio;
+	WT_DECL_RET;
+	WT_SESSION_IMPL *session;
+	uint32_t n;
+
+	session = arg;
+	aio = S2C(session)->aio;
+
+	for (;;){
+		if (__aio_enter_wait(aio->ring_fd, WT_AIO_WAIT_USECS) < 0 && errno != EINTR && errno != ETIME)
+			WT_ERR(__wt_errno());
+
+		__wt_spin_lock(session, &aio->cq_lock);
+		n = __aio_reap(aio);
+		__wt_spin_unlock(session, &aio->cq_lock);
+		if (n > 0)
+			WT_ERR(__wt_cond_signal(session, aio->cond));
+
+		if (!aio->running && aio->inflight == 0)
+			break;
+	}
+
+	if (0){
+err:
+		/*完成线程退出后不再提交新的请求，已经提交的请求由等待者自己消费完成队列*/
+		aio->broken = 1;
+		__wt_err(session, ret, "io_uring completion server error");
+	}
+
+	return WT_THREAD_RET_VALUE;
+}
+
+/*根据io_uring配置创建io_uring实例和完成线程，内核不支持时退化成同步I/O*/
+int __wt_aio_create(WT_SESSION_IMPL* session, const char* cfg[])
+{
+	struct io_uring_params p;
+	WT_AIO *aio;
+	WT_CONFIG_ITEM cval;
+	WT_CONNECTION_IMPL *conn;
+	WT_DECL_RET;
+	uint8_t *cq, *sq;
+	int fd;
+
+	conn = S2C(session);
+
+	WT_RET(__wt_config_gets(session, cfg, "io_uring.enabled", &cval));
+	if (cval.val == 0)
+		return 0;
+	WT_RET(__wt_config_gets(session, cfg, "io_uring.queue_depth", &cval));
+
+	memset(&p, 0, sizeof(p));
+	if ((fd = __aio_setup((uint32_t)cval.val, &p)) < 0){
+		ret = __wt_errno();
+		return __wt_verbose(session, WT_VERB_FILEOPS, "io_uring_setup failed with error %d, using synchronous I/O", ret);
+	}
+	/*完成线程需要带超时的等待，内核不支持IORING_ENTER_EXT_ARG时不使用io_uring*/
+	if (!(p.features & IORING_FEAT_EXT_ARG)){
+		(void)close(fd);
+		return __wt_verbose(session, WT_VERB_FILEOPS, "io_uring does not support timed waits, using synchronous I/O");
+	}
+
+	if ((ret = __wt_calloc_one(session, &aio)) != 0){
+		(void)close(fd);
+		return ret;
+	}
+	aio->ring_fd = fd;
+	aio->entries = p.sq_entries;
+	conn->aio = aio;
+
+	aio->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+	aio->cq_ring_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+	aio->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+
+	if ((aio->sq_ring = mmap(NULL, aio->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING)) == MAP_FAILED){
+		aio->sq_ring = NULL;
+		WT_ERR_MSG(session, __wt_errno(), "io_uring submission queue mmap");
+	}
+	if ((aio->cq_ring = mmap(NULL, aio->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING)) == MAP_FAILED){
+		aio->cq_ring = NULL;
+		WT_ERR_MSG(session, __wt_errno(), "io_uring completion queue mmap");
+	}
+	if ((aio->sqes = mmap(NULL, aio->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES)) == MAP_FAILED){
+		aio->sqes = NULL;
+		WT_ERR_MSG(session, __wt_errno(), "io_uring sqe array mmap");
+	}
+
+	sq = aio->sq_ring;
+	aio->sq_head = (uint32_t *)(sq + p.sq_off.head);
+	aio->sq_tail = (uint32_t *)(sq + p.sq_off.tail);
+	aio->sq_array = (uint32_t *)(sq + p.sq_off.array);
+	aio->sq_mask = *(uint32_t *)(sq + p.sq_off.ring_mask);
+
+	cq = aio->cq_ring;
+	aio->cq_head = (uint32_t *)(cq + p.cq_off.head);
+	aio->cq_tail = (uint32_t *)(cq + p.cq_off.tail);
+	aio->cq_mask = *(uint32_t *)(cq + p.cq_off.ring_mask);
+	aio->cqes = cq + p.cq_off.cqes;
+
+	WT_ERR(__wt_spin_init(session, &aio->lock, "io_uring"));
+	WT_ERR(__wt_spin_init(session, &aio->cq_lock, "io_uring completion"));
+	WT_ERR(__wt_cond_alloc(session, "io_uring completion", 0, &aio->cond));
+
+	aio->running = 1;
+	WT_ERR(__wt_open_internal_session(conn, "io_uring", 0, 0, &aio->session));
+	WT_ERR(__wt_thread_create(session, &aio->tid, __aio_server, aio->session));
+	aio->tid_set = 1;
+
+	return 0;
+
+err:
+	WT_TRET(__wt_aio_destroy(session));
+	return ret;
+}
+
+/*停止完成线程并释放io_uring实例，这时所有的文件已经关闭，没有在途的I/O*/
+int __wt_aio_destroy(WT_SESSION_IMPL* session)
+{
+	WT_AIO *aio;
+	WT_CONNECTION_IMPL *conn;
+	WT_DECL_RET;
+	WT_SESSION *wt_session;
+
+	conn = S2C(session);
+	if ((aio = conn->aio) == NULL)
+		return 0;
+
+	/*
+	 * 完成线程最多等待WT_AIO_WAIT_USECS就会检查running，所以不管NOP是否提交成功都可以join，
+	 * NOP只是让完成线程尽快退出。必须在join之后才能解除映射和关闭ring_fd
+	 */
+	if (aio->tid_set){
+		WT_PUBLISH(aio->running, 0);
+		__wt_spin_lock(session, &aio->lock);
+		(void)__aio_sqe_push(aio, IORING_OP_NOP, NULL);
+		__wt_spin_unlock(session, &aio->lock);
+		WT_TRET(__wt_thread_join(session, aio->tid));
+		aio->tid_set = 0;
+	}
+	if (aio->session != NULL){
+		wt_session = &aio->session->iface;
+		WT_TRET(wt_session->close(wt_session, NULL));
+		aio->session = NULL;
+	}
+
+	if (aio->sqes != NULL)
+		(void)munmap(aio->sqes, aio->sqes_size);
+	if (aio->cq_ring != NULL)
+		(void)munmap(aio->cq_ring, aio->cq_ring_size);
+	if (aio->sq_ring != NULL)
+		(void)munmap(aio->sq_ring, aio->sq_ring_size);
+	(void)close(aio->ring_fd);
+
+	WT_TRET(__wt_cond_destroy(session, &aio->cond));
+	__wt_spin_destroy(session, &aio->lock);
+	__wt_spin_destroy(session, &aio->cq_lock);
+	__wt_free(session, conn->aio);
+
+	return ret;
+}
+#else
+int __wt_aio_create(WT_SESSION_IMPL* session, const char* cfg[])
+{
+	WT_CONFIG_ITEM cval;
+
+	WT_RET(__wt_config_gets(session, cfg, "io_uring.enabled", &cval));
+	if (cval.val != 0)
+		WT_RET(__wt_verbose(session, WT_VERB_FILEOPS, "io_uring is not supported, using synchronous I/O"));
+
+	return 0;
+}
+
+int __wt_aio_destroy(WT_SESSION_IMPL* session)
+{
+	WT_UNUSED(session);
+	return 0;
+}
+#endif
+
+#ifdef HAVE_LINUX_IO_URING_H
+/*
+ * io_uring出错以后由等待者自己消费完成队列，直到req被内核完成。req的内存在内核完成之前
+ * 一直被io_uring使用，所以这里不能提前返回。持有cq_lock时完成队列为空说明req还在途，
+ * 阻塞等待一定会有cqe返回；io_uring_enter也失败时只能轮询共享内存中的完成队列
+ */
+static void __aio_reap_wait(WT_SESSION_IMPL* session, WT_AIO* aio, WT_AIO_REQ* req)
+{
+	int wait_ret;
+
+	while (!req->done){
+		wait_ret = 0;
+		__wt_spin_lock(session, &aio->cq_lock);
+		if (__aio_reap(aio) == 0 && !req->done)
+			while ((wait_ret = __aio_enter(aio->ring_fd, 0, 1, IORING_ENTER_GETEVENTS)) < 0 && errno == EINTR)
+				;
+		if (wait_ret >= 0)
+			(void)__aio_reap(aio);
+		__wt_spin_unlock(session, &aio->cq_lock);
+
+		if (wait_ret < 0)
+			__wt_yield();
+	}
+}
+#endif
+
+/*同步执行一个I/O请求*/
+static int __aio_sync(WT_SESSION_IMPL* session, WT_AIO_REQ* req)
+{
+	WT_DECL_RET;
+
+	if (req->write)
+		ret = __wt_write(session, req->fh, req->offset, req->len, req->buf);
+	else
+		ret = __wt_read(session, req->fh, req->offset, req->len, req->buf);
+
+	req->res = ret == 0 ? (int64_t)req->len : -ret;
+	req->done = 1;
+	return ret;
+}
+
+/*
+ * 提交一个异步读写请求，req在__wt_aio_wait返回之前不能释放。没有io_uring、队列已满
+ * 或者请求超过1GB时直接做同步I/O，这时__wt_aio_wait会立即返回
+ */
+int __wt_aio_submit(WT_SESSION_IMPL* session, WT_AIO_REQ* req, WT_FH* fh, int write, wt_off_t offset, size_t len, void* buf)
+{
+	WT_AIO *aio;
+	WT_DECL_RET;
+
+	req->fh = fh;
+	req->write = write;
+	req->offset = offset;
+	req->len = len;
+	req->buf = buf;
+	req->res = 0;
+	req->done = 0;
+
+	if ((aio = S2C(session)->aio) == NULL)
+		return __aio_sync(session, req);
+
+#ifdef HAVE_LINUX_IO_URING_H
+	if (!aio->broken && len <= WT_GIGABYTE){
+		WT_RET(__wt_verbose(session, WT_VERB_FILEOPS, "%s: io_uring %s %" WT_SIZET_FMT " bytes at offset %" PRIuMAX,
+			fh->name, write ? "write" : "read", len, (uintmax_t)offset));
+
+		req->iov.iov_base = buf;
+		req->iov.iov_len = len;
+
+		__wt_spin_lock(session, &aio->lock);
+		/*在途请求数不超过提交队列的长度，完成队列(2倍长度)不会溢出*/
+		if (aio->inflight < aio->entries){
+			(void)WT_ATOMIC_ADD4(aio->inflight, 1);
+			if ((ret = __aio_sqe_push(aio, write ? IORING_OP_WRITEV : IORING_OP_READV, req)) != 0){
+				(void)WT_ATOMIC_SUB4(aio->inflight, 1);
+				aio->broken = 1;
+			}
+			__wt_spin_unlock(session, &aio->lock);
+
+			/*sqe已经撤回，这个请求改做同步I/O*/
+			if (ret != 0){
+				__wt_err(session, ret, "%s: io_uring_enter, using synchronous I/O", fh->name);
+				WT_STAT_FAST_CONN_INCR(session, aio_sync);
+				return __aio_sync(session, req);
+			}
+			if (write)
+				WT_STAT_FAST_CONN_INCR(session, write_io);
+			else
+				WT_STAT_FAST_CONN_INCR(session, read_io);
+			WT_STAT_FAST_CONN_INCR(session, aio_submit);
+			return 0;
+		}
+		__wt_spin_unlock(session, &aio->lock);
+	}
+#endif
+
+	WT_STAT_FAST_CONN_INCR(session, aio_sync);
+	return __aio_sync(session, req);
+}
+
+/*等待一个请求完成，读写不完整的部分用同步I/O补齐*/
+int __wt_aio_wait(WT_SESSION_IMPL* session, WT_AIO_REQ* req)
+{
+	WT_AIO *aio;
+	size_t done_len;
+	int yield_count;
+
+	aio = S2C(session)->aio;
+
+	for (yield_count = 0; !req->done; ++yield_count){
+#ifdef HAVE_LINUX_IO_URING_H
+		if (aio->broken){
+			WT_STAT_FAST_CONN_INCR(session, aio_reap_wait);
+			__aio_reap_wait(session, aio, req);
+			break;
+		}
+#endif
+		if (yield_count < 100)
+			__wt_yield();
+		else
+			WT_RET(__wt_cond_wait(session, aio->cond, 1000));
+	}
+	WT_READ_BARRIER();
+
+	if (req->res < 0)
+		WT_RET_MSG(session, (int)-req->res, "%s %s error: failed to %s %" WT_SIZET_FMT " bytes at offset %" PRIuMAX,
+			req->fh->name, req->write ? "write" : "read", req->write ? "write" : "read", req->len, (uintmax_t)req->offset);
+
+	done_len = (size_t)req->res;
+	if (done_len < req->len){
+		if (req->write)
+			return __wt_write(session, req->fh, req->offset + (wt_off_t)done_len, req->len - done_len, (uint8_t *)req->buf + done_len);
+		return __wt_read(session, req->fh, req->offset + (wt_off_t)done_len, req->len - done_len, (uint8_t *)req->buf + done_len);
+	}
+
+	return 0;
+}
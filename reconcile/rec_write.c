@@ -5,6 +5,8 @@ struct __rec_boundary;		typedef struct __rec_boundary WT_BOUNDARY;
 struct __rec_dictionary;	typedef struct __rec_dictionary WT_DICTIONARY;
 struct __rec_kv;			typedef struct __rec_kv WT_KV;
 
+#define WT_REC_COMPRESS_MAX		8		/*一次reconcile最多同时提交给压缩线程的split block数*/
+
 struct __rec_boundary {
 	/*
 	* Offset is the byte offset in the initial split buffer of the
@@ -238,6 +240,19 @@ typedef struct
 	WT_SALVAGE_COOKIE*		salvage;
 
 	int						tested_ref_state;		/* Debugging information */
+
+	/*
+	* 配置了压缩线程时，split block的压缩提交给压缩线程异步完成，reconcile继续
+	* 构建后面的block。block的写入(分配磁盘空间)仍然按照boundary的顺序进行，
+	* comp_first是最早提交的还没有写入的任务
+	*/
+	int						comp_enabled;
+	struct {
+		WT_COMPRESS_JOB		job;
+		uint32_t			bnd_slot;				/* 任务对应的boundary */
+	}						comp[WT_REC_COMPRESS_MAX];
+	uint32_t				comp_first;
+	uint32_t				comp_count;
 }WT_RECONCILE; 
 
 static void __rec_bnd_cleanup(WT_SESSION_IMPL *, WT_RECONCILE *, int);
@@ -253,6 +268,8 @@ static int  __rec_col_int(WT_SESSION_IMPL *, WT_RECONCILE *, WT_PAGE *);
 static int  __rec_col_merge(WT_SESSION_IMPL *, WT_RECONCILE *, WT_PAGE *);
 static int  __rec_col_var(WT_SESSION_IMPL *, WT_RECONCILE *, WT_PAGE *, WT_SALVAGE_COOKIE *);
 static int  __rec_col_var_helper(WT_SESSION_IMPL *, WT_RECONCILE *, WT_SALVAGE_COOKIE *, WT_ITEM *, int, uint8_t, uint64_t);
+static int  __rec_compress_discard(WT_SESSION_IMPL *, WT_RECONCILE *);
+static int  __rec_compress_flush(WT_SESSION_IMPL *, WT_RECONCILE *, int);
 static int  __rec_destroy_session(WT_SESSION_IMPL *);
 static int  __rec_root_write(WT_SESSION_IMPL *, WT_PAGE *, uint32_t);
 static int  __rec_row_int(WT_SESSION_IMPL *, WT_RECONCILE *, WT_PAGE *);
@@ -345,8 +362,11 @@ int __wt_reconcile(WT_SESSION_IMPL* session, WT_REF* ref, WT_SALVAGE_COOKIE* sal
 	/*wrap up the page reconciliation*/
 	if (ret == 0)
 		ret = __rec_write_wrapup(session, r, page);
-	else
+	else{
+		/*还没有写入的split block不会再写了，等待压缩线程放弃对它们的引用*/
+		WT_TRET(__rec_compress_discard(session, r));
 		WT_TRET(__rec_write_wrapup_err(session, r, page));
+	}
 
 	if (locked)
 		WT_PAGE_UNLOCK(session, page);
@@ -492,6 +512,9 @@ static int __rec_write_init(WT_SESSION_IMPL* session, WT_REF* ref, uint32_t flag
 		F_SET(&r->dsk, WT_ITEM_ALIGNED);
 	}
 
+	/*上一次reconcile出错(例如bulk load)时可能还有没写入的压缩任务*/
+	WT_RET(__rec_compress_discard(session, r));
+
 	r->ref = ref;
 	r->page = page;
 	r->flags = flags;
@@ -503,6 +526,10 @@ static int __rec_write_init(WT_SESSION_IMPL* session, WT_REF* ref, uint32_t flag
 	r->raw_compression = __rec_raw_compression_config(session, page, salvage);
 	r->raw_destination.flags = WT_ITEM_ALIGNED; /*压缩后的buffer必须是磁盘写入对其的长度,因为压缩后的数据要落盘*/
 
+	/*raw compression自己决定block的内容，不走异步压缩*/
+	r->comp_enabled = S2C(session)->compress_workers > 0 && btree->compressor != NULL && 
+		btree->compressor->compress != NULL && !r->raw_compression;
+
 	/* Track overflow items. */
 	r->ovfl_items = 0;
 
@@ -557,11 +584,18 @@ static int __rec_write_init(WT_SESSION_IMPL* session, WT_REF* ref, uint32_t flag
 static void __rec_destroy(WT_SESSION_IMPL* session, void* reconcilep)
 {
 	WT_RECONCILE *r;
+	uint32_t i;
 
 	if ((r = *(WT_RECONCILE **)reconcilep) == NULL)
 		return;
 	*(WT_RECONCILE **)reconcilep = NULL; /*在未释放之前，将引用出的指针置为NULL*/
 
+	(void)__rec_compress_discard(session, r);
+	for (i = 0; i < WT_REC_COMPRESS_MAX; i++){
+		__wt_buf_free(session, &r->comp[i].job.src);
+		__wt_buf_free(session, &r->comp[i].job.dst);
+	}
+
 	__wt_buf_free(session, &r->dsk);
 
 	__wt_free(session, r->raw_entries);
@@ -1823,7 +1857,8 @@ static int __rec_split_finish(WT_SESSION_IMPL* session, WT_RECONCILE* r)
 	else /*直接将page写入盘里面*/
 		WT_RET(__rec_split_finish_std(session, r));
 
-	return 0;
+	/*等待所有异步压缩的block完成并写入*/
+	return __rec_compress_flush(session, r, 1);
 }
 
 /*将已经split的boundary数据写入block中*/
@@ -1878,6 +1913,83 @@ err:
 	return ret;
 }
 
+/*等待最早提交的压缩任务完成，并将它的block写入*/
+static int __rec_compress_write_first(WT_SESSION_IMPL* session, WT_RECONCILE* r)
+{
+	WT_BOUNDARY *bnd;
+	WT_COMPRESS_JOB *job;
+	WT_DECL_RET;
+	size_t addr_size;
+	uint8_t addr[WT_BTREE_MAX_ADDR_COOKIE];
+
+	/*任务出错也要出队，后面的任务由__rec_compress_discard处理*/
+	job = &r->comp[r->comp_first].job;
+	bnd = &r->bnd[r->comp[r->comp_first].bnd_slot];
+	r->comp_first = (r->comp_first + 1) % WT_REC_COMPRESS_MAX;
+	--r->comp_count;
+
+	if ((ret = __wt_bt_compress_write(session, job, addr, &addr_size)) != 0){
+		WT_TRET(__wt_bt_compress_discard(session, job));
+		return ret;
+	}
+	WT_RET(__wt_strndup(session, addr, addr_size, &bnd->addr.addr));
+	bnd->addr.size = (uint8_t)addr_size;
+
+	return 0;
+}
+
+/*按照提交的顺序写入已经压缩完成的block，wait为1时等待所有的压缩任务完成并写入*/
+static int __rec_compress_flush(WT_SESSION_IMPL* session, WT_RECONCILE* r, int wait)
+{
+	while (r->comp_count > 0){
+		if (!wait && r->comp[r->comp_first].job.state != WT_COMPRESS_JOB_DONE)
+			break;
+		WT_RET(__rec_compress_write_first(session, r));
+	}
+
+	return 0;
+}
+
+/*放弃所有还没有写入的压缩任务*/
+static int __rec_compress_discard(WT_SESSION_IMPL* session, WT_RECONCILE* r)
+{
+	WT_DECL_RET;
+
+	for (; r->comp_count > 0; --r->comp_count){
+		WT_TRET(__wt_bt_compress_discard(session, &r->comp[r->comp_first].job));
+		r->comp_first = (r->comp_first + 1) % WT_REC_COMPRESS_MAX;
+	}
+	r->comp_first = 0;
+
+	return ret;
+}
+
+/*将boundary的block提交给压缩线程压缩，提交的任务满了时先写入最早提交的block*/
+static int __rec_compress_submit(WT_SESSION_IMPL* session, WT_RECONCILE* r, WT_BOUNDARY* bnd, WT_ITEM* buf, int* submittedp)
+{
+	uint32_t slot;
+
+	*submittedp = 0;
+
+	if (r->comp_count == WT_REC_COMPRESS_MAX){
+		WT_RET(__rec_compress_flush(session, r, 0));
+		/*没有完成的任务，只能等待最早的任务完成*/
+		if (r->comp_count == WT_REC_COMPRESS_MAX)
+			WT_RET(__rec_compress_write_first(session, r));
+	}
+
+	slot = (r->comp_first + r->comp_count) % WT_REC_COMPRESS_MAX;
+	WT_RET(__wt_bt_compress_submit(session, buf, &r->comp[slot].job, submittedp));
+	if (!*submittedp)
+		return 0;
+
+	r->comp[slot].bnd_slot = (uint32_t)(bnd - r->bnd);
+	++r->comp_count;
+
+	/*顺便写入已经压缩完成的block*/
+	return __rec_compress_flush(session, r, 0);
+}
+
 /*
 *	Write a disk block out for the split helper functions.
 */
@@ -1893,7 +2005,7 @@ static int __rec_split_write(WT_SESSION_IMPL* session, WT_RECONCILE* r, WT_BOUND
 	WT_UPD_SKIPPED *skip;
 	size_t addr_size;
 	uint32_t bnd_slot, i, j;
-	int cmp;
+	int cmp, submitted;
 	uint8_t addr[WT_BTREE_MAX_ADDR_COOKIE];
 
 	btree = S2BT(session);
@@ -2007,6 +2119,16 @@ skip_check_complete:
 			}
 		}
 	}
+	/*可以异步压缩的block交给压缩线程，写入推迟到压缩完成后*/
+	if (r->comp_enabled && !bnd->already_compressed){
+		WT_ERR(__rec_compress_submit(session, r, bnd, buf, &submitted));
+		if (submitted)
+			goto done;
+	}
+
+	/*同步写入的block必须排在已经提交的block之后*/
+	WT_ERR(__rec_compress_flush(session, r, 1));
+
 	/*将数据写入到block中,并获得block addr cookie*/
 	WT_ERR(__wt_bt_write(session,buf, addr, &addr_size, 0, bnd->already_compressed));
 	WT_ERR(__wt_strndup(session, addr, addr_size, &bnd->addr.addr));
@@ -276,10 +276,16 @@ static int __session_open_cursor(WT_SESSION* wt_session, const char* uri, WT_CUR
 			WT_ERR(__wt_bad_object_type(session, uri));
 	}
 
-	/*根据uri打开cursor*/
-	WT_ERR(__wt_open_cursor(session, uri, NULL, cfg, &cursor));
-	if (to_dup != NULL)
-		WT_ERR(__wt_cursor_dup_position(to_dup, cursor));
+	/*先在session的cursor cache中查找可以重用的cursor，没有找到再根据uri打开cursor*/
+	if (to_dup == NULL)
+		WT_ERR_NOTFOUND_OK(__wt_curfile_cache_get(session, uri, cfg, &cursor));
+	if (cursor == NULL){
+		WT_ERR(__wt_open_cursor(session, uri, NULL, cfg, &cursor));
+		if (to_dup != NULL)
+			WT_ERR(__wt_cursor_dup_position(to_dup, cursor));
+		else
+			WT_ERR(__wt_curfile_cache_prepare(session, cursor, config));
+	}
 
 	*cursorp = cursor;
 
@@ -864,6 +870,7 @@ int __wt_open_session(WT_CONNECTION_IMPL* conn, WT_EVENT_HANDLER* event_handler,
 		__wt_random_init(session_ret->rnd);
 
 	TAILQ_INIT(&session_ret->cursors);
+	TAILQ_INIT(&session_ret->cursor_cache);
 	SLIST_INIT(&session_ret->dhandles);
 	/*
 	* If we don't have one, allocate the dhandle hash array.
@@ -4,14 +4,18 @@
 static int __session_dhandle_sweep(WT_SESSION_IMPL* session);
 
 
-/*为session增加一个dhandle cache*/
+/*为session增加一个dhandle cache，调用者已经增加了dhandle的session_ref，这个引用由dhandle cache持有*/
 static int __session_add_dhandle(WT_SESSION_IMPL* session, WT_DATA_HANDLE_CACHE **dhandle_cachep)
 {
 	WT_DATA_HANDLE_CACHE *dhandle_cache;
+	WT_DECL_RET;
 	uint64_t bucket;
 
 	/*分配一个dhandle cache*/
-	WT_RET(__wt_calloc_one(session, &dhandle_cache));
+	if ((ret = __wt_calloc_one(session, &dhandle_cache)) != 0){
+		(void)WT_ATOMIC_SUB4(session->dhandle->session_ref, 1);
+		return ret;
+	}
 	dhandle_cache->dhandle = session->dhandle;
 
 	/*将cache加入到session cache list当中*/
@@ -22,8 +26,6 @@ static int __session_add_dhandle(WT_SESSION_IMPL* session, WT_DATA_HANDLE_CACHE
 	if(dhandle_cachep != NULL)
 		*dhandle_cachep = dhandle_cache;
 
-	WT_ATOMIC_ADD4(session->dhandle->session_ref, 1);
-
 	/*删除掉已经关闭或者不用的dhandle*/
 	return __session_dhandle_sweep(session);
 }
@@ -194,6 +196,9 @@ static void __session_discard_btree(WT_SESSION_IMPL* session, WT_DATA_HANDLE_CAC
 {
 	uint64_t bucket;
 
+	/*cursor cache中的cursor依赖session对dhandle的引用，先释放它们*/
+	__wt_curfile_cache_discard(session, dhandle_cache->dhandle);
+
 	bucket = dhandle_cache->dhandle->name_hash % WT_HASH_ARRAY_SIZE;
 	SLIST_REMOVE(&session->dhandles, dhandle_cache, __wt_data_handle_cache, l);
 	SLIST_REMOVE(&session->dhhash[bucket],dhandle_cache, __wt_data_handle_cache, hashl);
@@ -246,10 +251,10 @@ WT_CONNECTION_IMPL *conn;
 	return 0;
 }
 
-/*根据dhandle name和checkpoint name找到对应的dhandle,并将dhandle加入到dhandle cache当中*/
-static int __session_dhandle_find(WT_SESSION_IMPL* session, const char* uri, const char* checkpoint, uint32_t flags)
+/*根据dhandle name和checkpoint name找到对应的dhandle,并将dhandle加入到dhandle cache当中，查找不需要持有dhandle_lock*/
+static int __session_dhandle_find(WT_SESSION_IMPL* session, const char* uri, const char* checkpoint)
 {
-	WT_RET(__wt_conn_dhandle_find(session, uri, checkpoint, flags));
+	WT_RET(__wt_conn_dhandle_lookup(session, uri, checkpoint));
 	return __session_add_dhandle(session, NULL);
 }
 
@@ -285,7 +290,7 @@ int __wt_session_get_btree(WT_SESSION_IMPL *session, const char *uri, const char
 		 * We didn't find a match in the session cache, now search the
 		 * shared handle list and cache any handle we find.
 		 */
-		WT_WITH_DHANDLE_LOCK(session, ret = __session_dhandle_find(session, uri, checkpoint, flags));
+		ret = __session_dhandle_find(session, uri, checkpoint);
 		dhandle = (ret == 0) ? session->dhandle : NULL;
 		WT_RET_NOTFOUND_OK(ret);
 	}
@@ -323,8 +328,10 @@ int __wt_session_get_btree(WT_SESSION_IMPL *session, const char *uri, const char
 	WT_RET(ret);
 
 	/*__wt_conn_btree_get函数中会新建dhandle,如果是新建的，那么必须将dhandle加入到dhandle cache当中*/
-	if (!LF_ISSET(WT_DHANDLE_HAVE_REF))
+	if (!LF_ISSET(WT_DHANDLE_HAVE_REF)){
+		(void)WT_ATOMIC_ADD4(session->dhandle->session_ref, 1);
 		WT_RET(__session_add_dhandle(session, NULL));
+	}
 
 	WT_ASSERT(session, LF_ISSET(WT_DHANDLE_LOCK_ONLY) || F_ISSET(session->dhandle, WT_DHANDLE_OPEN));
 
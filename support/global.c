@@ -20,6 +20,37 @@ static int __system_is_little_endian()
 	return (EINVAL);
 }
 
+/*根据CPU支持的指令集选定默认比较器的实现方式*/
+void __wt_lex_compare_init(void)
+{
+#define	CPUID_EDX_HAS_SSE2	(1 << 26)
+
+#if (defined(__amd64) || defined(__x86_64))
+	unsigned int eax, ebx, ecx, edx;
+
+	__asm__ __volatile__ (
+			      "cpuid"
+			      : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx)
+			      : "a" (1));
+
+	if (edx & CPUID_EDX_HAS_SSE2)
+		__wt_process.lex_compare_method = WT_LEX_COMPARE_SSE2;
+	else
+		__wt_process.lex_compare_method = WT_LEX_COMPARE_WORD;
+#elif defined(_M_AMD64)
+	int cpuInfo[4];
+
+	__cpuid(cpuInfo, 1);
+
+	if (cpuInfo[3] & CPUID_EDX_HAS_SSE2)
+		__wt_process.lex_compare_method = WT_LEX_COMPARE_SSE2;
+	else
+		__wt_process.lex_compare_method = WT_LEX_COMPARE_WORD;
+#else
+	__wt_process.lex_compare_method = WT_LEX_COMPARE_WORD;
+#endif
+}
+
 /*限制只运行一次全局初始化函数调用,初始化wiredtiger库*/
 static void __wt_global_once(void)
 {
@@ -36,6 +67,7 @@ static void __wt_global_once(void)
 	}
 
 	__wt_cksum_init();
+	__wt_lex_compare_init();
 
 	TAILQ_INIT(&__wt_process.connqh);
 
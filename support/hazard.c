@@ -5,6 +5,32 @@
 
 #include "wt_internal.h"
 
+/*
+ * 在session的hazard位图中登记一个page，只有session自己修改位图，不需要原子操作。
+ * 位图中的位第一次置位时增加connection上的计数，这是原子操作，同时也是一个完整的内存屏障
+ */
+static inline void __hazard_filter_set(WT_SESSION_IMPL* session, WT_PAGE* page)
+{
+	uint32_t bit;
+
+	bit = WT_HAZARD_FILTER_BIT(page);
+	if (session->hazard_filter_cnt[bit]++ == 0){
+		session->hazard_filter[bit >> 6] |= WT_HAZARD_FILTER_MASK(bit);
+		(void)WT_ATOMIC_ADD4(S2C(session)->hazard_filter_cnt[bit], 1);
+	}
+}
+
+/*从session的hazard位图中去掉一个page*/
+static inline void __hazard_filter_clear(WT_SESSION_IMPL* session, WT_PAGE* page)
+{
+	uint32_t bit;
+
+	bit = WT_HAZARD_FILTER_BIT(page);
+	if (--session->hazard_filter_cnt[bit] == 0){
+		session->hazard_filter[bit >> 6] &= ~WT_HAZARD_FILTER_MASK(bit);
+		(void)WT_ATOMIC_SUB4(S2C(session)->hazard_filter_cnt[bit], 1);
+	}
+}
 
 /*将一个page作为hazard pointer设置到session hazard pointer list中*/
 int __wt_hazard_set(WT_SESSION_IMPL* session, WT_REF* ref, int* busyp)
@@ -38,6 +64,8 @@ int __wt_hazard_set(WT_SESSION_IMPL* session, WT_REF* ref, int* busyp)
 			continue;
 
 		hp->page = ref->page;
+		/*在session的hazard位图中登记这个page, eviction会先检查位图*/
+		__hazard_filter_set(session, hp->page);
 		/*发布新设置的hazard pointer，这里有内存屏障为了写生效，防止先执行内存屏障后面的代码*/
 		WT_FULL_BARRIER();
 
@@ -47,6 +75,7 @@ int __wt_hazard_set(WT_SESSION_IMPL* session, WT_REF* ref, int* busyp)
 			return 0;
 		}
 
+		__hazard_filter_clear(session, hp->page);
 		hp->page = NULL;
 		*busyp = 1;
 		return 0;
@@ -71,6 +100,7 @@ int __wt_hazard_clear(WT_SESSION_IMPL *session, WT_PAGE *page)
 		if (hp->page == page){
 			/*这个地方不需要用内存屏障来保证，因为hp->page在设置NULL的过程，不需要保证完全正确*/
 			hp->page = NULL;
+			__hazard_filter_clear(session, page);
 			--session->nhazard; /*这个值在会不会出现负数呢？*/
 			return 0;
 		}
@@ -100,6 +130,7 @@ void __wt_hazard_close(WT_SESSION_IMPL* session)
 	/*清除hazard pointer*/
 	for (hp = session->hazard; hp < session->hazard + session->hazard_size; ++hp){
 		if (hp->page != NULL) { 
+			__hazard_filter_clear(session, hp->page);
 			hp->page = NULL;
 			--session->nhazard;
 		}
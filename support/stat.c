@@ -44,6 +44,8 @@ void
 		"btree: pages rewritten by compaction";
 	stats->btree_row_internal.desc = "btree: row-store internal pages";
 	stats->btree_row_leaf.desc = "btree: row-store leaf pages";
+	stats->btree_checkpoint_time.desc =
+		"btree: time spent on checkpoint work for this file (usecs)";
 	stats->cache_bytes_read.desc = "cache: bytes read into cache";
 	stats->cache_bytes_write.desc = "cache: bytes written from cache";
 	stats->cache_eviction_checkpoint.desc =
@@ -92,6 +94,7 @@ void
 	stats->cursor_prev.desc = "cursor: prev calls";
 	stats->cursor_remove.desc = "cursor: remove calls";
 	stats->cursor_reset.desc = "cursor: reset calls";
+	stats->cursor_search_batch.desc = "cursor: search batch calls";
 	stats->cursor_search.desc = "cursor: search calls";
 	stats->cursor_search_near.desc = "cursor: search near calls";
 	stats->cursor_update.desc = "cursor: update calls";
@@ -171,6 +174,7 @@ void
 	stats->btree_compact_rewrite.v = 0;
 	stats->btree_row_internal.v = 0;
 	stats->btree_row_leaf.v = 0;
+	stats->btree_checkpoint_time.v = 0;
 	stats->cache_bytes_read.v = 0;
 	stats->cache_bytes_write.v = 0;
 	stats->cache_eviction_checkpoint.v = 0;
@@ -203,6 +207,7 @@ void
 	stats->cursor_prev.v = 0;
 	stats->cursor_remove.v = 0;
 	stats->cursor_reset.v = 0;
+	stats->cursor_search_batch.v = 0;
 	stats->cursor_search.v = 0;
 	stats->cursor_search_near.v = 0;
 	stats->cursor_update.v = 0;
@@ -270,6 +275,7 @@ void
 	p->btree_compact_rewrite.v += c->btree_compact_rewrite.v;
 	p->btree_row_internal.v += c->btree_row_internal.v;
 	p->btree_row_leaf.v += c->btree_row_leaf.v;
+	p->btree_checkpoint_time.v += c->btree_checkpoint_time.v;
 	p->cache_bytes_read.v += c->cache_bytes_read.v;
 	p->cache_bytes_write.v += c->cache_bytes_write.v;
 	p->cache_eviction_checkpoint.v += c->cache_eviction_checkpoint.v;
@@ -303,6 +309,7 @@ void
 	p->cursor_remove.v += c->cursor_remove.v;
 	p->cursor_reset.v += c->cursor_reset.v;
 	p->cursor_search.v += c->cursor_search.v;
+	p->cursor_search_batch.v += c->cursor_search_batch.v;
 	p->cursor_search_near.v += c->cursor_search_near.v;
 	p->cursor_update.v += c->cursor_update.v;
 	p->bloom_false_positive.v += c->bloom_false_positive.v;
@@ -354,12 +361,42 @@ void
 		"async: number of times operation allocation failed";
 	stats->async_nowork.desc =
 		"async: number of times worker found no work";
+	stats->async_worker_park.desc =
+		"async: number of times worker waited for work";
+	stats->async_worker_wakeup.desc = "async: number of worker wakeups";
 	stats->async_op_alloc.desc = "async: total allocations";
+	stats->async_op_batch.desc = "async: total batch calls";
 	stats->async_op_compact.desc = "async: total compact calls";
 	stats->async_op_insert.desc = "async: total insert calls";
+	stats->async_op_batch_ops.desc =
+		"async: total operations in batch calls";
 	stats->async_op_remove.desc = "async: total remove calls";
 	stats->async_op_search.desc = "async: total search calls";
 	stats->async_op_update.desc = "async: total update calls";
+	stats->async_queue_latency_p50.desc =
+		"async: work queue latency 50th percentile (usecs)";
+	stats->async_queue_latency_p90.desc =
+		"async: work queue latency 90th percentile (usecs)";
+	stats->async_queue_latency_p99.desc =
+		"async: work queue latency 99th percentile (usecs)";
+	stats->async_queue_latency_max.desc =
+		"async: work queue latency maximum (usecs)";
+	stats->block_cache_bytes.desc =
+		"block-cache: bytes currently in the block cache";
+	stats->block_cache_evict.desc =
+		"block-cache: page images evicted from the block cache";
+	stats->block_cache_hit.desc =
+		"block-cache: page images found in the block cache";
+	stats->block_cache_insert.desc =
+		"block-cache: page images inserted into the block cache";
+	stats->block_cache_miss.desc =
+		"block-cache: page images not found in the block cache";
+	stats->block_cache_remove.desc =
+		"block-cache: page images removed from the block cache when blocks are freed";
+	stats->block_shard_free_flush.desc =
+		"block-manager: batched frees returned to the free list";
+	stats->block_shard_alloc.desc =
+		"block-manager: blocks allocated from a write shard region";
 	stats->block_preload.desc = "block-manager: blocks pre-loaded";
 	stats->block_read.desc = "block-manager: blocks read";
 	stats->block_write.desc = "block-manager: blocks written";
@@ -367,27 +404,45 @@ void
 	stats->block_byte_write.desc = "block-manager: bytes written";
 	stats->block_map_read.desc = "block-manager: mapped blocks read";
 	stats->block_byte_map_read.desc = "block-manager: mapped bytes read";
+	stats->block_shard_refill.desc =
+		"block-manager: write shard regions carved from the free list";
 	stats->cache_bytes_inuse.desc = "cache: bytes currently in the cache";
 	stats->cache_bytes_read.desc = "cache: bytes read into cache";
 	stats->cache_bytes_write.desc = "cache: bytes written from cache";
 	stats->cache_eviction_checkpoint.desc =
 		"cache: checkpoint blocked page eviction";
+	stats->cache_eviction_dirty_skew.desc =
+		"cache: eviction candidates deprioritized by write cost";
+	stats->cache_eviction_queue_steal.desc =
+		"cache: eviction pages taken from another thread's queue";
 	stats->cache_eviction_queue_empty.desc =
 		"cache: eviction server candidate queue empty when topping up";
 	stats->cache_eviction_queue_not_empty.desc =
 		"cache: eviction server candidate queue not empty when topping up";
+	stats->cache_eviction_select_time_max.desc =
+		"cache: eviction server candidate queue selection max time (usecs)";
+	stats->cache_eviction_select_time_recent.desc =
+		"cache: eviction server candidate queue selection most recent time (usecs)";
+	stats->cache_eviction_select.desc =
+		"cache: eviction server candidate queue selection passes";
+	stats->cache_eviction_select_time_total.desc =
+		"cache: eviction server candidate queue selection total time (usecs)";
 	stats->cache_eviction_server_evicting.desc =
 		"cache: eviction server evicting pages";
 	stats->cache_eviction_server_not_evicting.desc =
 		"cache: eviction server populating queue, but not evicting pages";
 	stats->cache_eviction_slow.desc =
 		"cache: eviction server unable to reach eviction goal";
+	stats->cache_eviction_walk_worker.desc =
+		"cache: eviction walks performed by worker threads";
 	stats->cache_eviction_worker_evicting.desc =
 		"cache: eviction worker thread evicting pages";
 	stats->cache_eviction_force_fail.desc =
 		"cache: failed eviction of pages that exceeded the in-memory maximum";
 	stats->cache_eviction_hazard.desc =
 		"cache: hazard pointer blocked page eviction";
+	stats->cache_eviction_hazard_scan.desc =
+		"cache: hazard pointer scans after a hazard index hit";
 	stats->cache_inmem_split.desc = "cache: in-memory page splits";
 	stats->cache_eviction_internal.desc = "cache: internal pages evicted";
 	stats->cache_bytes_max.desc = "cache: maximum bytes configured";
@@ -404,14 +459,28 @@ void
 		"cache: pages evicted because they had chains of deleted items";
 	stats->cache_eviction_app.desc =
 		"cache: pages evicted by application threads";
+	stats->cache_readahead_queued.desc =
+		"cache: pages queued for read-ahead";
 	stats->cache_read.desc = "cache: pages read into cache";
+	stats->cache_readahead_read.desc =
+		"cache: pages read into cache by read-ahead threads";
 	stats->cache_eviction_fail.desc =
 		"cache: pages selected for eviction unable to be evicted";
 	stats->cache_eviction_split.desc =
 		"cache: pages split during eviction";
 	stats->cache_eviction_walk.desc = "cache: pages walked for eviction";
+	stats->cache_eviction_walk_rate.desc =
+		"cache: pages walked for eviction per second";
 	stats->cache_write.desc = "cache: pages written from cache";
 	stats->cache_overhead.desc = "cache: percentage overhead";
+	stats->cache_readahead_miss.desc =
+		"cache: read-ahead pages not in cache when reached by cursor scans";
+	stats->cache_readahead_hit.desc =
+		"cache: read-ahead pages used by cursor scans";
+	stats->cache_readahead_queue_full.desc =
+		"cache: read-ahead requests dropped because the queue is full";
+	stats->cache_readahead_skip_full.desc =
+		"cache: read-ahead requests skipped because the cache is full";
 	stats->cache_bytes_internal.desc =
 		"cache: tracked bytes belonging to internal pages in the cache";
 	stats->cache_bytes_leaf.desc =
@@ -435,15 +504,23 @@ void
 		"connection: pthread mutex shared lock write-lock calls";
 	stats->read_io.desc = "connection: total read I/Os";
 	stats->write_io.desc = "connection: total write I/Os";
+	stats->cursor_cache_discard.desc =
+		"cursor: cursor cache entries discarded";
+	stats->cursor_cache_hit.desc = "cursor: cursor cache hits";
+	stats->cursor_cache_insert.desc = "cursor: cursor cache inserts";
+	stats->cursor_cache_miss.desc = "cursor: cursor cache misses";
 	stats->cursor_create.desc = "cursor: cursor create calls";
 	stats->cursor_insert.desc = "cursor: cursor insert calls";
 	stats->cursor_next.desc = "cursor: cursor next calls";
 	stats->cursor_prev.desc = "cursor: cursor prev calls";
 	stats->cursor_remove.desc = "cursor: cursor remove calls";
 	stats->cursor_reset.desc = "cursor: cursor reset calls";
+	stats->cursor_search_batch.desc = "cursor: cursor search batch calls";
 	stats->cursor_search.desc = "cursor: cursor search calls";
 	stats->cursor_search_near.desc = "cursor: cursor search near calls";
 	stats->cursor_update.desc = "cursor: cursor update calls";
+	stats->cursor_search_batch_leaf.desc =
+		"cursor: search batch keys found without a root descent";
 	stats->dh_conn_ref.desc =
 		"data-handle: connection candidate referenced";
 	stats->dh_conn_handles.desc = "data-handle: connection dhandles swept";
@@ -451,6 +528,11 @@ void
 	stats->dh_conn_tod.desc = "data-handle: connection time-of-death sets";
 	stats->dh_session_handles.desc = "data-handle: session dhandles swept";
 	stats->dh_session_sweeps.desc = "data-handle: session sweep attempts";
+	stats->aio_sync.desc =
+		"io_uring: I/O requests done synchronously because the queue was full";
+	stats->aio_submit.desc = "io_uring: I/O requests submitted";
+	stats->aio_reap_wait.desc =
+		"io_uring: waits that reaped the completion queue after io_uring failed";
 	stats->log_slot_closes.desc = "log: consolidated slot closures";
 	stats->log_slot_races.desc = "log: consolidated slot join races";
 	stats->log_slot_transitions.desc =
@@ -475,17 +557,21 @@ void
 	stats->log_write_lsn.desc =
 		"log: log server thread advances write LSN";
 	stats->log_sync.desc = "log: log sync operations";
+	stats->log_sync_requests.desc =
+		"log: log sync requests handed to the flush thread";
 	stats->log_sync_dir.desc = "log: log sync_dir operations";
 	stats->log_writes.desc = "log: log write operations";
 	stats->log_slot_consolidated.desc = "log: logging bytes consolidated";
 	stats->log_max_filesize.desc = "log: maximum log file size";
 	stats->log_prealloc_max.desc =
 		"log: number of pre-allocated log files to create";
+	stats->log_recovery_ops.desc = "log: operations applied by recovery";
 	stats->log_prealloc_files.desc =
 		"log: pre-allocated log files prepared";
 	stats->log_prealloc_used.desc = "log: pre-allocated log files used";
 	stats->log_slot_toobig.desc = "log: record size exceeded maximum";
 	stats->log_scan_records.desc = "log: records processed by log scan";
+	stats->log_recovery_time.desc = "log: recovery time (usecs)";
 	stats->log_slot_switch_fails.desc =
 		"log: slots selected for switching that were unavailable";
 	stats->log_compress_mem.desc =
@@ -511,6 +597,12 @@ void
 	stats->lsm_work_units_created.desc =
 		"LSM: tree maintenance operations scheduled";
 	stats->lsm_work_queue_max.desc = "LSM: tree queue hit maximum";
+	stats->lsm_bloom_memory.desc = "LSM: bloom filter bytes in memory";
+	stats->lsm_bloom_probe_sampled.desc =
+		"LSM: bloom filter probes sampled for latency";
+	stats->lsm_bloom_probe_time.desc =
+		"LSM: bloom filter sampled probe time (nsecs)";
+	stats->lsm_bloom_load.desc = "LSM: bloom filters loaded into memory";
 	stats->rec_pages.desc = "reconciliation: page reconciliation calls";
 	stats->rec_pages_eviction.desc =
 		"reconciliation: page reconciliation calls for eviction";
@@ -518,6 +610,10 @@ void
 		"reconciliation: split bytes currently awaiting free";
 	stats->rec_split_stashed_objects.desc =
 		"reconciliation: split objects currently awaiting free";
+	stats->rec_compress_wait.desc =
+		"reconciliation: split page writes that waited for a block compression thread";
+	stats->rec_compress_async.desc =
+		"reconciliation: split pages compressed by block compression threads";
 	stats->session_cursor_open.desc = "session: open cursor count";
 	stats->session_open.desc = "session: open session count";
 	stats->page_busy_blocked.desc =
@@ -530,6 +626,8 @@ void
 		"thread-yield: page acquire read blocked";
 	stats->page_sleep.desc =
 		"thread-yield: page acquire time sleeping (usecs)";
+	stats->txn_checkpoint_file_time_max.desc =
+		"transaction: maximum per-file checkpoint operation time (usecs)";
 	stats->txn_begin.desc = "transaction: transaction begins";
 	stats->txn_checkpoint_running.desc =
 		"transaction: transaction checkpoint currently running";
@@ -550,6 +648,10 @@ void
 		"transaction: transaction range of IDs currently pinned";
 	stats->txn_pinned_checkpoint_range.desc =
 		"transaction: transaction range of IDs currently pinned by a checkpoint";
+	stats->txn_snapshot_cache_miss.desc =
+		"transaction: transaction snapshot cache misses";
+	stats->txn_snapshot_cache_hit.desc =
+		"transaction: transaction snapshots taken from the snapshot cache";
 	stats->txn_commit.desc = "transaction: transactions committed";
 	stats->txn_rollback.desc = "transaction: transactions rolled back";
 }
@@ -566,12 +668,23 @@ void
 	stats->async_alloc_view.v = 0;
 	stats->async_full.v = 0;
 	stats->async_nowork.v = 0;
+	stats->async_worker_park.v = 0;
+	stats->async_worker_wakeup.v = 0;
 	stats->async_op_alloc.v = 0;
+	stats->async_op_batch.v = 0;
 	stats->async_op_compact.v = 0;
 	stats->async_op_insert.v = 0;
+	stats->async_op_batch_ops.v = 0;
 	stats->async_op_remove.v = 0;
 	stats->async_op_search.v = 0;
 	stats->async_op_update.v = 0;
+	stats->block_cache_evict.v = 0;
+	stats->block_cache_hit.v = 0;
+	stats->block_cache_insert.v = 0;
+	stats->block_cache_miss.v = 0;
+	stats->block_cache_remove.v = 0;
+	stats->block_shard_free_flush.v = 0;
+	stats->block_shard_alloc.v = 0;
 	stats->block_preload.v = 0;
 	stats->block_read.v = 0;
 	stats->block_write.v = 0;
@@ -579,17 +692,23 @@ void
 	stats->block_byte_write.v = 0;
 	stats->block_map_read.v = 0;
 	stats->block_byte_map_read.v = 0;
+	stats->block_shard_refill.v = 0;
 	stats->cache_bytes_read.v = 0;
 	stats->cache_bytes_write.v = 0;
 	stats->cache_eviction_checkpoint.v = 0;
+	stats->cache_eviction_dirty_skew.v = 0;
+	stats->cache_eviction_queue_steal.v = 0;
 	stats->cache_eviction_queue_empty.v = 0;
 	stats->cache_eviction_queue_not_empty.v = 0;
+	stats->cache_eviction_select.v = 0;
 	stats->cache_eviction_server_evicting.v = 0;
 	stats->cache_eviction_server_not_evicting.v = 0;
 	stats->cache_eviction_slow.v = 0;
+	stats->cache_eviction_walk_worker.v = 0;
 	stats->cache_eviction_worker_evicting.v = 0;
 	stats->cache_eviction_force_fail.v = 0;
 	stats->cache_eviction_hazard.v = 0;
+	stats->cache_eviction_hazard_scan.v = 0;
 	stats->cache_inmem_split.v = 0;
 	stats->cache_eviction_internal.v = 0;
 	stats->cache_eviction_dirty.v = 0;
@@ -597,11 +716,17 @@ void
 	stats->cache_eviction_force.v = 0;
 	stats->cache_eviction_force_delete.v = 0;
 	stats->cache_eviction_app.v = 0;
+	stats->cache_readahead_queued.v = 0;
 	stats->cache_read.v = 0;
+	stats->cache_readahead_read.v = 0;
 	stats->cache_eviction_fail.v = 0;
 	stats->cache_eviction_split.v = 0;
 	stats->cache_eviction_walk.v = 0;
 	stats->cache_write.v = 0;
+	stats->cache_readahead_miss.v = 0;
+	stats->cache_readahead_hit.v = 0;
+	stats->cache_readahead_queue_full.v = 0;
+	stats->cache_readahead_skip_full.v = 0;
 	stats->cache_eviction_clean.v = 0;
 	stats->memory_allocation.v = 0;
 	stats->memory_free.v = 0;
@@ -611,21 +736,30 @@ void
 	stats->rwlock_write.v = 0;
 	stats->read_io.v = 0;
 	stats->write_io.v = 0;
+	stats->cursor_cache_discard.v = 0;
+	stats->cursor_cache_hit.v = 0;
+	stats->cursor_cache_insert.v = 0;
+	stats->cursor_cache_miss.v = 0;
 	stats->cursor_create.v = 0;
 	stats->cursor_insert.v = 0;
 	stats->cursor_next.v = 0;
 	stats->cursor_prev.v = 0;
 	stats->cursor_remove.v = 0;
 	stats->cursor_reset.v = 0;
+	stats->cursor_search_batch.v = 0;
 	stats->cursor_search.v = 0;
 	stats->cursor_search_near.v = 0;
 	stats->cursor_update.v = 0;
+	stats->cursor_search_batch_leaf.v = 0;
 	stats->dh_conn_ref.v = 0;
 	stats->dh_conn_handles.v = 0;
 	stats->dh_conn_sweeps.v = 0;
 	stats->dh_conn_tod.v = 0;
 	stats->dh_session_handles.v = 0;
 	stats->dh_session_sweeps.v = 0;
+	stats->aio_sync.v = 0;
+	stats->aio_submit.v = 0;
+	stats->aio_reap_wait.v = 0;
 	stats->log_slot_closes.v = 0;
 	stats->log_slot_races.v = 0;
 	stats->log_slot_transitions.v = 0;
@@ -643,9 +777,11 @@ void
 	stats->log_scan_rereads.v = 0;
 	stats->log_write_lsn.v = 0;
 	stats->log_sync.v = 0;
+	stats->log_sync_requests.v = 0;
 	stats->log_sync_dir.v = 0;
 	stats->log_writes.v = 0;
 	stats->log_slot_consolidated.v = 0;
+	stats->log_recovery_ops.v = 0;
 	stats->log_prealloc_files.v = 0;
 	stats->log_prealloc_used.v = 0;
 	stats->log_slot_toobig.v = 0;
@@ -661,8 +797,13 @@ void
 	stats->lsm_work_units_done.v = 0;
 	stats->lsm_work_units_created.v = 0;
 	stats->lsm_work_queue_max.v = 0;
+	stats->lsm_bloom_probe_sampled.v = 0;
+	stats->lsm_bloom_probe_time.v = 0;
+	stats->lsm_bloom_load.v = 0;
 	stats->rec_pages.v = 0;
 	stats->rec_pages_eviction.v = 0;
+	stats->rec_compress_wait.v = 0;
+	stats->rec_compress_async.v = 0;
 	stats->page_busy_blocked.v = 0;
 	stats->page_forcible_evict_blocked.v = 0;
 	stats->page_locked_blocked.v = 0;
@@ -671,6 +812,8 @@ void
 	stats->txn_begin.v = 0;
 	stats->txn_checkpoint.v = 0;
 	stats->txn_fail_cache.v = 0;
+	stats->txn_snapshot_cache_miss.v = 0;
+	stats->txn_snapshot_cache_hit.v = 0;
 	stats->txn_commit.v = 0;
 	stats->txn_rollback.v = 0;
 }
@@ -0,0 +1,204 @@
+#include "bench.h"
+#include <errno.h>
+#include <sched.h>
+#include <stddef.h>
+#include <string.h>
+
+/*
+ * 对比逐个提交async op和用async_batch批量提交的耗时: 同样数量的随机key分别用两种方式
+ * 插入，然后用batch search检查插入的结果。batch的执行顺序和回滚在test/check/async_batch_check.c中检查
+ */
+
+#define HOME_DIR		"WT_ASYNC_BATCH_BENCH"
+#define TAB_META		"key_format=u,value_format=u"
+#define WT_CONFIG		"create,cache_size=256MB,async=(enabled=true,ops_max=1024,threads=4)"
+#define OP_COUNT		500000
+#define BATCH_SIZE		500
+#define BATCH_INFLIGHT	16
+
+/*一个batch的缓冲区，在notify_batch回调之前必须保持有效*/
+typedef struct {
+	WT_ASYNC_BATCH_OP	ops[BATCH_SIZE];
+	char				keys[BATCH_SIZE][32];
+	char				values[BATCH_SIZE][32];
+	volatile int		busy;
+} BATCH;
+
+static BATCH batches[BATCH_INFLIGHT];
+static uint64_t failed, found;
+
+static int notify(WT_ASYNC_CALLBACK* cb, WT_ASYNC_OP* op, int op_ret, uint32_t flags)
+{
+	(void)cb;
+	(void)op;
+	(void)flags;
+
+	if (op_ret != 0)
+		__sync_add_and_fetch(&failed, 1);
+	return 0;
+}
+
+/*batch完成的回调，search要检查返回的value和key对应*/
+static int notify_batch(WT_ASYNC_CALLBACK* cb, WT_ASYNC_BATCH_OP* ops, uint32_t nops, int ret)
+{
+	BATCH *batch;
+	uint32_t i;
+
+	(void)cb;
+
+	batch = (BATCH *)((char *)ops - offsetof(BATCH, ops));
+	if (ret != 0)
+		__sync_add_and_fetch(&failed, 1);
+
+	for (i = 0; i < nops; i++){
+		if (ops[i].optype != WT_AOP_SEARCH || ops[i].ret != 0)
+			continue;
+		if (ops[i].value.size != ops[i].key.size || memcmp(ops[i].value.data, ops[i].key.data, ops[i].key.size) != 0)
+			__sync_add_and_fetch(&failed, 1);
+		else
+			__sync_add_and_fetch(&found, 1);
+	}
+
+	__sync_synchronize();
+	batch->busy = 0;
+	return 0;
+}
+
+static WT_ASYNC_CALLBACK callback = { notify, notify_batch };
+
+static void make_key(char* buf, size_t len, int prefix, int n)
+{
+	snprintf(buf, len, "%c%010d", prefix, n);
+}
+
+/*逐个提交async insert*/
+static int run_single(WT_CONNECTION* conn, const char* uri)
+{
+	WT_ASYNC_OP *op;
+	WT_ITEM key;
+	char kbuf[32];
+	int i, ret;
+
+	srand(42);
+	for (i = 0; i < OP_COUNT; i++){
+		while ((ret = conn->async_new_op(conn, uri, "raw", &callback, &op)) == EBUSY)
+			sched_yield();
+		if (ret != 0)
+			return ret;
+
+		make_key(kbuf, sizeof(kbuf), 's', rand());
+		key.data = kbuf;
+		key.size = strlen(kbuf);
+		op->set_key(op, &key);
+		op->set_value(op, &key);
+		if ((ret = op->insert(op)) != 0)
+			return ret;
+	}
+
+	return conn->async_flush(conn);
+}
+
+/*取一个空闲的batch缓冲区*/
+static BATCH* batch_get()
+{
+	int i;
+
+	for (;;){
+		for (i = 0; i < BATCH_INFLIGHT; i++)
+			if (!batches[i].busy){
+				batches[i].busy = 1;
+				return &batches[i];
+			}
+		sched_yield();
+	}
+}
+
+/*用async_batch提交，optype为WT_AOP_INSERT时value和key相同*/
+static int run_batch(WT_CONNECTION* conn, const char* uri, WT_ASYNC_OPTYPE optype, int prefix)
+{
+	BATCH *batch;
+	WT_ASYNC_BATCH_OP *bop;
+	int i, j, ret;
+
+	srand(42);
+	for (i = 0; i < OP_COUNT; i += BATCH_SIZE){
+		batch = batch_get();
+		for (j = 0; j < BATCH_SIZE; j++){
+			bop = &batch->ops[j];
+			memset(bop, 0, sizeof(*bop));
+			bop->optype = optype;
+			make_key(batch->keys[j], sizeof(batch->keys[j]), prefix, rand());
+			bop->key.data = batch->keys[j];
+			bop->key.size = strlen(batch->keys[j]);
+			if (optype == WT_AOP_INSERT){
+				memcpy(batch->values[j], batch->keys[j], bop->key.size);
+				bop->value.data = batch->values[j];
+				bop->value.size = bop->key.size;
+			}
+		}
+
+		while ((ret = conn->async_batch(conn, uri, NULL, &callback, batch->ops, BATCH_SIZE)) == EBUSY)
+			sched_yield();
+		if (ret != 0){
+			batch->busy = 0;
+			return ret;
+		}
+	}
+
+	return conn->async_flush(conn);
+}
+
+int main()
+{
+	WT_CONNECTION *conn;
+	WT_SESSION *session;
+	uint64_t batch_usec, single_usec, start;
+	int ret;
+
+	if (bench_home(HOME_DIR) != 0)
+		return 1;
+	if ((ret = wiredtiger_open(HOME_DIR, NULL, WT_CONFIG, &conn)) != 0){
+		printf("wiredtiger_open failed, ret = %d\n", ret);
+		return 1;
+	}
+
+	if ((ret = conn->open_session(conn, NULL, NULL, &session)) != 0 ||
+		(ret = session->create(session, "table:single", TAB_META)) != 0 ||
+		(ret = session->create(session, "table:batch", TAB_META)) != 0){
+		printf("create table failed, ret = %d\n", ret);
+		goto err;
+	}
+
+	start = bench_now_usec();
+	if ((ret = run_single(conn, "table:single")) != 0){
+		printf("async insert failed, ret = %d\n", ret);
+		goto err;
+	}
+	single_usec = bench_now_usec() - start;
+
+	start = bench_now_usec();
+	if ((ret = run_batch(conn, "table:batch", WT_AOP_INSERT, 'b')) != 0){
+		printf("async batch insert failed, ret = %d\n", ret);
+		goto err;
+	}
+	batch_usec = bench_now_usec() - start;
+
+	/*同样的随机序列再做一次batch search，每个key都应该找到*/
+	if ((ret = run_batch(conn, "table:batch", WT_AOP_SEARCH, 'b')) != 0){
+		printf("async batch search failed, ret = %d\n", ret);
+		goto err;
+	}
+
+	printf("%d async inserts: single ops = %llu us, batches of %d = %llu us, batch search found = %llu\n",
+		OP_COUNT, (unsigned long long)single_usec, BATCH_SIZE, (unsigned long long)batch_usec,
+		(unsigned long long)found);
+
+	if (failed != 0 || found != OP_COUNT){
+		printf("async batch results mismatch, failed = %llu\n", (unsigned long long)failed);
+		ret = -1;
+	}
+
+err:
+	conn->close(conn, NULL);
+	return ret == 0 ? 0 : 1;
+}
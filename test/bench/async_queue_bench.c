@@ -0,0 +1,135 @@
+#include "bench.h"
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * async排队队列的测试: 多个应用线程突发地提交async insert，统计提交和flush的耗时，
+ * 以及排队延迟的百分位数。然后通过reconfigure把worker数量调到超过原来20的上限再测一次。
+ * 操作结果的正确性在test/check/async_queue_check.c中检查
+ */
+
+#define HOME_DIR		"WT_ASYNC_QUEUE_BENCH"
+#define TAB_META		"key_format=q,value_format=S"
+#define WT_CONFIG		"create,cache_size=256MB,statistics=(fast),async=(enabled=true,ops_max=4096,threads=4,threads_max=64)"
+#define THREAD_COUNT	8
+#define OP_COUNT		100000
+
+static WT_CONNECTION* conn;
+static uint64_t key_base;
+static uint64_t failed;
+
+static int notify(WT_ASYNC_CALLBACK* cb, WT_ASYNC_OP* op, int op_ret, uint32_t flags)
+{
+	(void)cb;
+	(void)op;
+	(void)flags;
+
+	if (op_ret != 0)
+		__sync_add_and_fetch(&failed, 1);
+	return 0;
+}
+
+static WT_ASYNC_CALLBACK callback = { notify };
+
+static void* producer(void* arg)
+{
+	WT_ASYNC_OP *op;
+	int64_t base, i;
+	int ret;
+
+	base = (int64_t)(uintptr_t)arg;
+	ret = 0;
+
+	for (i = 0; i < OP_COUNT; i++){
+		/*op池用完时等待worker释放*/
+		while ((ret = conn->async_new_op(conn, "table:async", NULL, &callback, &op)) == EBUSY)
+			sched_yield();
+		if (ret != 0)
+			break;
+
+		op->set_key(op, base + i);
+		op->set_value(op, "value");
+		if ((ret = op->insert(op)) != 0)
+			break;
+
+		/*每提交一批后停顿一下，模拟突发的负载*/
+		if (i % 1000 == 999)
+			usleep(1000);
+	}
+
+	if (ret != 0)
+		printf("producer failed, ret = %d\n", ret);
+	return (void *)(intptr_t)ret;
+}
+
+static int bench(WT_SESSION* session, const char* label)
+{
+	pthread_t tids[THREAD_COUNT];
+	uint64_t p50, p99, park, start, usec;
+	void *thread_ret;
+	int i, ret;
+
+	ret = 0;
+	start = bench_now_usec();
+	for (i = 0; i < THREAD_COUNT; i++)
+		pthread_create(&tids[i], NULL, producer, (void *)(uintptr_t)(key_base + (uint64_t)i * OP_COUNT));
+	for (i = 0; i < THREAD_COUNT; i++){
+		pthread_join(tids[i], &thread_ret);
+		if (thread_ret != NULL)
+			ret = (int)(intptr_t)thread_ret;
+	}
+	key_base += (uint64_t)THREAD_COUNT * OP_COUNT;
+
+	if (ret != 0 || (ret = conn->async_flush(conn)) != 0)
+		return ret;
+	usec = bench_now_usec() - start;
+
+	if ((ret = bench_get_stat(session, WT_STAT_CONN_ASYNC_QUEUE_LATENCY_P50, &p50)) != 0 ||
+		(ret = bench_get_stat(session, WT_STAT_CONN_ASYNC_QUEUE_LATENCY_P99, &p99)) != 0 ||
+		(ret = bench_get_stat(session, WT_STAT_CONN_ASYNC_WORKER_PARK, &park)) != 0)
+		return ret;
+
+	printf("%s: %d x %d async inserts = %llu us, queue latency p50 = %llu us, p99 = %llu us, worker waits = %llu\n",
+		label, THREAD_COUNT, OP_COUNT, (unsigned long long)usec, (unsigned long long)p50,
+		(unsigned long long)p99, (unsigned long long)park);
+
+	return failed == 0 ? 0 : -1;
+}
+
+int main()
+{
+	WT_SESSION *session;
+	int ret;
+
+	if (bench_home(HOME_DIR) != 0)
+		return 1;
+	if ((ret = wiredtiger_open(HOME_DIR, NULL, WT_CONFIG, &conn)) != 0){
+		printf("wiredtiger_open failed, ret = %d\n", ret);
+		return 1;
+	}
+
+	if ((ret = conn->open_session(conn, NULL, NULL, &session)) != 0 ||
+		(ret = session->create(session, "table:async", TAB_META)) != 0){
+		printf("create table failed, ret = %d\n", ret);
+		goto err;
+	}
+
+	if ((ret = bench(session, "threads=4")) != 0)
+		goto err;
+
+	if ((ret = conn->reconfigure(conn, "async=(enabled=true,threads=32,threads_max=64)")) != 0){
+		printf("reconfigure failed, ret = %d\n", ret);
+		goto err;
+	}
+	if ((ret = bench(session, "threads=32")) != 0)
+		goto err;
+
+err:
+	if (ret != 0)
+		printf("async queue bench failed, ret = %d, failed ops = %llu\n", ret, (unsigned long long)failed);
+	conn->close(conn, NULL);
+	return ret == 0 ? 0 : 1;
+}
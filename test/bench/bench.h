@@ -0,0 +1,53 @@
+#ifndef __BENCH_H_
+#define __BENCH_H_
+
+/*
+ * benchmark共用的工具函数。每个benchmark是一个独立的可执行程序，只输出耗时，
+ * 不加入ctest，行为的检查放在test/check中
+ */
+
+#include "wiredtiger.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+static inline uint64_t bench_now_usec(void)
+{
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return (uint64_t)tv.tv_sec * 1000000 + (uint64_t)tv.tv_usec;
+}
+
+/*清空并重新创建benchmark的数据目录*/
+static inline int bench_home(const char* home)
+{
+	char cmd[512];
+
+	snprintf(cmd, sizeof(cmd), "rm -rf %s && mkdir %s", home, home);
+	if (system(cmd) != 0){
+		printf("create %s failed\n", home);
+		return -1;
+	}
+	return 0;
+}
+
+/*从statistics cursor中读取一个统计项*/
+static inline int bench_get_stat(WT_SESSION* session, int key, uint64_t* valuep)
+{
+	WT_CURSOR *cursor;
+	const char *desc, *pvalue;
+	int ret;
+
+	if ((ret = session->open_cursor(session, "statistics:", NULL, NULL, &cursor)) != 0)
+		return ret;
+
+	cursor->set_key(cursor, key);
+	if ((ret = cursor->search(cursor)) == 0)
+		ret = cursor->get_value(cursor, &desc, &pvalue, valuep);
+	cursor->close(cursor);
+	return ret;
+}
+
+#endif
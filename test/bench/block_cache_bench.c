@@ -0,0 +1,114 @@
+#include "bench.h"
+#include <string.h>
+
+/*
+ * 对比block_cache.size不同配置时的随机读耗时: cache_size远小于数据量，page会被频繁
+ * evict，打开block cache后重新读取被evict的page不需要再做磁盘I/O
+ */
+
+#define HOME_DIR		"WT_BLOCK_CACHE_BENCH"
+#define TAB_META		"key_format=S,value_format=S,leaf_page_max=16KB"
+#define WT_CONFIG		"cache_size=16MB,block_cache=(size=%s),statistics=(fast)"
+#define RECORD_COUNT	500000
+#define SEARCH_COUNT	500000
+
+static const char* block_cache_sizes[] = { "0", "256MB" };
+
+static int load()
+{
+	WT_CONNECTION *conn;
+	WT_CURSOR *cursor;
+	WT_SESSION *session;
+	char key[32], value[256];
+	int i, ret;
+
+	if (bench_home(HOME_DIR) != 0)
+		return 1;
+	if ((ret = wiredtiger_open(HOME_DIR, NULL, "create", &conn)) != 0){
+		printf("wiredtiger_open failed, ret = %d\n", ret);
+		return ret;
+	}
+
+	if ((ret = conn->open_session(conn, NULL, NULL, &session)) != 0 ||
+		(ret = session->create(session, "table:mytable", TAB_META)) != 0 ||
+		(ret = session->open_cursor(session, "table:mytable", NULL, "bulk", &cursor)) != 0){
+		printf("create table failed, ret = %d\n", ret);
+		goto err;
+	}
+
+	memset(value, 'v', sizeof(value) - 1);
+	value[sizeof(value) - 1] = '\0';
+	for (i = 0; i < RECORD_COUNT; i++){
+		snprintf(key, sizeof(key), "key%010d", i);
+		cursor->set_key(cursor, key);
+		cursor->set_value(cursor, value);
+		if ((ret = cursor->insert(cursor)) != 0){
+			printf("insert k/v failed, ret = %d\n", ret);
+			break;
+		}
+	}
+	cursor->close(cursor);
+
+err:
+	conn->close(conn, NULL);
+	return ret;
+}
+
+static int bench(const char* size)
+{
+	WT_CONNECTION *conn;
+	WT_CURSOR *cursor;
+	WT_SESSION *session;
+	uint64_t hit, miss, start, usec;
+	char config[256], key[32];
+	int i, ret;
+
+	snprintf(config, sizeof(config), WT_CONFIG, size);
+	conn = NULL;
+	srand(42);
+
+	if ((ret = wiredtiger_open(HOME_DIR, NULL, config, &conn)) != 0 ||
+		(ret = conn->open_session(conn, NULL, NULL, &session)) != 0 ||
+		(ret = session->open_cursor(session, "table:mytable", NULL, NULL, &cursor)) != 0)
+		goto err;
+
+	start = bench_now_usec();
+	for (i = 0; i < SEARCH_COUNT; i++){
+		snprintf(key, sizeof(key), "key%010d", rand() % RECORD_COUNT);
+		cursor->set_key(cursor, key);
+		if ((ret = cursor->search(cursor)) != 0){
+			printf("search %s failed, ret = %d\n", key, ret);
+			goto err;
+		}
+	}
+	usec = bench_now_usec() - start;
+	cursor->close(cursor);
+
+	if ((ret = bench_get_stat(session, WT_STAT_CONN_BLOCK_CACHE_HIT, &hit)) != 0 ||
+		(ret = bench_get_stat(session, WT_STAT_CONN_BLOCK_CACHE_MISS, &miss)) != 0)
+		goto err;
+
+	printf("block_cache size = %s: search = %llu us, block cache hit = %llu, miss = %llu\n", size,
+		(unsigned long long)usec, (unsigned long long)hit, (unsigned long long)miss);
+
+err:
+	if (ret != 0)
+		printf("block_cache size = %s: bench failed, ret = %d\n", size, ret);
+	if (conn != NULL)
+		conn->close(conn, NULL);
+	return ret;
+}
+
+int main()
+{
+	size_t i;
+
+	if (load() != 0)
+		return 1;
+
+	for (i = 0; i < sizeof(block_cache_sizes) / sizeof(block_cache_sizes[0]); i++)
+		if (bench(block_cache_sizes[i]) != 0)
+			return 1;
+
+	return 0;
+}
@@ -0,0 +1,82 @@
+#include "bench.h"
+#include <string.h>
+
+/*
+ * 对比短事务中使用配置字符串和预编译配置handle的耗时: 每个事务只插入一条记录，
+ * begin_transaction分别使用配置字符串和compile_configuration的结果
+ */
+
+#define HOME_DIR		"WT_CONFIG_COMPILE_BENCH"
+#define TAB_META		"key_format=q,value_format=S"
+#define BEGIN_CONFIG	"isolation=snapshot,priority=0"
+#define CURSOR_CONFIG	"overwrite=false"
+#define TXN_COUNT		200000
+
+static int run(WT_SESSION* session, WT_CURSOR* cursor, const char* begin_cfg, int64_t base, uint64_t* usecp)
+{
+	uint64_t start;
+	int64_t i;
+	int ret;
+
+	start = bench_now_usec();
+	for (i = 0; i < TXN_COUNT; i++){
+		if ((ret = session->begin_transaction(session, begin_cfg)) != 0)
+			return ret;
+
+		cursor->set_key(cursor, base + i);
+		cursor->set_value(cursor, "value");
+		if ((ret = cursor->insert(cursor)) != 0){
+			session->rollback_transaction(session, NULL);
+			return ret;
+		}
+
+		if ((ret = session->commit_transaction(session, NULL)) != 0)
+			return ret;
+	}
+	*usecp = bench_now_usec() - start;
+
+	return 0;
+}
+
+int main()
+{
+	WT_CONNECTION *conn;
+	WT_CURSOR *cursor;
+	WT_SESSION *session;
+	uint64_t compiled_usec, string_usec;
+	const char *begin_cfg, *cursor_cfg;
+	int ret;
+
+	if (bench_home(HOME_DIR) != 0)
+		return 1;
+	if ((ret = wiredtiger_open(HOME_DIR, NULL, "create,cache_size=256MB", &conn)) != 0){
+		printf("wiredtiger_open failed, ret = %d\n", ret);
+		return 1;
+	}
+
+	if ((ret = conn->compile_configuration(conn, "session.begin_transaction", BEGIN_CONFIG, &begin_cfg)) != 0 ||
+		(ret = conn->compile_configuration(conn, "session.open_cursor", CURSOR_CONFIG, &cursor_cfg)) != 0){
+		printf("compile_configuration failed, ret = %d\n", ret);
+		goto err;
+	}
+
+	if ((ret = conn->open_session(conn, NULL, NULL, &session)) != 0 ||
+		(ret = session->create(session, "table:mytable", TAB_META)) != 0 ||
+		(ret = session->open_cursor(session, "table:mytable", NULL, cursor_cfg, &cursor)) != 0){
+		printf("open table failed, ret = %d\n", ret);
+		goto err;
+	}
+
+	if ((ret = run(session, cursor, BEGIN_CONFIG, 0, &string_usec)) != 0 ||
+		(ret = run(session, cursor, begin_cfg, TXN_COUNT, &compiled_usec)) != 0){
+		printf("transaction failed, ret = %d\n", ret);
+		goto err;
+	}
+
+	printf("config string = %llu us, compiled config = %llu us\n",
+		(unsigned long long)string_usec, (unsigned long long)compiled_usec);
+
+err:
+	conn->close(conn, NULL);
+	return ret == 0 ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+#include "bench.h"
+#include <string.h>
+
+/*
+ * 对比session_cursor_cache不同配置时反复open/close cursor的耗时: 每次请求打开两个表的
+ * cursor做一次查询后关闭。cursor cache的行为在test/check/cursor_cache_check.c中检查
+ */
+
+#define HOME_DIR		"WT_CURSOR_CACHE_BENCH"
+#define TAB_META		"key_format=q,value_format=S"
+#define WT_CONFIG		"create,cache_size=64MB,session_cursor_cache=%s,statistics=(fast)"
+#define RECORD_COUNT	10000
+#define REQUEST_COUNT	200000
+
+static const char* cache_sizes[] = { "0", "32" };
+static const char* uris[] = { "table:orders", "file:items.wt" };
+
+static int load(WT_SESSION* session, const char* uri)
+{
+	WT_CURSOR *cursor;
+	int64_t i;
+	int ret;
+
+	if ((ret = session->create(session, uri, TAB_META)) != 0 ||
+		(ret = session->open_cursor(session, uri, NULL, NULL, &cursor)) != 0)
+		return ret;
+
+	for (i = 0; i < RECORD_COUNT; i++){
+		cursor->set_key(cursor, i);
+		cursor->set_value(cursor, "value");
+		if ((ret = cursor->insert(cursor)) != 0)
+			break;
+	}
+
+	cursor->close(cursor);
+	return ret;
+}
+
+/*模拟一次请求: 每个表打开一个cursor，查询一条记录后关闭*/
+static int request(WT_SESSION* session, int64_t key)
+{
+	WT_CURSOR *cursor;
+	const char *value;
+	size_t i;
+	int ret;
+
+	for (i = 0; i < sizeof(uris) / sizeof(uris[0]); i++){
+		if ((ret = session->open_cursor(session, uris[i], NULL, "overwrite=false", &cursor)) != 0)
+			return ret;
+
+		cursor->set_key(cursor, key);
+		if ((ret = cursor->search(cursor)) == 0)
+			ret = cursor->get_value(cursor, &value);
+		cursor->close(cursor);
+		if (ret != 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+static int bench(const char* size)
+{
+	WT_CONNECTION *conn;
+	WT_SESSION *session;
+	uint64_t hit, miss, start, usec;
+	char config[256];
+	size_t i;
+	int n, ret;
+
+	snprintf(config, sizeof(config), WT_CONFIG, size);
+	conn = NULL;
+	srand(42);
+
+	if (bench_home(HOME_DIR) != 0)
+		return 1;
+	if ((ret = wiredtiger_open(HOME_DIR, NULL, config, &conn)) != 0 ||
+		(ret = conn->open_session(conn, NULL, NULL, &session)) != 0)
+		goto err;
+
+	for (i = 0; i < sizeof(uris) / sizeof(uris[0]); i++)
+		if ((ret = load(session, uris[i])) != 0)
+			goto err;
+
+	start = bench_now_usec();
+	for (n = 0; n < REQUEST_COUNT; n++)
+		if ((ret = request(session, rand() % RECORD_COUNT)) != 0)
+			goto err;
+	usec = bench_now_usec() - start;
+
+	if ((ret = bench_get_stat(session, WT_STAT_CONN_CURSOR_CACHE_HIT, &hit)) != 0 ||
+		(ret = bench_get_stat(session, WT_STAT_CONN_CURSOR_CACHE_MISS, &miss)) != 0)
+		goto err;
+
+	printf("session_cursor_cache = %s: requests = %llu us, cursor cache hit = %llu, miss = %llu\n", size,
+		(unsigned long long)usec, (unsigned long long)hit, (unsigned long long)miss);
+
+err:
+	if (ret != 0)
+		printf("session_cursor_cache = %s: bench failed, ret = %d\n", size, ret);
+	if (conn != NULL)
+		conn->close(conn, NULL);
+	return ret;
+}
+
+int main()
+{
+	size_t i;
+
+	for (i = 0; i < sizeof(cache_sizes) / sizeof(cache_sizes[0]); i++)
+		if (bench(cache_sizes[i]) != 0)
+			return 1;
+
+	return 0;
+}
@@ -0,0 +1,113 @@
+#include "bench.h"
+#include <pthread.h>
+#include <string.h>
+
+/*
+ * 大量表和短生命周期session下的dhandle查找性能测试: 多个线程反复打开session，在随机的表上
+ * open cursor查询后关闭session，每次都要在connection的dhandle hash中查找。sweep的间隔
+ * 配置得很短，让dhandle的关闭和删除与无锁查找同时发生。查找结果的正确性在test/check/dhandle_sweep_check.c中检查
+ */
+
+#define HOME_DIR		"WT_DHANDLE_LOOKUP_BENCH"
+#define TAB_META		"key_format=q,value_format=S"
+#define WT_CONFIG		"create,cache_size=256MB,session_max=200,file_manager=(close_idle_time=1,close_scan_interval=1)"
+#define TABLE_COUNT		2000
+#define THREAD_COUNT	16
+#define LOOP_COUNT		20000
+
+static WT_CONNECTION* conn;
+
+static int create_tables()
+{
+	WT_CURSOR *cursor;
+	WT_SESSION *session;
+	char uri[64];
+	int i, ret;
+
+	if ((ret = conn->open_session(conn, NULL, NULL, &session)) != 0)
+		return ret;
+
+	for (i = 0; i < TABLE_COUNT; i++){
+		snprintf(uri, sizeof(uri), "table:t%05d", i);
+		if ((ret = session->create(session, uri, TAB_META)) != 0 ||
+			(ret = session->open_cursor(session, uri, NULL, NULL, &cursor)) != 0)
+			break;
+
+		cursor->set_key(cursor, (int64_t)i);
+		cursor->set_value(cursor, "value");
+		ret = cursor->insert(cursor);
+		cursor->close(cursor);
+		if (ret != 0)
+			break;
+	}
+
+	session->close(session, NULL);
+	return ret;
+}
+
+static void* worker(void* arg)
+{
+	WT_CURSOR *cursor;
+	WT_SESSION *session;
+	char uri[64];
+	unsigned int seed;
+	int i, n, ret;
+
+	seed = (unsigned int)(uintptr_t)arg;
+	ret = 0;
+
+	for (n = 0; n < LOOP_COUNT && ret == 0; n++){
+		if ((ret = conn->open_session(conn, NULL, NULL, &session)) != 0)
+			break;
+
+		i = rand_r(&seed) % TABLE_COUNT;
+		snprintf(uri, sizeof(uri), "table:t%05d", i);
+		if ((ret = session->open_cursor(session, uri, NULL, NULL, &cursor)) == 0){
+			cursor->set_key(cursor, (int64_t)i);
+			ret = cursor->search(cursor);
+			cursor->close(cursor);
+		}
+
+		session->close(session, NULL);
+	}
+
+	if (ret != 0)
+		printf("worker failed, ret = %d\n", ret);
+	return (void *)(intptr_t)ret;
+}
+
+int main()
+{
+	pthread_t tids[THREAD_COUNT];
+	uint64_t start;
+	void *thread_ret;
+	int i, ret;
+
+	if (bench_home(HOME_DIR) != 0)
+		return 1;
+	if ((ret = wiredtiger_open(HOME_DIR, NULL, WT_CONFIG, &conn)) != 0){
+		printf("wiredtiger_open failed, ret = %d\n", ret);
+		return 1;
+	}
+
+	if ((ret = create_tables()) != 0){
+		printf("create tables failed, ret = %d\n", ret);
+		goto err;
+	}
+
+	start = bench_now_usec();
+	for (i = 0; i < THREAD_COUNT; i++)
+		pthread_create(&tids[i], NULL, worker, (void *)(uintptr_t)(i + 1));
+	for (i = 0; i < THREAD_COUNT; i++){
+		pthread_join(tids[i], &thread_ret);
+		if (thread_ret != NULL)
+			ret = (int)(intptr_t)thread_ret;
+	}
+
+	printf("%d threads x %d session/cursor opens = %llu us\n", THREAD_COUNT, LOOP_COUNT,
+		(unsigned long long)(bench_now_usec() - start));
+
+err:
+	conn->close(conn, NULL);
+	return ret == 0 ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+#include "bench.h"
+#include <string.h>
+#include <pthread.h>
+
+/*
+ * 在batch_insert的写入模型上对比eviction.compress_threads不同配置时的写入延迟:
+ * cache设置得很小，写线程会被拉去做eviction，reconcile时split block的压缩耗时
+ * 会直接体现在insert的延迟上。每个配置输出insert的tps和延迟分布
+ */
+
+#define HOME_DIR		"WT_COMPRESS_BENCH"
+#define TAB_META		"block_compressor=zlib,key_format=i,value_format=S,internal_page_max=16KB,leaf_page_max=16KB,leaf_value_max=16KB,memory_page_max=2MB"
+#define WT_CONFIG		"create,cache_size=64MB,eviction=(threads_max=4,threads_min=4,compress_threads=%d),extensions=[/usr/local/lib/libwiredtiger_zlib.so],statistics=(fast)"
+
+#define WR_THREAD_NUM	8
+#define COUNT			200000		/*每个写线程写入的记录数*/
+#define LATENCY_BUCKETS	24			/*延迟按2的幂次(us)分桶*/
+
+typedef struct
+{
+	uint32_t start;
+	uint32_t end;
+	uint64_t latency[LATENCY_BUCKETS];
+	uint64_t max_usec;
+}item_t;
+
+static int compress_threads[] = { 0, 2, 4 };
+
+static WT_CONNECTION *conn;
+
+static void* write_thr(void* arg)
+{
+	WT_CURSOR *cursor;
+	WT_SESSION *session;
+	item_t* item = arg;
+	uint64_t start, usec;
+	uint32_t key;
+	char value[1024] = { 0 };
+	int bucket, ret;
+
+	if ((ret = conn->open_session(conn, NULL, "isolation=snapshot", &session)) != 0){
+		printf("open_session failed, ret = %d\n", ret);
+		return NULL;
+	}
+	if ((ret = session->open_cursor(session, "table:mytable", NULL, NULL, &cursor)) != 0){
+		printf("open_cursor failed, ret = %d\n", ret);
+		session->close(session, NULL);
+		return NULL;
+	}
+
+	for (key = item->start; key < item->end; key++){
+		cursor->set_key(cursor, key);
+		sprintf(value, "%uzeyyrgdfgdfg.t66784674446rokwerii939kdd,cgrfkg-@$$$**%u&XXZZamvbzc44k445i0915323/=-d2224===++--dkeiwnd,.,.,aamggnvcxvzczz|<>!-slsdshssrq2934745755mbikdd()!!%uslkweidnziend9*&&7634>>,skseinxslfsienninsdkisdf!!@sflsflsfsdfinzzinf!!!sdfslflsiendndisnziendidnwwwncidsd121232343!!sflskfwwieennsweidnsdifnsdfsdfsddddddfffggjjweneiwebeirrbsl39458745734flsdfzzzn????    ---=-09998776363827373333634.,,mnbbzcueeuee", key, key, key);
+		cursor->set_value(cursor, value);
+
+		start = bench_now_usec();
+		if ((ret = cursor->insert(cursor)) != 0)
+			printf("insert k/v failed, code = %d\n", ret);
+		usec = bench_now_usec() - start;
+
+		for (bucket = 0; bucket < LATENCY_BUCKETS - 1 && (1ULL << bucket) <= usec; bucket++)
+			;
+		item->latency[bucket]++;
+		if (usec > item->max_usec)
+			item->max_usec = usec;
+	}
+
+	cursor->close(cursor);
+	session->close(session, NULL);
+
+	return NULL;
+}
+
+/*返回延迟分布中pct百分位所在分桶的上限(us)*/
+static uint64_t latency_pct(uint64_t* latency, uint64_t total, double pct)
+{
+	uint64_t sum;
+	int i;
+
+	for (i = 0, sum = 0; i < LATENCY_BUCKETS; i++){
+		sum += latency[i];
+		if (sum >= total * pct)
+			return 1ULL << i;
+	}
+
+	return 1ULL << (LATENCY_BUCKETS - 1);
+}
+
+static int bench(int nthreads)
+{
+	WT_SESSION *session;
+	item_t item[WR_THREAD_NUM];
+	pthread_t wids[WR_THREAD_NUM];
+	uint64_t latency[LATENCY_BUCKETS], max_usec, start, usec, total;
+	char config[512];
+	int i, j, ret;
+
+	if ((ret = bench_home(HOME_DIR)) != 0)
+		return ret;
+
+	snprintf(config, sizeof(config), WT_CONFIG, nthreads);
+	if ((ret = wiredtiger_open(HOME_DIR, NULL, config, &conn)) != 0){
+		printf("wiredtiger_open failed, ret = %d\n", ret);
+		return ret;
+	}
+
+	if ((ret = conn->open_session(conn, NULL, NULL, &session)) != 0 ||
+		(ret = session->create(session, "table:mytable", TAB_META)) != 0){
+		printf("create table failed, ret = %d\n", ret);
+		goto err;
+	}
+
+	memset(item, 0, sizeof(item));
+	start = bench_now_usec();
+	for (i = 0; i < WR_THREAD_NUM; i++){
+		item[i].start = i * COUNT;
+		item[i].end = (i + 1) * COUNT;
+		pthread_create(wids + i, NULL, write_thr, &item[i]);
+	}
+	for (i = 0; i < WR_THREAD_NUM; i++)
+		pthread_join(wids[i], NULL);
+	usec = bench_now_usec() - start;
+
+	memset(latency, 0, sizeof(latency));
+	max_usec = 0;
+	for (i = 0; i < WR_THREAD_NUM; i++){
+		for (j = 0; j < LATENCY_BUCKETS; j++)
+			latency[j] += item[i].latency[j];
+		if (item[i].max_usec > max_usec)
+			max_usec = item[i].max_usec;
+	}
+	total = (uint64_t)WR_THREAD_NUM * COUNT;
+
+	printf("compress_threads = %d: insert tps = %llu, p50 < %llu us, p99 < %llu us, p999 < %llu us, max = %llu us\n",
+		nthreads, (unsigned long long)(total * 1000000 / (usec + 1)),
+		(unsigned long long)latency_pct(latency, total, 0.5),
+		(unsigned long long)latency_pct(latency, total, 0.99),
+		(unsigned long long)latency_pct(latency, total, 0.999),
+		(unsigned long long)max_usec);
+
+err:
+	if (conn->close(conn, NULL) != 0){
+		printf("wiredtiger_close failed!\n");
+		ret = -1;
+	}
+	return ret;
+}
+
+int main()
+{
+	size_t i;
+
+	for (i = 0; i < sizeof(compress_threads) / sizeof(compress_threads[0]); i++)
+		if (bench(compress_threads[i]) != 0)
+			return 1;
+
+	return 0;
+}
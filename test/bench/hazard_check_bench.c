@@ -0,0 +1,101 @@
+#include "wt_internal.h"
+#include "bench.h"
+
+/*
+ * eviction检查page的hazard pointer的性能对比: 扫描所有session的hazard array和
+ * 先查connection上的hazard filter计数两种方式，分别在100、1000、5000个session下测试
+ */
+
+#define HOME_DIR		"WT_HAZARD_BENCH"
+#define CHECK_COUNT		100000
+#define PAGE_COUNT		1024
+
+static int session_counts[] = { 100, 1000, 5000 };
+
+/*用来做检查的假page地址，检查只比较地址，不会访问page*/
+static WT_PAGE* pages[PAGE_COUNT];
+
+/*原来的检查方式，扫描所有session的hazard array*/
+static WT_HAZARD* bench_hazard_scan(WT_SESSION_IMPL* session, WT_PAGE* page)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_HAZARD *hp;
+	WT_SESSION_IMPL *s;
+	uint32_t i, hazard_size, session_cnt;
+
+	conn = S2C(session);
+
+	WT_ORDERED_READ(session_cnt, conn->session_cnt);
+	for (s = conn->sessions, i = 0; i < session_cnt; ++s, ++i){
+		if (!s->active)
+			continue;
+
+		WT_ORDERED_READ(hazard_size, s->hazard_size);
+		for (hp = s->hazard; hp < s->hazard + hazard_size; ++hp){
+			if (hp->page == page)
+				return hp;
+		}
+	}
+
+	return NULL;
+}
+
+static int bench_sessions(int nsessions)
+{
+	WT_CONNECTION *conn;
+	WT_SESSION **sessions;
+	WT_SESSION_IMPL *session;
+	uint64_t start, scan_usec, filter_usec;
+	char config[128];
+	int i, found, ret;
+
+	snprintf(config, sizeof(config), "create,session_max=%d", nsessions + 10);
+	if ((ret = wiredtiger_open(HOME_DIR, NULL, config, &conn)) != 0){
+		printf("wiredtiger_open failed, ret = %d\n", ret);
+		return ret;
+	}
+
+	sessions = calloc((size_t)nsessions, sizeof(WT_SESSION *));
+	for (i = 0; i < nsessions; i++){
+		if ((ret = conn->open_session(conn, NULL, NULL, &sessions[i])) != 0){
+			printf("open_session failed, ret = %d\n", ret);
+			goto err;
+		}
+	}
+	session = (WT_SESSION_IMPL *)sessions[0];
+
+	found = 0;
+	start = bench_now_usec();
+	for (i = 0; i < CHECK_COUNT; i++)
+		found += bench_hazard_scan(session, pages[i % PAGE_COUNT]) != NULL;
+	scan_usec = bench_now_usec() - start;
+
+	start = bench_now_usec();
+	for (i = 0; i < CHECK_COUNT; i++)
+		found += __wt_page_hazard_check(session, pages[i % PAGE_COUNT]) != NULL;
+	filter_usec = bench_now_usec() - start;
+
+	printf("%d sessions: scan = %" PRIu64 " us, hazard filter = %" PRIu64 " us, (%d)\n", nsessions, scan_usec, filter_usec, found);
+
+err:
+	free(sessions);
+	conn->close(conn, NULL);
+	return ret;
+}
+
+int main()
+{
+	size_t i;
+
+	if (bench_home(HOME_DIR) != 0)
+		return 1;
+
+	for (i = 0; i < PAGE_COUNT; i++)
+		pages[i] = (WT_PAGE *)(uintptr_t)(0x10000000 + i * 4096);
+
+	for (i = 0; i < sizeof(session_counts) / sizeof(session_counts[0]); i++)
+		if (bench_sessions(session_counts[i]) != 0)
+			return 1;
+
+	return 0;
+}
@@ -0,0 +1,118 @@
+#include "wt_internal.h"
+#include "bench.h"
+
+/*
+ * __wt_lex_compare和__wt_lex_compare_skip不同实现方式的性能对比。
+ * key是24 ~ 64字节的组合字符串，并且有很长的相同前缀，和row search时的key分布类似
+ */
+
+#define KEY_COUNT		4096
+#define KEY_PREFIX		"tenant:000042/collection:orders/"
+#define LOOP_COUNT		2000
+
+typedef struct
+{
+	int			method;
+	const char*	name;
+} method_t;
+
+static method_t methods[] = {
+	{ WT_LEX_COMPARE_BYTE, "byte" },
+	{ WT_LEX_COMPARE_WORD, "word" },
+#if defined(__amd64) || defined(__x86_64) || defined(_M_AMD64)
+	{ WT_LEX_COMPARE_SSE2, "sse2" },
+#endif
+};
+
+static char key_buf[KEY_COUNT][64];
+static WT_ITEM keys[KEY_COUNT];
+
+/*构建有相同前缀的key, key的长度在24 ~ 64字节之间*/
+static void build_keys()
+{
+	size_t len, prefix_len;
+	int i;
+
+	prefix_len = strlen(KEY_PREFIX);
+	for (i = 0; i < KEY_COUNT; i++){
+		len = 24 + (size_t)(rand() % 41);
+		memset(key_buf[i], 'x', sizeof(key_buf[i]));
+		memcpy(key_buf[i], KEY_PREFIX, WT_MIN(len, prefix_len));
+		if (len > prefix_len)
+			snprintf(key_buf[i] + prefix_len, len - prefix_len, "%08d", rand() % 10000);
+
+		keys[i].data = key_buf[i];
+		keys[i].size = len;
+	}
+}
+
+/*以byte方式的结果为准，检查其他比较方式的结果和matchp是否一致*/
+static int check_method(int method)
+{
+	size_t match_byte, match_method;
+	int cmp_byte, cmp_method, i, j;
+
+	for (i = 0; i < KEY_COUNT; i++){
+		j = (i * 7 + 1) % KEY_COUNT;
+		match_byte = match_method = 0;
+
+		__wt_process.lex_compare_method = WT_LEX_COMPARE_BYTE;
+		cmp_byte = __wt_lex_compare(&keys[i], &keys[j]);
+		(void)__wt_lex_compare_skip(&keys[i], &keys[j], &match_byte);
+
+		__wt_process.lex_compare_method = method;
+		cmp_method = __wt_lex_compare(&keys[i], &keys[j]);
+		(void)__wt_lex_compare_skip(&keys[i], &keys[j], &match_method);
+
+		if (cmp_byte != cmp_method || match_byte != match_method)
+			return -1;
+	}
+
+	return 0;
+}
+
+static void bench_method(method_t* m)
+{
+	uint64_t start, compare_usec, skip_usec;
+	size_t match;
+	int i, j, loop, sum;
+
+	__wt_process.lex_compare_method = m->method;
+	sum = 0;
+
+	start = bench_now_usec();
+	for (loop = 0; loop < LOOP_COUNT; loop++)
+		for (i = 0, j = loop % KEY_COUNT; i < KEY_COUNT; i++, j = (j + 1) % KEY_COUNT)
+			sum += __wt_lex_compare(&keys[i], &keys[j]);
+	compare_usec = bench_now_usec() - start;
+
+	start = bench_now_usec();
+	for (loop = 0; loop < LOOP_COUNT; loop++)
+		for (i = 0, j = loop % KEY_COUNT; i < KEY_COUNT; i++, j = (j + 1) % KEY_COUNT){
+			match = 0;
+			sum += __wt_lex_compare_skip(&keys[i], &keys[j], &match);
+		}
+	skip_usec = bench_now_usec() - start;
+
+	printf("%s: lex_compare = %" PRIu64 " us, lex_compare_skip = %" PRIu64 " us, (%d)\n", m->name, compare_usec, skip_usec, sum);
+}
+
+int main()
+{
+	size_t i;
+
+	srand(42);
+	build_keys();
+
+	for (i = 0; i < sizeof(methods) / sizeof(methods[0]); i++){
+		if (check_method(methods[i].method) != 0){
+			printf("%s: result mismatch with byte compare!\n", methods[i].name);
+			return 1;
+		}
+	}
+
+	for (i = 0; i < sizeof(methods) / sizeof(methods[0]); i++)
+		bench_method(&methods[i]);
+
+	return 0;
+}
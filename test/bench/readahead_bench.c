@@ -0,0 +1,130 @@
+#include "bench.h"
+#include <string.h>
+
+/*
+ * 对比read_ahead.threads不同配置时冷cache下全表扫描的耗时: 先写入数据并关闭connection，
+ * 每次重新打开connection后分别用next和prev做一次全表扫描，输出扫描耗时
+ */
+
+#define HOME_DIR		"WT_READAHEAD_BENCH"
+#define TAB_META		"key_format=S,value_format=S,leaf_page_max=16KB"
+#define WT_CONFIG		"cache_size=512MB,read_ahead=(depth=16,threads=%d),statistics=(fast)"
+#define RECORD_COUNT	2000000
+
+static int readahead_threads[] = { 0, 2, 4 };
+
+static int load()
+{
+	WT_CONNECTION *conn;
+	WT_CURSOR *cursor;
+	WT_SESSION *session;
+	char key[32], value[256];
+	int i, ret;
+
+	if (bench_home(HOME_DIR) != 0)
+		return 1;
+	if ((ret = wiredtiger_open(HOME_DIR, NULL, "create", &conn)) != 0){
+		printf("wiredtiger_open failed, ret = %d\n", ret);
+		return ret;
+	}
+
+	if ((ret = conn->open_session(conn, NULL, NULL, &session)) != 0 ||
+		(ret = session->create(session, "table:mytable", TAB_META)) != 0 ||
+		(ret = session->open_cursor(session, "table:mytable", NULL, "bulk", &cursor)) != 0){
+		printf("create table failed, ret = %d\n", ret);
+		goto err;
+	}
+
+	memset(value, 'v', sizeof(value) - 1);
+	value[sizeof(value) - 1] = '\0';
+	for (i = 0; i < RECORD_COUNT; i++){
+		snprintf(key, sizeof(key), "key%010d", i);
+		cursor->set_key(cursor, key);
+		cursor->set_value(cursor, value);
+		if ((ret = cursor->insert(cursor)) != 0){
+			printf("insert k/v failed, ret = %d\n", ret);
+			break;
+		}
+	}
+	cursor->close(cursor);
+
+err:
+	conn->close(conn, NULL);
+	return ret;
+}
+
+/*扫描整张表，返回扫描到的记录数是否正确*/
+static int scan(WT_SESSION* session, int prev, uint64_t* usecp)
+{
+	WT_CURSOR *cursor;
+	uint64_t start;
+	int count, ret;
+
+	if ((ret = session->open_cursor(session, "table:mytable", NULL, NULL, &cursor)) != 0)
+		return ret;
+
+	count = 0;
+	start = bench_now_usec();
+	while ((ret = (prev ? cursor->prev(cursor) : cursor->next(cursor))) == 0)
+		count++;
+	*usecp = bench_now_usec() - start;
+	cursor->close(cursor);
+
+	if (ret != WT_NOTFOUND)
+		return ret;
+	if (count != RECORD_COUNT){
+		printf("scan count mismatch, %d != %d\n", count, RECORD_COUNT);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int bench(int nthreads)
+{
+	WT_CONNECTION *conn;
+	WT_SESSION *session;
+	uint64_t next_usec, prev_usec;
+	char config[256];
+	int ret;
+
+	snprintf(config, sizeof(config), WT_CONFIG, nthreads);
+	conn = NULL;
+
+	/*每个方向都重新打开connection，保证从冷cache开始扫描*/
+	if ((ret = wiredtiger_open(HOME_DIR, NULL, config, &conn)) != 0 ||
+		(ret = conn->open_session(conn, NULL, NULL, &session)) != 0 ||
+		(ret = scan(session, 0, &next_usec)) != 0)
+		goto err;
+	conn->close(conn, NULL);
+	conn = NULL;
+
+	if ((ret = wiredtiger_open(HOME_DIR, NULL, config, &conn)) != 0 ||
+		(ret = conn->open_session(conn, NULL, NULL, &session)) != 0 ||
+		(ret = scan(session, 1, &prev_usec)) != 0)
+		goto err;
+
+	printf("read_ahead threads = %d: next scan = %llu us, prev scan = %llu us\n", nthreads,
+		(unsigned long long)next_usec, (unsigned long long)prev_usec);
+
+err:
+	if (ret != 0)
+		printf("read_ahead threads = %d: scan failed, ret = %d\n", nthreads, ret);
+	if (conn != NULL)
+		conn->close(conn, NULL);
+	return ret;
+}
+
+int main()
+{
+	size_t i;
+
+	if (load() != 0)
+		return 1;
+
+	for (i = 0; i < sizeof(readahead_threads) / sizeof(readahead_threads[0]); i++)
+		if (bench(readahead_threads[i]) != 0)
+			return 1;
+
+	return 0;
+}
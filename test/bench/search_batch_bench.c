@@ -0,0 +1,135 @@
+#include "bench.h"
+#include <string.h>
+
+/*
+ * cursor search_batch的性能测试: 对file:、table:和lsm:三种数据源，用同一组无序的key
+ * 分别做search_batch和逐个search，输出两种方式的耗时。结果的正确性在test/check/search_batch_check.c中检查
+ */
+
+#define HOME_DIR		"WT_SEARCH_BATCH_BENCH"
+#define TAB_META		"key_format=u,value_format=u"
+#define RECORD_COUNT	200000
+#define BATCH_SIZE		500
+#define LOOP_COUNT		200
+
+static const char* uris[] = { "file:batch.wt", "table:batch", "lsm:batch" };
+
+static char key_buf[BATCH_SIZE][32];
+static WT_ITEM keys[BATCH_SIZE];
+static WT_ITEM values[BATCH_SIZE];
+static int results[BATCH_SIZE];
+
+/*只插入偶数的key，奇数的key用来测试找不到的情况*/
+static int load(WT_SESSION* session, const char* uri)
+{
+	WT_CURSOR *cursor;
+	WT_ITEM key, value;
+	char kbuf[32], vbuf[64];
+	int i, ret;
+
+	if ((ret = session->create(session, uri, TAB_META)) != 0 ||
+		(ret = session->open_cursor(session, uri, NULL, "bulk", &cursor)) != 0)
+		return ret;
+
+	for (i = 0; i < RECORD_COUNT; i += 2){
+		key.data = kbuf;
+		key.size = (size_t)snprintf(kbuf, sizeof(kbuf), "key%08d", i);
+		value.data = vbuf;
+		value.size = (size_t)snprintf(vbuf, sizeof(vbuf), "value of %d", i);
+		cursor->set_key(cursor, &key);
+		cursor->set_value(cursor, &value);
+		if ((ret = cursor->insert(cursor)) != 0)
+			break;
+	}
+
+	cursor->close(cursor);
+	return ret;
+}
+
+static void build_keys()
+{
+	int i;
+
+	for (i = 0; i < BATCH_SIZE; i++){
+		keys[i].data = key_buf[i];
+		keys[i].size = (size_t)snprintf(key_buf[i], sizeof(key_buf[i]), "key%08d", rand() % RECORD_COUNT);
+	}
+}
+
+static int bench(WT_SESSION* session, const char* uri)
+{
+	WT_CURSOR *cursor;
+	WT_ITEM value;
+	uint64_t start, batch_usec, single_usec;
+	int found, i, loop, ret;
+
+	if ((ret = session->open_cursor(session, uri, NULL, "raw", &cursor)) != 0)
+		return ret;
+
+	build_keys();
+
+	found = 0;
+	start = bench_now_usec();
+	for (loop = 0; loop < LOOP_COUNT; loop++){
+		if ((ret = cursor->search_batch(cursor, BATCH_SIZE, keys, values, results)) != 0)
+			goto err;
+		for (i = 0; i < BATCH_SIZE; i++)
+			found += results[i] == 0;
+	}
+	batch_usec = bench_now_usec() - start;
+
+	start = bench_now_usec();
+	for (loop = 0; loop < LOOP_COUNT; loop++){
+		for (i = 0; i < BATCH_SIZE; i++){
+			cursor->set_key(cursor, &keys[i]);
+			if ((ret = cursor->search(cursor)) == 0 && (ret = cursor->get_value(cursor, &value)) == 0)
+				found++;
+			else if (ret != WT_NOTFOUND)
+				goto err;
+		}
+		cursor->reset(cursor);
+	}
+	single_usec = bench_now_usec() - start;
+	ret = 0;
+
+	printf("%s: search_batch = %llu us, search = %llu us, (%d)\n", uri,
+		(unsigned long long)batch_usec, (unsigned long long)single_usec, found);
+
+err:
+	cursor->close(cursor);
+	return ret;
+}
+
+int main()
+{
+	WT_CONNECTION *conn;
+	WT_SESSION *session;
+	size_t i;
+	int ret;
+
+	if (bench_home(HOME_DIR) != 0)
+		return 1;
+	srand(42);
+
+	if ((ret = wiredtiger_open(HOME_DIR, NULL, "create,cache_size=256MB", &conn)) != 0){
+		printf("wiredtiger_open failed, ret = %d\n", ret);
+		return 1;
+	}
+	if ((ret = conn->open_session(conn, NULL, NULL, &session)) != 0){
+		printf("open_session failed, ret = %d\n", ret);
+		goto err;
+	}
+
+	for (i = 0; i < sizeof(uris) / sizeof(uris[0]); i++){
+		if ((ret = load(session, uris[i])) != 0){
+			printf("%s: load failed, ret = %d\n", uris[i], ret);
+			goto err;
+		}
+		if ((ret = bench(session, uris[i])) != 0)
+			goto err;
+	}
+
+err:
+	conn->close(conn, NULL);
+	return ret == 0 ? 0 : 1;
+}
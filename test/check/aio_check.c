@@ -0,0 +1,123 @@
+#include "wt_internal.h"
+#include "check.h"
+
+/*
+ * io_uring请求的行为测试: 正常的读写、读到文件末尾的短读、无效fd的错误返回，以及io_uring
+ * 出错以后等待者自己消费完成队列，在请求完成之前不会返回。内核不支持io_uring时只检查同步I/O
+ */
+
+#define HOME_DIR		"WT_AIO_CHECK"
+#define WT_CONFIG		"create,statistics=(fast),io_uring=(enabled=true,queue_depth=64)"
+#define BUF_SIZE		4096
+#define REQ_COUNT		8
+
+static uint8_t wbuf[REQ_COUNT][BUF_SIZE];
+static uint8_t rbuf[REQ_COUNT][BUF_SIZE];
+
+static void fill(void)
+{
+	int i;
+
+	for (i = 0; i < REQ_COUNT; i++)
+		memset(wbuf[i], 'a' + i, BUF_SIZE);
+	memset(rbuf, 0, sizeof(rbuf));
+}
+
+/*写入REQ_COUNT个block再读回来检查*/
+static void check_rw(WT_SESSION_IMPL* session, WT_FH* fh)
+{
+	WT_AIO_REQ reqs[REQ_COUNT];
+	int i;
+
+	fill();
+	for (i = 0; i < REQ_COUNT; i++)
+		CHECK_OK(__wt_aio_submit(session, &reqs[i], fh, 1, (wt_off_t)i * BUF_SIZE, BUF_SIZE, wbuf[i]));
+	for (i = 0; i < REQ_COUNT; i++)
+		CHECK_OK(__wt_aio_wait(session, &reqs[i]));
+
+	for (i = 0; i < REQ_COUNT; i++)
+		CHECK_OK(__wt_aio_submit(session, &reqs[i], fh, 0, (wt_off_t)i * BUF_SIZE, BUF_SIZE, rbuf[i]));
+	for (i = 0; i < REQ_COUNT; i++){
+		CHECK_OK(__wt_aio_wait(session, &reqs[i]));
+		CHECK(reqs[i].done);
+		CHECK(memcmp(rbuf[i], wbuf[i], BUF_SIZE) == 0);
+	}
+}
+
+/*读到文件末尾以后的部分用同步I/O补齐，同步读也读不到数据时返回错误*/
+static void check_short_read(WT_SESSION_IMPL* session, WT_FH* fh)
+{
+	WT_AIO_REQ req;
+
+	if (__wt_aio_submit(session, &req, fh, 0, (wt_off_t)(REQ_COUNT - 1) * BUF_SIZE, 2 * BUF_SIZE, rbuf[0]) == 0)
+		CHECK(__wt_aio_wait(session, &req) != 0);
+	CHECK(req.done);
+}
+
+/*无效的fd，错误码从完成队列或者同步I/O返回*/
+static void check_bad_fd(WT_SESSION_IMPL* session, WT_FH* fh)
+{
+	WT_AIO_REQ req;
+	WT_FH bad;
+
+	bad = *fh;
+	bad.fd = -1;
+	if (__wt_aio_submit(session, &req, &bad, 0, 0, BUF_SIZE, rbuf[0]) == 0)
+		CHECK_RET(__wt_aio_wait(session, &req), EBADF);
+	CHECK(req.done);
+}
+
+/*io_uring出错以后已经提交的请求由等待者消费完成队列，返回时请求一定已经完成，新的请求走同步I/O*/
+static void check_broken(WT_SESSION_IMPL* session, WT_SESSION* wt_session, WT_FH* fh)
+{
+	WT_AIO *aio;
+	WT_AIO_REQ reqs[REQ_COUNT];
+	uint64_t sync;
+	int i;
+
+	aio = S2C(session)->aio;
+	memset(rbuf, 0, sizeof(rbuf));
+	for (i = 0; i < REQ_COUNT; i++)
+		CHECK_OK(__wt_aio_submit(session, &reqs[i], fh, 0, (wt_off_t)i * BUF_SIZE, BUF_SIZE, rbuf[i]));
+
+	aio->broken = 1;
+	for (i = 0; i < REQ_COUNT; i++){
+		CHECK_OK(__wt_aio_wait(session, &reqs[i]));
+		CHECK(reqs[i].done);
+		CHECK(memcmp(rbuf[i], wbuf[i], BUF_SIZE) == 0);
+	}
+	CHECK(aio->inflight == 0);
+
+	sync = check_get_stat(wt_session, WT_STAT_CONN_AIO_SYNC);
+	CHECK_OK(__wt_aio_submit(session, &reqs[0], fh, 0, 0, BUF_SIZE, rbuf[0]));
+	CHECK(reqs[0].done);
+	CHECK_OK(__wt_aio_wait(session, &reqs[0]));
+	CHECK(check_get_stat(wt_session, WT_STAT_CONN_AIO_SYNC) == sync + 1);
+}
+
+int main()
+{
+	WT_CONNECTION *conn;
+	WT_FH *fh;
+	WT_SESSION *wt_session;
+	WT_SESSION_IMPL *session;
+
+	check_home(HOME_DIR);
+	CHECK_OK(wiredtiger_open(HOME_DIR, NULL, WT_CONFIG, &conn));
+	CHECK_OK(conn->open_session(conn, NULL, NULL, &wt_session));
+	session = (WT_SESSION_IMPL *)wt_session;
+
+	CHECK_OK(__wt_open(session, "aio_check.dat", 1, 0, WT_FILE_TYPE_DATA, &fh));
+
+	check_rw(session, fh);
+	check_short_read(session, fh);
+	check_bad_fd(session, fh);
+	if (S2C(session)->aio != NULL)
+		check_broken(session, wt_session, fh);
+	else
+		printf("io_uring is not available, only synchronous I/O was checked\n");
+
+	CHECK_OK(__wt_close(session, &fh));
+	CHECK_OK(conn->close(conn, NULL));
+	return 0;
+}
@@ -0,0 +1,198 @@
+#include "check.h"
+#include <errno.h>
+#include <sched.h>
+#include <string.h>
+
+/*
+ * async_batch的行为测试: batch在worker中按key排序执行，同一个key上的多个操作必须按提交的顺序执行，
+ * 结果写回调用者数组中对应的位置。batch中的操作出错或者notify_batch返回非0时整个batch被回滚
+ */
+
+#define HOME_DIR		"WT_ASYNC_BATCH_CHECK"
+#define TAB_META		"key_format=u,value_format=u"
+#define WT_CONFIG		"create,async=(enabled=true,ops_max=16,threads=2)"
+#define BATCH_SIZE		1000
+#define KEY_COUNT		10
+
+static WT_CONNECTION* conn;
+static WT_ASYNC_BATCH_OP ops[BATCH_SIZE];
+static char keys[BATCH_SIZE][16];
+static char values[BATCH_SIZE][16];
+static char expect[BATCH_SIZE][16];		/*search期望的value，空字符串表示期望WT_NOTFOUND*/
+
+static volatile int batch_done, batch_ret, notify_ret;
+static volatile uint32_t batch_nops;
+static WT_ASYNC_BATCH_OP* volatile batch_ops;
+
+static int notify_batch(WT_ASYNC_CALLBACK* cb, WT_ASYNC_BATCH_OP* bops, uint32_t nops, int ret)
+{
+	(void)cb;
+
+	batch_ops = bops;
+	batch_nops = nops;
+	batch_ret = ret;
+	__sync_synchronize();
+	batch_done = 1;
+	return notify_ret;
+}
+
+static WT_ASYNC_CALLBACK callback = { NULL, notify_batch };
+
+static void set_op(int i, WT_ASYNC_OPTYPE optype, const char* key, const char* value)
+{
+	memset(&ops[i], 0, sizeof(ops[i]));
+	ops[i].optype = optype;
+	snprintf(keys[i], sizeof(keys[i]), "%s", key);
+	ops[i].key.data = keys[i];
+	ops[i].key.size = strlen(keys[i]);
+	if (value != NULL){
+		snprintf(values[i], sizeof(values[i]), "%s", value);
+		ops[i].value.data = values[i];
+		ops[i].value.size = strlen(values[i]);
+	}
+}
+
+/*提交一个batch并等到notify_batch被调用，返回batch的执行结果*/
+static int run_batch(const char* config, uint32_t nops)
+{
+	int ret;
+
+	batch_done = 0;
+	while ((ret = conn->async_batch(conn, "table:batch", config, &callback, ops, nops)) == EBUSY)
+		sched_yield();
+	CHECK_OK(ret);
+	CHECK_OK(conn->async_flush(conn));
+
+	CHECK(batch_done);
+	CHECK(batch_ops == ops);
+	CHECK(batch_nops == nops);
+	return batch_ret;
+}
+
+/*value为NULL时检查key不存在*/
+static void check_value(WT_SESSION* session, const char* key, const char* value)
+{
+	WT_CURSOR *cursor;
+	WT_ITEM k, v;
+
+	CHECK_OK(session->open_cursor(session, "table:batch", NULL, NULL, &cursor));
+	k.data = key;
+	k.size = strlen(key);
+	cursor->set_key(cursor, &k);
+	if (value == NULL)
+		CHECK_RET(cursor->search(cursor), WT_NOTFOUND);
+	else{
+		CHECK_OK(cursor->search(cursor));
+		CHECK_OK(cursor->get_value(cursor, &v));
+		CHECK(v.size == strlen(value) && memcmp(v.data, value, v.size) == 0);
+	}
+	CHECK_OK(cursor->close(cursor));
+}
+
+/*少量key上交错的insert/update/remove/search，每个key上的操作按提交顺序执行*/
+static void check_order(WT_SESSION* session)
+{
+	char key[16], last[KEY_COUNT][16], value[16];
+	int i, k;
+
+	memset(last, 0, sizeof(last));
+	srand(42);
+	for (i = 0; i < BATCH_SIZE; i++){
+		k = rand() % KEY_COUNT;
+		snprintf(key, sizeof(key), "k%02d", KEY_COUNT - k);
+		switch (rand() % 4){
+		case 0:
+			snprintf(value, sizeof(value), "v%d", i);
+			set_op(i, WT_AOP_INSERT, key, value);
+			snprintf(last[k], sizeof(last[k]), "%s", value);
+			break;
+		case 1:
+			snprintf(value, sizeof(value), "u%d", i);
+			set_op(i, WT_AOP_UPDATE, key, value);
+			snprintf(last[k], sizeof(last[k]), "%s", value);
+			break;
+		case 2:
+			set_op(i, WT_AOP_REMOVE, key, NULL);
+			last[k][0] = '\0';
+			break;
+		default:
+			set_op(i, WT_AOP_SEARCH, key, NULL);
+			snprintf(expect[i], sizeof(expect[i]), "%s", last[k]);
+			break;
+		}
+	}
+
+	CHECK_OK(run_batch(NULL, BATCH_SIZE));
+
+	/*结果写回提交时的位置*/
+	for (i = 0; i < BATCH_SIZE; i++){
+		CHECK(ops[i].key.data == keys[i]);
+		if (ops[i].optype == WT_AOP_SEARCH){
+			if (expect[i][0] == '\0')
+				CHECK(ops[i].ret == WT_NOTFOUND);
+			else{
+				CHECK(ops[i].ret == 0);
+				CHECK(ops[i].value.size == strlen(expect[i]) && memcmp(ops[i].value.data, expect[i], ops[i].value.size) == 0);
+			}
+		}
+		else if (ops[i].optype == WT_AOP_REMOVE)
+			CHECK(ops[i].ret == 0 || ops[i].ret == WT_NOTFOUND);
+		else
+			CHECK(ops[i].ret == 0);
+	}
+
+	for (k = 0; k < KEY_COUNT; k++){
+		snprintf(key, sizeof(key), "k%02d", KEY_COUNT - k);
+		check_value(session, key, last[k][0] == '\0' ? NULL : last[k]);
+	}
+}
+
+/*notify_batch返回非0时整个batch被回滚*/
+static void check_callback_rollback(WT_SESSION* session)
+{
+	set_op(0, WT_AOP_INSERT, "r1", "v1");
+	set_op(1, WT_AOP_INSERT, "r0", "v0");
+
+	notify_ret = -1;
+	CHECK_OK(run_batch(NULL, 2));
+	notify_ret = 0;
+
+	CHECK(ops[0].ret == 0 && ops[1].ret == 0);
+	check_value(session, "r0", NULL);
+	check_value(session, "r1", NULL);
+}
+
+/*一个操作出错时停止执行并回滚整个batch*/
+static void check_error_rollback(WT_SESSION* session)
+{
+	set_op(0, WT_AOP_INSERT, "e1", "v1");
+	set_op(1, WT_AOP_INSERT, "e0", "v0");
+	set_op(2, WT_AOP_INSERT, "e0", "dup");
+
+	CHECK_RET(run_batch("overwrite=false", 3), WT_DUPLICATE_KEY);
+	CHECK(ops[1].ret == 0);
+	CHECK(ops[2].ret == WT_DUPLICATE_KEY);
+	check_value(session, "e0", NULL);
+	check_value(session, "e1", NULL);
+}
+
+int main()
+{
+	WT_SESSION *session;
+
+	check_home(HOME_DIR);
+	CHECK_OK(wiredtiger_open(HOME_DIR, NULL, WT_CONFIG, &conn));
+	CHECK_OK(conn->open_session(conn, NULL, NULL, &session));
+	CHECK_OK(session->create(session, "table:batch", TAB_META));
+
+	check_order(session);
+	check_callback_rollback(session);
+	check_error_rollback(session);
+
+	/*batch中不支持compact*/
+	set_op(0, WT_AOP_COMPACT, "c", NULL);
+	CHECK(conn->async_batch(conn, "table:batch", NULL, &callback, ops, 1) != 0);
+
+	CHECK_OK(conn->close(conn, NULL));
+	return 0;
+}
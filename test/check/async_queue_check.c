@@ -0,0 +1,169 @@
+#include "check.h"
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+/*
+ * async队列的行为测试: 多个线程同时提交async insert，flush以后每个op都已经完成并且数据都已经写入，
+ * async search返回正确的value。reconfigure不能超过threads_max，调整worker数量以后队列仍然正常工作。
+ * 排队延迟的最大值不小于p99，清除统计信息以后延迟统计从0开始
+ */
+
+#define HOME_DIR		"WT_ASYNC_QUEUE_CHECK"
+#define TAB_META		"key_format=q,value_format=S"
+#define WT_CONFIG		"create,statistics=(fast),async=(enabled=true,ops_max=256,threads=2,threads_max=8)"
+#define THREAD_COUNT	4
+#define OP_COUNT		5000
+
+static WT_CONNECTION* conn;
+static volatile uint64_t completed, failed, found;
+
+static int notify(WT_ASYNC_CALLBACK* cb, WT_ASYNC_OP* op, int op_ret, uint32_t flags)
+{
+	const char *value;
+	char expect[32];
+	int64_t key;
+
+	(void)cb;
+	(void)flags;
+
+	if (op_ret != 0)
+		__sync_add_and_fetch(&failed, 1);
+	else if (op->get_type(op) == WT_AOP_SEARCH){
+		if (op->get_key(op, &key) != 0 || op->get_value(op, &value) != 0)
+			__sync_add_and_fetch(&failed, 1);
+		else{
+			snprintf(expect, sizeof(expect), "v%lld", (long long)key);
+			if (strcmp(value, expect) == 0)
+				__sync_add_and_fetch(&found, 1);
+			else
+				__sync_add_and_fetch(&failed, 1);
+		}
+	}
+	__sync_add_and_fetch(&completed, 1);
+	return 0;
+}
+
+static WT_ASYNC_CALLBACK callback = { notify };
+
+/*op池用完时等待worker释放*/
+static WT_ASYNC_OP* new_op()
+{
+	WT_ASYNC_OP *op;
+	int ret;
+
+	while ((ret = conn->async_new_op(conn, "table:async", NULL, &callback, &op)) == EBUSY)
+		sched_yield();
+	CHECK_OK(ret);
+	return op;
+}
+
+static void* producer(void* arg)
+{
+	WT_ASYNC_OP *op;
+	char value[32];
+	int64_t base, i;
+
+	base = (int64_t)(uintptr_t)arg;
+	for (i = base; i < base + OP_COUNT; i++){
+		op = new_op();
+		snprintf(value, sizeof(value), "v%lld", (long long)i);
+		op->set_key(op, i);
+		op->set_value(op, value);
+		CHECK_OK(op->insert(op));
+	}
+
+	return NULL;
+}
+
+/*THREAD_COUNT个线程提交insert，flush以后用cursor和async search检查结果*/
+static void run(WT_SESSION* session, int64_t base)
+{
+	WT_ASYNC_OP *op;
+	WT_CURSOR *cursor;
+	pthread_t tids[THREAD_COUNT];
+	const char *value;
+	char expect[32];
+	int64_t i, total;
+	int t;
+
+	completed = failed = found = 0;
+	total = (int64_t)THREAD_COUNT * OP_COUNT;
+
+	for (t = 0; t < THREAD_COUNT; t++)
+		CHECK(pthread_create(&tids[t], NULL, producer, (void *)(uintptr_t)(base + (int64_t)t * OP_COUNT)) == 0);
+	for (t = 0; t < THREAD_COUNT; t++)
+		CHECK(pthread_join(tids[t], NULL) == 0);
+
+	CHECK_OK(conn->async_flush(conn));
+	CHECK(completed == (uint64_t)total);
+	CHECK(failed == 0);
+
+	CHECK_OK(session->open_cursor(session, "table:async", NULL, NULL, &cursor));
+	for (i = base; i < base + total; i++){
+		snprintf(expect, sizeof(expect), "v%lld", (long long)i);
+		cursor->set_key(cursor, i);
+		CHECK_OK(cursor->search(cursor));
+		CHECK_OK(cursor->get_value(cursor, &value));
+		CHECK(strcmp(value, expect) == 0);
+	}
+	CHECK_OK(cursor->close(cursor));
+
+	completed = 0;
+	for (i = base; i < base + total; i += 7){
+		op = new_op();
+		op->set_key(op, i);
+		CHECK_OK(op->search(op));
+	}
+	CHECK_OK(conn->async_flush(conn));
+	CHECK(failed == 0);
+	CHECK(found == completed);
+	CHECK(found == (uint64_t)((total + 6) / 7));
+}
+
+/*读取并清除connection统计信息中的排队延迟*/
+static void latency_clear(WT_SESSION* session, uint64_t* p99p, uint64_t* maxp)
+{
+	WT_CURSOR *cursor;
+	const char *desc, *pvalue;
+
+	CHECK_OK(session->open_cursor(session, "statistics:", NULL, "statistics=(fast,clear)", &cursor));
+	cursor->set_key(cursor, WT_STAT_CONN_ASYNC_QUEUE_LATENCY_P99);
+	CHECK_OK(cursor->search(cursor));
+	CHECK_OK(cursor->get_value(cursor, &desc, &pvalue, p99p));
+	cursor->set_key(cursor, WT_STAT_CONN_ASYNC_QUEUE_LATENCY_MAX);
+	CHECK_OK(cursor->search(cursor));
+	CHECK_OK(cursor->get_value(cursor, &desc, &pvalue, maxp));
+	CHECK_OK(cursor->close(cursor));
+}
+
+int main()
+{
+	uint64_t max, p99;
+	WT_SESSION *session;
+
+	check_home(HOME_DIR);
+	CHECK_OK(wiredtiger_open(HOME_DIR, NULL, WT_CONFIG, &conn));
+	CHECK_OK(conn->open_session(conn, NULL, NULL, &session));
+	CHECK_OK(session->create(session, "table:async", TAB_META));
+
+	run(session, 0);
+
+	/*p99是直方图桶的上界，真实的最大值最多比它小一个桶*/
+	latency_clear(session, &p99, &max);
+	CHECK(max >= p99 / 2);
+	latency_clear(session, &p99, &max);
+	CHECK(p99 == 0 && max == 0);
+
+	/*worker数量不能超过threads_max*/
+	CHECK(conn->reconfigure(conn, "async=(enabled=true,threads=9)") != 0);
+	CHECK_OK(conn->reconfigure(conn, "async=(enabled=true,threads=8)"));
+	run(session, (int64_t)THREAD_COUNT * OP_COUNT);
+
+	CHECK_OK(conn->reconfigure(conn, "async=(enabled=true,threads=1)"));
+	run(session, (int64_t)2 * THREAD_COUNT * OP_COUNT);
+
+	CHECK_OK(conn->close(conn, NULL));
+	return 0;
+}
@@ -0,0 +1,58 @@
+#ifndef __CHECK_H_
+#define __CHECK_H_
+
+/*
+ * test/check中行为测试共用的断言和工具函数。每个测试是一个独立的程序，由ctest运行，
+ * 检查失败时输出失败的位置并以非0退出
+ */
+
+#include "wiredtiger.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(cond) do {														\
+	if (!(cond)){																\
+		fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);\
+		exit(1);																\
+	}																			\
+} while (0)
+
+/*call必须返回expect*/
+#define CHECK_RET(call, expect) do {											\
+	int __check_ret = (call);													\
+	if (__check_ret != (expect)){												\
+		fprintf(stderr, "%s:%d: %s returned %d (%s), expected %d\n",			\
+			__FILE__, __LINE__, #call, __check_ret,								\
+			wiredtiger_strerror(__check_ret), (expect));						\
+		exit(1);																\
+	}																			\
+} while (0)
+
+#define CHECK_OK(call)		CHECK_RET(call, 0)
+
+/*清空并重新创建测试的数据目录*/
+static inline void check_home(const char* home)
+{
+	char cmd[512];
+
+	snprintf(cmd, sizeof(cmd), "rm -rf %s && mkdir %s", home, home);
+	CHECK(system(cmd) == 0);
+}
+
+/*从statistics cursor中读取一个统计项*/
+static inline uint64_t check_get_stat(WT_SESSION* session, int key)
+{
+	WT_CURSOR *cursor;
+	const char *desc, *pvalue;
+	uint64_t value;
+
+	CHECK_OK(session->open_cursor(session, "statistics:", NULL, NULL, &cursor));
+	cursor->set_key(cursor, key);
+	CHECK_OK(cursor->search(cursor));
+	CHECK_OK(cursor->get_value(cursor, &desc, &pvalue, &value));
+	CHECK_OK(cursor->close(cursor));
+	return value;
+}
+
+#endif
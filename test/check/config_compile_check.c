@@ -0,0 +1,99 @@
+#include "check.h"
+#include <string.h>
+
+/*
+ * 预编译配置handle的行为测试: handle是配置字符串的拷贝并且在connection关闭前一直有效，
+ * 同一个配置重复编译返回同一个handle，大量不同的配置都能编译成功，handle不能用于其他方法
+ */
+
+#define HOME_DIR		"WT_CONFIG_COMPILE_CHECK"
+#define TAB_META		"key_format=q,value_format=S"
+#define HANDLE_COUNT	20000
+
+static const char* handles[HANDLE_COUNT];
+
+/*配置字符串的内存被修改以后handle仍然有效*/
+static void check_copy(WT_CONNECTION* conn, WT_SESSION* session)
+{
+	WT_CURSOR *cursor;
+	const char *cursor_cfg;
+	char buf[64];
+
+	snprintf(buf, sizeof(buf), "overwrite=false");
+	CHECK_OK(conn->compile_configuration(conn, "session.open_cursor", buf, &cursor_cfg));
+	CHECK(cursor_cfg != buf && strcmp(cursor_cfg, "overwrite=false") == 0);
+	snprintf(buf, sizeof(buf), "overwrite=true ");
+
+	CHECK_OK(session->open_cursor(session, "table:mytable", NULL, cursor_cfg, &cursor));
+	cursor->set_key(cursor, (int64_t)1);
+	cursor->set_value(cursor, "value");
+	CHECK_OK(cursor->insert(cursor));
+	cursor->set_key(cursor, (int64_t)1);
+	cursor->set_value(cursor, "value");
+	CHECK_RET(cursor->insert(cursor), WT_DUPLICATE_KEY);
+	CHECK_OK(cursor->close(cursor));
+
+	/*handle为open_cursor编译，不能用于begin_transaction*/
+	CHECK(session->begin_transaction(session, cursor_cfg) != 0);
+}
+
+/*大量不同的配置都能编译，编译过的配置重复编译返回同一个handle*/
+static void check_many(WT_CONNECTION* conn, WT_SESSION* session)
+{
+	const char *handle;
+	char buf[64];
+	int i;
+
+	for (i = 0; i < HANDLE_COUNT; i++){
+		snprintf(buf, sizeof(buf), "isolation=snapshot,name=txn%d", i);
+		CHECK_OK(conn->compile_configuration(conn, "session.begin_transaction", buf, &handles[i]));
+		CHECK(strcmp(handles[i], buf) == 0);
+	}
+
+	for (i = 0; i < HANDLE_COUNT; i++){
+		snprintf(buf, sizeof(buf), "isolation=snapshot,name=txn%d", i);
+		CHECK_OK(conn->compile_configuration(conn, "session.begin_transaction", buf, &handle));
+		CHECK(handle == handles[i]);
+	}
+
+	/*最早编译的handle仍然可以使用*/
+	for (i = 0; i < HANDLE_COUNT; i += HANDLE_COUNT / 10){
+		CHECK_OK(session->begin_transaction(session, handles[i]));
+		CHECK_OK(session->commit_transaction(session, NULL));
+	}
+}
+
+static void check_invalid(WT_CONNECTION* conn)
+{
+	const char *handle;
+
+	CHECK(conn->compile_configuration(conn, "session.begin_transaction", "isolation=bad", &handle) != 0);
+	CHECK(conn->compile_configuration(conn, "session.begin_transaction", "priority=1000", &handle) != 0);
+	CHECK(conn->compile_configuration(conn, "session.no_such_method", "", &handle) != 0);
+	CHECK(conn->compile_configuration(conn, "session.begin_transaction", NULL, &handle) != 0);
+}
+
+int main()
+{
+	WT_CONNECTION *conn;
+	WT_SESSION *session;
+	int loop;
+
+	check_home(HOME_DIR);
+
+	/*connection关闭时释放所有的handle，重新打开以后可以再次编译*/
+	for (loop = 0; loop < 2; loop++){
+		CHECK_OK(wiredtiger_open(HOME_DIR, NULL, "create", &conn));
+		CHECK_OK(conn->open_session(conn, NULL, NULL, &session));
+		CHECK_OK(session->drop(session, "table:mytable", "force"));
+		CHECK_OK(session->create(session, "table:mytable", TAB_META));
+
+		check_copy(conn, session);
+		check_many(conn, session);
+		check_invalid(conn);
+
+		CHECK_OK(conn->close(conn, NULL));
+	}
+
+	return 0;
+}
@@ -0,0 +1,145 @@
+#include "check.h"
+#include <string.h>
+
+/*
+ * session cursor cache的行为测试: 关闭的cursor被同样的uri和配置重用，重用的cursor已经被重置
+ * 并恢复打开时的配置，cache中的cursor不阻塞drop和verify，drop或者btree重新打开以后不会重用旧的cursor
+ */
+
+#define HOME_DIR		"WT_CURSOR_CACHE_CHECK"
+#define TAB_META		"key_format=q,value_format=S"
+#define WT_CONFIG		"create,session_cursor_cache=%d,statistics=(fast)"
+#define RECORD_COUNT	100
+
+static const char* uris[] = { "table:orders", "file:items.wt" };
+
+static void load(WT_SESSION* session, const char* uri)
+{
+	WT_CURSOR *cursor;
+	int64_t i;
+
+	CHECK_OK(session->create(session, uri, TAB_META));
+	CHECK_OK(session->open_cursor(session, uri, NULL, NULL, &cursor));
+	for (i = 0; i < RECORD_COUNT; i++){
+		cursor->set_key(cursor, i);
+		cursor->set_value(cursor, "value");
+		CHECK_OK(cursor->insert(cursor));
+	}
+	CHECK_OK(cursor->close(cursor));
+}
+
+/*同样的uri和配置重用关闭的cursor，不同的配置不能重用*/
+static void check_reuse(WT_SESSION* session, const char* uri)
+{
+	WT_CURSOR *cursor, *first;
+	const char *value;
+	int64_t key;
+	uint64_t hit, miss;
+
+	CHECK_OK(session->open_cursor(session, uri, NULL, "overwrite=false", &first));
+	first->set_key(first, (int64_t)10);
+	CHECK_OK(first->search(first));
+	CHECK_OK(first->close(first));
+
+	hit = check_get_stat(session, WT_STAT_CONN_CURSOR_CACHE_HIT);
+	CHECK_OK(session->open_cursor(session, uri, NULL, "overwrite=false", &cursor));
+	CHECK(cursor == first);
+	CHECK(check_get_stat(session, WT_STAT_CONN_CURSOR_CACHE_HIT) == hit + 1);
+
+	/*重用的cursor已经被重置，next从第一个key开始*/
+	CHECK_OK(cursor->next(cursor));
+	CHECK_OK(cursor->get_key(cursor, &key));
+	CHECK(key == 0);
+	CHECK_OK(cursor->get_value(cursor, &value));
+	CHECK(strcmp(value, "value") == 0);
+
+	/*恢复打开时的overwrite=false*/
+	cursor->set_key(cursor, (int64_t)1);
+	cursor->set_value(cursor, "other");
+	CHECK_RET(cursor->insert(cursor), WT_DUPLICATE_KEY);
+	CHECK_OK(cursor->close(cursor));
+
+	/*配置不同不能重用overwrite=false的cursor*/
+	miss = check_get_stat(session, WT_STAT_CONN_CURSOR_CACHE_MISS);
+	CHECK_OK(session->open_cursor(session, uri, NULL, NULL, &cursor));
+	CHECK(check_get_stat(session, WT_STAT_CONN_CURSOR_CACHE_MISS) == miss + 1);
+	cursor->set_key(cursor, (int64_t)1);
+	cursor->set_value(cursor, "value");
+	CHECK_OK(cursor->insert(cursor));
+	CHECK_OK(cursor->close(cursor));
+}
+
+/*cache中的cursor不持有btree，verify可以独占打开btree，之后不能重用verify之前的cursor*/
+static void check_verify(WT_SESSION* session, const char* uri)
+{
+	WT_CURSOR *cursor;
+
+	CHECK_OK(session->open_cursor(session, uri, NULL, NULL, &cursor));
+	CHECK_OK(cursor->close(cursor));
+	CHECK_OK(session->verify(session, uri, NULL));
+
+	CHECK_OK(session->open_cursor(session, uri, NULL, NULL, &cursor));
+	cursor->set_key(cursor, (int64_t)(RECORD_COUNT - 1));
+	CHECK_OK(cursor->search(cursor));
+	CHECK_OK(cursor->close(cursor));
+}
+
+/*cache中的cursor不阻塞drop，drop后重新创建的同名对象不能读到旧的数据*/
+static void check_drop(WT_SESSION* session, const char* uri)
+{
+	WT_CURSOR *cursor;
+	uint64_t hit;
+
+	CHECK_OK(session->open_cursor(session, uri, NULL, NULL, &cursor));
+	CHECK_OK(cursor->close(cursor));
+	CHECK_OK(session->drop(session, uri, NULL));
+
+	CHECK_OK(session->create(session, uri, TAB_META));
+	hit = check_get_stat(session, WT_STAT_CONN_CURSOR_CACHE_HIT);
+	CHECK_OK(session->open_cursor(session, uri, NULL, NULL, &cursor));
+	CHECK(check_get_stat(session, WT_STAT_CONN_CURSOR_CACHE_HIT) == hit);
+	cursor->set_key(cursor, (int64_t)1);
+	CHECK_RET(cursor->search(cursor), WT_NOTFOUND);
+	CHECK_RET(cursor->next(cursor), WT_NOTFOUND);
+	cursor->set_key(cursor, (int64_t)1);
+	cursor->set_value(cursor, "new");
+	CHECK_OK(cursor->insert(cursor));
+	CHECK_OK(cursor->close(cursor));
+
+	CHECK_OK(session->drop(session, uri, NULL));
+}
+
+static void check_cache(int cache_size)
+{
+	WT_CONNECTION *conn;
+	WT_SESSION *session;
+	char config[128];
+	size_t i;
+
+	check_home(HOME_DIR);
+	snprintf(config, sizeof(config), WT_CONFIG, cache_size);
+	CHECK_OK(wiredtiger_open(HOME_DIR, NULL, config, &conn));
+	CHECK_OK(conn->open_session(conn, NULL, NULL, &session));
+
+	for (i = 0; i < sizeof(uris) / sizeof(uris[0]); i++){
+		load(session, uris[i]);
+		if (cache_size != 0)
+			check_reuse(session, uris[i]);
+		check_verify(session, uris[i]);
+		check_drop(session, uris[i]);
+	}
+
+	if (cache_size == 0)
+		CHECK(check_get_stat(session, WT_STAT_CONN_CURSOR_CACHE_HIT) == 0);
+
+	/*关闭session和connection时释放cache中的cursor*/
+	CHECK_OK(session->close(session, NULL));
+	CHECK_OK(conn->close(conn, NULL));
+}
+
+int main()
+{
+	check_cache(0);
+	check_cache(32);
+	return 0;
+}
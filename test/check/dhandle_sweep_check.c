@@ -0,0 +1,98 @@
+#include "check.h"
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * 无锁的dhandle查找和sweep并发的行为测试: 多个线程反复打开短生命周期的session，在表上
+ * open cursor并检查查到的数据属于这张表。线程轮流使用一半的表，另一半空闲的表被sweep
+ * 关闭并从hash queue中删除，下一轮再被查找和重新打开
+ */
+
+#define HOME_DIR		"WT_DHANDLE_SWEEP_CHECK"
+#define TAB_META		"key_format=q,value_format=S"
+#define WT_CONFIG		"create,session_max=100,statistics=(fast),file_manager=(close_idle_time=1,close_scan_interval=1)"
+#define TABLE_COUNT		128
+#define THREAD_COUNT	8
+#define PHASE_COUNT		6
+#define PHASE_USEC		1500000
+
+static WT_CONNECTION* conn;
+static volatile int phase;
+static volatile int done;
+
+static void create_tables(WT_SESSION* session)
+{
+	WT_CURSOR *cursor;
+	char uri[64], value[64];
+	int i;
+
+	for (i = 0; i < TABLE_COUNT; i++){
+		snprintf(uri, sizeof(uri), "table:t%05d", i);
+		snprintf(value, sizeof(value), "value of t%05d", i);
+		CHECK_OK(session->create(session, uri, TAB_META));
+		CHECK_OK(session->open_cursor(session, uri, NULL, NULL, &cursor));
+		cursor->set_key(cursor, (int64_t)i);
+		cursor->set_value(cursor, value);
+		CHECK_OK(cursor->insert(cursor));
+		CHECK_OK(cursor->close(cursor));
+	}
+
+	/*sweep只关闭干净的btree*/
+	CHECK_OK(session->checkpoint(session, NULL));
+}
+
+static void* worker(void* arg)
+{
+	WT_CURSOR *cursor;
+	WT_SESSION *session;
+	const char *value;
+	char expect[64], uri[64];
+	unsigned int seed;
+	int i;
+
+	seed = (unsigned int)(uintptr_t)arg;
+	while (!done){
+		i = (phase % 2) * (TABLE_COUNT / 2) + (int)(rand_r(&seed) % (TABLE_COUNT / 2));
+		snprintf(uri, sizeof(uri), "table:t%05d", i);
+		snprintf(expect, sizeof(expect), "value of t%05d", i);
+
+		/*sweep正在关闭dhandle时open等待sweep完成，不能返回错误或者找到别的表*/
+		CHECK_OK(conn->open_session(conn, NULL, NULL, &session));
+		CHECK_OK(session->open_cursor(session, uri, NULL, NULL, &cursor));
+		cursor->set_key(cursor, (int64_t)i);
+		CHECK_OK(cursor->search(cursor));
+		CHECK_OK(cursor->get_value(cursor, &value));
+		CHECK(strcmp(value, expect) == 0);
+		CHECK_OK(cursor->close(cursor));
+		CHECK_OK(session->close(session, NULL));
+	}
+
+	return NULL;
+}
+
+int main()
+{
+	WT_SESSION *session;
+	pthread_t tids[THREAD_COUNT];
+	int i;
+
+	check_home(HOME_DIR);
+	CHECK_OK(wiredtiger_open(HOME_DIR, NULL, WT_CONFIG, &conn));
+	CHECK_OK(conn->open_session(conn, NULL, NULL, &session));
+	create_tables(session);
+
+	for (i = 0; i < THREAD_COUNT; i++)
+		CHECK(pthread_create(&tids[i], NULL, worker, (void *)(uintptr_t)(i + 1)) == 0);
+	for (phase = 0; phase < PHASE_COUNT; phase++)
+		usleep(PHASE_USEC);
+	done = 1;
+	for (i = 0; i < THREAD_COUNT; i++)
+		CHECK(pthread_join(tids[i], NULL) == 0);
+
+	/*空闲的表必须被sweep关闭过，否则查找没有和sweep并发*/
+	CHECK(check_get_stat(session, WT_STAT_CONN_DH_CONN_HANDLES) > 0);
+
+	CHECK_OK(conn->close(conn, NULL));
+	return 0;
+}
@@ -0,0 +1,152 @@
+#include "check.h"
+#include <string.h>
+
+/*
+ * cursor search_batch的行为测试: 对file:、table:和lsm:三种数据源，检查无序、重复、
+ * 超出范围和刚插入的key的查找结果，以及调用结束后cursor被重置
+ */
+
+#define HOME_DIR		"WT_SEARCH_BATCH_CHECK"
+#define TAB_META		"key_format=u,value_format=u"
+#define RECORD_COUNT	20000
+#define BATCH_SIZE		512
+
+static const char* uris[] = { "file:batch.wt", "table:batch", "lsm:batch" };
+
+static char key_buf[BATCH_SIZE][32];
+static int key_num[BATCH_SIZE];
+static WT_ITEM keys[BATCH_SIZE];
+static WT_ITEM values[BATCH_SIZE];
+static int results[BATCH_SIZE];
+
+static void set_key(int i, int n)
+{
+	key_num[i] = n;
+	keys[i].data = key_buf[i];
+	if (n < 0)
+		keys[i].size = (size_t)snprintf(key_buf[i], sizeof(key_buf[i]), "a");
+	else if (n >= RECORD_COUNT)
+		keys[i].size = (size_t)snprintf(key_buf[i], sizeof(key_buf[i]), "zzz");
+	else
+		keys[i].size = (size_t)snprintf(key_buf[i], sizeof(key_buf[i]), "key%08d", n);
+}
+
+/*只插入偶数的key，奇数的key用来检查找不到的情况*/
+static void load(WT_SESSION* session, const char* uri)
+{
+	WT_CURSOR *cursor;
+	WT_ITEM key, value;
+	char kbuf[32], vbuf[64];
+	int i;
+
+	CHECK_OK(session->create(session, uri, TAB_META));
+	CHECK_OK(session->open_cursor(session, uri, NULL, "bulk", &cursor));
+	for (i = 0; i < RECORD_COUNT; i += 2){
+		key.data = kbuf;
+		key.size = (size_t)snprintf(kbuf, sizeof(kbuf), "key%08d", i);
+		value.data = vbuf;
+		value.size = (size_t)snprintf(vbuf, sizeof(vbuf), "value of %d", i);
+		cursor->set_key(cursor, &key);
+		cursor->set_value(cursor, &value);
+		CHECK_OK(cursor->insert(cursor));
+	}
+	CHECK_OK(cursor->close(cursor));
+}
+
+/*检查search_batch的结果，inserted是load以后单独插入的奇数key*/
+static void verify(WT_CURSOR* cursor, int inserted)
+{
+	WT_ITEM value;
+	char vbuf[64];
+	size_t vlen;
+	int i;
+
+	for (i = 0; i < BATCH_SIZE; i++){
+		if (key_num[i] < 0 || key_num[i] >= RECORD_COUNT || (key_num[i] % 2 != 0 && key_num[i] != inserted)){
+			CHECK(results[i] == WT_NOTFOUND);
+			continue;
+		}
+
+		CHECK(results[i] == 0);
+		vlen = (size_t)snprintf(vbuf, sizeof(vbuf), "value of %d", key_num[i]);
+		CHECK(values[i].size == vlen && memcmp(values[i].data, vbuf, vlen) == 0);
+	}
+
+	/*和逐个search的结果一致*/
+	for (i = 0; i < BATCH_SIZE; i++){
+		cursor->set_key(cursor, &keys[i]);
+		CHECK_RET(cursor->search(cursor), results[i]);
+		if (results[i] == 0){
+			CHECK_OK(cursor->get_value(cursor, &value));
+			CHECK(value.size == values[i].size && memcmp(value.data, values[i].data, value.size) == 0);
+		}
+	}
+	CHECK_OK(cursor->reset(cursor));
+}
+
+static void check_uri(WT_SESSION* session, const char* uri)
+{
+	WT_CURSOR *cursor;
+	WT_ITEM key, value;
+	char vbuf[64];
+	int i, inserted;
+
+	load(session, uri);
+	CHECK_OK(session->open_cursor(session, uri, NULL, "raw", &cursor));
+
+	/*count为0时什么也不做*/
+	CHECK_OK(cursor->search_batch(cursor, 0, keys, values, results));
+
+	/*无序的key，其中有重复的key和超出范围的key*/
+	for (i = 0; i < BATCH_SIZE; i++)
+		set_key(i, rand() % RECORD_COUNT);
+	set_key(0, -1);
+	set_key(1, RECORD_COUNT);
+	set_key(2, key_num[3]);
+	CHECK_OK(cursor->search_batch(cursor, BATCH_SIZE, keys, values, results));
+	verify(cursor, -1);
+
+	/*插入一个奇数key，还在内存中的修改也要能找到*/
+	inserted = key_num[4] | 1;
+	if (inserted >= RECORD_COUNT)
+		inserted -= 2;
+	set_key(4, inserted);
+	key.data = key_buf[4];
+	key.size = keys[4].size;
+	value.data = vbuf;
+	value.size = (size_t)snprintf(vbuf, sizeof(vbuf), "value of %d", inserted);
+	cursor->set_key(cursor, &key);
+	cursor->set_value(cursor, &value);
+	CHECK_OK(cursor->insert(cursor));
+	CHECK_OK(cursor->reset(cursor));
+
+	CHECK_OK(cursor->search_batch(cursor, BATCH_SIZE, keys, values, results));
+	verify(cursor, inserted);
+
+	/*调用结束后cursor被重置，next从第一个key开始*/
+	CHECK_OK(cursor->search_batch(cursor, BATCH_SIZE, keys, values, results));
+	CHECK_OK(cursor->next(cursor));
+	CHECK_OK(cursor->get_key(cursor, &key));
+	CHECK(key.size == 11 && memcmp(key.data, "key00000000", 11) == 0);
+
+	CHECK_OK(cursor->close(cursor));
+}
+
+int main()
+{
+	WT_CONNECTION *conn;
+	WT_SESSION *session;
+	size_t i;
+
+	check_home(HOME_DIR);
+	srand(42);
+
+	CHECK_OK(wiredtiger_open(HOME_DIR, NULL, "create,cache_size=64MB", &conn));
+	CHECK_OK(conn->open_session(conn, NULL, NULL, &session));
+
+	for (i = 0; i < sizeof(uris) / sizeof(uris[0]); i++)
+		check_uri(session, uris[i]);
+
+	CHECK_OK(conn->close(conn, NULL));
+	return 0;
+}
@@ -12,14 +12,12 @@ int WT_CDECL __wt_txnid_cmp(const void* v1, const void* v2)
 	return ((id1 == id2) ? 0 : TXNID_LT(id1, id2) ? -1 : 1);
 }
 
-/*按事务ID按从小到大对snapshot数组进行排序*/
-static void __txn_sort_snapshot(WT_SESSION_IMPL* session, uint32_t n, uint64_t snap_max)
+/*设置session的snapshot信息，snapshot数组必须已经按事务ID从小到大有序*/
+static void __txn_set_snapshot(WT_SESSION_IMPL* session, uint32_t n, uint64_t snap_max)
 {
 	WT_TXN* txn;
 	txn = &session->txn;
 
-	if(n > 1)
-		qsort(txn->snapshot, n, sizeof(uint64_t), __wt_txnid_cmp);
 	txn->snapshot_count = n;
 	txn->snap_max = snap_max;
 	txn->snap_min = (n > 0 && TXNID_LE(txn->snapshot[0], snap_max)) ? txn->snapshot[0] : snap_max;
@@ -28,6 +26,105 @@ static void __txn_sort_snapshot(WT_SESSION_IMPL* session, uint32_t n, uint64_t s
 	WT_ASSERT(session, n == 0 || txn->snap_min != WT_TXN_NONE);
 }
 
+/*按事务ID按从小到大对snapshot数组进行排序*/
+static void __txn_sort_snapshot(WT_SESSION_IMPL* session, uint32_t n, uint64_t snap_max)
+{
+	WT_TXN* txn;
+	txn = &session->txn;
+
+	if(n > 1)
+		qsort(txn->snapshot, n, sizeof(uint64_t), __wt_txnid_cmp);
+	__txn_set_snapshot(session, n, snap_max);
+}
+
+/*
+ * 尝试用全局缓存的snapshot建立session的snapshot。缓存建立以后没有新的事务ID分配
+ * (current没变)、没有事务ID释放(snapshot_gen没变)并且checkpoint事务没变，缓存的
+ * 运行事务ID列表就还是准确的，拷贝的代价只和正在运行的事务数有关，和session数无关。
+ * 调用者必须持有scan_count，保证oldest_id在这个过程中不会被推进
+ */
+static int __txn_snapshot_cached(WT_SESSION_IMPL* session, WT_TXN_STATE* txn_state)
+{
+	WT_TXN *txn;
+	WT_TXN_GLOBAL *txn_global;
+	uint64_t current_id, id, own_id, prev_oldest_id, snap_min;
+	uint32_t i, n;
+	WT_DECL_SPINLOCK_ID(lock_id);
+
+	txn = &session->txn;
+	txn_global = &S2C(session)->txn_global;
+
+	/*有其他线程在使用缓存，直接做全量扫描，不在这里等待*/
+	if (__wt_spin_trylock(session, &txn_global->snapshot_lock, &lock_id) != 0)
+		return 0;
+
+	current_id = txn_global->current;
+	if (!txn_global->snapshot_cache_valid ||
+	    txn_global->snapshot_cache_gen != txn_global->snapshot_gen ||
+	    txn_global->snapshot_cache_current != current_id ||
+	    txn_global->snapshot_cache_ckpt_id != txn_global->checkpoint_id) {
+		__wt_spin_unlock(session, &txn_global->snapshot_lock);
+		WT_STAT_FAST_CONN_INCR(session, txn_snapshot_cache_miss);
+		return 0;
+	}
+
+	/*过滤掉session自己的事务ID和已经比oldest id更早的事务ID，缓存是有序的，拷贝后不需要排序*/
+	prev_oldest_id = txn_global->oldest_id;
+	own_id = txn_state->id;
+	snap_min = current_id;
+	for (i = n = 0; i < txn_global->snapshot_cache_count; i++) {
+		id = txn_global->snapshot_cache[i];
+		if (id == own_id || TXNID_LT(id, prev_oldest_id))
+			continue;
+		txn->snapshot[n++] = id;
+		if (TXNID_LT(id, snap_min))
+			snap_min = id;
+	}
+	__wt_spin_unlock(session, &txn_global->snapshot_lock);
+
+	txn_state->snap_min = snap_min;
+	__txn_set_snapshot(session, n, current_id);
+	WT_STAT_FAST_CONN_INCR(session, txn_snapshot_cache_hit);
+
+	return 1;
+}
+
+/*
+ * 用全量扫描得到的snapshot更新全局的snapshot缓存。全量扫描的snapshot不包含session自己
+ * 的事务ID，缓存需要包含所有运行中的事务ID，所以把自己的事务ID按顺序插入
+ */
+static void __txn_snapshot_cache_update(WT_SESSION_IMPL* session, WT_TXN_STATE* txn_state, uint64_t gen, uint64_t current_id, uint64_t ckpt_id)
+{
+	WT_TXN *txn;
+	WT_TXN_GLOBAL *txn_global;
+	uint64_t own_id;
+	uint32_t i, n;
+	WT_DECL_SPINLOCK_ID(lock_id);
+
+	txn = &session->txn;
+	txn_global = &S2C(session)->txn_global;
+
+	if (__wt_spin_trylock(session, &txn_global->snapshot_lock, &lock_id) != 0)
+		return;
+
+	n = txn->snapshot_count;
+	memcpy(txn_global->snapshot_cache, txn->snapshot, n * sizeof(uint64_t));
+	if ((own_id = txn_state->id) != WT_TXN_NONE && TXNID_LT(own_id, current_id)) {
+		for (i = n; i > 0 && TXNID_LT(own_id, txn_global->snapshot_cache[i - 1]); i--)
+			txn_global->snapshot_cache[i] = txn_global->snapshot_cache[i - 1];
+		txn_global->snapshot_cache[i] = own_id;
+		++n;
+	}
+
+	txn_global->snapshot_cache_count = n;
+	txn_global->snapshot_cache_gen = gen;
+	txn_global->snapshot_cache_current = current_id;
+	txn_global->snapshot_cache_ckpt_id = ckpt_id;
+	txn_global->snapshot_cache_valid = 1;
+
+	__wt_spin_unlock(session, &txn_global->snapshot_lock);
+}
+
 /*release当前的事务的snapshot*/
 void __wt_txn_release_snapshot(WT_SESSION_IMPL* session)
 {
@@ -73,8 +170,8 @@ void __wt_txn_refresh(WT_SESSION_IMPL* session, int get_snapshot)
 	WT_TXN *txn;
 	WT_TXN_GLOBAL *txn_global;
 	WT_TXN_STATE *s, *txn_state;
-	uint64_t current_id, id, oldest_id;
-	uint64_t prev_oldest_id, snap_min;
+	uint64_t ckpt_id, current_id, id, oldest_id;
+	uint64_t prev_oldest_id, snap_gen, snap_min;
 	uint32_t i, n, oldest_session, session_cnt;
 	int32_t count;
 
@@ -103,6 +200,17 @@ void __wt_txn_refresh(WT_SESSION_IMPL* session, int get_snapshot)
 			WT_PAUSE();
 	} while (count < 0 || !WT_ATOMIC_CAS4(txn_global->scan_count, count, count + 1));
 
+	/*运行事务的集合没有发生变化，直接使用缓存的snapshot，不扫描所有session的事务状态*/
+	if (get_snapshot && __txn_snapshot_cached(session, txn_state)) {
+		WT_ASSERT(session, txn_global->scan_count > 0);
+		(void)WT_ATOMIC_SUB4(txn_global->scan_count, 1);
+		return;
+	}
+
+	/*在扫描之前读取generation，扫描过程中有事务ID释放的话这次建立的缓存不会被使用*/
+	WT_ORDERED_READ(snap_gen, txn_global->snapshot_gen);
+	ckpt_id = txn_global->checkpoint_id;
+
 	/**/
 	prev_oldest_id = txn_global->oldest_id;
 	current_id = oldest_id = snap_min = txn_global->current;
@@ -184,8 +292,10 @@ void __wt_txn_refresh(WT_SESSION_IMPL* session, int get_snapshot)
 		(void)WT_ATOMIC_SUB4(txn_global->scan_count, 1);
 	}
 
-	if (get_snapshot)
+	if (get_snapshot) {
 		__txn_sort_snapshot(session, n, current_id);
+		__txn_snapshot_cache_update(session, txn_state, snap_gen, current_id, ckpt_id);
+	}
 }
 
 /*session开始一个事务*/
@@ -249,6 +359,8 @@ void __wt_txn_release(WT_SESSION_IMPL* session)
 		WT_ASSERT(session, txn_state->id != WT_TXN_NONE && txn->id != WT_TXN_NONE);
 		WT_PUBLISH(txn_state->id, WT_TXN_NONE);
 		txn->id = WT_TXN_NONE;
+		/*运行事务的集合发生了变化，缓存的snapshot失效*/
+		(void)WT_ATOMIC_ADD8(txn_global->snapshot_gen, 1);
 	}
 
 	/*释放logrec对象空间*/
@@ -438,6 +550,10 @@ int __wt_txn_global_init(WT_SESSION_IMPL* session, const char* cfg[])
 	for (i = 0, s = txn_global->states; i < conn->session_size; i++, s++)
 		s->id = s->snap_min = WT_TXN_NONE;
 
+	/*snapshot缓存最多包含每个session的一个事务ID*/
+	WT_RET(__wt_spin_init(session, &txn_global->snapshot_lock, "transaction snapshot"));
+	WT_RET(__wt_calloc_def(session, conn->session_size, &txn_global->snapshot_cache));
+
 	return 0;
 }
 
@@ -450,6 +566,9 @@ void __wt_txn_global_destroy(WT_SESSION_IMPL *session)
 	conn = S2C(session);
 	txn_global = &conn->txn_global;
 
-	if (txn_global != NULL)
+	if (txn_global != NULL) {
+		__wt_spin_destroy(session, &txn_global->snapshot_lock);
+		__wt_free(session, txn_global->snapshot_cache);
 		__wt_free(session, txn_global->states);
+	}
 }
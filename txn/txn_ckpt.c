@@ -131,6 +131,24 @@ err:
 	return ret;
 }
 
+/*对session->dhandle执行一个checkpoint操作，并统计这个文件上checkpoint操作的耗时*/
+static int __checkpoint_apply_one(WT_SESSION_IMPL* session, const char* cfg[], int (*op)(WT_SESSION_IMPL *, const char *[]))
+{
+	struct timespec start, stop;
+	uint64_t usecs;
+
+	WT_RET(__wt_epoch(session, &start));
+	WT_RET((*op)(session, cfg));
+	WT_RET(__wt_epoch(session, &stop));
+
+	usecs = WT_TIMEDIFF(stop, start) / WT_THOUSAND;
+	WT_STAT_FAST_DATA_INCRV(session, btree_checkpoint_time, usecs);
+	if (usecs > WT_CONN_STAT(session, txn_checkpoint_file_time_max))
+		WT_STAT_FAST_CONN_SET(session, txn_checkpoint_file_time_max, usecs);
+
+	return 0;
+}
+
 /*
  * __checkpoint_apply --
  *	Apply an operation to all handles locked for a checkpoint.
@@ -143,7 +161,7 @@ static int __checkpoint_apply(WT_SESSION_IMPL* session, const char* cfg[], int (
 	/* If we have already locked the handles, apply the operation. */
 	for(i = 0; i < session->ckpt_handle_next; ++i){
 		if (session->ckpt_handle[i].dhandle != NULL)
-			WT_WITH_DHANDLE(session, session->ckpt_handle[i].dhandle, ret = (*op)(session, cfg));
+			WT_WITH_DHANDLE(session, session->ckpt_handle[i].dhandle, ret = __checkpoint_apply_one(session, cfg, op));
 		else
 			WT_WITH_DHANDLE_LOCK(session, ret = __wt_conn_btree_apply_single(session, session->ckpt_handle[i].name, NULL, op, cfg));
 		WT_RET(ret);
@@ -152,6 +170,156 @@ static int __checkpoint_apply(WT_SESSION_IMPL* session, const char* cfg[], int (
 	return 0;
 }
 
+/*并行checkpoint时，所有worker共享的操作信息*/
+typedef struct
+{
+	WT_SESSION_IMPL*	session;		/* 持有checkpoint handles的session */
+	const char**		cfg;
+	int					(*op)(WT_SESSION_IMPL *, const char *[]);
+	uint32_t			next;			/* 下一个要处理的handle下标 */
+	int					ret;			/* 第一个出错的返回值 */
+} WT_CKPT_APPLY;
+
+/*并行checkpoint的worker, 每次checkpoint时创建，使用自己的internal session*/
+typedef struct
+{
+	WT_CKPT_APPLY*		apply;
+	WT_SESSION_IMPL*	session;
+	wt_thread_t			tid;
+	int					tid_set;
+} WT_CKPT_WORKER;
+
+/*从共享的handle列表中领取handle并执行checkpoint操作，直到所有的handle处理完或者有worker出错*/
+static int __checkpoint_apply_next(WT_CKPT_APPLY* apply, WT_SESSION_IMPL* session)
+{
+	WT_DATA_HANDLE *dhandle;
+	WT_DECL_RET;
+	uint32_t i;
+
+	while (apply->ret == 0) {
+		i = WT_ATOMIC_FETCH_ADD4(apply->next, 1);
+		if (i >= apply->session->ckpt_handle_next)
+			break;
+
+		/*打开时busy的handle只有名字，由发起checkpoint的session串行处理*/
+		if ((dhandle = apply->session->ckpt_handle[i].dhandle) == NULL)
+			continue;
+
+		WT_WITH_DHANDLE(session, dhandle, ret = __checkpoint_apply_one(session, apply->cfg, apply->op));
+		if (ret != 0) {
+			(void)WT_ATOMIC_CAS4(apply->ret, 0, ret);
+			break;
+		}
+	}
+
+	return ret;
+}
+
+/*checkpoint worker线程主体*/
+static WT_THREAD_RET __checkpoint_apply_server(void* arg)
+{
+	WT_CKPT_WORKER *worker;
+
+	worker = (WT_CKPT_WORKER *)arg;
+	(void)__checkpoint_apply_next(worker->apply, worker->session);
+
+	return WT_THREAD_RET_VALUE;
+}
+
+/*
+ * 将checkpoint操作分散到worker线程上并行执行，发起checkpoint的session也参与处理。
+ * 没有worker时退化成串行的__checkpoint_apply
+ */
+static int __checkpoint_apply_parallel(WT_SESSION_IMPL* session, const char* cfg[],
+	int (*op)(WT_SESSION_IMPL *, const char *[]), WT_CKPT_WORKER* workers, u_int nworkers)
+{
+	WT_CKPT_APPLY apply;
+	WT_DECL_RET;
+	u_int i;
+
+	if (nworkers == 0)
+		return (__checkpoint_apply(session, cfg, op));
+
+	WT_CLEAR(apply);
+	apply.session = session;
+	apply.cfg = cfg;
+	apply.op = op;
+
+	for (i = 0; i < nworkers; i++) {
+		workers[i].apply = &apply;
+		WT_ERR(__wt_thread_create(session, &workers[i].tid, __checkpoint_apply_server, &workers[i]));
+		workers[i].tid_set = 1;
+	}
+
+	WT_ERR(__checkpoint_apply_next(&apply, session));
+
+err:
+	for (i = 0; i < nworkers; i++) {
+		if (workers[i].tid_set) {
+			WT_TRET(__wt_thread_join(session, workers[i].tid));
+			workers[i].tid_set = 0;
+		}
+	}
+	WT_TRET(apply.ret);
+	WT_RET(ret);
+
+	/*处理只有名字的handle*/
+	for (i = 0; i < session->ckpt_handle_next; ++i) {
+		if (session->ckpt_handle[i].dhandle != NULL)
+			continue;
+		WT_WITH_DHANDLE_LOCK(session, ret = __wt_conn_btree_apply_single(session, session->ckpt_handle[i].name, NULL, op, cfg));
+		WT_RET(ret);
+	}
+
+	return 0;
+}
+
+/*根据checkpoint.threads为本次checkpoint打开worker使用的internal session*/
+static int __checkpoint_workers_open(WT_SESSION_IMPL* session, WT_CKPT_WORKER** workersp, u_int* nworkersp)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_CKPT_WORKER *workers;
+	WT_SESSION_IMPL *s;
+	u_int i, nworkers;
+
+	conn = S2C(session);
+	*workersp = NULL;
+	*nworkersp = 0;
+
+	if (conn->ckpt_threads < 2 || session->ckpt_handle_next < 2)
+		return 0;
+
+	nworkers = WT_MIN(conn->ckpt_threads, session->ckpt_handle_next) - 1;
+	WT_RET(__wt_calloc_def(session, nworkers, &workers));
+	*workersp = workers;
+
+	for (i = 0; i < nworkers; i++) {
+		WT_RET(__wt_open_internal_session(conn, "checkpoint-worker", 1, 0, &s));
+		/*worker只做写leaf page和sync文件的操作，不在checkpoint的事务中*/
+		s->isolation = s->txn.isolation = TXN_ISO_READ_COMMITTED;
+		workers[i].session = s;
+		++*nworkersp;
+	}
+
+	return 0;
+}
+
+/*关闭checkpoint worker的session*/
+static int __checkpoint_workers_close(WT_SESSION_IMPL* session, WT_CKPT_WORKER* workers, u_int nworkers)
+{
+	WT_DECL_RET;
+	WT_SESSION *wt_session;
+	u_int i;
+
+	for (i = 0; i < nworkers; i++) {
+		wt_session = &workers[i].session->iface;
+		WT_TRET(wt_session->close(wt_session, NULL));
+	}
+	__wt_free(session, workers);
+
+	return ret;
+}
+
 /*chectpoint all data sources*/
 static int __checkpoint_data_source(WT_SESSION_IMPL* session, const char* cfg[])
 {
@@ -240,15 +408,18 @@ int  __wt_txn_checkpoint(WT_SESSION_IMPL* session, const char* cfg[])
 	const char *txn_cfg[] =
 	{ WT_CONFIG_BASE(session, session_begin_transaction),
 	"isolation=snapshot", NULL };
+	WT_CKPT_WORKER *workers;
 	void *saved_meta_next;
 	int full, logging, tracking;
-	u_int i;
+	u_int i, nworkers;
 
 	conn = S2C(session);
 	txn_global = &conn->txn_global;
 	saved_isolation = session->isolation;
 	txn = &session->txn;
 	full = logging = tracking = 0;
+	workers = NULL;
+	nworkers = 0;
 
 	/* Ensure the metadata table is open before taking any locks. */
 	WT_RET(__wt_metadata_open(session));
@@ -275,12 +446,19 @@ int  __wt_txn_checkpoint(WT_SESSION_IMPL* session, const char* cfg[])
 	 */
 	__wt_txn_update_oldest(session);
 
+	/*
+	 * Open the sessions used to spread the per-file leaf writes and
+	 * syncs across threads.  The checkpoint itself runs in our snapshot
+	 * transaction and updates the metadata, so it stays on this session.
+	 */
+	WT_ERR(__checkpoint_workers_open(session, &workers, &nworkers));
+
 	WT_ERR(__checkpoint_data_source(session, cfg));
 	WT_ERR(__wt_epoch(session, &verb_timer));
 	WT_ERR(__checkpoint_verbose_track(session, "starting write leaves", &verb_timer));
 	/*进行脏页落盘*/
 	session->isolation = txn->isolation = TXN_ISO_READ_COMMITTED;
-	WT_ERR(__checkpoint_apply(session, cfg, __checkpoint_write_leaves));
+	WT_ERR(__checkpoint_apply_parallel(session, cfg, __checkpoint_write_leaves, workers, nworkers));
 
 	/*
 	 * The underlying flush routine scheduled an asynchronous flush
@@ -290,7 +468,7 @@ int  __wt_txn_checkpoint(WT_SESSION_IMPL* session, const char* cfg[])
 	 * asynchronous flush as much time as possible before we wait.
 	 */
 	if (F_ISSET(conn, WT_CONN_CKPT_SYNC))
-		WT_ERR(__checkpoint_apply(session, cfg, __wt_checkpoint_sync));
+		WT_ERR(__checkpoint_apply_parallel(session, cfg, __wt_checkpoint_sync, workers, nworkers));
 
 	/* Acquire the schema lock. 一个长时间的spin lock*/
 	F_SET(session, WT_SESSION_SCHEMA_LOCKED);
@@ -345,7 +523,7 @@ int  __wt_txn_checkpoint(WT_SESSION_IMPL* session, const char* cfg[])
 	 * lazy checkpoints, but we don't support them yet).
 	 */
 	if (F_ISSET(conn, WT_CONN_CKPT_SYNC))
-		WT_ERR(__checkpoint_apply(session, cfg, __wt_checkpoint_sync));
+		WT_ERR(__checkpoint_apply_parallel(session, cfg, __wt_checkpoint_sync, workers, nworkers));
 
 	WT_ERR(__checkpoint_verbose_track(session, "sync completed", &verb_timer));
 
@@ -422,6 +600,10 @@ err:	/*
 		__wt_spin_unlock(session, &conn->schema_lock);
 	}
 
+	/*关闭worker的session*/
+	if (workers != NULL)
+		WT_TRET(__checkpoint_workers_close(session, workers, nworkers));
+
 	/*设回checkpoint前的隔离级别*/
 	session->isolation = txn->isolation = saved_isolation;
 
@@ -3,6 +3,18 @@
  **********************************************************/
 #include "wt_internal.h"
 
+/*并行推演时每个worker队列中待推演数据的最大长度，超过时读日志的线程需要等待*/
+#define	WT_RECOVERY_QUEUE_MAX	(4 * WT_MEGABYTE)
+
+/*worker队列中一个操作的头，后面紧跟着操作的日志数据*/
+typedef struct
+{
+	WT_LSN		lsn;		/* 操作所在日志的LSN */
+	uint32_t	size;		/* 操作日志数据的长度 */
+} WT_RECOVERY_OP;
+
+typedef struct __wt_recovery_worker WT_RECOVERY_WORKER;
+
 typedef struct
 {
 	WT_SESSION_IMPL* session;
@@ -23,12 +35,44 @@ typedef struct
 	int missing;				/* Were there missing files? */
 	int modified;				/* Did recovery make any changes? */
 	int metadata_only;			/* Set during the first recovery pass, when only the metadata is recovered. */
+
+	WT_RECOVERY_WORKER* workers;/* 并行推演的worker */
+	u_int nworkers;				/* worker的个数，为0时在当前线程推演 */
+	WT_CONDVAR* space_cond;		/* worker消费了队列后通知读日志的线程 */
+	int workers_stop;			/* 通知worker推演完队列后退出 */
+
+	uint64_t ops;				/* 当前线程推演的操作数 */
 }WT_RECOVERY;
 
-/*为日志推演构建一个cursor*/
-static int __recovery_cursor(WT_SESSION_IMPL* session, WT_RECOVERY* r, WT_LSN* lsnp, u_int id, int duplicate, WT_CURSOR** cp)
+/*
+ * 并行推演的worker, 读日志的线程按照file id和key将操作分配到worker的队列中，
+ * 每个worker用自己的session和cursor推演
+ */
+struct __wt_recovery_worker
 {
-	WT_CURSOR *c;
+	WT_RECOVERY* r;
+	WT_SESSION_IMPL* session;
+
+	WT_CURSOR** cursors;		/* 每个文件的推演cursor，以file id为下标 */
+	u_int ncursors;
+
+	WT_SPINLOCK lock;			/* 保护queue和busy */
+	WT_CONDVAR* cond;			/* 通知worker有新的操作 */
+	WT_ITEM queue;				/* 读日志的线程写入的操作 */
+	WT_ITEM work;				/* worker正在推演的操作 */
+	int busy;					/* worker正在推演work中的操作 */
+
+	wt_thread_t tid;
+	int tid_set;
+	int ret;					/* worker推演出错的返回值 */
+
+	uint64_t ops;				/* worker推演的操作数 */
+};
+
+/*为日志推演构建一个cursor, w不为NULL时使用worker自己的cursor*/
+static int __recovery_cursor(WT_SESSION_IMPL* session, WT_RECOVERY* r, WT_RECOVERY_WORKER* w, WT_LSN* lsnp, u_int id, int duplicate, WT_CURSOR** cp)
+{
+	WT_CURSOR *c, **slot;
 	const char *cfg[] = { WT_CONFIG_BASE(session, session_open_cursor), "overwrite", NULL };
 	int metadata_op;
 
@@ -53,9 +97,10 @@ static int __recovery_cursor(WT_SESSION_IMPL* session, WT_RECOVERY* r, WT_LSN* l
 		r->missing = 1;
 	}
 	else if(LOG_CMP(lsnp, &r->files[id].ckpt_lsn) >= 0){
-		if ((c = r->files[id].c) == NULL) {
+		slot = (w == NULL) ? &r->files[id].c : &w->cursors[id];
+		if ((c = *slot) == NULL) {
 			WT_RET(__wt_open_cursor(session, r->files[id].uri, NULL, cfg, &c));
-			r->files[id].c = c;
+			*slot = c;
 		}
 	}
 
@@ -69,9 +114,9 @@ static int __recovery_cursor(WT_SESSION_IMPL* session, WT_RECOVERY* r, WT_LSN* l
 }
 
 /*创建一个recovery cursor对象*/
-#define	GET_RECOVERY_CURSOR(session, r, lsnp, fileid, cp)		\
+#define	GET_RECOVERY_CURSOR(session, r, w, lsnp, fileid, cp)	\
 	WT_ERR(__recovery_cursor(									\
-	    (session), (r), (lsnp), (fileid), 0, (cp)));			\
+	    (session), (r), (w), (lsnp), (fileid), 0, (cp)));		\
 	WT_ERR(__wt_verbose((session), WT_VERB_RECOVERY,			\
 	    "%s op %d to file %d at LSN %u/%" PRIuMAX,				\
 	    (cursor == NULL) ? "Skipping" : "Applying",				\
@@ -79,8 +124,8 @@ static int __recovery_cursor(WT_SESSION_IMPL* session, WT_RECOVERY* r, WT_LSN* l
 	if (cursor == NULL)											\
 		break
 
-/*日志推演一个操作*/
-static int txn_op_apply(WT_RECOVERY* r, WT_LSN* lsnp, const uint8_t** pp, const uint8_t* end)
+/*日志推演一个操作, w为NULL表示在读日志的线程中推演*/
+static int __txn_op_apply(WT_RECOVERY* r, WT_RECOVERY_WORKER* w, WT_LSN* lsnp, const uint8_t** pp, const uint8_t* end)
 {
 	WT_CURSOR *cursor, *start, *stop;
 	WT_DECL_RET;
@@ -89,7 +134,7 @@ static int txn_op_apply(WT_RECOVERY* r, WT_LSN* lsnp, const uint8_t** pp, const
 	uint64_t recno, start_recno, stop_recno;
 	uint32_t fileid, mode, optype, opsize;
 
-	session = r->session;
+	session = (w == NULL) ? r->session : w->session;
 	cursor = NULL;
 
 	/*读取一个日志的操作类型*/
@@ -99,7 +144,7 @@ static int txn_op_apply(WT_RECOVERY* r, WT_LSN* lsnp, const uint8_t** pp, const
 	switch (optype){
 	case WT_LOGOP_COL_PUT:
 		WT_ERR(__wt_logop_col_put_unpack(session, pp, end, &fileid, &recno, &value));
-		GET_RECOVERY_CURSOR(session, r, lsnp, fileid, &cursor);
+		GET_RECOVERY_CURSOR(session, r, w, lsnp, fileid, &cursor);
 		cursor->set_key(cursor, recno);
 		__wt_cursor_set_raw_value(cursor, &value);
 		WT_ERR(cursor->insert(cursor));
@@ -107,14 +152,14 @@ static int txn_op_apply(WT_RECOVERY* r, WT_LSN* lsnp, const uint8_t** pp, const
 
 	case WT_LOGOP_COL_REMOVE:
 		WT_ERR(__wt_logop_col_remove_unpack(session, pp, end, &fileid, &recno));
-		GET_RECOVERY_CURSOR(session, r, lsnp, fileid, &cursor);
+		GET_RECOVERY_CURSOR(session, r, w, lsnp, fileid, &cursor);
 		cursor->set_key(cursor, recno);
 		WT_ERR(cursor->remove(cursor));
 		break;
 
 	case WT_LOGOP_COL_TRUNCATE:
 		WT_ERR(__wt_logop_col_truncate_unpack(session, pp, end, &fileid, &start_recno, &stop_recno));
-		GET_RECOVERY_CURSOR(session, r, lsnp, fileid, &cursor);
+		GET_RECOVERY_CURSOR(session, r, w, lsnp, fileid, &cursor);
 
 		/*设置cursor的start/stop位置*/
 		if (start_recno == 0){
@@ -127,7 +172,7 @@ static int txn_op_apply(WT_RECOVERY* r, WT_LSN* lsnp, const uint8_t** pp, const
 		}
 		else{
 			start = cursor;
-			WT_ERR(__recovery_cursor(session, r, lsnp, filedid, 1, &stop));
+			WT_ERR(__recovery_cursor(session, r, w, lsnp, fileid, 1, &stop));
 		}
 
 		/*设置KEY*/
@@ -144,7 +189,7 @@ static int txn_op_apply(WT_RECOVERY* r, WT_LSN* lsnp, const uint8_t** pp, const
 
 	case WT_LOGOP_ROW_PUT:
 		WT_ERR(__wt_logop_row_put_unpack(session, pp, end, &fileid, &key, &value));
-		GET_RECOVERY_CURSOR(session, r, lsnp, fileid, &cursor);
+		GET_RECOVERY_CURSOR(session, r, w, lsnp, fileid, &cursor);
 		__wt_cursor_set_raw_key(cursor, &key);
 		__wt_cursor_set_raw_value(cursor, &value);
 		WT_ERR(cursor->insert(cursor));
@@ -152,7 +197,7 @@ static int txn_op_apply(WT_RECOVERY* r, WT_LSN* lsnp, const uint8_t** pp, const
 
 	case WT_LOGOP_ROW_REMOVE:
 		WT_ERR(__wt_logop_row_remove_unpack(session, pp, end, &fileid, &key));
-		GET_RECOVERY_CURSOR(session, r, lsnp, fileid, &cursor);
+		GET_RECOVERY_CURSOR(session, r, w, lsnp, fileid, &cursor);
 		__wt_cursor_set_raw_key(cursor, &key);
 		WT_ERR(cursor->remove(cursor));
 		break;
@@ -160,7 +205,7 @@ static int txn_op_apply(WT_RECOVERY* r, WT_LSN* lsnp, const uint8_t** pp, const
 		/*row truncate*/
 	case WT_LOGOP_ROW_TRUNCATE:
 		WT_ERR(__wt_logop_row_truncate_unpack(session, pp, end, &fileid, &start_key, &stop_key, &mode));
-		GET_RECOVERY_CURSOR(session, r, lsnp, fileid, &cursor);
+		GET_RECOVERY_CURSOR(session, r, w, lsnp, fileid, &cursor);
 
 		/*设置truncate操作start/stop位置*/
 		start = stop = NULL;
@@ -170,7 +215,7 @@ static int txn_op_apply(WT_RECOVERY* r, WT_LSN* lsnp, const uint8_t** pp, const
 			break;
 		case TXN_TRUNC_BOTH:
 			start = cursor;
-			WT_ERR(__recovery_cursor(session, r, lsnp, fileid, 1, &stop));
+			WT_ERR(__recovery_cursor(session, r, w, lsnp, fileid, 1, &stop));
 			break;
 		case TXN_TRUNC_START:
 			start = cursor;
@@ -203,6 +248,10 @@ static int txn_op_apply(WT_RECOVERY* r, WT_LSN* lsnp, const uint8_t** pp, const
 		WT_ERR(cursor->reset(cursor));
 
 	r->modified = 1;
+	if (w == NULL)
+		++r->ops;
+	else
+		++w->ops;
 
 err:
 	if (ret != 0)
@@ -211,13 +260,301 @@ err:
 	return ret;
 }
 
+/*
+ * 确定一个操作由哪个worker推演。同一个文件中相同的key总是分配给同一个worker，
+ * 保证每个key上的操作按照日志顺序推演。truncate操作涉及一个key范围，返回NULL
+ */
+static int __recovery_op_worker(WT_RECOVERY* r, const uint8_t* p, const uint8_t* end, WT_RECOVERY_WORKER** wp)
+{
+	WT_ITEM key, value;
+	WT_SESSION_IMPL *session;
+	uint64_t hash, recno;
+	uint32_t fileid, optype, opsize;
+
+	session = r->session;
+	*wp = NULL;
+
+	WT_RET(__wt_logop_read(session, &p, end, &optype, &opsize));
+	end = p + opsize;
+
+	switch (optype){
+	case WT_LOGOP_COL_PUT:
+		WT_RET(__wt_logop_col_put_unpack(session, &p, end, &fileid, &recno, &value));
+		hash = __wt_hash_city64(&recno, sizeof(recno));
+		break;
+	case WT_LOGOP_COL_REMOVE:
+		WT_RET(__wt_logop_col_remove_unpack(session, &p, end, &fileid, &recno));
+		hash = __wt_hash_city64(&recno, sizeof(recno));
+		break;
+	case WT_LOGOP_ROW_PUT:
+		WT_RET(__wt_logop_row_put_unpack(session, &p, end, &fileid, &key, &value));
+		hash = __wt_hash_city64(key.data, key.size);
+		break;
+	case WT_LOGOP_ROW_REMOVE:
+		WT_RET(__wt_logop_row_remove_unpack(session, &p, end, &fileid, &key));
+		hash = __wt_hash_city64(key.data, key.size);
+		break;
+	default:
+		return 0;
+	}
+
+	*wp = &r->workers[(hash ^ fileid) % r->nworkers];
+	return 0;
+}
+
+/*检查worker是否推演出错*/
+static int __recovery_workers_check(WT_RECOVERY* r)
+{
+	u_int i;
+
+	for (i = 0; i < r->nworkers; i++)
+		if (r->workers[i].ret != 0)
+			return (r->workers[i].ret);
+
+	return 0;
+}
+
+/*将一个操作放入worker的队列中，如果队列满了，等待worker消费*/
+static int __recovery_worker_push(WT_RECOVERY* r, WT_RECOVERY_WORKER* w, WT_LSN* lsnp, const uint8_t* p, uint32_t size)
+{
+	WT_DECL_RET;
+	WT_RECOVERY_OP op;
+	WT_SESSION_IMPL *session;
+	size_t len;
+	int wakeup;
+
+	session = r->session;
+	len = WT_ALIGN(sizeof(op) + size, 8);
+
+	for (;;) {
+		WT_RET(__recovery_workers_check(r));
+
+		__wt_spin_lock(session, &w->lock);
+		if (w->queue.size == 0 || w->queue.size + len <= WT_RECOVERY_QUEUE_MAX)
+			break;
+		__wt_spin_unlock(session, &w->lock);
+
+		WT_RET(__wt_cond_signal(session, w->cond));
+		WT_RET(__wt_cond_wait(session, r->space_cond, 1000));
+	}
+
+	op.lsn = *lsnp;
+	op.size = size;
+	wakeup = (w->queue.size == 0);
+	if ((ret = __wt_buf_extend(session, &w->queue, w->queue.size + len)) == 0) {
+		memcpy((uint8_t *)w->queue.mem + w->queue.size, &op, sizeof(op));
+		memcpy((uint8_t *)w->queue.mem + w->queue.size + sizeof(op), p, size);
+		w->queue.size += len;
+	}
+	__wt_spin_unlock(session, &w->lock);
+	WT_RET(ret);
+
+	if (wakeup)
+		WT_RET(__wt_cond_signal(session, w->cond));
+
+	return 0;
+}
+
+/*等待所有worker推演完队列中的操作*/
+static int __recovery_workers_drain(WT_RECOVERY* r)
+{
+	WT_RECOVERY_WORKER *w;
+	WT_SESSION_IMPL *session;
+	u_int i;
+	int idle;
+
+	session = r->session;
+	for (i = 0; i < r->nworkers; i++) {
+		w = &r->workers[i];
+		for (;;) {
+			WT_RET(__recovery_workers_check(r));
+
+			__wt_spin_lock(session, &w->lock);
+			idle = (w->queue.size == 0 && !w->busy);
+			__wt_spin_unlock(session, &w->lock);
+			if (idle)
+				break;
+
+			WT_RET(__wt_cond_signal(session, w->cond));
+			WT_RET(__wt_cond_wait(session, r->space_cond, 1000));
+		}
+	}
+
+	return 0;
+}
+
+/*worker线程，取出队列中的操作进行推演*/
+static WT_THREAD_RET __recovery_worker(void* arg)
+{
+	WT_DECL_RET;
+	WT_ITEM tmp;
+	WT_RECOVERY *r;
+	WT_RECOVERY_OP op;
+	WT_RECOVERY_WORKER *w;
+	WT_SESSION_IMPL *session;
+	const uint8_t *end, *p, *opp;
+
+	w = (WT_RECOVERY_WORKER *)arg;
+	r = w->r;
+	session = w->session;
+
+	for (;;) {
+		__wt_spin_lock(session, &w->lock);
+		if (w->queue.size == 0) {
+			w->busy = 0;
+			__wt_spin_unlock(session, &w->lock);
+			if (r->workers_stop)
+				break;
+
+			WT_ERR(__wt_cond_signal(session, r->space_cond));
+			WT_ERR(__wt_cond_wait(session, w->cond, 1000));
+			continue;
+		}
+
+		/*交换queue和work，读日志的线程可以继续写入queue*/
+		tmp = w->work;
+		w->work = w->queue;
+		w->queue = tmp;
+		w->queue.size = 0;
+		w->busy = 1;
+		__wt_spin_unlock(session, &w->lock);
+		WT_ERR(__wt_cond_signal(session, r->space_cond));
+
+		p = w->work.mem;
+		end = p + w->work.size;
+		for (; p < end; p += WT_ALIGN(sizeof(op) + op.size, 8)) {
+			memcpy(&op, p, sizeof(op));
+			opp = p + sizeof(op);
+			WT_ERR(__txn_op_apply(r, w, &op.lsn, &opp, opp + op.size));
+		}
+		w->work.size = 0;
+	}
+
+	return WT_THREAD_RET_VALUE;
+
+err:
+	__wt_spin_lock(session, &w->lock);
+	w->ret = ret;
+	w->busy = 0;
+	__wt_spin_unlock(session, &w->lock);
+	(void)__wt_cond_signal(session, r->space_cond);
+
+	return WT_THREAD_RET_VALUE;
+}
+
+/*启动并行推演的worker，log.recover_threads小于2时在当前线程推演*/
+static int __recovery_workers_start(WT_RECOVERY* r)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_RECOVERY_WORKER *w;
+	WT_SESSION_IMPL *session;
+	u_int i;
+
+	session = r->session;
+	conn = S2C(session);
+	if (conn->log_recover_threads < 2)
+		return 0;
+
+	WT_RET(__wt_cond_alloc(session, "recovery queue space", 0, &r->space_cond));
+	WT_RET(__wt_calloc_def(session, conn->log_recover_threads, &r->workers));
+	r->nworkers = conn->log_recover_threads;
+	r->workers_stop = 0;
+
+	for (i = 0; i < r->nworkers; i++) {
+		w = &r->workers[i];
+		w->r = r;
+		WT_RET(__wt_spin_init(session, &w->lock, "recovery worker"));
+		WT_RET(__wt_cond_alloc(session, "recovery worker", 0, &w->cond));
+		WT_RET(__wt_calloc_def(session, r->nfiles, &w->cursors));
+		w->ncursors = r->nfiles;
+
+		WT_RET(__wt_open_session(conn, NULL, NULL, &w->session));
+		F_SET(w->session, WT_SESSION_NO_LOGGING);
+
+		WT_RET(__wt_thread_create(session, &w->tid, __recovery_worker, w));
+		w->tid_set = 1;
+	}
+
+	return 0;
+}
+
+/*等待worker推演完所有的操作后退出，并释放worker的资源*/
+static int __recovery_workers_stop(WT_RECOVERY* r)
+{
+	WT_CURSOR *c;
+	WT_DECL_RET;
+	WT_RECOVERY_WORKER *w;
+	WT_SESSION_IMPL *session;
+	u_int i, j;
+
+	session = r->session;
+	if (r->workers == NULL)
+		return 0;
+
+	r->workers_stop = 1;
+	WT_FULL_BARRIER();
+
+	for (i = 0; i < r->nworkers; i++) {
+		w = &r->workers[i];
+		if (w->tid_set) {
+			WT_TRET(__wt_cond_signal(session, w->cond));
+			WT_TRET(__wt_thread_join(session, w->tid));
+			w->tid_set = 0;
+		}
+		WT_TRET(w->ret);
+		r->ops += w->ops;
+
+		for (j = 0; j < w->ncursors; j++)
+			if ((c = w->cursors[j]) != NULL)
+				WT_TRET(c->close(c));
+		__wt_free(session, w->cursors);
+
+		if (w->session != NULL)
+			WT_TRET(w->session->iface.close(&w->session->iface, NULL));
+
+		__wt_buf_free(session, &w->queue);
+		__wt_buf_free(session, &w->work);
+		if (w->cond != NULL)
+			WT_TRET(__wt_cond_destroy(session, &w->cond));
+		__wt_spin_destroy(session, &w->lock);
+	}
+
+	__wt_free(session, r->workers);
+	r->nworkers = 0;
+	if (r->space_cond != NULL)
+		WT_TRET(__wt_cond_destroy(session, &r->space_cond));
+
+	return ret;
+}
+
 /*进行一条日志的推演*/
 static int __txn_commit_apply(WT_RECOVERY* r, WT_LSN* lsnp, const uint8_t** pp, const uint8_t* end)
 {
-	WT_UNUSED(lsnp);
+	WT_RECOVERY_WORKER *w;
+	uint32_t optype, opsize;
+
+	while (*pp < end && **pp){
+		/*推演meta信息或者没有worker时，直接在当前线程推演*/
+		if (r->nworkers == 0 || r->metadata_only) {
+			WT_RET(__txn_op_apply(r, NULL, lsnp, pp, end));
+			continue;
+		}
 
-	while (*pp < end && **pp)
-		WT_RET(__txn_op_apply(r, lsnp, pp, end));
+		WT_RET(__wt_logop_read(r->session, pp, end, &optype, &opsize));
+		if (opsize > WT_PTRDIFF(end, *pp))
+			WT_RET_MSG(r->session, WT_ERROR, "Recovery operation of size %" PRIu32 " overruns its log record", opsize);
+
+		WT_RET(__recovery_op_worker(r, *pp, end, &w));
+		if (w != NULL) {
+			WT_RET(__recovery_worker_push(r, w, lsnp, *pp, opsize));
+			*pp += opsize;
+		}
+		else {
+			/*truncate需要等所有worker推演完之前的操作后才能进行*/
+			WT_RET(__recovery_workers_drain(r));
+			WT_RET(__txn_op_apply(r, NULL, lsnp, pp, end));
+		}
+	}
 
 	return 0;
 }
@@ -358,7 +695,10 @@ int __wt_txn_recover(WT_SESSION_IMPL* session)
 	WT_DECL_RET;
 	WT_RECOVERY r;
 	struct WT_RECOVERY_FILE *metafile;
+	struct timespec start, stop;
 	char *config;
+	uint64_t ops, usecs;
+	u_int nthreads;
 	int needs_rec, was_backup;
 
 	conn = S2C(session);
@@ -433,6 +773,12 @@ int __wt_txn_recover(WT_SESSION_IMPL* session)
 	if (needs_rec && FLD_ISSET(conn->log_flags, WT_CONN_LOG_RECOVER_ERR))
 		WT_ERR(WT_RUN_RECOVERY);
 
+	/*启动并行推演的worker，当前线程只负责读取和解析日志*/
+	WT_ERR(__wt_epoch(session, &start));
+	r.ops = 0;
+	WT_ERR(__recovery_workers_start(&r));
+	nthreads = WT_MAX(r.nworkers, 1);
+
 	/*
 	* Always run recovery even if it was a clean shutdown.
 	* We can consider skipping it in the future.
@@ -442,6 +788,18 @@ int __wt_txn_recover(WT_SESSION_IMPL* session)
 	else
 		WT_ERR(__wt_log_scan(session, &r.ckpt_lsn, WT_LOGSCAN_RECOVER, __txn_log_recover, &r));
 
+	/*等待所有worker推演完成*/
+	WT_ERR(__recovery_workers_stop(&r));
+	ops = r.ops;
+
+	WT_ERR(__wt_epoch(session, &stop));
+	usecs = WT_TIMEDIFF(stop, start) / WT_THOUSAND;
+	WT_STAT_FAST_CONN_INCRV(session, log_recovery_ops, ops);
+	WT_STAT_FAST_CONN_SET(session, log_recovery_time, usecs);
+	WT_ERR(__wt_verbose(session, WT_VERB_RECOVERY,
+	    "Main recovery loop: applied %" PRIu64 " operations in %" PRIu64 "ms with %u threads, %" PRIu64 " ops/sec",
+	    ops, usecs / WT_THOUSAND, nthreads, usecs == 0 ? ops : ops * WT_MILLION / usecs));
+
 	conn->next_file_id = r.max_fileid;
 
 	/*推演完成，建立一个checkpoint*/
@@ -449,6 +807,7 @@ int __wt_txn_recover(WT_SESSION_IMPL* session)
 
 done:
 err:
+	WT_TRET(__recovery_workers_stop(&r));
 	WT_TRET(__recovery_free(&r));
    __wt_free(session, config);
    WT_TRET(session->iface.close(&session->iface, NULL));